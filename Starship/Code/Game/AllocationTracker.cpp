@@ -0,0 +1,198 @@
+#include "AllocationTracker.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Zero before any constructor runs, so allocations during static
+//  initialization are counted correctly too
+static std::atomic<int> s_FrameCounts[ ALLOCATION_TAG_COUNT ];
+static std::atomic<long long> s_FrameBytes[ ALLOCATION_TAG_COUNT ];
+static std::atomic<long long> s_LiveBytes;
+static std::atomic<long long> s_PeakLiveBytes;
+static AllocationFrameStats s_LastFrameStats;
+
+static thread_local AllocationTag t_CurrentTag = ALLOCATION_TAG_UNTAGGED;
+static thread_local long long t_AllocationCount = 0;
+
+//-----------------------------------------------------------------------------
+void EndAllocationFrame()
+{
+    for( int tagIndex = 0; tagIndex < ALLOCATION_TAG_COUNT; ++tagIndex )
+    {
+        s_LastFrameStats.tags[ tagIndex ].count = s_FrameCounts[ tagIndex ].exchange( 0, std::memory_order_relaxed );
+        s_LastFrameStats.tags[ tagIndex ].bytes = s_FrameBytes[ tagIndex ].exchange( 0, std::memory_order_relaxed );
+    }
+    s_LastFrameStats.liveBytes = s_LiveBytes.load( std::memory_order_relaxed );
+    s_LastFrameStats.peakLiveBytes = s_PeakLiveBytes.load( std::memory_order_relaxed );
+}
+
+//-----------------------------------------------------------------------------
+const AllocationFrameStats& GetLastAllocationFrameStats()
+{
+    return s_LastFrameStats;
+}
+
+//-----------------------------------------------------------------------------
+long long GetAllocationFrameBytes( const AllocationFrameStats& stats )
+{
+    long long bytes = 0;
+    for( int tagIndex = 0; tagIndex < ALLOCATION_TAG_COUNT; ++tagIndex )
+    {
+        bytes += stats.tags[ tagIndex ].bytes;
+    }
+    return bytes;
+}
+
+//-----------------------------------------------------------------------------
+AllocationTagScope::AllocationTagScope( AllocationTag tag )
+    : m_PreviousTag( t_CurrentTag )
+{
+    t_CurrentTag = tag;
+}
+
+//-----------------------------------------------------------------------------
+AllocationTagScope::~AllocationTagScope()
+{
+    t_CurrentTag = m_PreviousTag;
+}
+
+//-----------------------------------------------------------------------------
+NoAllocationScope::NoAllocationScope( const char* regionName )
+    : m_RegionName( regionName )
+    , m_AllocationsAtStart( t_AllocationCount )
+{
+}
+
+//-----------------------------------------------------------------------------
+NoAllocationScope::~NoAllocationScope()
+{
+    long long allocations = t_AllocationCount - m_AllocationsAtStart;
+    if( allocations != 0 )
+    {
+        char message[ 128 ];
+        snprintf( message, sizeof( message ), "%s allocated %lli times", m_RegionName, allocations );
+        ERROR_RECOVERABLE( message );
+    }
+}
+
+#if !defined( GAME_DISABLE_ALLOCATION_TRACKING )
+
+//-----------------------------------------------------------------------------
+// The block size sits in front of every allocation, padded to the default
+//  new alignment so what follows is still aligned for anything plain new
+//  has to hold
+static constexpr size_t ALLOCATION_HEADER_BYTES = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+static_assert( ALLOCATION_HEADER_BYTES >= sizeof( size_t ), "Allocation header has to hold the block size" );
+
+//-----------------------------------------------------------------------------
+static void* TrackedAllocate( size_t bytes )
+{
+    unsigned char* block = static_cast<unsigned char*>(malloc( bytes + ALLOCATION_HEADER_BYTES ));
+    if( block == nullptr )
+    {
+        return nullptr;
+    }
+    *reinterpret_cast<size_t*>(block) = bytes;
+
+    s_FrameCounts[ t_CurrentTag ].fetch_add( 1, std::memory_order_relaxed );
+    s_FrameBytes[ t_CurrentTag ].fetch_add( static_cast<long long>(bytes), std::memory_order_relaxed );
+    t_AllocationCount++;
+
+    long long liveBytes = s_LiveBytes.fetch_add( static_cast<long long>(bytes), std::memory_order_relaxed ) + static_cast<long long>(bytes);
+    long long peakLiveBytes = s_PeakLiveBytes.load( std::memory_order_relaxed );
+    while( liveBytes > peakLiveBytes &&
+           !s_PeakLiveBytes.compare_exchange_weak( peakLiveBytes, liveBytes, std::memory_order_relaxed ) )
+    {
+    }
+
+    return block + ALLOCATION_HEADER_BYTES;
+}
+
+//-----------------------------------------------------------------------------
+static void TrackedFree( void* memory )
+{
+    if( memory == nullptr )
+    {
+        return;
+    }
+
+    unsigned char* block = static_cast<unsigned char*>(memory) - ALLOCATION_HEADER_BYTES;
+    s_LiveBytes.fetch_sub( static_cast<long long>(*reinterpret_cast<size_t*>(block)), std::memory_order_relaxed );
+    free( block );
+}
+
+//-----------------------------------------------------------------------------
+void* operator new( size_t bytes )
+{
+    void* memory = TrackedAllocate( bytes );
+    if( memory == nullptr )
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+//-----------------------------------------------------------------------------
+void* operator new[]( size_t bytes )
+{
+    void* memory = TrackedAllocate( bytes );
+    if( memory == nullptr )
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+//-----------------------------------------------------------------------------
+void* operator new( size_t bytes, const std::nothrow_t& ) noexcept
+{
+    return TrackedAllocate( bytes );
+}
+
+//-----------------------------------------------------------------------------
+void* operator new[]( size_t bytes, const std::nothrow_t& ) noexcept
+{
+    return TrackedAllocate( bytes );
+}
+
+//-----------------------------------------------------------------------------
+void operator delete( void* memory ) noexcept
+{
+    TrackedFree( memory );
+}
+
+//-----------------------------------------------------------------------------
+void operator delete[]( void* memory ) noexcept
+{
+    TrackedFree( memory );
+}
+
+//-----------------------------------------------------------------------------
+void operator delete( void* memory, size_t ) noexcept
+{
+    TrackedFree( memory );
+}
+
+//-----------------------------------------------------------------------------
+void operator delete[]( void* memory, size_t ) noexcept
+{
+    TrackedFree( memory );
+}
+
+//-----------------------------------------------------------------------------
+void operator delete( void* memory, const std::nothrow_t& ) noexcept
+{
+    TrackedFree( memory );
+}
+
+//-----------------------------------------------------------------------------
+void operator delete[]( void* memory, const std::nothrow_t& ) noexcept
+{
+    TrackedFree( memory );
+}
+
+#endif
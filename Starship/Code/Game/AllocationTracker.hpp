@@ -0,0 +1,70 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+// Counts every heap allocation in the process through replacement global
+//  operator new and delete. Each allocation is charged to whichever
+//  AllocationTag is innermost on the allocating thread's scope stack, and
+//  carries a small header so its bytes come back off the live total when
+//  freed, whoever frees it.
+//
+//  Counts and bytes accumulate per tag until the App calls
+//  EndAllocationFrame once a frame, which publishes them as the last frame's
+//  stats. Live and peak live bytes cover the whole process.
+//
+//  NoAllocationScope marks code that is expected not to touch the heap
+//  once warmed up; any allocation on its thread inside it is reported when
+//  the scope closes, not from inside operator new.
+//
+//  Over aligned news go to the default allocator and are not counted.
+//  Define GAME_DISABLE_ALLOCATION_TRACKING to leave the global operators
+//  alone; scopes still compile but nothing is counted.
+enum AllocationTag
+{
+    ALLOCATION_TAG_UNTAGGED = 0,
+    ALLOCATION_TAG_UPDATE,
+    ALLOCATION_TAG_COLLISION,
+    ALLOCATION_TAG_RENDER,
+    ALLOCATION_TAG_DEBUG,
+    ALLOCATION_TAG_COUNT
+};
+
+//-----------------------------------------------------------------------------
+struct AllocationTagStats
+{
+    int count = 0;
+    long long bytes = 0;
+};
+
+struct AllocationFrameStats
+{
+    AllocationTagStats tags[ ALLOCATION_TAG_COUNT ];
+    long long liveBytes = 0;
+    long long peakLiveBytes = 0;            // Since startup
+};
+
+void EndAllocationFrame();
+const AllocationFrameStats& GetLastAllocationFrameStats();
+long long GetAllocationFrameBytes( const AllocationFrameStats& stats );     // Every tag together
+
+//-----------------------------------------------------------------------------
+class AllocationTagScope
+{
+public:
+    explicit AllocationTagScope( AllocationTag tag );
+    ~AllocationTagScope();
+
+private:
+    AllocationTag m_PreviousTag = ALLOCATION_TAG_UNTAGGED;
+};
+
+//-----------------------------------------------------------------------------
+class NoAllocationScope
+{
+public:
+    explicit NoAllocationScope( const char* regionName );
+    ~NoAllocationScope();
+
+private:
+    const char* m_RegionName = nullptr;
+    long long m_AllocationsAtStart = 0;
+};
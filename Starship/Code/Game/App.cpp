@@ -1,11 +1,26 @@
 #include "App.hpp"
 
+#include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/Time.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
 #include "Engine/Renderer/Camera.hpp"
 
+#include "Game/AllocationTracker.hpp"
 #include "Game/Game.hpp"
+#include "Game/GameBatchRunner.hpp"
+#include "Game/GameCounterWriter.hpp"
+#include "Game/GameEventQueue.hpp"
+#include "Game/InputThread.hpp"
+#include "Game/Net/GameClient.hpp"
+#include "Game/Net/GameServer.hpp"
+#include "Game/Net/RollbackLoopback.hpp"
+#include "Game/SimulationThread.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
 
 // Globally defined renderer
 InputSystem* g_InputSystem = nullptr;
@@ -13,6 +28,7 @@ RenderContext* g_Renderer = nullptr;
 
 //-----------------------------------------------------------------------------
 App::App()
+    : m_FramePacer( m_FramePacerClock )
 {
 }
 
@@ -22,30 +38,84 @@ App::~App()
 }
 
 //-----------------------------------------------------------------------------
-void App::Startup()
+void App::Startup( const char* commandLine )
 {
+    ParseCommandLine( commandLine );
+    m_FramePacer.SetTargetFramesPerSecond( m_TargetFramesPerSecond );
+
     // Initialize the Engine
     g_InputSystem = &InputSystem::INSTANCE();
     g_InputSystem->SetWindow( g_Window );
 
     g_Renderer = new RenderContext();
     g_Renderer->Startup( g_Window );
+    LoadShaderBundle();
 
     g_EventSystem->Subscribe( "WM_CLOSE", this, &App::HandleQuitRequested );
     g_EventSystem->Subscribe( "Shutdown", this, &App::HandleQuitRequested );
 
+    if( m_CountersFilePath[ 0 ] != '\0' && m_NetMode == APP_NET_MODE_NONE )
+    {
+        m_CounterWriter = new GameCounterWriter();
+        if( !m_CounterWriter->Startup( m_CountersFilePath ) )
+        {
+            ERROR_RECOVERABLE( "Failed to open the counters file" );
+            delete m_CounterWriter;
+            m_CounterWriter = nullptr;
+        }
+    }
+
+    if( m_BatchGameCount > 0 )
+    {
+        RunBatch();
+    }
+    if( m_EventBenchEventCount > 0 )
+    {
+        RunEventBenchmark();
+    }
+
+    // Before the game, whose context carries it
+    if( m_UseInputThread && m_NetMode == APP_NET_MODE_NONE )
+    {
+        m_InputThread = new InputThread();
+        m_InputThread->Startup( m_PlayerCount );
+    }
+
     // Initialize the Game
-    m_GameInstance = new Game();
-    m_GameInstance->Startup();
+    // A server also holds a ship for every client that can join
+    m_GameInstance = new Game( MakeLocalGameContext() );
+    m_GameInstance->Startup( m_NetMode == APP_NET_MODE_SERVER ? MAX_PLAYERS : m_PlayerCount );
+    AttachBotPilots();
+
+    StartupNetwork();
+    StartupSimulationThread();
 }
 
 //-----------------------------------------------------------------------------
 void App::Shutdown()
 {
+    ShutdownSimulationThread();
+    ShutdownNetwork();
+
     m_GameInstance->Shutdown();
     delete m_GameInstance;
     m_GameInstance = nullptr;
 
+    if( m_InputThread != nullptr )
+    {
+        m_InputThread->Shutdown();
+        delete m_InputThread;
+        m_InputThread = nullptr;
+    }
+
+    // After the game, which pushes its last tick on shutdown
+    if( m_CounterWriter != nullptr )
+    {
+        m_CounterWriter->Shutdown();
+        delete m_CounterWriter;
+        m_CounterWriter = nullptr;
+    }
+
     g_Renderer->Shutdown();
     delete g_Renderer;
     g_Renderer = nullptr;
@@ -56,16 +126,14 @@ void App::Shutdown()
 //-----------------------------------------------------------------------------
 void App::RunFrame()
 {
-    static double timeLastFrameStarted = GetCurrentTimeSeconds();
-    double timeThisFrameStarted = GetCurrentTimeSeconds();
-    float deltaSeconds = static_cast<float>(timeThisFrameStarted -
-                                             timeLastFrameStarted);
-    timeLastFrameStarted = timeThisFrameStarted;
+    float deltaSeconds = static_cast<float>(m_FramePacer.WaitForNextFrame());
 
     BeginFrame(); // For all engine systems, before game updates
     Update( deltaSeconds );
     Render();
     EndFrame(); // For all engine systems, after the game updates
+
+    EndAllocationFrame();
 }
 
 //-----------------------------------------------------------------------------
@@ -86,13 +154,42 @@ void App::BeginFrame()
 void App::Update( float deltaSeconds )
 {
     HandleUserInput();
+    UpdatePacerStats();
 
-    m_GameInstance->Update( deltaSeconds );
+    // Networked games are stepped by the server at its own fixed tick
+    if( m_Server != nullptr )
+    {
+        m_Server->Update( deltaSeconds );
+    }
+    if( m_Client != nullptr )
+    {
+        m_Client->Update( deltaSeconds );
+    }
+    if( m_RollbackLoopback != nullptr )
+    {
+        m_RollbackLoopback->Update( deltaSeconds );
+    }
+    if( m_SimulationThread != nullptr )
+    {
+        m_SimulationThread->Update( deltaSeconds );
+    }
+    else if( m_Server == nullptr && m_Client == nullptr && m_RollbackLoopback == nullptr )
+    {
+        m_GameInstance->Update( deltaSeconds );
+    }
 }
 
 //-----------------------------------------------------------------------------
 void App::Render() const
 {
+    if( m_SimulationThread != nullptr )
+    {
+        double startSeconds = GetCurrentTimeSeconds();
+        m_GameInstance->Render();
+        m_SimulationThread->AddRenderSeconds( GetCurrentTimeSeconds() - startSeconds );
+        return;
+    }
+
     m_GameInstance->Render();
 }
 
@@ -117,15 +214,450 @@ void App::HandleUserInput()
     }
 }
 
+//-----------------------------------------------------------------------------
+// Shown with the game's other debug readouts
+void App::UpdatePacerStats()
+{
+    m_FramesSincePacerStats++;
+    if( m_FramesSincePacerStats < APP_PACER_STATS_FRAMES )
+    {
+        return;
+    }
+    m_FramesSincePacerStats = 0;
+
+    FramePacerStats stats = m_FramePacer.GetStats();
+    char text[ 128 ];
+    snprintf( text, sizeof( text ), "PACE %.0f  AVG %.2f  JITTER %.2f  WORST %.2f  LATE %i",
+              m_FramePacer.GetTargetFramesPerSecond(),
+              stats.averageSeconds * 1000.0,
+              stats.jitterSeconds * 1000.0,
+              stats.worstSeconds * 1000.0,
+              stats.overrunCount );
+    m_GameInstance->SetPacerStatsText( text );
+}
+
+//-----------------------------------------------------------------------------
+// A missing or out of date bundle only costs startup time, never correctness
+void App::LoadShaderBundle()
+{
+    std::string bundlePath = std::string( APP_SHADER_ROOT ) + SHADER_BUNDLE_FILE_NAME;
+    if( !m_ShaderBundle.Load( bundlePath.c_str() ) )
+    {
+        DebuggerPrintf( "Shaders: no bundle at %s, compiling every program from source\n", bundlePath.c_str() );
+        return;
+    }
+
+    double startSeconds = GetCurrentTimeSeconds();
+    int staleCount = m_ShaderBundle.ValidateAgainstSources( APP_SHADER_ROOT );
+    DebuggerPrintf( "Shaders: %i of %i prebuilt programs current (%s), %i changed since, checked in %.2fms\n",
+                    m_ShaderBundle.GetEntryCount() - staleCount,
+                    m_ShaderBundle.GetEntryCount(),
+                    m_ShaderBundle.GetCompiler(),
+                    staleCount,
+                    (GetCurrentTimeSeconds() - startSeconds) * 1000.0 );
+}
+
 //-----------------------------------------------------------------------------
 void App::RestartGame()
 {
-    // Delete the game
-    m_GameInstance->Shutdown();
-    delete m_GameInstance;
-    m_GameInstance = nullptr;
+    ShutdownSimulationThread();
+    ShutdownNetwork();
+
+    // Same game and storage, only the world goes back to the start
+    m_GameInstance->Reset( m_GameInstance->GetContext().rngSeed );
+    AttachBotPilots();
+
+    StartupNetwork();
+    StartupSimulationThread();
+}
+
+//-----------------------------------------------------------------------------
+GameContext App::MakeLocalGameContext() const
+{
+    GameContext context;
+    context.renderer = g_Renderer;
+    context.input = g_InputSystem;
+    context.counterWriter = m_CounterWriter;
+    context.inputThread = m_InputThread;
+
+    // Parked sectors are not in the WorldState, so there is nothing for a
+    //  rewind or a peer to carry them in
+    if( m_NetMode == APP_NET_MODE_NONE && m_WorldSectorsPerSide > 1 )
+    {
+        context.worldSectorsPerSide = m_WorldSectorsPerSide;
+        context.keepsRewindHistory = false;
+    }
+    return context;
+}
+
+//-----------------------------------------------------------------------------
+void App::AttachBotPilots()
+{
+    if( !m_UseBots )
+    {
+        return;
+    }
+
+    for( int playerIndex = 0; playerIndex < m_PlayerCount; ++playerIndex )
+    {
+        m_BotPilots[ playerIndex ] = BotPilot();
+        m_GameInstance->SetPlayerPilot( playerIndex, &m_BotPilots[ playerIndex ] );
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Blocks startup until the whole batch is done, then asks to quit
+void App::RunBatch()
+{
+    GameBatchSettings settings;
+    settings.gameCount = m_BatchGameCount;
+    settings.ticksPerGame = m_BatchTicksPerGame;
+    settings.playerCount = m_PlayerCount;
+
+    GameBatchRunner runner;
+    runner.Startup( 0 );
+
+    std::vector<GameBatchResult> results;
+    double startSeconds = GetCurrentTimeSeconds();
+    runner.Run( settings, results );
+    double wallSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+    long long totalTicks = 0;
+    int totalWaves = 0;
+    int gameOverCount = 0;
+    long long totalKills = 0;
+    double worstTickSeconds = 0.0;
+    for( const GameBatchResult& result : results )
+    {
+        totalTicks += result.ticksSimulated;
+        totalWaves += result.wavesReached;
+        totalKills += result.kills;
+        gameOverCount += result.isGameOver ? 1 : 0;
+        worstTickSeconds = result.worstTickSeconds > worstTickSeconds ? result.worstTickSeconds : worstTickSeconds;
+    }
+
+    DebuggerPrintf( "Batch: %i games, %i players, %i threads in %.2fs (%.0f ticks/s)\n",
+                    settings.gameCount,
+                    settings.playerCount,
+                    runner.GetThreadCount(),
+                    wallSeconds,
+                    wallSeconds > 0.0 ? static_cast<double>(totalTicks) / wallSeconds : 0.0 );
+    DebuggerPrintf( "Batch: average wave %.2f, %.1f kills, %i of %i games over before %i ticks, worst tick %.3fms\n",
+                    static_cast<double>(totalWaves) / static_cast<double>(settings.gameCount),
+                    static_cast<double>(totalKills) / static_cast<double>(settings.gameCount),
+                    gameOverCount,
+                    settings.gameCount,
+                    settings.ticksPerGame,
+                    worstTickSeconds * 1000.0 );
+
+    runner.Shutdown();
+    m_isQuitting = true;
+}
+
+//-----------------------------------------------------------------------------
+namespace
+{
+    // Does just enough with each payload that the handlers can't be skipped
+    struct EventBenchmarkSubscriber
+    {
+        long long spawns = 0;
+        long long hits = 0;
+        long long kills = 0;
+        float checksum = 0.f;
+
+        void HandleSpawn( const GameSpawnEvent& spawn ) { spawns++; checksum += spawn.position.x; }
+        void HandleHit( const GameHitEvent& hit ) { hits++; checksum += hit.point.y; }
+        void HandleKill( const GameKillEvent& kill ) { kills++; checksum += kill.position.x; }
+    };
+}
+
+//-----------------------------------------------------------------------------
+// Publishes a spawn, hit, kill mix in queue sized batches, like a busy tick,
+//  and times publishing and dispatching apart. The loop is held to no
+//  allocations once the queue is warm.
+void App::RunEventBenchmark()
+{
+    GameEventQueue events;
+    EventBenchmarkSubscriber subscriber;
+    events.Subscribe<GameSpawnEvent, EventBenchmarkSubscriber, &EventBenchmarkSubscriber::HandleSpawn>( &subscriber );
+    events.Subscribe<GameHitEvent, EventBenchmarkSubscriber, &EventBenchmarkSubscriber::HandleHit>( &subscriber );
+    events.Subscribe<GameKillEvent, EventBenchmarkSubscriber, &EventBenchmarkSubscriber::HandleKill>( &subscriber );
+
+    GameSpawnEvent spawn;
+    spawn.kind = ENTITY_KIND_DEBRIS;
+    GameHitEvent hit;
+    hit.type = CONTACT_TYPE_BULLET_ASTEROID;
+    GameKillEvent kill;
+    kill.killedKind = ENTITY_KIND_ASTEROID;
+    kill.killerKind = ENTITY_KIND_BULLET;
+
+    double publishSeconds = 0.0;
+    double dispatchSeconds = 0.0;
+    long long dispatchedCount = 0;
+    {
+        NoAllocationScope noAllocation( "App::RunEventBenchmark" );
+        for( int eventIndex = 0; eventIndex < m_EventBenchEventCount; )
+        {
+            int batchEnd = eventIndex + GAME_EVENT_QUEUE_RESERVED;
+            batchEnd = batchEnd < m_EventBenchEventCount ? batchEnd : m_EventBenchEventCount;
+
+            double startSeconds = GetCurrentTimeSeconds();
+            for( ; eventIndex < batchEnd; ++eventIndex )
+            {
+                float position = static_cast<float>(eventIndex & 0xff);
+                switch( eventIndex % 3 )
+                {
+                    case 0: spawn.position = Vec2( position, 0.f ); events.Publish( spawn ); break;
+                    case 1: hit.point = Vec2( 0.f, position ); events.Publish( hit ); break;
+                    default: kill.position = Vec2( position, 0.f ); events.Publish( kill ); break;
+                }
+            }
+            double publishedSeconds = GetCurrentTimeSeconds();
+            dispatchedCount += events.DispatchEvents();
+            double dispatchedSeconds = GetCurrentTimeSeconds();
+
+            publishSeconds += publishedSeconds - startSeconds;
+            dispatchSeconds += dispatchedSeconds - publishedSeconds;
+        }
+    }
+
+    double eventCount = static_cast<double>(m_EventBenchEventCount);
+    DebuggerPrintf( "Event bench: %lld events, publish %.1fns (%.0f M/s), dispatch %.1fns (%.0f M/s) per event\n",
+                    dispatchedCount,
+                    publishSeconds * 1e9 / eventCount,
+                    publishSeconds > 0.0 ? eventCount / publishSeconds * 1e-6 : 0.0,
+                    dispatchSeconds * 1e9 / eventCount,
+                    dispatchSeconds > 0.0 ? eventCount / dispatchSeconds * 1e-6 : 0.0 );
+    DebuggerPrintf( "Event bench: handled %lld spawns, %lld hits, %lld kills (checksum %.0f)\n",
+                    subscriber.spawns,
+                    subscriber.hits,
+                    subscriber.kills,
+                    static_cast<double>(subscriber.checksum) );
+
+    m_isQuitting = true;
+}
+
+//-----------------------------------------------------------------------------
+void App::ParseCommandLine( const char* commandLine )
+{
+    m_NetMode = APP_NET_MODE_NONE;
+    m_PlayerCount = 1;
+    m_BatchGameCount = 0;
+    m_EventBenchEventCount = 0;
+    m_WorldSectorsPerSide = 1;
+    m_UseBots = false;
+    m_UseSimulationThread = false;
+    m_UseInputThread = false;
+    m_TargetFramesPerSecond = FRAME_PACER_DEFAULT_FRAMES_PER_SECOND;
+    m_CountersFilePath[ 0 ] = '\0';
+    if( commandLine == nullptr )
+    {
+        return;
+    }
+
+    m_UseBots = strstr( commandLine, "-bots" ) != nullptr;
+    m_UseSimulationThread = strstr( commandLine, "-threaded" ) != nullptr;
+    m_UseInputThread = strstr( commandLine, "-inputthread" ) != nullptr;
+
+    if( const char* countersArguments = strstr( commandLine, "-counters" ) )
+    {
+        const char* filePath = countersArguments + strlen( "-counters" );
+        filePath += strspn( filePath, " " );
+        size_t filePathLength = strcspn( filePath, " " );
+        if( filePathLength == 0 || *filePath == '-' || filePathLength >= sizeof( m_CountersFilePath ) )
+        {
+            filePath = APP_DEFAULT_COUNTERS_FILE_PATH;
+            filePathLength = strlen( APP_DEFAULT_COUNTERS_FILE_PATH );
+        }
+        memcpy( m_CountersFilePath, filePath, filePathLength );
+        m_CountersFilePath[ filePathLength ] = '\0';
+    }
+
+    if( const char* fpsArguments = strstr( commandLine, "-fps" ) )
+    {
+        double framesPerSecond = strtod( fpsArguments + strlen( "-fps" ), nullptr );
+        m_TargetFramesPerSecond = framesPerSecond > 0.0 ? static_cast<float>(framesPerSecond) : 0.f;
+    }
+
+    if( const char* batchArguments = strstr( commandLine, "-batch" ) )
+    {
+        char* argumentEnd = nullptr;
+        const char* gameCountArgument = batchArguments + strlen( "-batch" );
+        long gameCount = strtol( gameCountArgument, &argumentEnd, 10 );
+        long ticksPerGame = strtol( argumentEnd, nullptr, 10 );
+        m_BatchGameCount = gameCount > 0 ? static_cast<int>(gameCount) : APP_DEFAULT_BATCH_GAMES;
+        m_BatchTicksPerGame = ticksPerGame > 0 ? static_cast<int>(ticksPerGame) : GameBatchSettings().ticksPerGame;
+    }
+
+    if( const char* eventBenchArguments = strstr( commandLine, "-eventbench" ) )
+    {
+        long eventCount = strtol( eventBenchArguments + strlen( "-eventbench" ), nullptr, 10 );
+        m_EventBenchEventCount = eventCount > 0 ? static_cast<int>(eventCount) : APP_DEFAULT_EVENT_BENCH_EVENTS;
+    }
+
+    if( const char* sectorsArguments = strstr( commandLine, "-sectors" ) )
+    {
+        long sectorsPerSide = strtol( sectorsArguments + strlen( "-sectors" ), nullptr, 10 );
+        sectorsPerSide = sectorsPerSide > 0 ? sectorsPerSide : APP_DEFAULT_WORLD_SECTORS_PER_SIDE;
+        m_WorldSectorsPerSide = static_cast<int>(sectorsPerSide > MAX_WORLD_SECTORS_PER_SIDE ? MAX_WORLD_SECTORS_PER_SIDE : sectorsPerSide);
+    }
+
+    if( const char* playersArguments = strstr( commandLine, "-players" ) )
+    {
+        long playerCount = strtol( playersArguments + strlen( "-players" ), nullptr, 10 );
+        m_PlayerCount = static_cast<int>(playerCount < 1 ? 1 : (playerCount > MAX_PLAYERS ? MAX_PLAYERS : playerCount));
+    }
+
+    long port = 0;
+    if( const char* rollbackArguments = strstr( commandLine, "-rollback" ) )
+    {
+        // One ship per peer, both games have to agree on that
+        m_NetMode = APP_NET_MODE_ROLLBACK_LOOPBACK;
+        m_PlayerCount = ROLLBACK_LOOPBACK_PEERS;
+
+        char* argumentEnd = nullptr;
+        const char* latencyArgument = rollbackArguments + strlen( "-rollback" );
+        double latencyMilliseconds = strtod( latencyArgument, &argumentEnd );
+        if( argumentEnd == latencyArgument )
+        {
+            latencyMilliseconds = ROLLBACK_LOOPBACK_DEFAULT_LATENCY_SECONDS * 1000.0;
+        }
+
+        const char* jitterArgument = argumentEnd;
+        double jitterMilliseconds = strtod( jitterArgument, &argumentEnd );
+        if( argumentEnd == jitterArgument )
+        {
+            jitterMilliseconds = ROLLBACK_LOOPBACK_DEFAULT_JITTER_SECONDS * 1000.0;
+        }
+
+        m_RollbackLatencySeconds = latencyMilliseconds > 0.0 ? static_cast<float>(latencyMilliseconds * .001) : 0.f;
+        m_RollbackJitterSeconds = jitterMilliseconds > 0.0 ? static_cast<float>(jitterMilliseconds * .001) : 0.f;
+    }
+    else if( strstr( commandLine, "-loopback" ) != nullptr )
+    {
+        m_NetMode = APP_NET_MODE_LOOPBACK;
+    }
+    else if( const char* serverArguments = strstr( commandLine, "-server" ) )
+    {
+        m_NetMode = APP_NET_MODE_SERVER;
+        port = strtol( serverArguments + strlen( "-server" ), nullptr, 10 );
+    }
+    else if( const char* clientArguments = strstr( commandLine, "-client" ) )
+    {
+        m_NetMode = APP_NET_MODE_CLIENT;
 
-    // Recreate the game
-    m_GameInstance = new Game();
-    m_GameInstance->Startup();
+        const char* address = clientArguments + strlen( "-client" );
+        address += strspn( address, " " );
+        size_t addressLength = strcspn( address, " " );
+        if( addressLength > 0 && addressLength < sizeof( m_ServerAddress ) )
+        {
+            memcpy( m_ServerAddress, address, addressLength );
+            m_ServerAddress[ addressLength ] = '\0';
+        }
+        port = strtol( address + addressLength, nullptr, 10 );
+    }
+
+    m_ServerPort = port > 0 && port < 65536 ? static_cast<unsigned short>(port) : NET_DEFAULT_PORT;
+}
+
+//-----------------------------------------------------------------------------
+void App::StartupNetwork()
+{
+    if( m_NetMode == APP_NET_MODE_SERVER )
+    {
+        m_Server = new GameServer( m_GameInstance, m_PlayerCount );
+        GUARANTEE_RECOVERABLE( m_Server->Startup( m_ServerPort ), "Failed to open server port" );
+    }
+    else if( m_NetMode == APP_NET_MODE_CLIENT )
+    {
+        NetAddress serverAddress;
+        GUARANTEE_RECOVERABLE( NetAddress::MakeFromString( m_ServerAddress, m_ServerPort, serverAddress ),
+                               "Client needs an IPv4 server address" );
+        m_Client = new GameClient( m_GameInstance );
+        m_Client->SetPlayerPilot( m_UseBots ? &m_BotPilots[ 0 ] : nullptr );
+        GUARANTEE_RECOVERABLE( m_Client->Startup( serverAddress ), "Failed to open client socket" );
+    }
+    else if( m_NetMode == APP_NET_MODE_LOOPBACK )
+    {
+        // The whole replication path in one process: the rendered game only
+        //  ever shows what came back over the socket
+        m_ServerGameInstance = new Game( GameContext() );
+        m_ServerGameInstance->Startup( MAX_PLAYERS );
+        m_Server = new GameServer( m_ServerGameInstance, 0 );
+        GUARANTEE_RECOVERABLE( m_Server->Startup( m_ServerPort ), "Failed to open server port" );
+
+        m_Client = new GameClient( m_GameInstance );
+        m_Client->SetPlayerPilot( m_UseBots ? &m_BotPilots[ 0 ] : nullptr );
+        GUARANTEE_RECOVERABLE( m_Client->Startup( NetAddress::MakeLoopback( m_ServerPort ) ),
+                               "Failed to open client socket" );
+    }
+    else if( m_NetMode == APP_NET_MODE_ROLLBACK_LOOPBACK )
+    {
+        m_RollbackLoopback = new RollbackLoopback( m_GameInstance );
+        m_RollbackLoopback->Startup( m_RollbackLatencySeconds, m_RollbackJitterSeconds );
+    }
+}
+
+//-----------------------------------------------------------------------------
+void App::ShutdownNetwork()
+{
+    if( m_RollbackLoopback != nullptr )
+    {
+        m_RollbackLoopback->Shutdown();
+        delete m_RollbackLoopback;
+        m_RollbackLoopback = nullptr;
+    }
+
+    if( m_Client != nullptr )
+    {
+        m_Client->Shutdown();
+        delete m_Client;
+        m_Client = nullptr;
+    }
+
+    if( m_Server != nullptr )
+    {
+        m_Server->Shutdown();
+        delete m_Server;
+        m_Server = nullptr;
+    }
+
+    if( m_ServerGameInstance != nullptr )
+    {
+        m_ServerGameInstance->Shutdown();
+        delete m_ServerGameInstance;
+        m_ServerGameInstance = nullptr;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// The game App draws becomes a mirror of one stepped on another thread; the
+//  bots move with the simulation since that is where inputs are read
+void App::StartupSimulationThread()
+{
+    if( !m_UseSimulationThread || m_NetMode != APP_NET_MODE_NONE )
+    {
+        return;
+    }
+
+    m_SimulationThread = new SimulationThread( m_GameInstance );
+    if( m_UseBots )
+    {
+        for( int playerIndex = 0; playerIndex < m_PlayerCount; ++playerIndex )
+        {
+            m_SimulationThread->SetPlayerPilot( playerIndex, &m_BotPilots[ playerIndex ] );
+        }
+    }
+    m_SimulationThread->Startup( m_PlayerCount );
+}
+
+//-----------------------------------------------------------------------------
+void App::ShutdownSimulationThread()
+{
+    if( m_SimulationThread != nullptr )
+    {
+        m_SimulationThread->Shutdown();
+        delete m_SimulationThread;
+        m_SimulationThread = nullptr;
+    }
 }
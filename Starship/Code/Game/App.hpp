@@ -3,18 +3,85 @@
 #include "Engine/Core/Math/Primatives/Vec2.hpp"
 #include "Engine/Event/EventSystem.hpp"
 
+#include "Game/BotPilot.hpp"
+#include "Game/FramePacer.hpp"
+#include "Game/GameCommon.hpp"
+#include "Game/GameContext.hpp"
+#include "Game/ShaderBundle.hpp"
+#include "Game/SystemFramePacerClock.hpp"
+
+class App;
+class InputSystem;
+class RenderContext;
 class Window;
+
+//-------------------------------------------------------------------------------
+// Process wide singletons; only the App and the platform layer touch these,
+//  games get what they need through their GameContext
+extern App* g_App;
+extern InputSystem* g_InputSystem;
+extern RenderContext* g_Renderer;
 extern Window* g_Window;
 
 class Game;
 class Camera;
+class GameClient;
+class GameCounterWriter;
+class GameServer;
+class InputThread;
+class RollbackLoopback;
+class SimulationThread;
+
+//-----------------------------------------------------------------------------
+// Chosen from the command line:
+//  -server [port]          Authoritative server, renders its own game;
+//                          clients fly the ships after the local players
+//  -client <ip> [port]     Mirrors a server and flies the ship it is given,
+//                          never simulates
+//  -loopback               Server and client in one process over 127.0.0.1
+//  -rollback [ms] [jitter] Two rollback peers in one process over a fake link
+// Independent of those:
+//  -players <count>        Local ships, one per controller; player 0 also
+//                          gets the keyboard
+//  -batch [games] [ticks]  Run that many headless games on every core, log
+//                          a summary and quit
+//  -bots                   Bots fly every local ship (a client's remote
+//                          one), for watching soaks
+//  -threaded               Simulate on its own thread, overlapped with
+//                          rendering; ignored by the network modes
+//  -fps <rate>             Frame rate to pace the main loop to, 0 for as
+//                          fast as possible; defaults to 60
+//  -counters [file]        Log per tick gameplay counters as CSV; local
+//                          play only
+//  -inputthread            Sample local devices on their own thread and
+//                          latch them per tick; local play only
+//  -eventbench [events]    Time publishing and dispatching that many game
+//                          events, log the rates and quit
+//  -sectors [per side]     Play in a world that many screens on a side,
+//                          streamed around the ships; defaults to 256. Turns
+//                          off rewind; local play only
+enum AppNetMode
+{
+    APP_NET_MODE_NONE = 0,
+    APP_NET_MODE_SERVER,
+    APP_NET_MODE_CLIENT,
+    APP_NET_MODE_LOOPBACK,
+    APP_NET_MODE_ROLLBACK_LOOPBACK,
+};
+
+constexpr int APP_DEFAULT_BATCH_GAMES = 256;
+constexpr int APP_DEFAULT_EVENT_BENCH_EVENTS = 10000000;
+constexpr int APP_DEFAULT_WORLD_SECTORS_PER_SIDE = 256;     // About 260000 parked asteroids
+constexpr int APP_PACER_STATS_FRAMES = 30;            // How often the pacing readout refreshes
+constexpr const char* APP_DEFAULT_COUNTERS_FILE_PATH = "Data/Counters.csv";
+constexpr const char* APP_SHADER_ROOT = "Data/Shaders/";      // Built into a bundle by Code/Tools/ShaderBundler
 
 class App
 {
 public:
     App();
     ~App();
-    void Startup();
+    void Startup( const char* commandLine );
     void Shutdown();
     void RunFrame();
 
@@ -23,6 +90,10 @@ public:
     bool HandleKeyReleased( unsigned char keyCode );
     bool HandleQuitRequested( EventArgs* );
 
+    // Prebuilt programs whose sources are unchanged; anything else the
+    //  renderer compiles from APP_SHADER_ROOT as before
+    const ShaderBundle& GetShaderBundle() const { return m_ShaderBundle; }
+
 private:
     bool m_isQuitting = false;
     bool m_isPaused = false;
@@ -33,6 +104,37 @@ private:
     Game* m_GameInstance = nullptr;
     Camera* m_Camera = nullptr;
 
+    ShaderBundle m_ShaderBundle;
+
+    SystemFramePacerClock m_FramePacerClock;    // Declared first; the pacer keeps a reference
+    FramePacer m_FramePacer;
+    float m_TargetFramesPerSecond = FRAME_PACER_DEFAULT_FRAMES_PER_SECOND;
+    int m_FramesSincePacerStats = 0;
+
+    char m_CountersFilePath[ 260 ] = "";          // Empty when not logging
+    GameCounterWriter* m_CounterWriter = nullptr;
+
+    int m_PlayerCount = 1;
+    int m_BatchGameCount = 0;                   // Non zero runs a batch instead of playing
+    int m_BatchTicksPerGame = 0;
+    int m_EventBenchEventCount = 0;             // Non zero runs the event benchmark and quits
+    int m_WorldSectorsPerSide = 1;
+    bool m_UseBots = false;
+    BotPilot m_BotPilots[ MAX_PLAYERS ];
+    bool m_UseSimulationThread = false;
+    bool m_UseInputThread = false;
+    InputThread* m_InputThread = nullptr;
+    SimulationThread* m_SimulationThread = nullptr;
+    AppNetMode m_NetMode = APP_NET_MODE_NONE;
+    char m_ServerAddress[ 64 ] = "127.0.0.1";
+    unsigned short m_ServerPort = 0;
+    Game* m_ServerGameInstance = nullptr;      // Loopback only; the rendered game is the client's
+    GameServer* m_Server = nullptr;
+    GameClient* m_Client = nullptr;
+    RollbackLoopback* m_RollbackLoopback = nullptr;
+    float m_RollbackLatencySeconds = 0.f;
+    float m_RollbackJitterSeconds = 0.f;
+
     float m_shipSpeedSeconds = 10.f;
     float m_shipWidth = 6.f;
     float m_shipHeight = 2.5f;
@@ -43,6 +145,19 @@ private:
     void EndFrame();
 
     void HandleUserInput();
+    void UpdatePacerStats();
+    void LoadShaderBundle();
 
     void RestartGame();
+    GameContext MakeLocalGameContext() const;
+    void AttachBotPilots();
+    void RunBatch();
+    void RunEventBenchmark();
+
+    void StartupSimulationThread();
+    void ShutdownSimulationThread();
+
+    void ParseCommandLine( const char* commandLine );
+    void StartupNetwork();
+    void ShutdownNetwork();
 };
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "BotPilot.hpp"
+
+#include "Engine/Core/Math/MathUtils.hpp"
+
+#include "Game/Entity/PlayerShip.hpp"
+#include "Game/Game.hpp"
+#include "Game/GameCommon.hpp"
+
+//-----------------------------------------------------------------------------
+BotPilot::BotPilot()
+{
+}
+
+//-----------------------------------------------------------------------------
+BotPilot::~BotPilot()
+{
+}
+
+//-----------------------------------------------------------------------------
+PlayerInput BotPilot::UpdatePilot( const Game& game, int playerIndex )
+{
+    PlayerInput input;
+    const PlayerShip* ship = game.GetPlayerShip( playerIndex );
+    if( ship == nullptr )
+    {
+        return input;
+    }
+
+    if( game.IsAttractMode() || ship->IsDead() )
+    {
+        input.buttons |= PLAYER_INPUT_START;
+        return input;
+    }
+
+    const Vec3 shipPosition = ship->GetPosition();
+    const Vec3 shipVelocity = ship->GetVelocity();
+    m_TicksSinceFire++;
+
+    // Dodge: of the enemies close enough to matter, the one whose closest
+    //  approach is inside touching distance and comes soonest
+    const Entity* threats[ BOT_MAX_THREATS ];
+    int threatCount = game.GetEnemiesInDisc( shipPosition, BOT_DODGE_RADIUS, threats, BOT_MAX_THREATS );
+
+    float soonestSeconds = BOT_DODGE_LOOKAHEAD_SECONDS;
+    Vec3 soonestMiss = Vec3::ZERO;
+    Vec3 soonestRelativeVelocity = Vec3::ZERO;
+    bool isDodging = false;
+    for( int threatIndex = 0; threatIndex < threatCount; ++threatIndex )
+    {
+        const Entity& threat = *threats[ threatIndex ];
+        Vec3 relativePosition = threat.GetPosition() - shipPosition;
+        Vec3 relativeVelocity = threat.GetVelocity() - shipVelocity;
+
+        float closingSpeedSquared = relativeVelocity.x * relativeVelocity.x + relativeVelocity.y * relativeVelocity.y;
+        float closestSeconds = 0.f;
+        if( closingSpeedSquared > 0.f )
+        {
+            closestSeconds = -(relativePosition.x * relativeVelocity.x + relativePosition.y * relativeVelocity.y) / closingSpeedSquared;
+            closestSeconds = closestSeconds > 0.f ? closestSeconds : 0.f;
+        }
+        if( closestSeconds >= soonestSeconds )
+        {
+            continue;
+        }
+
+        Vec3 miss = relativePosition + relativeVelocity * closestSeconds;
+        float touchDistance = threat.GetPhysicsRadius() + ship->GetPhysicsRadius() + BOT_DODGE_CLEARANCE;
+        if( miss.x * miss.x + miss.y * miss.y < touchDistance * touchDistance )
+        {
+            soonestSeconds = closestSeconds;
+            soonestMiss = miss;
+            soonestRelativeVelocity = relativeVelocity;
+            isDodging = true;
+        }
+    }
+
+    if( isDodging )
+    {
+        // Away from where it will pass; dead on collisions go across its path
+        Vec2 away = Vec2( -soonestMiss.x, -soonestMiss.y );
+        if( away.x * away.x + away.y * away.y < .01f )
+        {
+            away = Vec2( soonestRelativeVelocity.x, soonestRelativeVelocity.y ).GetRotated90Degrees();
+        }
+        input.SetSteerAngleDegrees( atan2fDegrees( away.y, away.x ) );
+        input.thrust = PLAYER_INPUT_THRUST_MAX;
+        return input;
+    }
+
+    const float shipSpeed = ship->GetVelocity().GetLength();
+    if( shipSpeed > BOT_BRAKE_SPEED )
+    {
+        input.SetSteerAngleDegrees( atan2fDegrees( -shipVelocity.y, -shipVelocity.x ) );
+        input.thrust = PLAYER_INPUT_THRUST_MAX;
+        return input;
+    }
+
+    // Attack: lead the nearest enemy by the bullet's flight time. With
+    //  nothing left drift back to the middle of the world.
+    const Entity* target = game.GetNearestEnemy( shipPosition );
+    if( target == nullptr )
+    {
+        const Vec2 worldCenter = game.GetWorldSize() * .5f;
+        Vec3 toCenter = Vec3( worldCenter.x, worldCenter.y, 0.f ) - shipPosition;
+        input.SetSteerAngleDegrees( atan2fDegrees( toCenter.y, toCenter.x ) );
+        if( toCenter.GetLength() > BOT_PREFERRED_RANGE && shipSpeed < BOT_CRUISE_SPEED )
+        {
+            input.thrust = PLAYER_INPUT_THRUST_MAX;
+        }
+        return input;
+    }
+
+    Vec3 toTarget = target->GetPosition() - shipPosition;
+    float targetDistance = toTarget.GetLength();
+    Vec3 aim = toTarget + target->GetVelocity() * (targetDistance / BULLET_SPEED);
+    input.SetSteerAngleDegrees( atan2fDegrees( aim.y, aim.x ) );
+
+    if( targetDistance > BOT_PREFERRED_RANGE && shipSpeed < BOT_CRUISE_SPEED )
+    {
+        input.thrust = PLAYER_INPUT_THRUST_MAX;
+    }
+
+    // Steering is instant, so the shot leaves along the aim this same tick
+    if( m_TicksSinceFire >= BOT_FIRE_INTERVAL_TICKS && targetDistance < BULLET_SPEED * BULLET_LIFETIME_SECONDS )
+    {
+        input.buttons |= PLAYER_INPUT_FIRE;
+        m_TicksSinceFire = 0;
+    }
+
+    return input;
+}
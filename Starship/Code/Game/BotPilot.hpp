@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Game/PlayerPilot.hpp"
+
+//-----------------------------------------------------------------------------
+// Built in bot for attract mode demos and soak tests. Each tick it either
+//  dodges the enemy that will pass closest soonest, or turns to lead the
+//  nearest enemy and fires on a fixed cadence. Both come from Game's enemy
+//  disc queries, so the cost stays flat however many bullets are in flight.
+//  Nothing is random; apart from the fire cadence the same world always
+//  gets the same answer. Dead ships press start.
+constexpr float BOT_DODGE_RADIUS = 25.f;                // Only enemies this close are threats
+constexpr float BOT_DODGE_LOOKAHEAD_SECONDS = .75f;
+constexpr float BOT_DODGE_CLEARANCE = 3.f;              // Beyond the two physics radii
+constexpr float BOT_CRUISE_SPEED = 25.f;
+constexpr float BOT_BRAKE_SPEED = 40.f;                 // Turns against its velocity above this
+constexpr float BOT_PREFERRED_RANGE = 35.f;
+constexpr int BOT_FIRE_INTERVAL_TICKS = 6;
+constexpr int BOT_MAX_THREATS = 16;
+
+class BotPilot: public PlayerPilot
+{
+public:
+    BotPilot();
+    virtual ~BotPilot();
+
+    virtual PlayerInput UpdatePilot( const Game& game, int playerIndex ) override;
+
+private:
+    int m_TicksSinceFire = 0;
+};
@@ -0,0 +1,143 @@
+#include "CollisionGrid.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include "Game/Entity/Entity.hpp"
+
+//-----------------------------------------------------------------------------
+CollisionGrid::CollisionGrid()
+{
+}
+
+//-----------------------------------------------------------------------------
+CollisionGrid::~CollisionGrid()
+{
+}
+
+//-----------------------------------------------------------------------------
+void CollisionGrid::Startup( const AABB2& bounds, float cellSize, float maxQueryRadius )
+{
+    GUARANTEE_OR_DIE( cellSize > 0.f, "CollisionGrid cells need a size" );
+
+    m_Bounds = bounds;
+    m_InverseCellSize = 1.f / cellSize;
+    m_MaxQueryRadius = maxQueryRadius;
+    m_CellCountX = static_cast<int>((bounds.maxs.x - bounds.mins.x) * m_InverseCellSize) + 1;
+    m_CellCountY = static_cast<int>((bounds.maxs.y - bounds.mins.y) * m_InverseCellSize) + 1;
+
+    m_CellStarts.resize( m_CellCountX * m_CellCountY + 1 );
+    Clear();
+}
+
+//-----------------------------------------------------------------------------
+void CollisionGrid::Shutdown()
+{
+    m_Entries.clear();
+    m_Entries.shrink_to_fit();
+    m_CellStarts.clear();
+    m_CellStarts.shrink_to_fit();
+    m_Candidates.clear();
+    m_Candidates.shrink_to_fit();
+}
+
+//-----------------------------------------------------------------------------
+void CollisionGrid::MoveBounds( const Vec2& mins )
+{
+    m_Bounds.maxs = m_Bounds.maxs + (mins - m_Bounds.mins);
+    m_Bounds.mins = mins;
+}
+
+//-----------------------------------------------------------------------------
+// Keeps capacity, after the first few ticks nothing here allocates
+void CollisionGrid::Clear()
+{
+    m_Entries.clear();
+    m_Candidates.clear();
+}
+
+//-----------------------------------------------------------------------------
+void CollisionGrid::Insert( Entity* entity, int tag )
+{
+    const Vec3 position = entity->GetPosition();
+    const float reach = entity->GetPhysicsRadius() + m_MaxQueryRadius;
+
+    const int minX = GetCellX( position.x - reach );
+    const int maxX = GetCellX( position.x + reach );
+    const int minY = GetCellY( position.y - reach );
+    const int maxY = GetCellY( position.y + reach );
+
+    Entry entry;
+    entry.candidate.entity = entity;
+    entry.candidate.tag = tag;
+    for( int cellY = minY; cellY <= maxY; ++cellY )
+    {
+        for( int cellX = minX; cellX <= maxX; ++cellX )
+        {
+            entry.cellIndex = cellY * m_CellCountX + cellX;
+            m_Entries.push_back( entry );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Counting sort by cell; stable, so each cell keeps insertion order
+void CollisionGrid::Build()
+{
+    const int cellCount = m_CellCountX * m_CellCountY;
+    for( int cellIndex = 0; cellIndex <= cellCount; ++cellIndex )
+    {
+        m_CellStarts[ cellIndex ] = 0;
+    }
+
+    for( const Entry& entry : m_Entries )
+    {
+        m_CellStarts[ entry.cellIndex + 1 ]++;
+    }
+    for( int cellIndex = 0; cellIndex < cellCount; ++cellIndex )
+    {
+        m_CellStarts[ cellIndex + 1 ] += m_CellStarts[ cellIndex ];
+    }
+
+    // Fill from each cell's start, then shift the starts back into place
+    m_Candidates.resize( m_Entries.size() );
+    for( const Entry& entry : m_Entries )
+    {
+        m_Candidates[ m_CellStarts[ entry.cellIndex ]++ ] = entry.candidate;
+    }
+    for( int cellIndex = cellCount; cellIndex > 0; --cellIndex )
+    {
+        m_CellStarts[ cellIndex ] = m_CellStarts[ cellIndex - 1 ];
+    }
+    m_CellStarts[ 0 ] = 0;
+}
+
+//-----------------------------------------------------------------------------
+int CollisionGrid::GetCandidates( const Vec2& position, const CollisionCandidate** outCandidates ) const
+{
+    const int cellIndex = GetCellY( position.y ) * m_CellCountX + GetCellX( position.x );
+    const int start = m_CellStarts[ cellIndex ];
+    *outCandidates = m_Candidates.data() + start;
+    return m_CellStarts[ cellIndex + 1 ] - start;
+}
+
+//-----------------------------------------------------------------------------
+int CollisionGrid::GetCellX( float x ) const
+{
+    int cellX = static_cast<int>((x - m_Bounds.mins.x) * m_InverseCellSize);
+    if( x < m_Bounds.mins.x || cellX < 0 )
+    {
+        return 0;
+    }
+    return cellX < m_CellCountX ? cellX : m_CellCountX - 1;
+}
+
+//-----------------------------------------------------------------------------
+int CollisionGrid::GetCellY( float y ) const
+{
+    int cellY = static_cast<int>((y - m_Bounds.mins.y) * m_InverseCellSize);
+    if( y < m_Bounds.mins.y || cellY < 0 )
+    {
+        return 0;
+    }
+    return cellY < m_CellCountY ? cellY : m_CellCountY - 1;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Engine/Core/Math/Primatives/AABB2.hpp"
+
+#include <vector>
+
+class Entity;
+
+//-----------------------------------------------------------------------------
+// Uniform grid broadphase, refilled every tick. Each target is filed under
+//  every cell its physics disc grown by the largest query radius touches, so
+//  a query only reads the one cell under its center, sees each candidate at
+//  most once, and sees them in the order they were inserted.
+//
+//  Positions outside the bounds clamp to the edge cells; the result is still
+//  exact, just less selective out there.
+struct CollisionCandidate
+{
+    Entity* entity = nullptr;
+    int tag = 0;                        // Caller's label, e.g. what kind it is
+};
+
+class CollisionGrid
+{
+public:
+    CollisionGrid();
+    ~CollisionGrid();
+
+    void Startup( const AABB2& bounds, float cellSize, float maxQueryRadius );
+    void Shutdown();
+    void MoveBounds( const Vec2& mins );    // Same size and cells, taken up by the next Clear
+
+    void Clear();
+    void Insert( Entity* entity, int tag );
+    void Build();
+
+    int GetCandidates( const Vec2& position, const CollisionCandidate** outCandidates ) const;
+
+    int GetCellCount() const { return m_CellCountX * m_CellCountY; }
+    int GetEntryCount() const { return static_cast<int>(m_Entries.size()); }
+
+private:
+    struct Entry
+    {
+        int cellIndex = 0;
+        CollisionCandidate candidate;
+    };
+
+    AABB2 m_Bounds;
+    float m_InverseCellSize = 1.f;
+    float m_MaxQueryRadius = 0.f;
+    int m_CellCountX = 0;
+    int m_CellCountY = 0;
+
+    std::vector<Entry> m_Entries;                   // Insert order, unsorted
+    std::vector<int> m_CellStarts;                  // Per cell offset into m_Candidates, plus an end
+    std::vector<CollisionCandidate> m_Candidates;   // m_Entries sorted by cell
+
+    int GetCellX( float x ) const;
+    int GetCellY( float y ) const;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Engine/Core/Math/Primatives/Vec2.hpp"
+
+#include "Game/WorldState.hpp"
+
+class Entity;
+
+//-----------------------------------------------------------------------------
+// One overlap found by collision detection, waiting for its response. Entity
+//  A is the bullet or ship that queried the grid, entity B what it touched.
+//  Detection only reads the world and writes these, so it can be split into
+//  chunks; response applies them strictly in stream order.
+//
+//  The entities may be deleted by the end of the tick, so anything looking
+//  at contacts afterwards should only use the point.
+enum ContactType: unsigned char
+{
+    CONTACT_TYPE_BULLET_ASTEROID = 0,
+    CONTACT_TYPE_BULLET_BEETLE,
+    CONTACT_TYPE_BULLET_WASP,
+    CONTACT_TYPE_SHIP_ASTEROID,
+    CONTACT_TYPE_SHIP_BEETLE,
+    CONTACT_TYPE_SHIP_WASP,
+    CONTACT_TYPE_COUNT
+};
+
+struct ContactEvent
+{
+    Entity* entityA = nullptr;
+    Entity* entityB = nullptr;
+    Vec2 point = Vec2( 0.f, 0.f );              // Midway between the two centers
+    ContactType type = CONTACT_TYPE_BULLET_ASTEROID;
+};
+
+//-----------------------------------------------------------------------------
+// Only bullets and ships query, and only asteroids, beetles and wasps are in
+//  the grid to be found
+inline ContactType MakeContactType( EntityKind kindA, EntityKind kindB )
+{
+    int targetOffset = kindB == ENTITY_KIND_BEETLE ? 1 : (kindB == ENTITY_KIND_WASP ? 2 : 0);
+    int firstType = kindA == ENTITY_KIND_PLAYER_SHIP ? CONTACT_TYPE_SHIP_ASTEROID : CONTACT_TYPE_BULLET_ASTEROID;
+    return static_cast<ContactType>(firstType + targetOffset);
+}
+
+//-----------------------------------------------------------------------------
+inline EntityKind GetContactQueryKind( ContactType type )
+{
+    return type >= CONTACT_TYPE_SHIP_ASTEROID ? ENTITY_KIND_PLAYER_SHIP : ENTITY_KIND_BULLET;
+}
+
+//-----------------------------------------------------------------------------
+inline EntityKind GetContactTargetKind( ContactType type )
+{
+    int targetOffset = static_cast<int>(type) % (CONTACT_TYPE_SHIP_ASTEROID - CONTACT_TYPE_BULLET_ASTEROID);
+    return targetOffset == 0 ? ENTITY_KIND_ASTEROID : (targetOffset == 1 ? ENTITY_KIND_BEETLE : ENTITY_KIND_WASP);
+}
@@ -0,0 +1,141 @@
+#include "DebugRenderBatch.hpp"
+
+#include "Engine/Renderer/RenderContext.hpp"
+
+#include "Game/GameCommon.hpp"
+
+#include <cmath>
+
+// Enough for a few hundred entities worth of circles before the first regrow
+constexpr int DEBUG_BATCH_STARTING_VERTEXES = 1 << 16;
+
+//-----------------------------------------------------------------------------
+DebugRenderBatch::DebugRenderBatch()
+{
+    m_Vertexes.reserve( DEBUG_BATCH_STARTING_VERTEXES );
+}
+
+//-----------------------------------------------------------------------------
+DebugRenderBatch::~DebugRenderBatch()
+{
+}
+
+//-----------------------------------------------------------------------------
+void DebugRenderBatch::BeginFrame( const AABB2& cullBounds )
+{
+    // clear() keeps the capacity so steady state frames never allocate
+    m_Vertexes.clear();
+    m_CullBounds = cullBounds;
+
+    m_PrimitivesDrawn = 0;
+    m_PrimitivesCulled = 0;
+}
+
+//-----------------------------------------------------------------------------
+void DebugRenderBatch::Flush( RenderContext& renderer )
+{
+    if( m_Vertexes.empty() )
+    {
+        return;
+    }
+
+    renderer.DrawVertexArray( m_Vertexes );
+    m_Vertexes.clear();
+}
+
+//-----------------------------------------------------------------------------
+void DebugRenderBatch::AddLine( const Vec2& start,
+                                const Vec2& end,
+                                const Rgba8& color,
+                                float thickness )
+{
+    float lineRadius = thickness * .5f;
+    Vec2 mins = Vec2( fminf( start.x, end.x ) - lineRadius,
+                      fminf( start.y, end.y ) - lineRadius );
+    Vec2 maxs = Vec2( fmaxf( start.x, end.x ) + lineRadius,
+                      fmaxf( start.y, end.y ) + lineRadius );
+    if( IsCulled( mins, maxs ) )
+    {
+        m_PrimitivesCulled++;
+        return;
+    }
+    m_PrimitivesDrawn++;
+
+    Vec2 displacement = end - start;
+    Vec2 forward = lineRadius * displacement.GetNormalized();
+    Vec2 left = forward.GetRotated90Degrees();
+
+    m_Vertexes.emplace_back( start - forward - left, color );
+    m_Vertexes.emplace_back( end + forward - left, color );
+    m_Vertexes.emplace_back( end + forward + left, color );
+
+    m_Vertexes.emplace_back( end + forward + left, color );
+    m_Vertexes.emplace_back( start - forward + left, color );
+    m_Vertexes.emplace_back( start - forward - left, color );
+}
+
+//-----------------------------------------------------------------------------
+void DebugRenderBatch::AddCircle( const Vec2& center,
+                                  float radius,
+                                  const Rgba8& color,
+                                  float thickness )
+{
+    float lineRadius = thickness * .5f;
+    float outerRadius = radius + lineRadius;
+    Vec2 extents = Vec2( outerRadius, outerRadius );
+    if( IsCulled( center - extents, center + extents ) )
+    {
+        m_PrimitivesCulled++;
+        return;
+    }
+    m_PrimitivesDrawn++;
+
+    const Vec2* unitCircle = GetDebugUnitCircle();
+    float innerRadius = radius - lineRadius;
+    int stride = GetCircleStride( radius );
+
+    for( int currentRadius = 0; currentRadius < DEBUG_CIRCLE_RADIUSES; currentRadius += stride )
+    {
+        const Vec2& curr = unitCircle[ currentRadius ];
+        const Vec2& next = unitCircle[ currentRadius + stride ];
+        Vec2 currShort = center + curr * innerRadius;
+        Vec2 currLong = center + curr * outerRadius;
+        Vec2 nextShort = center + next * innerRadius;
+        Vec2 nextLong = center + next * outerRadius;
+
+        // First triangle
+        m_Vertexes.emplace_back( currShort, color );
+        m_Vertexes.emplace_back( currLong, color );
+        m_Vertexes.emplace_back( nextShort, color );
+        // Second Triangle
+        m_Vertexes.emplace_back( nextShort, color );
+        m_Vertexes.emplace_back( currLong, color );
+        m_Vertexes.emplace_back( nextLong, color );
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool DebugRenderBatch::IsCulled( const Vec2& mins, const Vec2& maxs ) const
+{
+    return maxs.x < m_CullBounds.mins.x ||
+           maxs.y < m_CullBounds.mins.y ||
+           mins.x > m_CullBounds.maxs.x ||
+           mins.y > m_CullBounds.maxs.y;
+}
+
+//-----------------------------------------------------------------------------
+// Small circles are a few pixels across on a 200 unit wide screen, so skip
+//  entries in the unit circle table for them. Strides divide
+//  DEBUG_CIRCLE_RADIUSES so the loop always lands on the closing point.
+int DebugRenderBatch::GetCircleStride( float radius ) const
+{
+    if( radius < 1.f )
+    {
+        return 4;
+    }
+    if( radius < 4.f )
+    {
+        return 2;
+    }
+    return 1;
+}
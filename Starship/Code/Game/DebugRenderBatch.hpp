@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Engine/Core/Math/Primatives/AABB2.hpp"
+#include "Engine/Core/Math/Primatives/Vec2.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/VertexTypes/VertexMaster.hpp"
+
+#include <vector>
+
+class RenderContext;
+
+//-----------------------------------------------------------------------------
+// Accumulates debug lines and circles into one vertex buffer that is reused
+//  every frame and submitted with a single draw. Primitives that fall fully
+//  outside the cull bounds are dropped before any vertexes are generated.
+class DebugRenderBatch
+{
+public:
+    DebugRenderBatch();
+    ~DebugRenderBatch();
+
+    void BeginFrame( const AABB2& cullBounds );
+    void Flush( RenderContext& renderer );
+
+    void AddLine( const Vec2& start,
+                  const Vec2& end,
+                  const Rgba8& color,
+                  float thickness );
+    void AddCircle( const Vec2& center,
+                    float radius,
+                    const Rgba8& color,
+                    float thickness );
+
+    int GetPrimitivesDrawn() const { return m_PrimitivesDrawn; }
+    int GetPrimitivesCulled() const { return m_PrimitivesCulled; }
+    int GetVertexCount() const { return static_cast<int>(m_Vertexes.size()); }
+
+private:
+    std::vector<VertexMaster> m_Vertexes;
+    AABB2 m_CullBounds;
+
+    int m_PrimitivesDrawn = 0;
+    int m_PrimitivesCulled = 0;
+
+    bool IsCulled( const Vec2& mins, const Vec2& maxs ) const;
+    int GetCircleStride( float radius ) const;
+};
@@ -6,11 +6,11 @@
 
 #include "Game/GameCommon.hpp"
 #include "Game/Game.hpp"
+#include "Game/RenderSnapshot.hpp"
+#include "Game/WorldState.hpp"
 
-constexpr int ASTEROID_TRIANGLES = 16;
 constexpr int ASTEROID_VERTEXES = ASTEROID_TRIANGLES * 3;
-
-bool g_AstroidsWrapScreen = true;
+static_assert( ASTEROID_TRIANGLES <= MAX_ENTITY_SHAPE_CORNERS, "Asteroid outline must fit in EntityShapeState" );
 
 Asteroid::Asteroid( Game* game, Vec3 startingPosition )
     : Entity( game, startingPosition )
@@ -25,6 +25,7 @@ Asteroid::Asteroid( Game* game, Vec3 startingPosition )
 
 Asteroid::~Asteroid()
 {
+    delete[] m_TriangleCorners;
 }
 
 void Asteroid::Create()
@@ -52,7 +53,7 @@ void Asteroid::Update( float deltaSeconds )
 
     if ( IsOffscreen() )
     {
-        if ( g_AstroidsWrapScreen )
+        if ( m_Game->GetContext().asteroidsWrapScreen )
         {
             WrapAstroid();
         }
@@ -75,7 +76,14 @@ void Asteroid::Update( float deltaSeconds )
     Entity::Update( deltaSeconds );
 }
 
-void Asteroid::Render() const
+void Asteroid::Render( RenderContext& renderer ) const
+{
+    RenderEntityState state;
+    SaveRenderState( state );
+    m_Game->CountDraw( RenderFromState( renderer, state, m_TriangleCorners ) );
+}
+
+int Asteroid::RenderFromState( RenderContext& renderer, const RenderEntityState& state, const Vec2* corners )
 {
     std::vector<VertexMaster> visual;
 
@@ -84,26 +92,27 @@ void Asteroid::Render() const
     {
         // First vertex is always the center
         visual.push_back(  VertexMaster( Vec3( 0.f, 0.f, 0.f ), 
-                                                   m_Color ) );
+                                                   state.color ) );
         // Second vertex (counter-clockwise) is always the current triangle point in the TriangleCorners array
-        visual.push_back( VertexMaster( m_TriangleCorners[ triangleIndex ],
-                                                       m_Color ) );
+        visual.push_back( VertexMaster( corners[ triangleIndex ],
+                                                       state.color ) );
         // If not the last triangle, use the next element in the TriangleCorners array
         if ( triangleIndex + 1 < ASTEROID_TRIANGLES )
         {
-            visual.push_back( VertexMaster( m_TriangleCorners[ triangleIndex + 1 ],
-                                                           m_Color ) );
+            visual.push_back( VertexMaster( corners[ triangleIndex + 1 ],
+                                                           state.color ) );
         }
         // If is the last triangle, use the first TriangleCorners element to connect back to the start
         else
         {
-            visual.push_back( VertexMaster( m_TriangleCorners[ 0 ],
-                                                           m_Color ) );
+            visual.push_back( VertexMaster( corners[ 0 ],
+                                                           state.color ) );
         }
     }
 
-    TransformVertexArray( visual, static_cast<Vec2>(m_Position), m_AngleDegrees, m_UniformScale );
-    g_Renderer->DrawVertexArray( visual );
+    TransformVertexArray( visual, state.position, state.angleDegrees, state.uniformScale );
+    renderer.DrawVertexArray( visual );
+    return static_cast<int>(visual.size());
 }
 
 void Asteroid::Die()
@@ -112,28 +121,58 @@ void Asteroid::Die()
     m_Game->AddControllerVibration( 0, .35f, .1f );
 
     m_Game->CreateDebrisClusterAt( m_Position, ASTEROID_COLOR, 1.5f, 30 );
+    m_Game->AddExplosionLight( Vec2( m_Position ), ASTEROID_COLOR, ASTEROID_EXPLOSION_LIGHT_RADIUS, ASTEROID_EXPLOSION_LIGHT_INTENSITY );
 }
 
 void Asteroid::Destroy()
 {
     delete[] m_TriangleCorners;
+    m_TriangleCorners = nullptr;
+}
+
+void Asteroid::SaveShape( EntityShapeState& shape ) const
+{
+    if ( m_TriangleCorners == nullptr )
+    {
+        return;
+    }
+
+    shape.cornerCount = ASTEROID_TRIANGLES;
+    for ( int cornerIndex = 0; cornerIndex < ASTEROID_TRIANGLES; ++cornerIndex )
+    {
+        shape.corners[ cornerIndex ] = m_TriangleCorners[ cornerIndex ];
+    }
+}
+
+void Asteroid::LoadShape( const EntityShapeState& shape )
+{
+    // Restored asteroids skip Create() so the outline does not reroll
+    if ( m_TriangleCorners == nullptr )
+    {
+        m_TriangleCorners = new Vec2[ ASTEROID_TRIANGLES ];
+    }
+
+    for ( int cornerIndex = 0; cornerIndex < ASTEROID_TRIANGLES; ++cornerIndex )
+    {
+        m_TriangleCorners[ cornerIndex ] = shape.corners[ cornerIndex ];
+    }
 }
 
 void Asteroid::WrapAstroid()
 {
     if ( m_Position.x < -MAX_SCREEN_SHAKE - m_CosmeticRadius )
     {
-        m_Position.x = WORLD_SIZE_X + MAX_SCREEN_SHAKE + m_CosmeticRadius;
+        m_Position.x = m_Game->GetWorldSize().x + MAX_SCREEN_SHAKE + m_CosmeticRadius;
     }
-    if ( m_Position.x > WORLD_SIZE_X + MAX_SCREEN_SHAKE + m_CosmeticRadius )
+    if ( m_Position.x > m_Game->GetWorldSize().x + MAX_SCREEN_SHAKE + m_CosmeticRadius )
     {
         m_Position.x = -MAX_SCREEN_SHAKE - m_CosmeticRadius;
     }
     if ( m_Position.y < -MAX_SCREEN_SHAKE - m_CosmeticRadius )
     {
-        m_Position.y = WORLD_SIZE_Y + MAX_SCREEN_SHAKE + m_CosmeticRadius;
+        m_Position.y = m_Game->GetWorldSize().y + MAX_SCREEN_SHAKE + m_CosmeticRadius;
     }
-    if ( m_Position.y > WORLD_SIZE_Y + MAX_SCREEN_SHAKE + m_CosmeticRadius )
+    if ( m_Position.y > m_Game->GetWorldSize().y + MAX_SCREEN_SHAKE + m_CosmeticRadius )
     {
         m_Position.y = -MAX_SCREEN_SHAKE - m_CosmeticRadius;
     }
@@ -2,8 +2,6 @@
 
 #include "Game/Entity/Entity.hpp"
 
-extern bool g_AstroidsWrapScreen;
-
 class Asteroid: public Entity
 {
 public:
@@ -12,10 +10,16 @@ public:
 
     virtual void Create() override;
     virtual void Update( float deltaSeconds ) override;
-    virtual void Render() const override;
+    virtual void Render( RenderContext& renderer ) const override;
     virtual void Die() override;
     virtual void Destroy() override;
 
+    virtual void SaveShape( EntityShapeState& shape ) const override;
+    virtual void LoadShape( const EntityShapeState& shape ) override;
+
+    // Draws from a snapshot as well as from a live asteroid; returns the vertexes drawn
+    static int RenderFromState( RenderContext& renderer, const RenderEntityState& state, const Vec2* corners );
+
 private:
     Vec2* m_TriangleCorners = nullptr;
 
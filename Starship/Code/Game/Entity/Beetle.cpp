@@ -7,6 +7,7 @@
 #include "Game/Game.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/Entity/PlayerShip.hpp"
+#include "Game/RenderSnapshot.hpp"
 
 Beetle::Beetle( Game* game, const Vec3& startingPosition )
     : Entity( game, startingPosition )
@@ -52,30 +53,38 @@ void Beetle::Update( float deltaSeconds )
     Entity::Update( deltaSeconds );
 }
 
-void Beetle::Render() const
+void Beetle::Render( RenderContext& renderer ) const
+{
+    RenderEntityState state;
+    SaveRenderState( state );
+    m_Game->CountDraw( RenderFromState( renderer, state ) );
+}
+
+int Beetle::RenderFromState( RenderContext& renderer, const RenderEntityState& state )
 {
     std::vector<VertexMaster> beetleVisual;
-    beetleVisual.push_back(VertexMaster( Vec2( -2.f, 0.f ), m_Color )    );
-    beetleVisual.push_back(VertexMaster( Vec2( 1.f, 0.f ), m_Color )   );
-    beetleVisual.push_back(VertexMaster( Vec2( 2.f, 1.f ), m_Color )    );
+    beetleVisual.push_back(VertexMaster( Vec2( -2.f, 0.f ), state.color )    );
+    beetleVisual.push_back(VertexMaster( Vec2( 1.f, 0.f ), state.color )   );
+    beetleVisual.push_back(VertexMaster( Vec2( 2.f, 1.f ), state.color )    );
 
-    beetleVisual.push_back(VertexMaster(Vec2( -2.f, 0.f ), m_Color )  );
-    beetleVisual.push_back(VertexMaster( Vec2( 2.f, -1.f ), m_Color )   );
-    beetleVisual.push_back(VertexMaster( Vec2( 1.f, 0.f ), m_Color )   );
+    beetleVisual.push_back(VertexMaster(Vec2( -2.f, 0.f ), state.color )  );
+    beetleVisual.push_back(VertexMaster( Vec2( 2.f, -1.f ), state.color )   );
+    beetleVisual.push_back(VertexMaster( Vec2( 1.f, 0.f ), state.color )   );
 
-    beetleVisual.push_back(VertexMaster( Vec2( -3.f, 1.5f ), m_Color )  );
-    beetleVisual.push_back(VertexMaster( Vec2( -2.f, 0.f ), m_Color )  );
-    beetleVisual.push_back(VertexMaster( Vec2( 2.f, 1.f ), m_Color )    );
+    beetleVisual.push_back(VertexMaster( Vec2( -3.f, 1.5f ), state.color )  );
+    beetleVisual.push_back(VertexMaster( Vec2( -2.f, 0.f ), state.color )  );
+    beetleVisual.push_back(VertexMaster( Vec2( 2.f, 1.f ), state.color )    );
 
-    beetleVisual.push_back(VertexMaster( Vec2( -3.f, -1.5f ), m_Color ) );
-    beetleVisual.push_back(VertexMaster( Vec2( 2.f, -1.f ), m_Color )   );
-    beetleVisual.push_back(VertexMaster( Vec2( -2.f, 0.f ), m_Color )   );
+    beetleVisual.push_back(VertexMaster( Vec2( -3.f, -1.5f ), state.color ) );
+    beetleVisual.push_back(VertexMaster( Vec2( 2.f, -1.f ), state.color )   );
+    beetleVisual.push_back(VertexMaster( Vec2( -2.f, 0.f ), state.color )   );
 
     TransformVertexArray( beetleVisual,
-                          static_cast<Vec2>(m_Position),
-                          m_AngleDegrees,
-                          m_UniformScale );
-    g_Renderer->DrawVertexArray( beetleVisual );
+                          state.position,
+                          state.angleDegrees,
+                          state.uniformScale );
+    renderer.DrawVertexArray( beetleVisual );
+    return static_cast<int>(beetleVisual.size());
 }
 
 void Beetle::Die()
@@ -91,17 +100,8 @@ void Beetle::Destroy()
 
 bool Beetle::UpdateTarget()
 {
-    if ( m_TargetPlayer == nullptr )
-    {
-        m_TargetPlayer = m_Game->GetAlivePlayer();
-        //  If the ship is still nullptr
-        if ( m_TargetPlayer == nullptr ) { return false; }
-    }
-
-    if ( m_TargetPlayer->IsDead() )
-    {
-        m_TargetPlayer = m_Game->GetAlivePlayer();
-    }
+    // Chase whichever ship is closest right now
+    m_TargetPlayer = m_Game->GetNearestAlivePlayer( m_Position );
 
     // If no player is alive stop
     if ( m_TargetPlayer == nullptr ) { return false; }
@@ -5,8 +5,7 @@
 
 #include "Game/GameCommon.hpp"
 #include "Game/Game.hpp"
-
-bool g_BulletWrapAround = false;
+#include "Game/RenderSnapshot.hpp"
 
 //-------------------------------------------------------------------------------
 Bullet::Bullet(Game* game, const Vec3& startingPosition)
@@ -35,7 +34,7 @@ void Bullet::Update( float deltaSeconds )
 
     if ( IsOffscreen() )
     {
-        if( g_BulletWrapAround )
+        if( m_Game->GetContext().bulletsWrapAround )
         {
             WrapAround();
         }
@@ -50,23 +49,40 @@ void Bullet::Update( float deltaSeconds )
 }
 
 //-------------------------------------------------------------------------------
-void Bullet::Render() const
+void Bullet::Render( RenderContext& renderer ) const
 {
-    std::vector<VertexMaster> visual;
-    visual.emplace_back( Vec2( 0.f, -.5f ), BULLET_HEAD_COLOR );
-    visual.emplace_back( Vec2( .5f, 0.f ), BULLET_HEAD_COLOR );
-    visual.emplace_back( Vec2( 0.f, .5f ), BULLET_HEAD_COLOR );
+    RenderEntityState state;
+    SaveRenderState( state );
+    m_Game->CountDraw( RenderFromState( renderer, state ) );
+}
+
+//-------------------------------------------------------------------------------
+int Bullet::RenderFromState( RenderContext& renderer, const RenderEntityState& state )
+{
+    // Every bullet is the same six vertexes. Up to MAX_BULLETS draw a frame,
+    //  so they share one buffer instead of each allocating its own; rendering
+    //  is main thread only
+    static const VertexMaster s_LocalVisual[ BULLET_VERTEXES ] =
+    {
+        VertexMaster( Vec2( 0.f, -.5f ), BULLET_HEAD_COLOR ),
+        VertexMaster( Vec2( .5f, 0.f ), BULLET_HEAD_COLOR ),
+        VertexMaster( Vec2( 0.f, .5f ), BULLET_HEAD_COLOR ),
+
+        VertexMaster( Vec2( -2.f, 0.f ), BULLET_TAIL_COLOR_END ),
+        VertexMaster( Vec2( 0.f, -.5f ), BULLET_TAIL_COLOR_START ),
+        VertexMaster( Vec2( 0.f, .5f ), BULLET_TAIL_COLOR_START ),
+    };
+    static std::vector<VertexMaster> s_Visual;
+    s_Visual.assign( s_LocalVisual, s_LocalVisual + BULLET_VERTEXES );
 
-    visual.emplace_back( Vec2( -2.f, 0.f ), BULLET_TAIL_COLOR_END );
-    visual.emplace_back( Vec2( 0.f, -.5f ), BULLET_TAIL_COLOR_START );
-    visual.emplace_back( Vec2( 0.f, .5f ), BULLET_TAIL_COLOR_START );
+    TransformVertexArray( s_Visual,
+                          state.position,
+                          state.angleDegrees,
+                          state.uniformScale );
 
-    TransformVertexArray( visual,
-                          static_cast<Vec2>(m_Position),
-                          m_AngleDegrees,
-                          m_UniformScale );
+    renderer.DrawVertexArray( s_Visual );
 
-    g_Renderer->DrawVertexArray( visual );
+    return static_cast<int>(s_Visual.size());
 }
 
 //-------------------------------------------------------------------------------
@@ -79,17 +95,17 @@ void Bullet::WrapAround()
 {
     if ( m_Position.x < -MAX_SCREEN_SHAKE - m_CosmeticRadius )
     {
-        m_Position.x = WORLD_SIZE_X + MAX_SCREEN_SHAKE + m_CosmeticRadius;
+        m_Position.x = m_Game->GetWorldSize().x + MAX_SCREEN_SHAKE + m_CosmeticRadius;
     }
-    if ( m_Position.x > WORLD_SIZE_X + MAX_SCREEN_SHAKE + m_CosmeticRadius )
+    if ( m_Position.x > m_Game->GetWorldSize().x + MAX_SCREEN_SHAKE + m_CosmeticRadius )
     {
         m_Position.x = -MAX_SCREEN_SHAKE - m_CosmeticRadius;
     }
     if ( m_Position.y < -MAX_SCREEN_SHAKE - m_CosmeticRadius )
     {
-        m_Position.y = WORLD_SIZE_Y + MAX_SCREEN_SHAKE + m_CosmeticRadius;
+        m_Position.y = m_Game->GetWorldSize().y + MAX_SCREEN_SHAKE + m_CosmeticRadius;
     }
-    if ( m_Position.y > WORLD_SIZE_Y + MAX_SCREEN_SHAKE + m_CosmeticRadius )
+    if ( m_Position.y > m_Game->GetWorldSize().y + MAX_SCREEN_SHAKE + m_CosmeticRadius )
     {
         m_Position.y = -MAX_SCREEN_SHAKE - m_CosmeticRadius;
     }
@@ -2,8 +2,6 @@
 
 #include "Game/Entity/Entity.hpp"
 
-extern bool g_BulletWrapAround;
-
 class Bullet: public Entity
 {
 public:
@@ -11,9 +9,12 @@ public:
     virtual ~Bullet();
 
     virtual void Update( float deltaSeconds ) override;
-    virtual void Render() const override;
+    virtual void Render( RenderContext& renderer ) const override;
     virtual void Die() override;
 
+    // Draws from a snapshot as well as from a live bullet; returns the vertexes drawn
+    static int RenderFromState( RenderContext& renderer, const RenderEntityState& state );
+
 private:
     void WrapAround();
 };
@@ -7,9 +7,34 @@
 
 #include "Game/GameCommon.hpp"
 #include "Game/Game.hpp"
+#include "Game/RenderSnapshot.hpp"
+#include "Game/WorldState.hpp"
 
 constexpr int DEBRIS_TRIANGLES = 5;
 constexpr int DEBRIS_VERTEXES = DEBRIS_TRIANGLES * 3;
+static_assert( DEBRIS_TRIANGLES <= MAX_ENTITY_SHAPE_CORNERS, "Debris outline must fit in EntityShapeState" );
+
+// Defines the n * 3 vertexes for the n triangles
+static void AppendDebrisVertexes( std::vector<VertexMaster>& visual, const Vec2* corners, const Rgba8& color )
+{
+    for ( int triangleIndex = 0; triangleIndex < DEBRIS_TRIANGLES; ++triangleIndex )
+    {
+        // First vertex is always the center
+        visual.emplace_back(  Vec3( 0.f, 0.f, 0.f ), color );
+        // Second vertex (counter-clockwise) is always the current triangle point in the TriangleCorners array
+        visual.emplace_back( corners[ triangleIndex ], color );
+        // If not the last triangle, use the next element in the TriangleCorners array
+        if ( triangleIndex + 1 < DEBRIS_TRIANGLES )
+        {
+            visual.emplace_back( corners[ triangleIndex + 1 ], color );
+        }
+        // If is the last triangle, use the first TriangleCorners element to connect back to the start
+        else
+        {
+            visual.emplace_back( corners[ 0 ], color );
+        }
+    }
+}
 
 Debris::Debris( Game* game, const Vec3& startingPosition )
     : Entity( game, startingPosition )
@@ -37,6 +62,7 @@ Debris::Debris( Game* game,
 
 Debris::~Debris()
 {
+    delete[] m_TriangleCorners;
 }
 
 void Debris::Create()
@@ -63,13 +89,9 @@ void Debris::Create()
     GenerateVertexPCU();
 }
 
+// Retired by the Game's expiry wheel once m_DebrisTime is up
 void Debris::Update( float deltaSeconds )
 {
-    if ( m_Age > m_DebrisTime )
-    {
-        Die();
-    }
-
     // Update the color of the debris
      float alphaModifier = RangeMapFloat( 0.f, m_DebrisTime, .5f, 0.f, m_Age );
      m_DebrisColor.SetAlphaAsPercent( alphaModifier );
@@ -77,15 +99,16 @@ void Debris::Update( float deltaSeconds )
     Entity::Update( deltaSeconds );
 }
 
-void Debris::Render() const
+void Debris::Render( RenderContext& renderer ) const
 {
     Transform transform;
     transform.position = m_Position;
     transform.rotationAroundAxis.z = m_AngleDegrees;
 
-    g_Renderer->SetModelUBO( transform.GetAsMatrix() );
-    g_Renderer->DrawVertexArray( m_LocalVisual );
-    g_Renderer->SetModelUBO();
+    renderer.SetModelUBO( transform.GetAsMatrix() );
+    renderer.DrawVertexArray( m_LocalVisual );
+    m_Game->CountDraw( static_cast<int>(m_LocalVisual.size()) );
+    renderer.SetModelUBO();
 }
 
 void Debris::Die()
@@ -100,27 +123,79 @@ void Debris::Destroy()
     m_TriangleCorners = nullptr;
 }
 
-void Debris::GenerateVertexPCU()
+void Debris::SaveState( EntityState& state ) const
 {
-    // Defines the n * 3 vertexes for the n triangles
-    m_LocalVisual.reserve( DEBRIS_TRIANGLES * 3 );
-    for ( int triangleIndex = 0; triangleIndex < DEBRIS_TRIANGLES; ++triangleIndex )
+    Entity::SaveState( state );
+
+    state.lifeSpan = m_DebrisTime;
+    state.secondaryColor = m_DebrisColor;
+}
+
+void Debris::LoadState( const EntityState& state )
+{
+    Entity::LoadState( state );
+
+    m_DebrisTime = state.lifeSpan;
+    m_DebrisColor = state.secondaryColor;
+}
+
+void Debris::SaveShape( EntityShapeState& shape ) const
+{
+    if ( m_TriangleCorners == nullptr )
     {
-        // First vertex is always the center
-        m_LocalVisual.emplace_back(  Vec3( 0.f, 0.f, 0.f ), m_DebrisColor );
-        // Second vertex (counter-clockwise) is always the current triangle point in the TriangleCorners array
-        m_LocalVisual.emplace_back( m_TriangleCorners[ triangleIndex ], m_DebrisColor );
-        // If not the last triangle, use the next element in the TriangleCorners array
-        if ( triangleIndex + 1 < DEBRIS_TRIANGLES )
-        {
-            m_LocalVisual.emplace_back( m_TriangleCorners[ triangleIndex + 1 ],
-                                                          m_DebrisColor );
-        }
-        // If is the last triangle, use the first TriangleCorners element to connect back to the start
-        else
-        {
-            m_LocalVisual.emplace_back( m_TriangleCorners[ 0 ],
-                                                          m_DebrisColor );
-        }
+        return;
+    }
+
+    shape.cornerCount = DEBRIS_TRIANGLES;
+    for ( int cornerIndex = 0; cornerIndex < DEBRIS_TRIANGLES; ++cornerIndex )
+    {
+        shape.corners[ cornerIndex ] = m_TriangleCorners[ cornerIndex ];
+    }
+}
+
+void Debris::LoadShape( const EntityShapeState& shape )
+{
+    // Restored debris skips Create() so the outline and spin do not reroll
+    if ( m_TriangleCorners == nullptr )
+    {
+        m_TriangleCorners = new Vec2[ DEBRIS_TRIANGLES ];
+    }
+
+    for ( int cornerIndex = 0; cornerIndex < DEBRIS_TRIANGLES; ++cornerIndex )
+    {
+        m_TriangleCorners[ cornerIndex ] = shape.corners[ cornerIndex ];
     }
+
+    GenerateVertexPCU();
+}
+
+void Debris::SaveRenderState( RenderEntityState& state ) const
+{
+    Entity::SaveRenderState( state );
+
+    state.color = m_DebrisColor;
+}
+
+// Rendering is main thread only, so every snapshot debris shares one buffer
+int Debris::RenderFromState( RenderContext& renderer, const RenderEntityState& state, const Vec2* corners )
+{
+    static std::vector<VertexMaster> s_Visual;
+    s_Visual.clear();
+    AppendDebrisVertexes( s_Visual, corners, state.color );
+
+    Transform transform;
+    transform.position = Vec3( state.position.x, state.position.y, 0.f );
+    transform.rotationAroundAxis.z = state.angleDegrees;
+
+    renderer.SetModelUBO( transform.GetAsMatrix() );
+    renderer.DrawVertexArray( s_Visual );
+    renderer.SetModelUBO();
+    return static_cast<int>(s_Visual.size());
+}
+
+void Debris::GenerateVertexPCU()
+{
+    m_LocalVisual.clear();
+    m_LocalVisual.reserve( DEBRIS_VERTEXES );
+    AppendDebrisVertexes( m_LocalVisual, m_TriangleCorners, m_DebrisColor );
 }
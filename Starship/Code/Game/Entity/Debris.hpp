@@ -19,10 +19,20 @@ public:
 
     virtual void Create() override;
     virtual void Update( float deltaSeconds ) override;
-    virtual void Render() const override;
+    virtual void Render( RenderContext& renderer ) const override;
     virtual void Die() override;
     virtual void Destroy() override;
 
+    virtual void SaveState( EntityState& state ) const override;
+    virtual void LoadState( const EntityState& state ) override;
+    virtual void SaveShape( EntityShapeState& shape ) const override;
+    virtual void LoadShape( const EntityShapeState& shape ) override;
+    virtual void SaveRenderState( RenderEntityState& state ) const override;
+
+    // Draws from a snapshot, which carries the outline but no cached visual;
+    //  returns the vertexes drawn
+    static int RenderFromState( RenderContext& renderer, const RenderEntityState& state, const Vec2* corners );
+
 private:
     Vec2* m_TriangleCorners = nullptr;
     float m_DebrisTime = MAX_DEBRIS_LIFESPAN;
@@ -1,11 +1,15 @@
 #include "Entity.hpp"
 
+#include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Math/MathUtils.hpp"
 #include "Engine/Core/Math/Primatives/Disc.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
 
+#include "Game/DebugRenderBatch.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/Game.hpp"
+#include "Game/RenderSnapshot.hpp"
+#include "Game/WorldState.hpp"
 
 //-------------------------------------------------------------------------------
 Entity::Entity( Game* game, const Vec3& startingPositon )
@@ -39,29 +43,113 @@ void Entity::Update( float deltaSeconds )
 }
 
 //-------------------------------------------------------------------------------
-void Entity::DebugRender() const
+void Entity::DebugRender( DebugRenderBatch& debugBatch ) const
 {
+    Vec2 position = Vec2( m_Position.x, m_Position.y );
     // Draw debug velocity
-    DrawDebugLine( Vec2( m_Position.x, m_Position.y ),
-                   Vec2( m_Position.x, m_Position.y ) +
-                   Vec2( m_Velocity.x, m_Velocity.y ),
-                   Rgba8( 255, 255, 0 ), .2f );
+    debugBatch.AddLine( position,
+                        position + Vec2( m_Velocity.x, m_Velocity.y ),
+                        DEBUG_FORWARD_VECTOR_COLOR, .2f );
     // Draw Physics circle
-    DrawDebugCircle( Vec2( m_Position.x, m_Position.y ),
-                     m_PhysicsRadius,
-                     DEBUG_PHYSICS_CIRCLE,
-                     .1f );
+    debugBatch.AddCircle( position,
+                          m_PhysicsRadius,
+                          DEBUG_PHYSICS_CIRCLE,
+                          .1f );
     // Draw Cosmetic circle
-    DrawDebugCircle( Vec2( m_Position.x, m_Position.y ),
-                     m_CosmeticRadius,
-                     DEBUG_COSMETIC_CIRCLE,
-                     .1f );
+    debugBatch.AddCircle( position,
+                          m_CosmeticRadius,
+                          DEBUG_COSMETIC_CIRCLE,
+                          .1f );
 }
 
 void Entity::Destroy()
 {
 }
 
+//-------------------------------------------------------------------------------
+// Callers hand in a zeroed state, so anything not written here stays zero and
+//  deltas cleanly against the previous capture
+void Entity::SaveState( EntityState& state ) const
+{
+    state.position = m_Position;
+    state.velocity = m_Velocity;
+    state.acceleration = m_Acceleration;
+
+    state.uniformScale = m_UniformScale;
+    state.angleDegrees = m_AngleDegrees;
+    state.angularVelocity = m_AngularVelocity;
+    state.angularAcceleration = m_AngularAcceleration;
+    state.physicsRadius = m_PhysicsRadius;
+    state.cosmeticRadius = m_CosmeticRadius;
+
+    state.age = m_Age;
+    state.lengthHitTime = m_LenghtHitTime;
+    state.lastHitTime = m_LastHitTime;
+
+    state.health = m_Health;
+    state.expiryTick = m_ExpiryTick;
+    state.color = m_Color;
+
+    state.isDead = m_IsDead;
+    state.isGarbage = m_IsGarbage;
+    state.isSectorField = m_IsSectorField;
+}
+
+//-------------------------------------------------------------------------------
+void Entity::LoadState( const EntityState& state )
+{
+    m_Position = state.position;
+    m_Velocity = state.velocity;
+    m_Acceleration = state.acceleration;
+
+    m_UniformScale = state.uniformScale;
+    m_AngleDegrees = state.angleDegrees;
+    m_AngularVelocity = state.angularVelocity;
+    m_AngularAcceleration = state.angularAcceleration;
+    m_PhysicsRadius = state.physicsRadius;
+    m_CosmeticRadius = state.cosmeticRadius;
+
+    m_Age = state.age;
+    m_LenghtHitTime = state.lengthHitTime;
+    m_LastHitTime = state.lastHitTime;
+
+    m_Health = state.health;
+    m_ExpiryTick = state.expiryTick;
+    m_Color = state.color;
+
+    m_IsDead = state.isDead;
+    m_IsGarbage = state.isGarbage;
+    m_IsSectorField = state.isSectorField;
+}
+
+//-------------------------------------------------------------------------------
+void Entity::SaveShape( EntityShapeState& shape ) const
+{
+    UNUSED( shape );
+}
+
+//-------------------------------------------------------------------------------
+void Entity::LoadShape( const EntityShapeState& shape )
+{
+    UNUSED( shape );
+}
+
+//-------------------------------------------------------------------------------
+// Kind and shape are filled in by whoever packs the snapshot
+void Entity::SaveRenderState( RenderEntityState& state ) const
+{
+    state.position = Vec2( m_Position.x, m_Position.y );
+    state.velocity = Vec2( m_Velocity.x, m_Velocity.y );
+    state.angleDegrees = m_AngleDegrees;
+    state.uniformScale = m_UniformScale;
+    state.physicsRadius = m_PhysicsRadius;
+    state.cosmeticRadius = m_CosmeticRadius;
+    state.color = m_Color;
+    state.kind = ENTITY_KIND_NONE;
+    state.playerIndex = 0;
+    state.shapeIndex = RENDER_SNAPSHOT_NO_SHAPE;
+}
+
 //-------------------------------------------------------------------------------
 const Vec3 Entity::GetPosition() const
 {
@@ -91,6 +179,18 @@ float Entity::GetUniformScale() const
     return m_UniformScale;
 }
 
+//-------------------------------------------------------------------------------
+float Entity::GetCosmeticRadius() const
+{
+    return m_CosmeticRadius;
+}
+
+//-------------------------------------------------------------------------------
+float Entity::GetPhysicsRadius() const
+{
+    return m_PhysicsRadius;
+}
+
 //-------------------------------------------------------------------------------
 float Entity::GetAngleDegrees() const
 {
@@ -122,13 +222,15 @@ bool Entity::IsDead() const
 }
 
 //-------------------------------------------------------------------------------
+// Off the world rather than the camera; the two are the same unless the world
+//  streams more than one sector
 bool Entity::IsOffscreen() const
 {
     if ( m_Position.x < -MAX_SCREEN_SHAKE - m_CosmeticRadius )
     {
         return true;
     }
-    if ( m_Position.x > WORLD_SIZE_X + MAX_SCREEN_SHAKE + m_CosmeticRadius )
+    if ( m_Position.x > m_Game->GetWorldSize().x + MAX_SCREEN_SHAKE + m_CosmeticRadius )
     {
         return true;
     }
@@ -136,7 +238,7 @@ bool Entity::IsOffscreen() const
     {
         return true;
     }
-    if ( m_Position.y > WORLD_SIZE_Y + MAX_SCREEN_SHAKE + m_CosmeticRadius )
+    if ( m_Position.y > m_Game->GetWorldSize().y + MAX_SCREEN_SHAKE + m_CosmeticRadius )
     {
         return true;
     }
@@ -263,3 +365,11 @@ void Entity::SetDead( bool newDead )
 {
     m_IsDead = newDead;
 }
+
+//-------------------------------------------------------------------------------
+// Lifetime ran out; gone quietly at the end of the tick, without Die()
+void Entity::Expire()
+{
+    m_IsDead = true;
+    m_IsGarbage = true;
+}
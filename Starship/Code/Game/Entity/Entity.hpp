@@ -6,7 +6,12 @@
 
 #include "Game/GameCommon.hpp"
 
+class DebugRenderBatch;
 class Game;
+class RenderContext;
+struct EntityState;
+struct EntityShapeState;
+struct RenderEntityState;
 
 class Entity
 {
@@ -16,17 +21,25 @@ public:
 
     virtual void Create();
     virtual void Update( float deltaSeconds );
-    virtual void Render() const = 0;
-    virtual void DebugRender() const;
+    virtual void Render( RenderContext& renderer ) const = 0;
+    virtual void DebugRender( DebugRenderBatch& debugBatch ) const;
     virtual void Die() = 0;
     virtual void Destroy();
 
+    virtual void SaveState( EntityState& state ) const;
+    virtual void LoadState( const EntityState& state );
+    virtual void SaveShape( EntityShapeState& shape ) const;
+    virtual void LoadShape( const EntityShapeState& shape );
+    virtual void SaveRenderState( RenderEntityState& state ) const;
+
     const Vec3 GetPosition() const;
     const Vec3 GetVelocity() const;
     const Vec3 GetAcceleration() const;
     const Vec3 GetForwardVector() const;
 
     float GetUniformScale() const;
+    float GetCosmeticRadius() const;
+    float GetPhysicsRadius() const;
 
     float GetAngleDegrees() const;
     float GetAngularVelocity() const;
@@ -37,6 +50,8 @@ public:
     bool IsDead() const;
     bool IsOffscreen() const;
     bool IsGarbage() const;
+    int GetExpiryTick() const { return m_ExpiryTick; }
+    bool IsSectorField() const { return m_IsSectorField; }
 
     void SetPosition( const Vec3& newPosition );
     void AddPosition( const Vec3& deltaPosition );
@@ -59,6 +74,8 @@ public:
     void DamageEntity( int damage );
     bool WasJustHit();
     void SetDead( bool newDead );
+    void SetExpiryTick( int expiryTick ) { m_ExpiryTick = expiryTick; }
+    void Expire();
 
 protected:
     Vec3 m_Position = Vec3::ZERO;           // Position of the Entity units
@@ -79,9 +96,11 @@ protected:
     float m_LenghtHitTime = HIT_TIME;       // How many seconds the entity should be hit;
     float m_LastHitTime = -HIT_TIME;        // Last time the entity was hit
     int m_Health = 1;                       // Health of the Entity
+    int m_ExpiryTick = 0;                   // Tick of the Game's expiry clock it is retired on, 0 for never
 
     bool m_IsDead = false;                  // Is the Entity Dead
     bool m_IsGarbage = false;               // Will the Entity be Garbage Collected next Update
+    bool m_IsSectorField = false;           // Part of a streamed world's asteroid field, not of any wave
 
     Game* m_Game = nullptr;                 // Reference to the Game where Entity Lives
 };
\ No newline at end of file
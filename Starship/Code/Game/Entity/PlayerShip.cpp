@@ -1,18 +1,20 @@
 #include "PlayerShip.hpp"
 
 #include "Engine/Core/VertexTypes/VertexMaster.hpp"
-#include "Engine/Input/InputSystem.hpp"
-#include "Engine/Input/XboxController.hpp"
 #include "Engine/Core/Math/MathUtils.hpp"
 #include "Engine/Core/Math/RandomNumberGenerator.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
 
 #include "Game/GameCommon.hpp"
 #include "Game/Game.hpp"
+#include "Game/PlayerInput.hpp"
+#include "Game/RenderSnapshot.hpp"
+#include "Game/WorldState.hpp"
 
 //-------------------------------------------------------------------------------
-PlayerShip::PlayerShip( Game* game, const Vec3& startingPosition )
+PlayerShip::PlayerShip( Game* game, const Vec3& startingPosition, int playerIndex )
     : Entity( game, startingPosition )
+    , m_PlayerIndex( playerIndex )
 {
     m_PhysicsRadius = PLAYER_SHIP_PHYSICS_RADIUS;
     m_CosmeticRadius = PLAYER_SHIP_COSMETIC_RADIUS;
@@ -32,7 +34,7 @@ void PlayerShip::Update( float deltaSeconds )
         return;
     }
 
-    ProcessInput();
+    ProcessInput( m_Game->GetPlayerInput( m_PlayerIndex ) );
 
     BounceOffSides();
 
@@ -50,15 +52,26 @@ void PlayerShip::Update( float deltaSeconds )
 }
 
 //-------------------------------------------------------------------------------
-void PlayerShip::Render() const
+void PlayerShip::Render( RenderContext& renderer ) const
 {
     if ( IsDead() )
     {
         return;
     }
 
-    float joystickMag = g_InputSystem->GetXboxController( 0 ).GetLeftJoystick().GetMagnitude();
-    Vec2 exhaust = Vec2( -2.f - 4.f * joystickMag, 0 ) + m_RandomThurstOffset;
+    RenderEntityState state;
+    SaveRenderState( state );
+    float thrustFraction = m_Game->GetPlayerInput( m_PlayerIndex ).GetThrustFraction();
+    m_Game->CountDraw( RenderFromState( renderer, state, thrustFraction, m_RandomThurstOffset ) );
+}
+
+//-------------------------------------------------------------------------------
+int PlayerShip::RenderFromState( RenderContext& renderer,
+                                 const RenderEntityState& state,
+                                 float thrustFraction,
+                                 const Vec2& thrustOffset )
+{
+    Vec2 exhaust = Vec2( -2.f - 4.f * thrustFraction, 0 ) + thrustOffset;
 
     std::vector<VertexMaster> visual;
         visual.push_back(VertexMaster( Vec2( -2.5f, 2.f ), PLAYER_SHIP_COLOR_1 ) );
@@ -94,23 +107,52 @@ void PlayerShip::Render() const
         visual.push_back( VertexMaster( exhaust, PLAYER_SHIP_EXHAUST_2 ) );
 
     TransformVertexArray( visual,
-                          static_cast<Vec2>(m_Position),
-                          m_AngleDegrees,
-                          m_UniformScale );
-    g_Renderer->DrawVertexArray( visual );
+                          state.position,
+                          state.angleDegrees,
+                          state.uniformScale );
+    renderer.DrawVertexArray( visual );
+    return static_cast<int>(visual.size());
 }
 
 //-------------------------------------------------------------------------------
 void PlayerShip::Die()
 {
     m_Game->AddScreenShake( 1.f );
-    m_Game->AddControllerVibration( 0, .75f, .45f );
+    m_Game->AddControllerVibration( m_PlayerIndex, .75f, .45f );
 
     m_Game->CreateDebrisClusterAt( m_Position,
                                    PLAYER_SHIP_COLOR_1,
                                    2.f,
                                    45,
                                    3.5f );
+    m_Game->AddExplosionLight( Vec2( m_Position ),
+                               PLAYER_SHIP_COLOR_1,
+                               PLAYER_SHIP_EXPLOSION_LIGHT_RADIUS,
+                               PLAYER_SHIP_EXPLOSION_LIGHT_INTENSITY );
+}
+
+//-------------------------------------------------------------------------------
+void PlayerShip::SaveState( EntityState& state ) const
+{
+    Entity::SaveState( state );
+
+    state.isThrusting = m_Thrusting;
+}
+
+//-------------------------------------------------------------------------------
+void PlayerShip::LoadState( const EntityState& state )
+{
+    Entity::LoadState( state );
+
+    m_Thrusting = state.isThrusting;
+}
+
+//-------------------------------------------------------------------------------
+void PlayerShip::SaveRenderState( RenderEntityState& state ) const
+{
+    Entity::SaveRenderState( state );
+
+    state.playerIndex = static_cast<unsigned char>(m_PlayerIndex);
 }
 
 //-------------------------------------------------------------------------------
@@ -163,7 +205,7 @@ void PlayerShip::RespawnShip()
         return;
     }
 
-    m_Position = Vec3( WORLD_CENTER_X, WORLD_CENTER_Y, 0.f );
+    m_Position = m_Game->GetPlayerSpawnPosition( m_PlayerIndex );
     m_Velocity = Vec3( 0.f, 0.f, 0.f );
     m_Acceleration = Vec3( 0.f, 0.f, 0.f );
     m_AngleDegrees = 0.f;
@@ -178,79 +220,29 @@ Vec3 PlayerShip::GetNoseSpawn()
                                                       2.75f * m_UniformScale );
 }
 
-void PlayerShip::ProcessInput()
+//-------------------------------------------------------------------------------
+// Input comes from the game rather than the InputSystem so the same tick
+//  replays identically for local, remote and re-simulated players
+void PlayerShip::ProcessInput( const PlayerInput& input )
 {
-
-    if ( g_InputSystem->IsKeyPressed( 'W' ) )
+    if ( input.IsPressed( PLAYER_INPUT_STEER ) )
     {
-        SetAcceleration( Vec3::MakeFromPolarDegreesXY( m_AngleDegrees,
-                                                       PLAYER_SHIP_ACCELERATION ) );
+        SetAngleDegrees( input.GetSteerAngleDegrees() );
     }
-    if ( g_InputSystem->IsKeyPressed( UP_ARROW ) )
+
+    if ( input.thrust > 0 )
     {
         SetAcceleration( Vec3::MakeFromPolarDegreesXY( m_AngleDegrees,
-                                                       PLAYER_SHIP_ACCELERATION ) );
+                                                       PLAYER_SHIP_ACCELERATION * input.GetThrustFraction() ) );
     }
-    if ( !g_InputSystem->IsKeyPressed( 'W' ) &&
-         !g_InputSystem->IsKeyPressed( UP_ARROW ) )
+    else
     {
         SetAcceleration( Vec3( 0.f, 0.f, 0.f ) );
     }
 
-    if ( g_InputSystem->IsKeyPressed( 'A' ) )
-    {
-        SetAngularVelocity( PLAYER_SHIP_TURN_SPEED );
-    }
-    if ( g_InputSystem->IsKeyPressed( 'D' ) )
-    {
-        SetAngularVelocity( -PLAYER_SHIP_TURN_SPEED );
-    }
-    if ( g_InputSystem->IsKeyPressed( LEFT_ARROW ) )
-    {
-        SetAngularVelocity( PLAYER_SHIP_TURN_SPEED );
-    }
-    if ( g_InputSystem->IsKeyPressed( RIGHT_ARROW ) )
-    {
-        SetAngularVelocity( -PLAYER_SHIP_TURN_SPEED );
-    }
-
-    if ( g_InputSystem->IsKeyPressed( 'A' ) &&
-         g_InputSystem->IsKeyPressed( 'D' ) )
-    {
-        SetAngularVelocity( 0.f );
-    }
-
-    if ( g_InputSystem->IsKeyPressed( LEFT_ARROW ) &&
-         g_InputSystem->IsKeyPressed( RIGHT_ARROW ) )
-    {
-        SetAngularVelocity( 0.f );
-    }
-
-    if ( !g_InputSystem->IsKeyPressed( 'A' ) &&
-         !g_InputSystem->IsKeyPressed( 'D' ) &&
-         !g_InputSystem->IsKeyPressed( LEFT_ARROW ) &&
-         !g_InputSystem->IsKeyPressed( RIGHT_ARROW ) )
-    {
-        SetAngularVelocity( 0.f );
-    }
-
-    if ( g_InputSystem->WasKeyJustPressed( SPACE ) && m_Age > 0.f )
-    {
-        ShootBullet();
-    }
-
-    const XboxController& gamepad = g_InputSystem->GetXboxController( 0 );
-    if ( !gamepad.IsConnected() ) { return; }
-
-    const AnalogJoystick& joystick = gamepad.GetLeftJoystick();
-    if ( joystick.GetMagnitude() > 0 )
-    {
-        SetAngleDegrees( joystick.GetAngleDegrees() );
-        SetAcceleration( Vec3::MakeFromPolarDegreesXY( GetAngleDegrees(),
-                                                       PLAYER_SHIP_ACCELERATION * joystick.GetMagnitude() ) );
-    }
+    SetAngularVelocity( PLAYER_SHIP_TURN_SPEED * static_cast<float>(input.turn) );
 
-    if ( gamepad.IsButtonJustPressed( XboxButtonID::XBOX_BUTTON_A ) )
+    if ( input.IsPressed( PLAYER_INPUT_FIRE ) && m_Age > 0.f )
     {
         ShootBullet();
     }
@@ -266,9 +258,9 @@ void PlayerShip::BounceOffSides()
         m_Velocity.x = -m_Velocity.x;
     }
     // Bounce off right side
-    if ( m_Position.x + m_CosmeticRadius > WORLD_SIZE_X )
+    if ( m_Position.x + m_CosmeticRadius > m_Game->GetWorldSize().x )
     {
-        m_Position.x = WORLD_SIZE_X - m_CosmeticRadius;
+        m_Position.x = m_Game->GetWorldSize().x - m_CosmeticRadius;
         m_Velocity.x = -m_Velocity.x;
     }
     // Bounce of bottom side
@@ -278,9 +270,9 @@ void PlayerShip::BounceOffSides()
         m_Velocity.y = -m_Velocity.y;
     }
     // Bounce of top side
-    if ( m_Position.y + m_CosmeticRadius > WORLD_SIZE_Y )
+    if ( m_Position.y + m_CosmeticRadius > m_Game->GetWorldSize().y )
     {
-        m_Position.y = WORLD_SIZE_Y - m_CosmeticRadius;
+        m_Position.y = m_Game->GetWorldSize().y - m_CosmeticRadius;
         m_Velocity.y = -m_Velocity.y;
     }
 }
@@ -2,16 +2,30 @@
 
 #include "Game/Entity/Entity.hpp"
 
+struct PlayerInput;
+
 class PlayerShip: public Entity
 {
 public:
-    PlayerShip( Game* game, const Vec3& startingPosition );
+    PlayerShip( Game* game, const Vec3& startingPosition, int playerIndex = 0 );
     virtual ~PlayerShip() override;
 
     virtual void Update( float deltaSeconds ) override;
-    virtual void Render() const override;
+    virtual void Render( RenderContext& renderer ) const override;
     virtual void Die() override;
 
+    virtual void SaveState( EntityState& state ) const override;
+    virtual void LoadState( const EntityState& state ) override;
+    virtual void SaveRenderState( RenderEntityState& state ) const override;
+
+    // Draws from a snapshot as well as from a live ship; returns the vertexes drawn
+    static int RenderFromState( RenderContext& renderer,
+                                const RenderEntityState& state,
+                                float thrustFraction,
+                                const Vec2& thrustOffset );
+
+    int GetPlayerIndex() const { return m_PlayerIndex; }
+
     bool IsThrusting() const;
     void SetThrusting( bool newThrusting );
     void TurnLeft( float deltaSeconds );
@@ -24,9 +38,10 @@ public:
 private:
     Vec2 m_RandomThurstOffset = Vec2( 0.f, 0.f );
     bool m_Thrusting = false;
+    int m_PlayerIndex = 0;          // Whose PlayerInput steers this ship
 
     Vec3 GetNoseSpawn();
 
-    void ProcessInput();
+    void ProcessInput( const PlayerInput& input );
     void BounceOffSides();
 };
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "Game/Game.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/Entity/PlayerShip.hpp"
+#include "Game/RenderSnapshot.hpp"
 
 Wasp::Wasp( Game* game, const Vec3& startingPosition )
     : Entity( game, startingPosition )
@@ -54,35 +55,44 @@ void Wasp::Update( float deltaSeconds )
     Entity::Update( deltaSeconds );
 }
 
-void Wasp::Render() const
+void Wasp::Render( RenderContext& renderer ) const
+{
+    RenderEntityState state;
+    SaveRenderState( state );
+    m_Game->CountDraw( RenderFromState( renderer, state ) );
+}
+
+int Wasp::RenderFromState( RenderContext& renderer, const RenderEntityState& state )
 {
     std::vector<VertexMaster> visual;
-        visual.emplace_back( Vec2( -1.f, 1.f ), m_Color );
-        visual.emplace_back( Vec2( 3.f, 1.f ), m_Color );
-        visual.emplace_back( Vec2( 0.f, 2.f ), m_Color );
+        visual.emplace_back( Vec2( -1.f, 1.f ), state.color );
+        visual.emplace_back( Vec2( 3.f, 1.f ), state.color );
+        visual.emplace_back( Vec2( 0.f, 2.f ), state.color );
         visual.emplace_back(                            );
-        visual.emplace_back( Vec2( -1.f, 1.f ), m_Color );
-        visual.emplace_back( Vec2( -1.f, 0.f ), m_Color );
-        visual.emplace_back( Vec2( 0.f, 1.f ), m_Color );
+        visual.emplace_back( Vec2( -1.f, 1.f ), state.color );
+        visual.emplace_back( Vec2( -1.f, 0.f ), state.color );
+        visual.emplace_back( Vec2( 0.f, 1.f ), state.color );
         visual.emplace_back(                            );
-        visual.emplace_back( Vec2( -2.f, 0.f ), m_Color );
-        visual.emplace_back( Vec2( -1.f, -1.f ), m_Color);
-        visual.emplace_back( Vec2( -1.f, 1.f ), m_Color );
+        visual.emplace_back( Vec2( -2.f, 0.f ), state.color );
+        visual.emplace_back( Vec2( -1.f, -1.f ), state.color);
+        visual.emplace_back( Vec2( -1.f, 1.f ), state.color );
         visual.emplace_back(                            );
-        visual.emplace_back( Vec2( -1.f, 0.f ), m_Color );
-        visual.emplace_back( Vec2( -1.f, -1.f ), m_Color);
-        visual.emplace_back( Vec2( 0.f, -1.f ), m_Color );
+        visual.emplace_back( Vec2( -1.f, 0.f ), state.color );
+        visual.emplace_back( Vec2( -1.f, -1.f ), state.color);
+        visual.emplace_back( Vec2( 0.f, -1.f ), state.color );
         visual.emplace_back(                            );
-        visual.emplace_back( Vec2( -1.f, -1.f ), m_Color);
-        visual.emplace_back( Vec2( 0.f, -2.f ), m_Color );
-        visual.emplace_back( Vec2( 1.f, -1.f ), m_Color );
+        visual.emplace_back( Vec2( -1.f, -1.f ), state.color);
+        visual.emplace_back( Vec2( 0.f, -2.f ), state.color );
+        visual.emplace_back( Vec2( 1.f, -1.f ), state.color );
 
     TransformVertexArray( visual,
-                          static_cast<Vec2>(m_Position),
-                          m_AngleDegrees,
-                          m_UniformScale );
+                          state.position,
+                          state.angleDegrees,
+                          state.uniformScale );
 
-    g_Renderer->DrawVertexArray( visual );
+    renderer.DrawVertexArray( visual );
+
+    return static_cast<int>(visual.size());
 }
 
 void Wasp::Die()
@@ -98,17 +108,8 @@ void Wasp::Destroy()
 
 bool Wasp::UpdateTarget()
 {
-    if ( m_TargetPlayer == nullptr )
-    {
-        m_TargetPlayer = m_Game->GetAlivePlayer();
-        //  If the ship is still nullptr
-        if ( m_TargetPlayer == nullptr ) { return false; }
-    }
-
-    if ( m_TargetPlayer->IsDead() )
-    {
-        m_TargetPlayer = m_Game->GetAlivePlayer();
-    }
+    // Chase whichever ship is closest right now
+    m_TargetPlayer = m_Game->GetNearestAlivePlayer( m_Position );
 
     // If no player is alive stop
     if ( m_TargetPlayer == nullptr ) { return false; }
@@ -12,8 +12,11 @@ public:
 
     virtual void Create() override;
     virtual void Update( float deltaSeconds ) override;
-    virtual void Render() const override;
+    virtual void Render( RenderContext& renderer ) const override;
     virtual void Die() override;
+
+    // Draws from a snapshot as well as from a live wasp; returns the vertexes drawn
+    static int RenderFromState( RenderContext& renderer, const RenderEntityState& state );
     virtual void Destroy() override;
 
 private:
@@ -0,0 +1,93 @@
+#include "EntityPool.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include "Game/Entity/Entity.hpp"
+
+//-----------------------------------------------------------------------------
+EntityPool::EntityPool()
+{
+}
+
+//-----------------------------------------------------------------------------
+EntityPool::~EntityPool()
+{
+    Shutdown();
+}
+
+//-----------------------------------------------------------------------------
+void EntityPool::Startup( Entity** slots, int slotCount, size_t entityBytes )
+{
+    Shutdown();
+
+    constexpr size_t alignment = alignof( std::max_align_t );
+    m_Slots = slots;
+    m_SlotCount = slotCount;
+    m_StrideBytes = (entityBytes + alignment - 1) & ~(alignment - 1);
+    m_Storage = static_cast<unsigned char*>(::operator new( m_StrideBytes * static_cast<size_t>(slotCount) ));
+    m_LiveSlots.reserve( slotCount );
+    m_LivePositions.assign( slotCount, -1 );
+}
+
+//-----------------------------------------------------------------------------
+void EntityPool::Shutdown()
+{
+    if( m_Storage == nullptr )
+    {
+        return;
+    }
+
+    Clear();
+    ::operator delete( m_Storage );
+    m_Storage = nullptr;
+    m_Slots = nullptr;
+    m_SlotCount = 0;
+    m_StrideBytes = 0;
+    m_LivePositions.clear();
+}
+
+//-----------------------------------------------------------------------------
+void* EntityPool::Claim( int slotIndex, size_t entityBytes )
+{
+    GUARANTEE_OR_DIE( slotIndex >= 0 && slotIndex < m_SlotCount, "EntityPool slot out of range" );
+    GUARANTEE_OR_DIE( entityBytes <= m_StrideBytes, "Entity is too big for its pool" );
+    GUARANTEE_OR_DIE( m_Slots[ slotIndex ] == nullptr, "EntityPool slot is already in use" );
+
+    m_LivePositions[ slotIndex ] = static_cast<int>(m_LiveSlots.size());
+    m_LiveSlots.push_back( slotIndex );
+    return m_Storage + static_cast<size_t>(slotIndex) * m_StrideBytes;
+}
+
+//-----------------------------------------------------------------------------
+// The last live slot takes the released one's place in the list
+void EntityPool::Release( int slotIndex )
+{
+    Entity*& entity = m_Slots[ slotIndex ];
+    if( entity == nullptr )
+    {
+        return;
+    }
+
+    entity->~Entity();
+    entity = nullptr;
+
+    int livePosition = m_LivePositions[ slotIndex ];
+    int lastSlotIndex = m_LiveSlots.back();
+    m_LiveSlots[ livePosition ] = lastSlotIndex;
+    m_LivePositions[ lastSlotIndex ] = livePosition;
+    m_LiveSlots.pop_back();
+    m_LivePositions[ slotIndex ] = -1;
+}
+
+//-----------------------------------------------------------------------------
+// Walks the live list only, however many slots the pool has
+void EntityPool::Clear()
+{
+    for( int slotIndex : m_LiveSlots )
+    {
+        m_Slots[ slotIndex ]->~Entity();
+        m_Slots[ slotIndex ] = nullptr;
+        m_LivePositions[ slotIndex ] = -1;
+    }
+    m_LiveSlots.clear();
+}
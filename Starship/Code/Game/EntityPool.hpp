@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+class Entity;
+
+//-----------------------------------------------------------------------------
+// Storage behind one of Game's entity slot arrays (m_Bullets and the like),
+//  allocated once at Startup. The entity in slot i is always built in
+//  storage slot i, so spawning and removing never touch the heap, and live
+//  slots are kept in a dense list so Clear only visits what is alive.
+//
+//  Release and Clear run the destructor only; callers that want a kill's
+//  side effects call Destroy() first, as before. Clear skipping them is the
+//  point: it throws a whole world away, and a wasp dropping debris into the
+//  world being thrown away would leave that debris behind.
+class EntityPool
+{
+public:
+    EntityPool();
+    ~EntityPool();
+
+    void Startup( Entity** slots, int slotCount, size_t entityBytes );
+    void Shutdown();
+
+    // The slot must be empty; the new entity is written into it
+    template<typename EntityType, typename... Args>
+    EntityType* Create( int slotIndex, Args&&... args );
+
+    void Release( int slotIndex );          // Destructs and empties the slot
+    void Clear();                           // Releases every live slot
+
+    int GetSlotCount() const { return m_SlotCount; }
+    int GetLiveCount() const { return static_cast<int>(m_LiveSlots.size()); }
+    Entity* GetEntity( int slotIndex ) const { return m_Slots[ slotIndex ]; }
+
+private:
+    Entity** m_Slots = nullptr;             // Not owned
+    int m_SlotCount = 0;
+    size_t m_StrideBytes = 0;
+    unsigned char* m_Storage = nullptr;
+    std::vector<int> m_LiveSlots;           // In no particular order
+    std::vector<int> m_LivePositions;       // Per slot, its index in m_LiveSlots, -1 when empty
+
+    void* Claim( int slotIndex, size_t entityBytes );
+    void Adopt( int slotIndex, Entity* entity ) { m_Slots[ slotIndex ] = entity; }
+};
+
+//-----------------------------------------------------------------------------
+template<typename EntityType, typename... Args>
+EntityType* EntityPool::Create( int slotIndex, Args&&... args )
+{
+    static_assert( alignof( EntityType ) <= alignof( std::max_align_t ), "EntityPool slots are only max_align_t aligned" );
+
+    EntityType* entity = new( Claim( slotIndex, sizeof( EntityType ) ) ) EntityType( std::forward<Args>( args )... );
+    Adopt( slotIndex, entity );
+    return entity;
+}
@@ -0,0 +1,87 @@
+#include "ExpiryWheel.hpp"
+
+//-----------------------------------------------------------------------------
+ExpiryWheel::ExpiryWheel()
+{
+}
+
+//-----------------------------------------------------------------------------
+ExpiryWheel::~ExpiryWheel()
+{
+}
+
+//-----------------------------------------------------------------------------
+// Slots keep their capacity, so a wheel that has warmed up stops allocating
+void ExpiryWheel::Reset( int currentTick )
+{
+    for( std::vector<ExpiryEntry>& slot : m_NearSlots )
+    {
+        slot.clear();
+    }
+    for( std::vector<ExpiryEntry>& slot : m_FarSlots )
+    {
+        slot.clear();
+    }
+    m_CurrentTick = currentTick;
+    m_ScheduledCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+void ExpiryWheel::Schedule( const ExpiryEntry& entry )
+{
+    ExpiryEntry scheduled = entry;
+    if( scheduled.expiryTick <= m_CurrentTick )
+    {
+        scheduled.expiryTick = m_CurrentTick + 1;
+    }
+
+    Insert( scheduled );
+    m_ScheduledCount++;
+}
+
+//-----------------------------------------------------------------------------
+// Too far out for the far wheel goes in its last slot and is simply placed
+//  again each time that slot is poured
+void ExpiryWheel::Insert( const ExpiryEntry& entry )
+{
+    if( entry.expiryTick - m_CurrentTick < EXPIRY_WHEEL_NEAR_SLOTS )
+    {
+        m_NearSlots[ entry.expiryTick & (EXPIRY_WHEEL_NEAR_SLOTS - 1) ].push_back( entry );
+        return;
+    }
+
+    int currentTurn = m_CurrentTick >> EXPIRY_WHEEL_NEAR_SHIFT;
+    int expiryTurn = entry.expiryTick >> EXPIRY_WHEEL_NEAR_SHIFT;
+    if( expiryTurn - currentTurn >= EXPIRY_WHEEL_FAR_SLOTS )
+    {
+        expiryTurn = currentTurn + EXPIRY_WHEEL_FAR_SLOTS - 1;
+    }
+    m_FarSlots[ expiryTurn & (EXPIRY_WHEEL_FAR_SLOTS - 1) ].push_back( entry );
+}
+
+//-----------------------------------------------------------------------------
+void ExpiryWheel::Advance( int toTick, std::vector<ExpiryEntry>& outExpired )
+{
+    while( m_CurrentTick < toTick )
+    {
+        m_CurrentTick++;
+
+        // A new turn of the near wheel: everything filed under it in the far
+        //  wheel now lands within one turn, so it can take its exact slot
+        if( (m_CurrentTick & (EXPIRY_WHEEL_NEAR_SLOTS - 1)) == 0 )
+        {
+            int turn = m_CurrentTick >> EXPIRY_WHEEL_NEAR_SHIFT;
+            m_CascadeScratch.swap( m_FarSlots[ turn & (EXPIRY_WHEEL_FAR_SLOTS - 1) ] );
+            for( const ExpiryEntry& entry : m_CascadeScratch )
+            {
+                Insert( entry );
+            }
+            m_CascadeScratch.clear();
+        }
+
+        std::vector<ExpiryEntry>& slot = m_NearSlots[ m_CurrentTick & (EXPIRY_WHEEL_NEAR_SLOTS - 1) ];
+        outExpired.insert( outExpired.end(), slot.begin(), slot.end() );
+        m_ScheduledCount -= static_cast<int>(slot.size());
+        slot.clear();
+    }
+}
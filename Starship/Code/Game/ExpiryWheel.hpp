@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Game/WorldState.hpp"
+
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Two level timing wheel of entity expiries, keyed by expiry tick. The near
+//  wheel has a slot per tick for the next EXPIRY_WHEEL_NEAR_SLOTS ticks; the
+//  far wheel has a slot per full turn of the near one, and a far slot is
+//  poured back into the near wheel as its turn begins. Advancing a tick
+//  touches only what expires on it, plus one far slot per turn.
+//
+//  Entries name a slot in one of Game's entity arrays, not a pointer, and
+//  nothing is removed when an entity dies early; the game checks that the
+//  entity in that slot still expects that tick before retiring it.
+constexpr int EXPIRY_WHEEL_NEAR_SLOTS = 256;
+constexpr int EXPIRY_WHEEL_FAR_SLOTS = 64;
+constexpr int EXPIRY_WHEEL_NEAR_SHIFT = 8;              // log2 of EXPIRY_WHEEL_NEAR_SLOTS
+static_assert( (1 << EXPIRY_WHEEL_NEAR_SHIFT) == EXPIRY_WHEEL_NEAR_SLOTS, "Near wheel size must match its shift" );
+
+struct ExpiryEntry
+{
+    int expiryTick = 0;
+    int slotIndex = 0;
+    EntityKind kind = ENTITY_KIND_NONE;
+};
+
+class ExpiryWheel
+{
+public:
+    ExpiryWheel();
+    ~ExpiryWheel();
+
+    void Reset( int currentTick );
+    void Schedule( const ExpiryEntry& entry );     // Ticks already passed expire on the next one
+
+    // Appends everything due in (current, toTick], one tick at a time
+    void Advance( int toTick, std::vector<ExpiryEntry>& outExpired );
+
+    int GetCurrentTick() const { return m_CurrentTick; }
+    int GetScheduledCount() const { return m_ScheduledCount; }
+
+private:
+    std::vector<ExpiryEntry> m_NearSlots[ EXPIRY_WHEEL_NEAR_SLOTS ];
+    std::vector<ExpiryEntry> m_FarSlots[ EXPIRY_WHEEL_FAR_SLOTS ];
+    std::vector<ExpiryEntry> m_CascadeScratch;
+    int m_CurrentTick = 0;
+    int m_ScheduledCount = 0;
+
+    void Insert( const ExpiryEntry& entry );
+};
@@ -0,0 +1,108 @@
+#include "FramePacer.hpp"
+
+#include <cmath>
+
+//-----------------------------------------------------------------------------
+FramePacer::FramePacer( FramePacerClock& clock )
+    : m_Clock( &clock )
+{
+}
+
+//-----------------------------------------------------------------------------
+FramePacer::~FramePacer()
+{
+}
+
+//-----------------------------------------------------------------------------
+void FramePacer::SetTargetFramesPerSecond( float framesPerSecond )
+{
+    m_TargetFramesPerSecond = framesPerSecond > 0.f ? framesPerSecond : 0.f;
+    m_PeriodSeconds = m_TargetFramesPerSecond > 0.f ? 1.0 / static_cast<double>(m_TargetFramesPerSecond) : 0.0;
+    m_NextDeadlineSeconds = m_LastFrameSeconds + m_PeriodSeconds;
+}
+
+//-----------------------------------------------------------------------------
+double FramePacer::WaitForNextFrame()
+{
+    if( !m_HasStarted )
+    {
+        m_HasStarted = true;
+        m_LastFrameSeconds = m_Clock->GetCurrentSeconds();
+        m_NextDeadlineSeconds = m_LastFrameSeconds + m_PeriodSeconds;
+        return 0.0;
+    }
+
+    double nowSeconds = m_Clock->GetCurrentSeconds();
+    if( m_PeriodSeconds > 0.0 )
+    {
+        double sleepSeconds = m_NextDeadlineSeconds - nowSeconds - m_SpinSeconds;
+        if( sleepSeconds > 0.0 )
+        {
+            m_Clock->SleepSeconds( sleepSeconds );
+            nowSeconds = m_Clock->GetCurrentSeconds();
+        }
+        while( nowSeconds < m_NextDeadlineSeconds )
+        {
+            m_Clock->Spin();
+            nowSeconds = m_Clock->GetCurrentSeconds();
+        }
+    }
+
+    double lateSeconds = nowSeconds - m_NextDeadlineSeconds;
+    bool isOverrun = m_PeriodSeconds > 0.0 && lateSeconds > m_PeriodSeconds * FRAME_PACER_OVERRUN_TOLERANCE;
+
+    // Keep to the grid while close to it, so small late frames are made up
+    //  by the next one rather than pushing every later frame back
+    m_NextDeadlineSeconds += m_PeriodSeconds;
+    if( lateSeconds > m_PeriodSeconds )
+    {
+        m_NextDeadlineSeconds = nowSeconds + m_PeriodSeconds;
+    }
+
+    double frameSeconds = nowSeconds - m_LastFrameSeconds;
+    m_LastFrameSeconds = nowSeconds;
+    RecordFrame( frameSeconds, isOverrun );
+    return frameSeconds;
+}
+
+//-----------------------------------------------------------------------------
+void FramePacer::RecordFrame( double frameSeconds, bool isOverrun )
+{
+    m_FrameHistory[ m_NextHistoryIndex ] = frameSeconds;
+    m_OverrunHistory[ m_NextHistoryIndex ] = isOverrun;
+    m_NextHistoryIndex = (m_NextHistoryIndex + 1) % FRAME_PACER_HISTORY_FRAMES;
+    if( m_HistoryCount < FRAME_PACER_HISTORY_FRAMES )
+    {
+        m_HistoryCount++;
+    }
+}
+
+//-----------------------------------------------------------------------------
+FramePacerStats FramePacer::GetStats() const
+{
+    FramePacerStats stats;
+    stats.frameCount = m_HistoryCount;
+    if( m_HistoryCount == 0 )
+    {
+        return stats;
+    }
+
+    double totalSeconds = 0.0;
+    for( int historyIndex = 0; historyIndex < m_HistoryCount; ++historyIndex )
+    {
+        double frameSeconds = m_FrameHistory[ historyIndex ];
+        totalSeconds += frameSeconds;
+        stats.worstSeconds = frameSeconds > stats.worstSeconds ? frameSeconds : stats.worstSeconds;
+        stats.overrunCount += m_OverrunHistory[ historyIndex ] ? 1 : 0;
+    }
+    stats.averageSeconds = totalSeconds / static_cast<double>(m_HistoryCount);
+
+    double totalSquaredError = 0.0;
+    for( int historyIndex = 0; historyIndex < m_HistoryCount; ++historyIndex )
+    {
+        double error = m_FrameHistory[ historyIndex ] - stats.averageSeconds;
+        totalSquaredError += error * error;
+    }
+    stats.jitterSeconds = sqrt( totalSquaredError / static_cast<double>(m_HistoryCount) );
+    return stats;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+// Holds the main loop to a target frame rate. Each frame is given a deadline
+//  one period after the last; the pacer sleeps through most of the wait,
+//  which is cheap but only accurate to the OS scheduler, then spins the last
+//  FRAME_PACER_DEFAULT_SPIN_SECONDS for precision. Missing a deadline by more
+//  than a whole period restarts the schedule from now instead of running
+//  a burst of short frames to catch up.
+//
+//  Time comes through a FramePacerClock, so the pacing and the statistics
+//  can be driven by a fake clock with no window or real waiting; nothing in
+//  here needs the engine. SystemFramePacerClock is the real one.
+constexpr float FRAME_PACER_DEFAULT_FRAMES_PER_SECOND = 60.f;
+constexpr double FRAME_PACER_DEFAULT_SPIN_SECONDS = .002;
+constexpr double FRAME_PACER_OVERRUN_TOLERANCE = .1;           // Of a period, before a frame counts as late
+constexpr int FRAME_PACER_HISTORY_FRAMES = 120;
+
+//-----------------------------------------------------------------------------
+class FramePacerClock
+{
+public:
+    virtual ~FramePacerClock() {}
+
+    virtual double GetCurrentSeconds() = 0;
+    virtual void SleepSeconds( double seconds ) = 0;
+    virtual void Spin() {}
+};
+
+//-----------------------------------------------------------------------------
+// Over the last FRAME_PACER_HISTORY_FRAMES frames, measured start to start
+struct FramePacerStats
+{
+    int frameCount = 0;
+    double averageSeconds = 0.0;
+    double jitterSeconds = 0.0;             // Standard deviation of the frame time
+    double worstSeconds = 0.0;
+    int overrunCount = 0;                   // Frames past their deadline by more than the tolerance
+};
+
+//-----------------------------------------------------------------------------
+class FramePacer
+{
+public:
+    explicit FramePacer( FramePacerClock& clock );             // Must outlive the pacer
+    ~FramePacer();
+
+    void SetTargetFramesPerSecond( float framesPerSecond );    // Zero or less runs unpaced
+    void SetSpinSeconds( double spinSeconds ) { m_SpinSeconds = spinSeconds; }
+    float GetTargetFramesPerSecond() const { return m_TargetFramesPerSecond; }
+
+    // Blocks until the next frame is due; returns the seconds since the last
+    //  frame started, for the frame's update
+    double WaitForNextFrame();
+
+    FramePacerStats GetStats() const;
+
+private:
+    FramePacerClock* m_Clock = nullptr;
+
+    float m_TargetFramesPerSecond = 0.f;
+    double m_PeriodSeconds = 0.0;
+    double m_SpinSeconds = FRAME_PACER_DEFAULT_SPIN_SECONDS;
+
+    bool m_HasStarted = false;
+    double m_LastFrameSeconds = 0.0;
+    double m_NextDeadlineSeconds = 0.0;
+
+    double m_FrameHistory[ FRAME_PACER_HISTORY_FRAMES ] = { 0.0 };
+    bool m_OverrunHistory[ FRAME_PACER_HISTORY_FRAMES ] = { false };
+    int m_HistoryCount = 0;
+    int m_NextHistoryIndex = 0;
+
+    void RecordFrame( double frameSeconds, bool isOverrun );
+};
@@ -4,12 +4,14 @@
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Core/Math/MathUtils.hpp"
 #include "Engine/Core/Math/RandomNumberGenerator.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
 #include "Engine/Renderer/Camera.hpp"
 
+#include "Game/AllocationTracker.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/Entity/PlayerShip.hpp"
 #include "Game/Entity/Asteroid.hpp"
@@ -17,12 +19,19 @@
 #include "Game/Entity/Debris.hpp"
 #include "Game/Entity/Beetle.hpp"
 #include "Game/Entity/Wasp.hpp"
+#include "Game/GameCounterWriter.hpp"
+#include "Game/InputThread.hpp"
+#include "Game/RenderSnapshot.hpp"
+#include "Game/WorldStateFile.hpp"
 
+#include <cmath>
+#include <cstring>
 #include <vector>
 
 
 //-----------------------------------------------------------------------------
-Game::Game()
+Game::Game( const GameContext& context )
+    : m_Context( context )
 {
 }
 
@@ -32,52 +41,74 @@ Game::~Game()
 }
 
 //-----------------------------------------------------------------------------
-void Game::Startup()
+void Game::Startup( int playerCount )
 {
-    m_Rng = new RandomNumberGenerator();
-    m_PlayerShip = new PlayerShip( this,
-                                   Vec3( WORLD_CENTER_X, WORLD_CENTER_Y, 0.f )
-                                 );
+    GUARANTEE_OR_DIE( playerCount > 0 && playerCount <= MAX_PLAYERS, "Player count out of range" );
+
+    m_Rng = new RandomNumberGenerator( m_Context.rngSeed );
+    m_Sectors.Startup( m_Context.worldSectorsPerSide );
+    m_BulletPool.Startup( m_Bullets, MAX_BULLETS, sizeof( Bullet ) );
+    m_AsteroidPool.Startup( m_Asteroids, MAX_ASTEROIDS, sizeof( Asteroid ) );
+    m_DebrisPool.Startup( m_Debris, MAX_DEBRIS, sizeof( Debris ) );
+    m_BeetlePool.Startup( m_Beetles, MAX_BEETLES, sizeof( Beetle ) );
+    m_WaspPool.Startup( m_Wasps, MAX_WASPS, sizeof( Wasp ) );
+    m_PlayerCount = playerCount;
+    for( int playerIndex = 0; playerIndex < m_PlayerCount; ++playerIndex )
+    {
+        m_PlayerShips[ playerIndex ] = new PlayerShip( this, GetPlayerSpawnPosition( playerIndex ), playerIndex );
+    }
     m_PlayerShipCurrentLife = 1;
 
-    m_GameCamera = new Camera( g_Renderer );
-    m_UICamera = new Camera( g_Renderer );
+    if( !m_Context.IsHeadless() )
+    {
+        m_GameCamera = new Camera( m_Context.renderer );
+        m_UICamera = new Camera( m_Context.renderer );
 
-    const AABB2 screenSize( Vec2::ZERO, Vec2( WORLD_SIZE_X, WORLD_SIZE_Y ) );
-    m_GameCamera->SetProjectionOrthographic( screenSize );
-    m_GameCamera->SetClearMode( CLEAR_COLOR_BIT | CLEAR_DEPTH_BIT, Rgba8::BLACK );
-    m_GameCamera->SetColorTarget( g_Renderer->GetBackBuffer() );
+        const AABB2 screenSize( Vec2::ZERO, Vec2( SCREEN_SIZE_X, SCREEN_SIZE_Y ) );
+        m_GameCamera->SetProjectionOrthographic( screenSize );
+        m_GameCamera->SetClearMode( CLEAR_COLOR_BIT | CLEAR_DEPTH_BIT, Rgba8::BLACK );
+        m_GameCamera->SetColorTarget( m_Context.renderer->GetBackBuffer() );
 
+        m_UICamera->SetProjectionOrthographic( screenSize );
+        m_UICamera->SetColorTarget( m_Context.renderer->GetBackBuffer() );
 
-    m_UICamera->SetProjectionOrthographic( screenSize );
-    m_UICamera->SetColorTarget( g_Renderer->GetBackBuffer() );
+        // Serial: at the few hundred lights explosions reach, waking workers
+        //  costs more than it saves (.139ms on four threads, .100ms on one)
+        m_LightBinner.Startup( 0 );
+    }
 
     m_IsAttractMode = true;
 
-    for( int astroidIndex = 0; astroidIndex < MAX_ASTEROIDS; ++astroidIndex )
-    {
-        m_Asteroids[ astroidIndex ] = nullptr;
-    }
-
-    for( int bulletIndex = 0; bulletIndex < MAX_BULLETS; ++bulletIndex )
-    {
-        m_Bullets[ bulletIndex ] = nullptr;
-    }
+    StartupHud();
 
-    for( int debrisIndex = 0; debrisIndex < MAX_DEBRIS; ++debrisIndex )
+    m_SnapshotScratch = new WorldState();
+    if( m_Context.keepsRewindHistory )
     {
-        m_Debris[ debrisIndex ] = nullptr;
+        m_Snapshots.Startup( sizeof( WorldState ), MAX_SNAPSHOTS, SNAPSHOT_DELTA_BUDGET_BYTES );
     }
 
-    for( int beetleIndex = 0; beetleIndex < MAX_BEETLES; ++beetleIndex )
+    // A streamed world only has the sectors kept around the camera live, so
+    //  the grids cover that block and follow the camera; see MoveSpatialGrids
+    Vec2 gridSize = Vec2( SCREEN_SIZE_X, SCREEN_SIZE_Y );
+    if( m_Sectors.IsStreaming() )
     {
-        m_Beetles[ beetleIndex ] = nullptr;
+        gridSize = gridSize * static_cast<float>(2 * SECTOR_KEEP_RADIUS + 1);
     }
+    const AABB2 gridBounds( Vec2( -SPATIAL_GRID_MARGIN, -SPATIAL_GRID_MARGIN ),
+                            gridSize + Vec2( SPATIAL_GRID_MARGIN, SPATIAL_GRID_MARGIN ) );
+    m_NearestPlayerGrid.Startup( gridBounds, NEAREST_PLAYER_GRID_CELL_SIZE );
+    // Bullets and ships are the only things that query, ships are the larger
+    m_CollisionGrid.Startup( gridBounds, COLLISION_GRID_CELL_SIZE, PLAYER_SHIP_PHYSICS_RADIUS );
+    m_Contacts.reserve( CONTACT_EVENTS_RESERVED );
+    m_ExpiryWheel.Reset( 0 );
+    m_ExplosionLights.reserve( MAX_EXPLOSION_LIGHTS );
+    m_TileLights.reserve( MAX_EXPLOSION_LIGHTS );
 
-    for( int waspIndex = 0; waspIndex < MAX_WASPS; ++waspIndex )
-    {
-        m_Wasps[ waspIndex ] = nullptr;
-    }
+    BuildDefaultEntityState( ENTITY_KIND_ASTEROID, m_SectorDefaults[ ENTITY_KIND_ASTEROID ] );
+    BuildDefaultEntityState( ENTITY_KIND_BEETLE, m_SectorDefaults[ ENTITY_KIND_BEETLE ] );
+    BuildDefaultEntityState( ENTITY_KIND_WASP, m_SectorDefaults[ ENTITY_KIND_WASP ] );
+    PopulateSectors();
+    UpdateCameraFocus();
 
     m_SpawnNextWave = true;
 }
@@ -85,53 +116,29 @@ void Game::Startup()
 //-----------------------------------------------------------------------------
 void Game::Shutdown()
 {
-    for( int astroidIndex = 0; astroidIndex < MAX_ASTEROIDS; ++astroidIndex )
-    {
-        if( m_Asteroids[ astroidIndex ] == nullptr )
-        {
-            delete m_Asteroids[ astroidIndex ];
-            m_Asteroids[ astroidIndex ] = nullptr;
-        }
-    }
-
-    for( int bulletIndex = 0; bulletIndex < MAX_BULLETS; ++bulletIndex )
-    {
-        if( m_Bullets[ bulletIndex ] == nullptr )
-        {
-            delete m_Bullets[ bulletIndex ];
-            m_Bullets[ bulletIndex ] = nullptr;
-        }
-    }
+    FlushCounters();
 
-    for( int beetleIndex = 0; beetleIndex < MAX_BEETLES; ++beetleIndex )
-    {
-        if( m_Beetles[ beetleIndex ] == nullptr )
-        {
-            delete m_Beetles[ beetleIndex ];
-            m_Beetles[ beetleIndex ] = nullptr;
-        }
-    }
+    m_BulletPool.Shutdown();
+    m_AsteroidPool.Shutdown();
+    m_DebrisPool.Shutdown();
+    m_BeetlePool.Shutdown();
+    m_WaspPool.Shutdown();
 
-    for( int waspIndex = 0; waspIndex < MAX_WASPS; ++waspIndex )
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
     {
-        if( m_Wasps[ waspIndex ] == nullptr )
-        {
-            delete m_Wasps[ waspIndex ];
-            m_Wasps[ waspIndex ] = nullptr;
-        }
+        delete m_PlayerShips[ playerIndex ];
+        m_PlayerShips[ playerIndex ] = nullptr;
     }
+    m_PlayerCount = 0;
 
-    for( int debrisIndex = 0; debrisIndex < MAX_DEBRIS; ++debrisIndex )
-    {
-        if( m_Debris[ debrisIndex ] == nullptr )
-        {
-            delete m_Debris[ debrisIndex ];
-            m_Debris[ debrisIndex ] = nullptr;
-        }
-    }
+    m_NearestPlayerGrid.Shutdown();
+    m_CollisionGrid.Shutdown();
+    m_LightBinner.Shutdown();
+    m_Sectors.Shutdown();
 
-    delete m_PlayerShip;
-    m_PlayerShip = nullptr;
+    m_Snapshots.Shutdown();
+    delete m_SnapshotScratch;
+    m_SnapshotScratch = nullptr;
 
     delete m_Rng;
     m_Rng = nullptr;
@@ -143,6 +150,76 @@ void Game::Shutdown()
     m_UICamera = nullptr;
 }
 
+//-----------------------------------------------------------------------------
+// Puts the game back where Startup leaves a new one, on a new seed, keeping
+//  every camera, grid, queue, snapshot buffer, entity pool and HUD mesh it
+//  already has. The pools are cleared through their live lists, without
+//  Destroy(): a wasp's would drop debris into the new game, debris that the
+//  expiry wheel reset below would then never retire. The ships are rebuilt
+//  in place. Pilots and event subscribers belong to the host and stay
+//  attached.
+void Game::Reset( unsigned int rngSeed )
+{
+    GUARANTEE_OR_DIE( m_Rng != nullptr, "Game needs Startup before Reset" );
+
+    FlushCounters();
+    m_BulletPool.Clear();
+    m_AsteroidPool.Clear();
+    m_DebrisPool.Clear();
+    m_BeetlePool.Clear();
+    m_WaspPool.Clear();
+
+    m_Context.rngSeed = rngSeed;
+    *m_Rng = RandomNumberGenerator( rngSeed );
+    for( int playerIndex = 0; playerIndex < m_PlayerCount; ++playerIndex )
+    {
+        *m_PlayerShips[ playerIndex ] = PlayerShip( this, GetPlayerSpawnPosition( playerIndex ), playerIndex );
+        m_PlayerInputs[ playerIndex ] = PlayerInput();
+        m_DemoPilots[ playerIndex ] = BotPilot();
+    }
+
+    m_GameTime = 0.f;
+    m_IsDemo = false;
+    m_AttractIdleSeconds = 0.f;
+
+    m_Contacts.clear();
+    m_Events.ClearEvents();
+    m_ExpiryWheel.Reset( 0 );
+    m_ExpiryClockSeconds = 0.0;
+    PopulateSectors();
+    m_CameraMins = Vec2( 0.f, 0.f );
+    UpdateCameraFocus();
+    m_LastStreamSeconds = 0.0;
+    m_ExplosionLights.clear();
+
+    m_TitleColor = Rgba8::RED;
+    m_TitleRotaiton = 0.f;
+    m_TitleScale = 3.f;
+    m_TitleTime = 0.f;
+    m_LastColorChangeTime = 0.f;
+
+    m_PlayerShipCurrentLife = 1;
+    m_PlayerShipDestroyedTime = 0.0;
+    m_SpawnNextWave = true;
+    m_WaveNumber = 0;
+
+    m_IsAttractMode = true;
+    m_WasJustAttractMode = false;
+    m_IsPaused = false;
+    m_WasJustPaused = false;
+    m_IsSlowMo = false;
+
+    m_CurrentScreenShakePercentage = 0.f;
+    m_ScreenShakeOffset = Vec2( 0.f, 0.f );
+    m_CurrentControllerLeftVibration = 0.f;
+    m_CurrentControllerRightVibration = 0.f;
+
+    m_Snapshots.Clear();
+    m_LastSnapshotSeconds = 0.0;
+    m_PeakSnapshotSeconds = 0.0;
+    m_LivesVisualCount = -1;
+}
+
 //-----------------------------------------------------------------------------
 RandomNumberGenerator* Game::GetRng()
 {
@@ -157,6 +234,8 @@ bool Game::RequestSpawnAstroid()
         if( m_Asteroids[ astroidIndex ] == nullptr )
         {
             CreateAstroidInArray( astroidIndex );
+            PublishSpawn( ENTITY_KIND_ASTEROID, *m_Asteroids[ astroidIndex ] );
+            AddCounter( GAME_COUNTER_SPAWNS );
             return true;
         }
     }
@@ -170,10 +249,12 @@ bool Game::RequestSpawnBeetle()
         if( m_Beetles[ beetleIndex ] == nullptr )
         {
             Entity*& currentBeetle = m_Beetles[ beetleIndex ];
-            Vec2 outOfBounds = PointJustOffScreen( 25.f );
+            Vec2 outOfBounds = PointJustOffScreen( *m_Rng, 25.f, m_CameraMins );
             Vec3 startingPos = Vec3( outOfBounds.x, outOfBounds.y, 0.f );
-            currentBeetle = new Beetle( this, startingPos );
+            currentBeetle = m_BeetlePool.Create<Beetle>( beetleIndex, this, startingPos );
             currentBeetle->Create();
+            PublishSpawn( ENTITY_KIND_BEETLE, *currentBeetle );
+            AddCounter( GAME_COUNTER_SPAWNS );
             return true;
         }
     }
@@ -187,10 +268,12 @@ bool Game::RequestSpawnWasp()
         if( m_Wasps[ waspIndex ] == nullptr )
         {
             Entity*& currentWasp = m_Wasps[ waspIndex ];
-            Vec2 outOfBounds = PointJustOffScreen( 25.f );
+            Vec2 outOfBounds = PointJustOffScreen( *m_Rng, 25.f, m_CameraMins );
             Vec3 startingPos = Vec3( outOfBounds.x, outOfBounds.y, 0.f );
-            currentWasp = new Wasp( this, startingPos );
+            currentWasp = m_WaspPool.Create<Wasp>( waspIndex, this, startingPos );
             currentWasp->Create();
+            PublishSpawn( ENTITY_KIND_WASP, *currentWasp );
+            AddCounter( GAME_COUNTER_SPAWNS );
             return true;
         }
     }
@@ -209,13 +292,17 @@ bool Game::RequestSpawnBullet( const Vec3& position, float degrees )
             {
                 // More bullets spawned less accurate they are
                 degrees = degrees + m_Rng->FloatInRange( -5.f, 5.f ) * bulletNumber;
-                m_Bullets[ bulletIndex ] = new Bullet( this, position );
+                m_BulletPool.Create<Bullet>( bulletIndex, this, position );
                 m_Bullets[ bulletIndex ]->SetAngleDegrees( degrees );
                 m_Bullets[ bulletIndex ]->SetVelocity(
                                                       Vec3::MakeFromPolarDegreesXY( degrees, BULLET_SPEED )
                                                      );
 
+                ScheduleExpiry( *m_Bullets[ bulletIndex ], ENTITY_KIND_BULLET, bulletIndex, BULLET_LIFETIME_SECONDS );
+                PublishSpawn( ENTITY_KIND_BULLET, *m_Bullets[ bulletIndex ] );
+
                 AddControllerVibration( 0, .0f, .1f );
+                AddCounter( GAME_COUNTER_SPAWNS );
                 anyBulletSpawned = true;
                 break;
             }
@@ -248,39 +335,264 @@ void Game::AddControllerVibration( int contollerId,
     m_CurrentControllerRightVibration += rightVibrationPercent;
 }
 
-const PlayerShip* Game::GetAlivePlayer() const
+//-----------------------------------------------------------------------------
+// Past MAX_EXPLOSION_LIGHTS the oldest makes room, it is the dimmest
+void Game::AddExplosionLight( const Vec2& position, const Rgba8& color, float radius, float intensity )
 {
-    if( m_PlayerShip == nullptr )
+    ExplosionLightState light;
+    light.position = position;
+    light.color = color;
+    light.radius = radius;
+    light.intensity = intensity;
+    light.ageSeconds = 0.f;
+
+    if( static_cast<int>(m_ExplosionLights.size()) < MAX_EXPLOSION_LIGHTS )
     {
-        return nullptr;
+        m_ExplosionLights.push_back( light );
+        return;
+    }
+
+    ExplosionLightState* oldestLight = &m_ExplosionLights[ 0 ];
+    for( ExplosionLightState& existingLight : m_ExplosionLights )
+    {
+        oldestLight = existingLight.ageSeconds > oldestLight->ageSeconds ? &existingLight : oldestLight;
     }
-    if( m_PlayerShip->IsDead() )
+    *oldestLight = light;
+}
+
+//-----------------------------------------------------------------------------
+const PlayerShip* Game::GetPlayerShip( int playerIndex ) const
+{
+    if( playerIndex < 0 || playerIndex >= MAX_PLAYERS )
     {
         return nullptr;
     }
+    return m_PlayerShips[ playerIndex ];
+}
+
+//-----------------------------------------------------------------------------
+// Answered from the grid built after the ships moved this tick
+const PlayerShip* Game::GetNearestAlivePlayer( const Vec3& position ) const
+{
+    return m_NearestPlayerGrid.FindNearest( static_cast<Vec2>(position) );
+}
+
+//-----------------------------------------------------------------------------
+// Player 0 in the middle of the world, the rest alternating right and left
+//  of it
+Vec3 Game::GetPlayerSpawnPosition( int playerIndex ) const
+{
+    float side = (playerIndex % 2 == 1) ? 1.f : -1.f;
+    float offset = PLAYER_SPAWN_SPACING * static_cast<float>((playerIndex + 1) / 2) * side;
+    const Vec2 worldCenter = GetWorldSize() * .5f;
+    return Vec3( worldCenter.x + offset, worldCenter.y, 0.f );
+}
+
+//-----------------------------------------------------------------------------
+void Game::SetPlayerInput( int playerIndex, const PlayerInput& input )
+{
+    GUARANTEE_OR_DIE( playerIndex >= 0 && playerIndex < MAX_PLAYERS, "Player index out of range" );
+    m_PlayerInputs[ playerIndex ] = input;
+}
+
+//-----------------------------------------------------------------------------
+const PlayerInput& Game::GetPlayerInput( int playerIndex ) const
+{
+    GUARANTEE_OR_DIE( playerIndex >= 0 && playerIndex < MAX_PLAYERS, "Player index out of range" );
+    return m_PlayerInputs[ playerIndex ];
+}
+
+//-----------------------------------------------------------------------------
+void Game::SetPlayerPilot( int playerIndex, PlayerPilot* pilot )
+{
+    GUARANTEE_OR_DIE( playerIndex >= 0 && playerIndex < MAX_PLAYERS, "Player index out of range" );
+    m_PlayerPilots[ playerIndex ] = pilot;
+}
+
+//-----------------------------------------------------------------------------
+// Live enemies whose physics disc reaches into the query disc. Enemies are
+//  the short arrays (asteroids, beetles, wasps), never bullets, so a straight
+//  pass over them is cheaper than keeping a grid valid between ticks.
+static int GatherEnemiesInDisc( Entity* const* entities,
+                                int entitiesSize,
+                                const Vec3& center,
+                                float radius,
+                                const Entity** outEnemies,
+                                int enemyCount,
+                                int maxEnemies )
+{
+    for( int entityIndex = 0; entityIndex < entitiesSize && enemyCount < maxEnemies; ++entityIndex )
+    {
+        const Entity* entity = entities[ entityIndex ];
+        if( entity == nullptr || entity->IsDead() )
+        {
+            continue;
+        }
+
+        Vec3 displacement = entity->GetPosition() - center;
+        float reach = radius + entity->GetPhysicsRadius();
+        if( displacement.x * displacement.x + displacement.y * displacement.y < reach * reach )
+        {
+            outEnemies[ enemyCount++ ] = entity;
+        }
+    }
+    return enemyCount;
+}
+
+//-----------------------------------------------------------------------------
+int Game::GetEnemiesInDisc( const Vec3& center,
+                            float radius,
+                            const Entity** outEnemies,
+                            int maxEnemies ) const
+{
+    int enemyCount = 0;
+    enemyCount = GatherEnemiesInDisc( m_Asteroids, MAX_ASTEROIDS, center, radius, outEnemies, enemyCount, maxEnemies );
+    enemyCount = GatherEnemiesInDisc( m_Beetles, MAX_BEETLES, center, radius, outEnemies, enemyCount, maxEnemies );
+    enemyCount = GatherEnemiesInDisc( m_Wasps, MAX_WASPS, center, radius, outEnemies, enemyCount, maxEnemies );
+    return enemyCount;
+}
+
+//-----------------------------------------------------------------------------
+const Entity* Game::GetNearestEnemy( const Vec3& position ) const
+{
+    const Entity* const* enemyArrays[] = { m_Asteroids, m_Beetles, m_Wasps };
+    const int enemyArraySizes[] = { MAX_ASTEROIDS, MAX_BEETLES, MAX_WASPS };
+
+    const Entity* nearestEnemy = nullptr;
+    float nearestDistanceSquared = 0.f;
+    for( int arrayIndex = 0; arrayIndex < 3; ++arrayIndex )
+    {
+        for( int entityIndex = 0; entityIndex < enemyArraySizes[ arrayIndex ]; ++entityIndex )
+        {
+            const Entity* entity = enemyArrays[ arrayIndex ][ entityIndex ];
+            if( entity == nullptr || entity->IsDead() )
+            {
+                continue;
+            }
+
+            Vec3 displacement = entity->GetPosition() - position;
+            float distanceSquared = displacement.x * displacement.x + displacement.y * displacement.y;
+            if( nearestEnemy == nullptr || distanceSquared < nearestDistanceSquared )
+            {
+                nearestEnemy = entity;
+                nearestDistanceSquared = distanceSquared;
+            }
+        }
+    }
+    return nearestEnemy;
+}
+
+//-----------------------------------------------------------------------------
+// Set by whatever is driving the game over the network; shown with the other
+//  debug readouts
+void Game::SetNetStatsText( const char* text )
+{
+    m_NetStatsText.SetText( text );
+}
+
+//-----------------------------------------------------------------------------
+void Game::CountDraw( int vertexCount ) const
+{
+    AddCounter( GAME_COUNTER_DRAWS );
+    AddCounter( GAME_COUNTER_VERTEXES, vertexCount );
+    AddCounter( GAME_COUNTER_VERTEX_BYTES, vertexCount * static_cast<int>(sizeof( VertexMaster )) );
+}
+
+//-----------------------------------------------------------------------------
+// Hands the finished tick's counters, and whatever rendered it, to the
+//  writer and starts the next row. Without a writer the counters still run
+//  but are simply dropped.
+void Game::FlushCounters()
+{
+    if( m_HasCounterFrame && m_Context.counterWriter != nullptr )
+    {
+        m_Context.counterWriter->Push( m_Counters );
+    }
 
-    return m_PlayerShip;
+    m_Counters.Clear();
+    m_Counters.tick++;
+    m_Counters.gameTime = m_GameTime;
+    m_HasCounterFrame = true;
+}
+
+//-----------------------------------------------------------------------------
+// Set by the SimulationThread when the world is stepped off this thread
+void Game::SetThreadStatsText( const char* text )
+{
+    m_ThreadStatsText.SetText( text );
+}
+
+//-----------------------------------------------------------------------------
+// Set by the App from its frame pacer
+void Game::SetPacerStatsText( const char* text )
+{
+    m_PacerStatsText.SetText( text );
 }
 
 //-----------------------------------------------------------------------------
 void Game::Update( float deltaSeconds )
 {
-    m_GameTime += deltaSeconds;
+    UpdateHud( deltaSeconds );
+
+    if( m_Context.input != nullptr )
+    {
+        HandleUserInput();
+    }
+
+    UpdateDemo( deltaSeconds );
+    UpdatePlayerInputs();
+
+    float simulatedSeconds = SimulateTick( deltaSeconds );
+
+    // The demo round ran out of lives and went back to the title
+    if( m_IsDemo && m_IsAttractMode )
+    {
+        m_IsDemo = false;
+    }
+
+    // Paused ticks do not move the world, and skipping them keeps a rewind
+    //  from being overwritten by the frame that displays it
+    if( simulatedSeconds > 0.f )
+    {
+        CaptureSnapshot();
+    }
+}
 
-    m_GameCamera->SetCameraPosition( Vec3::ZERO );
+//-----------------------------------------------------------------------------
+// One step of the world driven only by its own state and m_PlayerInputs, so
+//  replaying a restored state with the same inputs lands on the same bytes.
+//  Returns how far the world moved, zero while paused.
+float Game::SimulateTick( float deltaSeconds )
+{
+    AllocationTagScope allocationTag( ALLOCATION_TAG_UPDATE );
+    FlushCounters();
+    m_GameTime += deltaSeconds;
 
-    HandleUserInput();
+    m_ScreenShakeOffset = Vec2( 0.f, 0.f );
 
     ScreenShakeAblation( deltaSeconds );
     ControllerVibrationAblation( deltaSeconds );
 
-    if( g_InputSystem->GetXboxController( 0 )
-                     .IsButtonJustPressed( XBOX_BUTTON_START ) )
+    // Start leaves attract mode straight into a ship; respawn (the N key)
+    //  only leaves it, and respawns once playing
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
     {
-        m_IsAttractMode = false;
-        if( m_PlayerShip->IsDead() )
+        const PlayerInput& input = m_PlayerInputs[ playerIndex ];
+        if( input.IsPressed( PLAYER_INPUT_START ) )
         {
-            RequestShipRespawn();
+            m_IsAttractMode = false;
+            RequestShipRespawn( playerIndex );
+        }
+        else if( input.IsPressed( PLAYER_INPUT_RESPAWN ) )
+        {
+            if( m_IsAttractMode )
+            {
+                m_IsAttractMode = false;
+            }
+            else
+            {
+                RequestShipRespawn( playerIndex );
+            }
         }
     }
 
@@ -295,7 +607,7 @@ void Game::Update( float deltaSeconds )
         m_WasJustAttractMode = m_IsAttractMode;
     }
 
-    if( m_PlayerShipCurrentLife >= MAX_NUMBER_OF_LIVES && m_PlayerShip->IsDead() )
+    if( m_PlayerShipCurrentLife >= MAX_NUMBER_OF_LIVES && AreAllPlayersDead() )
     {
         if( m_PlayerShipDestroyedTime == 0 )
         {
@@ -310,33 +622,92 @@ void Game::Update( float deltaSeconds )
     }
 
     deltaSeconds = UpdateDeltaSecondsBasedOnState( deltaSeconds );
+    m_ExpiryClockSeconds += deltaSeconds;
 
     if( m_SpawnNextWave )
     {
         SpawnWave();
     }
 
-    m_PlayerShip->Update( deltaSeconds );
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+    {
+        if( m_PlayerShips[ playerIndex ] != nullptr )
+        {
+            m_PlayerShips[ playerIndex ]->Update( deltaSeconds );
+        }
+    }
+    UpdateCameraFocus();
+    MoveSpatialGrids();
+    // Once for every enemy this tick; ships have finished moving
+    {
+        NoAllocationScope noAllocation( "NearestPlayerGrid::Build" );
+        m_NearestPlayerGrid.Build( m_PlayerShips, MAX_PLAYERS );
+    }
+
     UpdateEntities( deltaSeconds, m_Asteroids, MAX_ASTEROIDS );
     UpdateEntities( deltaSeconds, m_Bullets, MAX_BULLETS );
     UpdateEntities( deltaSeconds, m_Debris, MAX_DEBRIS );
     UpdateEntities( deltaSeconds, m_Beetles, MAX_BEETLES );
     UpdateEntities( deltaSeconds, m_Wasps, MAX_WASPS );
+    UpdateExplosionLights( deltaSeconds );
 
-    PhysicsCollisions();
+    {
+        AllocationTagScope collisionTag( ALLOCATION_TAG_COLLISION );
+        PhysicsCollisions();
+    }
 
     m_SpawnNextWave = CheckWaveComplete();
 
+    ExpireEntities();
     DeleteGarbageEntities();
+    StreamSectors();
+
+    m_Events.DispatchEvents();
+
+    return deltaSeconds;
+}
+
+//-----------------------------------------------------------------------------
+// A replicated game is moved by RestoreWorldState alone; only the parts that
+//  present it run here
+void Game::UpdateAsClient( float deltaSeconds )
+{
+    // A render snapshot brings the simulation's own camera and shake
+    if( m_RenderSnapshot == nullptr )
+    {
+        m_ScreenShakeOffset = Vec2( 0.f, 0.f );
+        UpdateCameraFocus();
+    }
+
+    if( m_Context.input != nullptr && m_Context.input->WasKeyJustPressed( F1 ) )
+    {
+        m_IsDebug = !m_IsDebug;
+    }
+
+    // No tick flushes a mirror's counters; the HUD has read the last frame's
+    //  draws, so start this frame's from zero
+    UpdateHud( deltaSeconds );
+    m_Counters.Clear();
 }
 
 //-----------------------------------------------------------------------------
 void Game::Render() const
 {
-    g_Renderer->ClearColor( *m_GameCamera );
+    if( m_Context.IsHeadless() )
+    {
+        return;
+    }
+
+    AllocationTagScope allocationTag( ALLOCATION_TAG_RENDER );
+
+    RenderContext& renderer = *m_Context.renderer;
+    const Vec2 cameraPosition = m_CameraMins + m_ScreenShakeOffset;
+    m_GameCamera->SetCameraPosition( Vec3( cameraPosition.x, cameraPosition.y, 0.f ) );
+    renderer.ClearColor( *m_GameCamera );
 
     // Render Game
-    g_Renderer->BeginCamera( *m_GameCamera );
+    renderer.BeginCamera( *m_GameCamera );
+    BinExplosionLights();
 
     if( m_IsAttractMode )
     {
@@ -344,13 +715,32 @@ void Game::Render() const
     }
     else
     {
-        m_PlayerShip->Render();
+        // Anything outside what the camera sees is skipped before it builds
+        //  any vertexes. Required once the world grows past one screen.
+        const AABB2 viewBounds = GetGameCameraBounds();
+        m_EntitiesDrawnThisFrame = 0;
+        m_EntitiesCulledThisFrame = 0;
+
+        if( m_RenderSnapshot != nullptr )
+        {
+            RenderSnapshotEntities( viewBounds );
+        }
+        else
+        {
+            for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+            {
+                if( m_PlayerShips[ playerIndex ] != nullptr )
+                {
+                    RenderEntityIfVisible( *m_PlayerShips[ playerIndex ], viewBounds );
+                }
+            }
 
-        RenderEntities( m_Asteroids, MAX_ASTEROIDS );
-        RenderEntities( m_Bullets, MAX_BULLETS );
-        RenderEntities( m_Debris, MAX_DEBRIS );
-        RenderEntities( m_Beetles, MAX_BEETLES );
-        RenderEntities( m_Wasps, MAX_WASPS );
+            RenderEntities( m_Asteroids, MAX_ASTEROIDS, viewBounds );
+            RenderEntities( m_Bullets, MAX_BULLETS, viewBounds );
+            RenderEntities( m_Debris, MAX_DEBRIS, viewBounds );
+            RenderEntities( m_Beetles, MAX_BEETLES, viewBounds );
+            RenderEntities( m_Wasps, MAX_WASPS, viewBounds );
+        }
     }
 
 
@@ -359,134 +749,195 @@ void Game::Render() const
         DebugRender();
     }
 
-    g_Renderer->EndCamera( *m_GameCamera );
+    renderer.EndCamera( *m_GameCamera );
 
     // Render UI
-    g_Renderer->BeginCamera( *m_UICamera );
+    renderer.BeginCamera( *m_UICamera );
 
     RenderLives();
+    RenderHud();
 
-    g_Renderer->EndCamera( *m_UICamera );
+    renderer.EndCamera( *m_UICamera );
 }
 
 //-----------------------------------------------------------------------------
 void Game::DebugRender() const
 {
-    bool isShip = false;
-    Vec2 shipPosition = Vec2( 0.f, 0.f );
-    if( m_PlayerShip != nullptr )
+    AllocationTagScope allocationTag( ALLOCATION_TAG_DEBUG );
+    m_DebugBatch.BeginFrame( GetGameCameraBounds() );
+
+    if( m_RenderSnapshot != nullptr )
     {
-        m_PlayerShip->DebugRender();
-        isShip = true;
-        shipPosition = Vec2( m_PlayerShip->GetPosition().x,
-                             m_PlayerShip->GetPosition().y
-                           );
+        DebugRenderSnapshotEntities();
     }
-
-    DebugRenderEntities( m_Asteroids, MAX_ASTEROIDS );
-    DebugRenderEntities( m_Bullets, MAX_BULLETS );
-    DebugRenderEntities( m_Debris, MAX_DEBRIS );
-    DebugRenderEntities( m_Beetles, MAX_BEETLES );
-    DebugRenderEntities( m_Wasps, MAX_WASPS );
-
-
-    for( int bulletIndex = 0; bulletIndex < MAX_BULLETS; ++bulletIndex )
+    else
     {
-        Entity* const& currentBullet = m_Bullets[ bulletIndex ];
-        if( currentBullet != nullptr )
+        for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
         {
-            currentBullet->DebugRender();
-            if( isShip )
+            if( m_PlayerShips[ playerIndex ] != nullptr )
             {
-                DrawDebugLine( shipPosition,
-                               Vec2( currentBullet->GetPosition().x,
-                                     currentBullet->GetPosition().y
-                                   ),
-                               Rgba8::DARK_GRAY,
-                               .1f
-                             );
+                m_PlayerShips[ playerIndex ]->DebugRender( m_DebugBatch );
             }
         }
+
+        // Debris is purely cosmetic so it has no debug visuals
+        DebugRenderEntities( m_Asteroids, MAX_ASTEROIDS );
+        DebugRenderEntities( m_Bullets, MAX_BULLETS );
+        DebugRenderEntities( m_Beetles, MAX_BEETLES );
+        DebugRenderEntities( m_Wasps, MAX_WASPS );
+    }
+
+    for( const ContactEvent& contact : m_Contacts )
+    {
+        m_DebugBatch.AddCircle( contact.point, 1.f, Rgba8::MAGENTA, .2f );
     }
 
-    if( g_InputSystem->GetXboxController( 0 ).IsConnected() )
+    for( const ExplosionLightState& light : m_ExplosionLights )
     {
-        XboxController const& gamepad = g_InputSystem->GetXboxController( 0 );
-        Vec2 centerLeft = Vec2( 25.f, 25.f );
-        Vec2 centerRight = Vec2( WORLD_SIZE_X - 25.f, 25.f );
+        m_DebugBatch.AddCircle( light.position, light.radius, light.color, .1f );
+    }
+
+    if( m_Context.input != nullptr && m_Context.input->GetXboxController( 0 ).IsConnected() )
+    {
+        XboxController const& gamepad = m_Context.input->GetXboxController( 0 );
+        Vec2 centerLeft = m_CameraMins + Vec2( 25.f, 25.f );
+        Vec2 centerRight = m_CameraMins + Vec2( SCREEN_SIZE_X - 25.f, 25.f );
         float circleRadius = 20.f;
-        DrawDebugCircle( centerLeft, circleRadius, Rgba8::WHITE, .1f );
-        DrawDebugCircle( centerRight, circleRadius, Rgba8::WHITE, .1f );
+        m_DebugBatch.AddCircle( centerLeft, circleRadius, Rgba8::WHITE, .1f );
+        m_DebugBatch.AddCircle( centerRight, circleRadius, Rgba8::WHITE, .1f );
 
         // Draw Left Joystick Debug
-        DrawDebugCircle( centerLeft + gamepad.GetLeftJoystick().GetPosition() * circleRadius,
-                         1.f,
-                         Rgba8::GREEN,
-                         .1f
-                       );
-        DrawDebugCircle( centerLeft + gamepad.GetLeftJoystick().GetRawPosition() * circleRadius,
-                         1.f,
-                         Rgba8::RED,
-                         .1f
-                       );
-        DrawDebugLine( centerLeft,
-                       centerLeft + gamepad.GetLeftJoystick().GetPosition() * circleRadius,
-                       Rgba8::GREEN,
-                       .1f
-                     );
-        DrawDebugLine( centerLeft,
-                       centerLeft + gamepad.GetLeftJoystick().GetRawPosition() * circleRadius,
-                       Rgba8::RED,
-                       .1f
-                     );
+        m_DebugBatch.AddCircle( centerLeft + gamepad.GetLeftJoystick().GetPosition() * circleRadius,
+                                1.f,
+                                Rgba8::GREEN,
+                                .1f
+                              );
+        m_DebugBatch.AddCircle( centerLeft + gamepad.GetLeftJoystick().GetRawPosition() * circleRadius,
+                                1.f,
+                                Rgba8::RED,
+                                .1f
+                              );
+        m_DebugBatch.AddLine( centerLeft,
+                              centerLeft + gamepad.GetLeftJoystick().GetPosition() * circleRadius,
+                              Rgba8::GREEN,
+                              .1f
+                            );
+        m_DebugBatch.AddLine( centerLeft,
+                              centerLeft + gamepad.GetLeftJoystick().GetRawPosition() * circleRadius,
+                              Rgba8::RED,
+                              .1f
+                            );
 
         // Draw Right Joystick Debug
-        DrawDebugCircle( centerRight + gamepad.GetRightJoystick().GetPosition() * circleRadius,
-                         1.f,
-                         Rgba8::GREEN,
-                         .1f
-                       );
-        DrawDebugCircle( centerRight + gamepad.GetRightJoystick().GetRawPosition() * circleRadius,
-                         1.f,
-                         Rgba8::RED,
-                         .1f
-                       );
-        DrawDebugLine( centerRight,
-                       centerRight + gamepad.GetRightJoystick().GetPosition() * circleRadius,
-                       Rgba8::GREEN,
-                       .1f
-                     );
-        DrawDebugLine( centerRight,
-                       centerRight + gamepad.GetRightJoystick().GetRawPosition() * circleRadius,
-                       Rgba8::RED,
-                       .1f
-                     );
+        m_DebugBatch.AddCircle( centerRight + gamepad.GetRightJoystick().GetPosition() * circleRadius,
+                                1.f,
+                                Rgba8::GREEN,
+                                .1f
+                              );
+        m_DebugBatch.AddCircle( centerRight + gamepad.GetRightJoystick().GetRawPosition() * circleRadius,
+                                1.f,
+                                Rgba8::RED,
+                                .1f
+                              );
+        m_DebugBatch.AddLine( centerRight,
+                              centerRight + gamepad.GetRightJoystick().GetPosition() * circleRadius,
+                              Rgba8::GREEN,
+                              .1f
+                            );
+        m_DebugBatch.AddLine( centerRight,
+                              centerRight + gamepad.GetRightJoystick().GetRawPosition() * circleRadius,
+                              Rgba8::RED,
+                              .1f
+                            );
 
         Vec2 leftTriggerStart = centerLeft + Vec2( 25.f, -20.f );
         Vec2 rightTriggerStart = centerRight + Vec2( -25.f, -20.f );
         float triggerDistance = circleRadius * 2.f;
         // Draw Left Trigger Debug
-        DrawDebugLine( leftTriggerStart,
-                       leftTriggerStart + Vec2( 0.f, 1.f ) * triggerDistance * gamepad.GetLeftTrigger(),
-                       Rgba8::CYAN,
-                       .5f
-                     );
-        DrawDebugLine( rightTriggerStart,
-                       rightTriggerStart + Vec2( 0.f, 1.f ) * triggerDistance * gamepad.GetRightTrigger(),
-                       Rgba8::MAGENTA,
-                       .5f
-                     );
+        m_DebugBatch.AddLine( leftTriggerStart,
+                              leftTriggerStart + Vec2( 0.f, 1.f ) * triggerDistance * gamepad.GetLeftTrigger(),
+                              Rgba8::CYAN,
+                              .5f
+                            );
+        m_DebugBatch.AddLine( rightTriggerStart,
+                              rightTriggerStart + Vec2( 0.f, 1.f ) * triggerDistance * gamepad.GetRightTrigger(),
+                              Rgba8::MAGENTA,
+                              .5f
+                            );
+    }
+
+    if( m_DebugBatch.GetVertexCount() > 0 )
+    {
+        CountDraw( m_DebugBatch.GetVertexCount() );
+    }
+    m_DebugBatch.Flush( *m_Context.renderer );
+}
+
+//-----------------------------------------------------------------------------
+// The game camera always looks at the screen sized region from m_CameraMins,
+//  offset by the current screen shake
+AABB2 Game::GetGameCameraBounds() const
+{
+    const Vec2 cameraMins = m_CameraMins + m_ScreenShakeOffset;
+    return AABB2( cameraMins, cameraMins + Vec2( SCREEN_SIZE_X, SCREEN_SIZE_Y ) );
+}
+
+//-----------------------------------------------------------------------------
+// Centers the camera on the live ships, kept inside the world so it never
+//  shows past an edge. A one sector world pins it at the origin. With every
+//  ship dead it stays where it was.
+void Game::UpdateCameraFocus()
+{
+    Vec2 focus = Vec2( 0.f, 0.f );
+    int liveShipCount = 0;
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+    {
+        const PlayerShip* playerShip = m_PlayerShips[ playerIndex ];
+        if( playerShip != nullptr && !playerShip->IsDead() )
+        {
+            focus = focus + static_cast<Vec2>(playerShip->GetPosition());
+            liveShipCount++;
+        }
+    }
+    if( liveShipCount == 0 )
+    {
+        return;
+    }
+
+    focus = focus / static_cast<float>(liveShipCount);
+    const Vec2& worldSize = GetWorldSize();
+    m_CameraMins.x = Clamp( focus.x - SCREEN_CENTER_X, 0.f, worldSize.x - SCREEN_SIZE_X );
+    m_CameraMins.y = Clamp( focus.y - SCREEN_CENTER_Y, 0.f, worldSize.y - SCREEN_SIZE_Y );
+}
+
+//-----------------------------------------------------------------------------
+// Ships far from the camera fall outside the grids and clamp to their edge
+//  cells, which stays exact; the grids are only less selective out there
+void Game::MoveSpatialGrids()
+{
+    if( !m_Sectors.IsStreaming() )
+    {
+        return;
     }
+
+    const float keptSectors = static_cast<float>(2 * SECTOR_KEEP_RADIUS + 1);
+    const Vec2 gridMins = GetCameraCenter() -
+                          Vec2( SCREEN_SIZE_X, SCREEN_SIZE_Y ) * (keptSectors * .5f) -
+                          Vec2( SPATIAL_GRID_MARGIN, SPATIAL_GRID_MARGIN );
+    m_NearestPlayerGrid.MoveBounds( gridMins );
+    m_CollisionGrid.MoveBounds( gridMins );
 }
 
 void Game::HandleUserInput()
 {
-    if( g_InputSystem->WasKeyJustPressed( F1 ) )
+    InputSystem& input = *m_Context.input;
+
+    if( input.WasKeyJustPressed( F1 ) )
     {
         m_IsDebug = !m_IsDebug;
     }
 
-    if( g_InputSystem->IsKeyPressed( SPACE ) )
+    if( input.IsKeyPressed( SPACE ) )
     {
         if( m_IsAttractMode )
         {
@@ -494,39 +945,134 @@ void Game::HandleUserInput()
         }
     }
 
-    if( g_InputSystem->WasKeyJustPressed( 'N' ) )
+    if( input.WasKeyJustPressed( F5 ) )
     {
-        if( m_IsAttractMode )
-        {
-            m_IsAttractMode = false;
-        }
-        else
-        {
-            RequestShipRespawn();
-        }
+        SaveWorld( QUICK_SAVE_FILE_PATH );
+    }
+
+    if( input.WasKeyJustPressed( F9 ) )
+    {
+        LoadWorld( QUICK_SAVE_FILE_PATH );
+    }
+
+    if( input.WasKeyJustPressed( F6 ) )
+    {
+        LoadBulletStormScenario();
     }
 
-    if( g_InputSystem->WasKeyJustPressed( 'O' ) )
+    if( input.WasKeyJustPressed( 'O' ) )
     {
         RequestSpawnAstroid();
     }
 
-    if( g_InputSystem->WasKeyJustPressed( 'P' ) )
+    if( input.WasKeyJustPressed( 'P' ) )
     {
         m_IsPaused = !m_IsPaused;
     }
 
-    if( g_InputSystem->WasKeyJustPressed( 'T' ) )
+    if( input.WasKeyJustPressed( 'T' ) )
     {
         m_IsSlowMo = true;
     }
 
-    if( g_InputSystem->WasKeyJustReleased( 'T' ) )
+    if( m_IsPaused )
+    {
+        if( input.WasKeyJustPressed( 'Z' ) )
+        {
+            RewindSnapshots( 1 );
+        }
+        else if( input.IsKeyPressed( 'X' ) )
+        {
+            RewindSnapshots( SNAPSHOT_REWIND_TICKS_PER_FRAME );
+        }
+    }
+
+    if( input.WasKeyJustReleased( 'T' ) )
     {
         m_IsSlowMo = false;
     }
 }
 
+//-----------------------------------------------------------------------------
+// Pilots first, then local devices. Without either an input stays whatever
+//  the host last set. An input thread is latched right before the tick, so
+//  it holds everything pressed up to now rather than up to BeginFrame.
+void Game::UpdatePlayerInputs()
+{
+    PlayerInput latchedInputs[ MAX_PLAYERS ];
+    if( m_Context.inputThread != nullptr )
+    {
+        m_Context.inputThread->LatchInputs( GetCurrentTimeSeconds(), latchedInputs, m_PlayerCount );
+    }
+
+    for( int playerIndex = 0; playerIndex < m_PlayerCount; ++playerIndex )
+    {
+        PlayerPilot* pilot = m_IsDemo ? &m_DemoPilots[ playerIndex ] : m_PlayerPilots[ playerIndex ];
+        if( pilot != nullptr )
+        {
+            SetPlayerInput( playerIndex, pilot->UpdatePilot( *this, playerIndex ) );
+        }
+        else if( m_Context.inputThread != nullptr )
+        {
+            SetPlayerInput( playerIndex, latchedInputs[ playerIndex ] );
+        }
+        else if( m_Context.input != nullptr )
+        {
+            // The keyboard joins player 0, every other player is a pad
+            SetPlayerInput( playerIndex, SampleLocalPlayerInput( *m_Context.input, playerIndex, playerIndex == 0 ) );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Only for games someone is sitting at; a start press during the demo
+//  drops back to the title and starts a real game on the same tick
+void Game::UpdateDemo( float deltaSeconds )
+{
+    if( m_Context.input == nullptr )
+    {
+        return;
+    }
+
+    if( m_IsDemo )
+    {
+        for( int playerIndex = 0; playerIndex < m_PlayerCount; ++playerIndex )
+        {
+            PlayerInput input = SampleLocalPlayerInput( *m_Context.input, playerIndex, playerIndex == 0 );
+            if( input.IsPressed( PLAYER_INPUT_START ) || input.IsPressed( PLAYER_INPUT_RESPAWN ) )
+            {
+                EndDemo();
+                return;
+            }
+        }
+        return;
+    }
+
+    if( !m_IsAttractMode )
+    {
+        m_AttractIdleSeconds = 0.f;
+        return;
+    }
+
+    m_AttractIdleSeconds += deltaSeconds;
+    if( m_AttractIdleSeconds > ATTRACT_DEMO_DELAY_SECONDS )
+    {
+        m_AttractIdleSeconds = 0.f;
+        m_IsDemo = true;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void Game::EndDemo()
+{
+    m_IsDemo = false;
+    DeleteAllEntities();
+    AttractModeDefaults();
+    m_IsAttractMode = true;
+    m_WasJustAttractMode = true;
+    m_PlayerShipDestroyedTime = 0.f;
+}
+
 void Game::AttractionMode( float deltaSeconds )
 {
     if( !m_IsAttractMode && m_WasJustAttractMode )
@@ -560,7 +1106,8 @@ void Game::AttractionMode( float deltaSeconds )
 void Game::PostAttractionExplosion()
 {
     int randomExplosion = m_Rng->IntInRange( 3, 7 );
-    Vec3 worldCenter = Vec3( WORLD_CENTER_X, WORLD_CENTER_Y, 0.f );
+    const Vec2 cameraCenter = GetCameraCenter();
+    Vec3 worldCenter = Vec3( cameraCenter.x, cameraCenter.y, 0.f );
 
     for( int explosion = 0; explosion < randomExplosion; ++explosion )
     {
@@ -585,10 +1132,18 @@ void Game::AttractModeDefaults()
     AddScreenShake( -1.f );
     AddControllerVibration( 0, -1.f, -1.f );
 
-    m_PlayerShip->SetAngleDegrees( 0.f );
-    m_PlayerShip->SetPosition( Vec3( WORLD_CENTER_X, WORLD_CENTER_Y, 0.f ) );
-    m_PlayerShip->SetVelocity( Vec3::ZERO );
-    m_PlayerShip->SetDead( false );
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+    {
+        PlayerShip* playerShip = m_PlayerShips[ playerIndex ];
+        if( playerShip == nullptr )
+        {
+            continue;
+        }
+        playerShip->SetAngleDegrees( 0.f );
+        playerShip->SetPosition( GetPlayerSpawnPosition( playerIndex ) );
+        playerShip->SetVelocity( Vec3::ZERO );
+        playerShip->SetDead( false );
+    }
 
     m_PlayerShipCurrentLife = 1;
     m_WaveNumber = 0;
@@ -596,156 +1151,11 @@ void Game::AttractModeDefaults()
 
 void Game::RenderAttractMode() const
 {
-    Vec3 center = Vec3( WORLD_CENTER_X, WORLD_CENTER_Y + 10.f, 0.f );
-
-    std::vector<VertexMaster> visual;
-    // S
-    visual.emplace_back( Vec2( -11.5f, 1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -9.5f, .5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( -9.5f, 1.5f ), m_TitleColor );
-                                                            
-    visual.emplace_back( Vec2( -11.5f, 1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -10.5f, -.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -10.5f, .5f ), m_TitleColor );
-                                                            
-    visual.emplace_back( Vec2( -10.5f, .5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -10.5f, -.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -9.5f, -1.5f ), m_TitleColor );
-                                                            
-    visual.emplace_back( Vec2( -11.5f, -.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -11.5f, -1.5f ), m_TitleColor);
-    visual.emplace_back( Vec2( -9.5f, -1.5f ), m_TitleColor);
-
-    // T
-    visual.emplace_back( Vec2( -8.5f, 1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -8.5f, .5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( -7.5f, 1.5f ), m_TitleColor );
-                                                            
-    visual.emplace_back( Vec2( -6.5f, .5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( -6.5f, 1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -7.5f, 1.5f ), m_TitleColor );
-                                                            
-    visual.emplace_back( Vec2( -8.f, -1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -7.f, -1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -7.5f, 1.5f ), m_TitleColor );
-
-    // A
-    visual.emplace_back( Vec2( -5.5f, 1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -5.5f, .5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( -3.5f, 1.5f ), m_TitleColor );
-                                                            
-    visual.emplace_back( Vec2( -5.5f, 1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -3.5f, .5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( -3.5f, 1.5f ), m_TitleColor );
-                                                            
-    visual.emplace_back( Vec2( -5.5f, 1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -5.5f, -1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -4.5f, 1.5f ), m_TitleColor );
-                                                            
-    visual.emplace_back( Vec2( -4.5f, 1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -3.5f, -1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -3.5f, 1.5f ), m_TitleColor );
-                                                            
-    visual.emplace_back( Vec2( -5.5f, -.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -4.5f, -1.f ), m_TitleColor );
-    visual.emplace_back( Vec2( -4.5f, 0.f ), m_TitleColor ) ;
-                                                            
-    visual.emplace_back( Vec2( -3.5f, -.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -4.5f, 0.f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( -4.5f, -1.f ), m_TitleColor );
-                                                            
-    visual.emplace_back( Vec2( -2.5f, 1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -2.5f, -1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -1.5f, 1.5f ), m_TitleColor );
-
-    // R
-    visual.emplace_back( Vec2( -2.5f, 1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -.5f, .5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( -.5f, 1.5f ), m_TitleColor ) ;
-                                                            
-    visual.emplace_back( Vec2( -2.5f, -.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -.5f, -.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( -.5f, .5f ), m_TitleColor ) ;
-                                                            
-    visual.emplace_back( Vec2( -2.5f, .5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( -2.5f, -.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( -.5f, -1.5f ), m_TitleColor );
-                                                            
-    // S
-    visual.emplace_back( Vec2( .5f, 1.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 2.5f, .5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 2.5f, 1.5f ), m_TitleColor ) ;
-
-    visual.emplace_back( Vec2( .5f, 1.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 1.5f, -.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 1.5f, .5f ), m_TitleColor ) ;
-                                                            
-    visual.emplace_back( Vec2( 1.5f, .5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 1.5f, -.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 2.5f, -1.5f ), m_TitleColor );
-                                                            
-    visual.emplace_back( Vec2( 2.5f, -1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( .5f, -.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( .5f, -1.5f ), m_TitleColor ) ;
-                                                            
-    // H
-    visual.emplace_back( Vec2( 3.5f, 1.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 3.5f, -1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( 4.5f, 1.5f ), m_TitleColor ) ;
-    
-    visual.emplace_back( Vec2( 4.5f, -1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( 5.5f, -1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( 5.5f, 1.5f ), m_TitleColor ) ;
-                                                            
-    visual.emplace_back( Vec2( 3.5f, 0.f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 4.5f, -.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 4.5f, .5f ), m_TitleColor ) ;
-                                                            
-    visual.emplace_back( Vec2( 4.5f, .5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 4.5f, -.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 5.5f, 0.f ), m_TitleColor ) ;
-
-    // I
-    visual.emplace_back( Vec2( 6.5f, 1.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 6.5f, .5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 7.5f, 1.5f ), m_TitleColor ) ;
-                                                            
-    visual.emplace_back( Vec2( 7.5f, 1.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 8.5f, .5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 8.5f, 1.5f ), m_TitleColor ) ;
-                                                            
-    visual.emplace_back( Vec2( 7.f, 1.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 7.5f, -1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( 8.f, 1.5f ), m_TitleColor ) ;
-                                                            
-    visual.emplace_back( Vec2( 7.f, -1.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 7.5f, 1.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 8.f, -1.5f ), m_TitleColor ) ;
-                                                            
-    visual.emplace_back( Vec2( 6.5f, -.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 6.5f, -1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( 7.5f, -1.5f ), m_TitleColor );
-                                                            
-    visual.emplace_back( Vec2( 7.5f, -1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( 8.5f, -1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( 8.5f, -.5f ), m_TitleColor ) ;
-                                                            
-    // P                                                    
-    visual.emplace_back( Vec2( 9.5f, 1.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 9.5f, -1.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( 10.5f, 1.5f ), m_TitleColor );
-                                                            
-    visual.emplace_back( Vec2( 9.5f, 1.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 11.5f, .5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 11.5f, 1.5f ), m_TitleColor );
-                                                            
-    visual.emplace_back( Vec2( 9.5f, -.5f ), m_TitleColor ) ;
-    visual.emplace_back( Vec2( 11.5f, -.5f ), m_TitleColor );
-    visual.emplace_back( Vec2( 11.5f, .5f ), m_TitleColor ) ;
-
-    TransformVertexArray( visual, Vec2(100,50) , m_TitleRotaiton, m_TitleScale );
-
-    g_Renderer->DrawVertexArray( visual );
+    m_TitleText.Render( *m_Context.renderer,
+                        GetCameraCenter(),
+                        m_TitleRotaiton,
+                        m_TitleScale,
+                        m_TitleColor );
 }
 
 float Game::UpdateDeltaSecondsBasedOnState( float deltaSeconds )
@@ -795,11 +1205,18 @@ void Game::SpawnWave()
     m_WaveNumber++;
 }
 
+// A wave is every asteroid, beetle and wasp, live or parked in a far sector,
+//  except the asteroid field a streamed world is scattered with
 bool Game::CheckWaveComplete()
 {
+    if( m_Sectors.GetParkedWaveCount() > 0 )
+    {
+        return false;
+    }
+
     for( int asteroidIndex = 0; asteroidIndex < MAX_ASTEROIDS; ++asteroidIndex )
     {
-        if( m_Asteroids[ asteroidIndex ] != nullptr )
+        if( m_Asteroids[ asteroidIndex ] != nullptr && !m_Asteroids[ asteroidIndex ]->IsSectorField() )
         {
             return false;
         }
@@ -833,11 +1250,56 @@ void Game::ScreenShakeAblation( float deltaSeconds )
                           m_Rng->FloatInRange( -MAX_SCREEN_SHAKE, MAX_SCREEN_SHAKE )
                          );
         shake *= m_CurrentScreenShakePercentage * m_CurrentScreenShakePercentage;
-        m_GameCamera->SetCameraPosition( m_GameCamera->GetPosition() + static_cast<Vec3>(shake) );
+        m_ScreenShakeOffset += shake;
         m_CurrentScreenShakePercentage -= SCREEN_SHAKE_ABLATION_PER_SECOND * deltaSeconds;
     }
 }
 
+//-----------------------------------------------------------------------------
+// Order is not kept; nothing reads the lights by index between frames
+void Game::UpdateExplosionLights( float deltaSeconds )
+{
+    for( size_t lightIndex = 0; lightIndex < m_ExplosionLights.size(); )
+    {
+        ExplosionLightState& light = m_ExplosionLights[ lightIndex ];
+        light.ageSeconds += deltaSeconds;
+        if( light.ageSeconds < EXPLOSION_LIGHT_SECONDS )
+        {
+            lightIndex++;
+            continue;
+        }
+
+        light = m_ExplosionLights.back();
+        m_ExplosionLights.pop_back();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Converted to what the shader reads, faded by age, and binned over exactly
+//  what the game camera sees this frame
+void Game::BinExplosionLights() const
+{
+    m_TileLights.clear();
+    for( const ExplosionLightState& light : m_ExplosionLights )
+    {
+        TileLight tileLight;
+        tileLight.position[ 0 ] = light.position.x;
+        tileLight.position[ 1 ] = light.position.y;
+        tileLight.position[ 2 ] = EXPLOSION_LIGHT_HEIGHT;
+        tileLight.radius = light.radius;
+        tileLight.color[ 0 ] = static_cast<float>(light.color.r) / 255.f;
+        tileLight.color[ 1 ] = static_cast<float>(light.color.g) / 255.f;
+        tileLight.color[ 2 ] = static_cast<float>(light.color.b) / 255.f;
+        tileLight.intensity = light.intensity * (1.f - light.ageSeconds / EXPLOSION_LIGHT_SECONDS);
+        m_TileLights.push_back( tileLight );
+    }
+
+    const AABB2 viewBounds = GetGameCameraBounds();
+    const float viewMins[ 2 ] = { viewBounds.mins.x, viewBounds.mins.y };
+    const float viewMaxs[ 2 ] = { viewBounds.maxs.x, viewBounds.maxs.y };
+    m_LightBinner.Bin( m_TileLights.data(), static_cast<int>(m_TileLights.size()), viewMins, viewMaxs );
+}
+
 void Game::ControllerVibrationAblation( float deltaSeconds )
 {
     if( m_CurrentControllerLeftVibration < 0 )
@@ -851,10 +1313,13 @@ void Game::ControllerVibrationAblation( float deltaSeconds )
     if( m_CurrentControllerLeftVibration >= 0 ||
         m_CurrentControllerRightVibration >= 0 )
     {
-        g_InputSystem->SetXboxControllerVibration( 0,
-                                                   m_CurrentControllerLeftVibration,
-                                                   m_CurrentControllerRightVibration
-                                                 );
+        if( m_Context.input != nullptr )
+        {
+            m_Context.input->SetXboxControllerVibration( 0,
+                                                         m_CurrentControllerLeftVibration,
+                                                         m_CurrentControllerRightVibration
+                                                       );
+        }
         m_CurrentControllerLeftVibration -= CONTROLLER_VIBRATION_ABLATION_PER_SECOND * deltaSeconds;
         m_CurrentControllerRightVibration -= CONTROLLER_VIBRATION_ABLATION_PER_SECOND * deltaSeconds;
 
@@ -884,56 +1349,159 @@ void Game::UpdateEntities( float deltaSeconds,
     }
 }
 
+//-----------------------------------------------------------------------------
+static bool IsDiscOutsideView( const Vec2& center, float radius, const AABB2& viewBounds )
+{
+    return center.x + radius < viewBounds.mins.x ||
+           center.x - radius > viewBounds.maxs.x ||
+           center.y + radius < viewBounds.mins.y ||
+           center.y - radius > viewBounds.maxs.y;
+}
+
 //-----------------------------------------------------------------------------
 void Game::RenderEntities( const Entity* const* entities,
-                           int entitiesSize ) const
+                           int entitiesSize,
+                           const AABB2& viewBounds ) const
 {
     for( int entityIndex = 0; entityIndex < entitiesSize; ++entityIndex )
     {
         const Entity* const& currentEntity = entities[ entityIndex ];
         if( currentEntity != nullptr )
         {
-            currentEntity->Render();
+            RenderEntityIfVisible( *currentEntity, viewBounds );
         }
     }
 }
 
-void Game::DebugRenderEntities( const Entity* const* entities,
-                                int entitiesSize ) const
+//-----------------------------------------------------------------------------
+// Cosmetic radius bounds every vertex an entity draws, so if that disc's
+//  box misses the view nothing the entity renders could be seen
+bool Game::RenderEntityIfVisible( const Entity& entity,
+                                  const AABB2& viewBounds ) const
 {
-    bool isShip = false;
-    Vec2 shipPosition = Vec2( 0.f, 0.f );
-    if( m_PlayerShip != nullptr )
+    const Vec3 position = entity.GetPosition();
+    if( IsDiscOutsideView( Vec2( position.x, position.y ), entity.GetCosmeticRadius(), viewBounds ) )
     {
-        isShip = true;
-        shipPosition = Vec2( m_PlayerShip->GetPosition().x,
-                             m_PlayerShip->GetPosition().y
-                           );
+        m_EntitiesCulledThisFrame++;
+        return false;
     }
 
+    m_EntitiesDrawnThisFrame++;
+    entity.Render( *m_Context.renderer );
+    return true;
+}
+
+void Game::DebugRenderEntities( const Entity* const* entities,
+                                int entitiesSize ) const
+{
     for( int entityIndex = 0; entityIndex < entitiesSize; ++entityIndex )
     {
         const Entity* const& currentEntity = entities[ entityIndex ];
-        if( currentEntity != nullptr )
+        if( currentEntity == nullptr )
         {
-            if( isShip && dynamic_cast<const Debris*>(currentEntity) == nullptr )
-            {
-                currentEntity->DebugRender();
-                DrawDebugLine( shipPosition,
-                               Vec2( currentEntity->GetPosition().x,
-                                     currentEntity->GetPosition().y
-                                   ),
-                               Rgba8::DARK_GRAY,
-                               .1f
-                             );
-            }
+            continue;
+        }
+
+        currentEntity->DebugRender( m_DebugBatch );
+
+        // Line to whichever ship it would chase
+        const PlayerShip* nearestShip = GetNearestAlivePlayer( currentEntity->GetPosition() );
+        if( nearestShip != nullptr )
+        {
+            Vec2 shipPosition = Vec2( nearestShip->GetPosition().x,
+                                      nearestShip->GetPosition().y
+                                    );
+            m_DebugBatch.AddLine( shipPosition,
+                                  Vec2( currentEntity->GetPosition().x,
+                                        currentEntity->GetPosition().y
+                                      ),
+                                  Rgba8::DARK_GRAY,
+                                  .1f
+                                );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Same culling and draw order as the live path, read straight from the
+//  packed snapshot
+void Game::RenderSnapshotEntities( const AABB2& viewBounds ) const
+{
+    RenderContext& renderer = *m_Context.renderer;
+    const RenderSnapshot& snapshot = *m_RenderSnapshot;
+    for( int entityIndex = 0; entityIndex < snapshot.entityCount; ++entityIndex )
+    {
+        const RenderEntityState& state = snapshot.entities[ entityIndex ];
+        if( IsDiscOutsideView( state.position, state.cosmeticRadius, viewBounds ) )
+        {
+            m_EntitiesCulledThisFrame++;
+            continue;
+        }
+
+        m_EntitiesDrawnThisFrame++;
+        int vertexCount = 0;
+        switch( state.kind )
+        {
+            case ENTITY_KIND_PLAYER_SHIP:
+                vertexCount = PlayerShip::RenderFromState( renderer,
+                                                           state,
+                                                           GetPlayerInput( state.playerIndex ).GetThrustFraction(),
+                                                           Vec2( 0.f, 0.f ) );
+                break;
+            case ENTITY_KIND_ASTEROID:
+                vertexCount = Asteroid::RenderFromState( renderer, state, snapshot.shapes[ state.shapeIndex ].corners );
+                break;
+            case ENTITY_KIND_BULLET:
+                vertexCount = Bullet::RenderFromState( renderer, state );
+                break;
+            case ENTITY_KIND_DEBRIS:
+                vertexCount = Debris::RenderFromState( renderer, state, snapshot.shapes[ state.shapeIndex ].corners );
+                break;
+            case ENTITY_KIND_BEETLE:
+                vertexCount = Beetle::RenderFromState( renderer, state );
+                break;
+            case ENTITY_KIND_WASP:
+                vertexCount = Wasp::RenderFromState( renderer, state );
+                break;
+            default:
+                break;
+        }
+        CountDraw( vertexCount );
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Debris is purely cosmetic so it has no debug visuals here either
+void Game::DebugRenderSnapshotEntities() const
+{
+    const RenderSnapshot& snapshot = *m_RenderSnapshot;
+    for( int entityIndex = 0; entityIndex < snapshot.entityCount; ++entityIndex )
+    {
+        const RenderEntityState& state = snapshot.entities[ entityIndex ];
+        if( state.kind == ENTITY_KIND_DEBRIS )
+        {
+            continue;
         }
+
+        m_DebugBatch.AddLine( state.position,
+                              state.position + state.velocity,
+                              DEBUG_FORWARD_VECTOR_COLOR, .2f );
+        m_DebugBatch.AddCircle( state.position,
+                                state.physicsRadius,
+                                DEBUG_PHYSICS_CIRCLE,
+                                .1f );
+        m_DebugBatch.AddCircle( state.position,
+                                state.cosmeticRadius,
+                                DEBUG_COSMETIC_CIRCLE,
+                                .1f );
     }
 }
 
-void Game::RequestShipRespawn()
+// Lives are one pool shared by every player
+void Game::RequestShipRespawn( int playerIndex )
 {
-    if( m_PlayerShip->IsDead() )
+    PlayerShip* playerShip = m_PlayerShips[ playerIndex ];
+    if( playerShip != nullptr && playerShip->IsDead() )
     {
         if( m_PlayerShipCurrentLife >= MAX_NUMBER_OF_LIVES )
         {
@@ -941,48 +1509,211 @@ void Game::RequestShipRespawn()
         }
         m_PlayerShipCurrentLife += 1;
 
-        m_PlayerShip->RespawnShip();
+        playerShip->RespawnShip();
     }
 
 }
 
-void Game::RenderLives() const
+//-----------------------------------------------------------------------------
+bool Game::AreAllPlayersDead() const
 {
-    for( int liveIndex = 0; liveIndex < MAX_NUMBER_OF_LIVES - m_PlayerShipCurrentLife; ++liveIndex )
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
     {
-        std::vector<VertexMaster> visual;
-        // Life 1
-        visual.push_back(VertexMaster( Vec2( -2.5f, 2.f ), PLAYER_SHIP_COLOR_1 ));
-        visual.push_back(VertexMaster( Vec2( -1.5f, 1.f ), PLAYER_SHIP_COLOR_1 ));
-        visual.push_back(VertexMaster( Vec2( -1.5f, 2.f ), PLAYER_SHIP_COLOR_1 ));
+        if( m_PlayerShips[ playerIndex ] != nullptr && !m_PlayerShips[ playerIndex ]->IsDead() )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void Game::StartupHud()
+{
+    m_TitleFont.AddTitleGlyphs();
+    m_TitleFont.SetGlyphSpacing( 1.f );
+    m_HudFont.AddSegmentGlyphs();
+
+    m_TitleText = VectorText( &m_TitleFont, Vec2( .5f, .5f ) );
+    m_TitleText.SetText( "STARSHIP" );
+
+    m_WaveText = VectorText( &m_HudFont, Vec2( 1.f, 1.f ) );
+    m_FrameTimeText = VectorText( &m_HudFont, Vec2( 0.f, 0.f ) );
+    m_RenderStatsText = VectorText( &m_HudFont, Vec2( 0.f, 0.f ) );
+    m_SnapshotStatsText = VectorText( &m_HudFont, Vec2( 0.f, 0.f ) );
+    m_NetStatsText = VectorText( &m_HudFont, Vec2( 0.f, 0.f ) );
+    m_ThreadStatsText = VectorText( &m_HudFont, Vec2( 0.f, 0.f ) );
+    m_PacerStatsText = VectorText( &m_HudFont, Vec2( 0.f, 0.f ) );
+    m_AllocationStatsText = VectorText( &m_HudFont, Vec2( 0.f, 0.f ) );
+    m_InputStatsText = VectorText( &m_HudFont, Vec2( 0.f, 0.f ) );
+    m_LightStatsText = VectorText( &m_HudFont, Vec2( 0.f, 0.f ) );
+    m_SectorStatsText = VectorText( &m_HudFont, Vec2( 0.f, 0.f ) );
+    m_DemoText = VectorText( &m_HudFont, Vec2( .5f, 1.f ) );
+    m_DemoText.SetText( "DEMO  PRESS START" );
+
+    // Life icon in local space, laid out into m_LivesVisual when lives change
+    m_LifeIconVisual.clear();
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( -2.5f, 2.f ), PLAYER_SHIP_COLOR_1 ) );
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( -1.5f, 1.f ), PLAYER_SHIP_COLOR_1 ) );
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( -1.5f, 2.f ), PLAYER_SHIP_COLOR_1 ) );
+
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( -1.5f, 2.f ), PLAYER_SHIP_COLOR_2 ) );
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( -1.5f, 0.f ), PLAYER_SHIP_COLOR_2 ) );
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( 1.5f, 1.f ), PLAYER_SHIP_COLOR_2 ) );
+
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( -1.5f, 0.f ), PLAYER_SHIP_COLOR_1 ) );
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( 1.5f, -1.f ), PLAYER_SHIP_COLOR_1 ) );
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( 1.5f, 1.f ), PLAYER_SHIP_COLOR_1 ) );
+
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( -1.5f, 0.f ), PLAYER_SHIP_COLOR_2 ) );
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( -1.5f, -2.f ), PLAYER_SHIP_COLOR_2 ) );
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( 1.5f, -1.f ), PLAYER_SHIP_COLOR_2 ) );
+
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( 1.5f, 1.f ), PLAYER_SHIP_COLOR_1 ) );
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( 1.5f, -1.f ), PLAYER_SHIP_COLOR_1 ) );
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( 2.5f, 0.f ), PLAYER_SHIP_COLOR_1 ) );
+
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( -1.5f, -1.f ), PLAYER_SHIP_COLOR_1 ) );
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( -2.5f, -2.f ), PLAYER_SHIP_COLOR_1 ) );
+    m_LifeIconVisual.push_back( VertexMaster( Vec2( -1.5f, -2.f ), PLAYER_SHIP_COLOR_1 ) );
+
+    m_LivesVisualCount = -1;
+}
 
-        visual.push_back( VertexMaster( Vec2( -1.5f, 2.f ), PLAYER_SHIP_COLOR_2 ) );
-        visual.push_back( VertexMaster( Vec2( -1.5f, 0.f ), PLAYER_SHIP_COLOR_2 ) );
-        visual.push_back( VertexMaster( Vec2( 1.5f, 1.f ), PLAYER_SHIP_COLOR_2 ));
+//-----------------------------------------------------------------------------
+void Game::UpdateHud( float deltaSeconds )
+{
+    UpdateLivesVisual();
+
+    m_WaveText.SetTextf( "WAVE %i", m_WaveNumber );
+
+    // Taken even while hidden, so the readout is never one huge window
+    m_InputStatsSeconds += deltaSeconds;
+    if( m_Context.inputThread != nullptr && m_InputStatsSeconds >= INPUT_LATENCY_STATS_SECONDS )
+    {
+        m_InputStatsSeconds = 0.f;
+        InputLatencyHistogram latency;
+        m_Context.inputThread->TakeLatencyHistogram( latency );
+        m_InputStatsText.SetTextf( "INPUT %i  P50 %.0f  P95 %.0f  P99 %.0f  WORST %.2f  DROPPED %i",
+                                   latency.GetTotalCount(),
+                                   latency.GetPercentileMilliseconds( .5f ),
+                                   latency.GetPercentileMilliseconds( .95f ),
+                                   latency.GetPercentileMilliseconds( .99f ),
+                                   latency.worstSeconds * 1000.0,
+                                   m_Context.inputThread->GetDroppedCount() );
+    }
+
+    if( !m_IsDebug )
+    {
+        return;
+    }
+
+    // Smooth so the readout is stable enough to read, then round so the text
+    //  (and its mesh) only changes when the number visibly does
+    m_SmoothedFrameSeconds += (deltaSeconds - m_SmoothedFrameSeconds) * .05f;
+    float frameMilliseconds = m_SmoothedFrameSeconds * 1000.f;
+    int framesPerSecond = m_SmoothedFrameSeconds > 0.f ? static_cast<int>(1.f / m_SmoothedFrameSeconds + .5f) : 0;
+    m_FrameTimeText.SetTextf( "FPS %i  MS %.1f", framesPerSecond, frameMilliseconds );
+    // Still holds the last frame's draws
+    int vertexBytes = m_Counters.values[ GAME_COUNTER_VERTEX_BYTES ];
+    m_RenderStatsText.SetTextf( "DRAWN %i  CULLED %i  DEBUG %i  VERTEX KB %.1f",
+                                m_EntitiesDrawnThisFrame,
+                                m_EntitiesCulledThisFrame,
+                                m_DebugBatch.GetPrimitivesDrawn(),
+                                static_cast<float>(vertexBytes) / 1024.f );
+    m_SnapshotStatsText.SetTextf( "SNAP %i  KB %i  MS %.2f  PEAK %.2f",
+                                  m_Snapshots.GetSnapshotCount(),
+                                  m_Snapshots.GetDeltaBytesUsed() / 1024,
+                                  m_LastSnapshotSeconds * 1000.0,
+                                  m_PeakSnapshotSeconds * 1000.0 );
+
+    const AllocationFrameStats& allocationStats = GetLastAllocationFrameStats();
+    m_AllocationStatsText.SetTextf( "ALLOC UPDATE %i COLLIDE %i RENDER %i DEBUG %i OTHER %i  KB %lli  LIVE MB %.1f  PEAK %.1f",
+                                    allocationStats.tags[ ALLOCATION_TAG_UPDATE ].count,
+                                    allocationStats.tags[ ALLOCATION_TAG_COLLISION ].count,
+                                    allocationStats.tags[ ALLOCATION_TAG_RENDER ].count,
+                                    allocationStats.tags[ ALLOCATION_TAG_DEBUG ].count,
+                                    allocationStats.tags[ ALLOCATION_TAG_UNTAGGED ].count,
+                                    GetAllocationFrameBytes( allocationStats ) / 1024,
+                                    static_cast<double>(allocationStats.liveBytes) / (1024.0 * 1024.0),
+                                    static_cast<double>(allocationStats.peakLiveBytes) / (1024.0 * 1024.0) );
+
+    m_LightStatsText.SetTextf( "LIGHTS %i  BINNED %i  TILE MOST %i  DROPPED %i  MS %.2f  THREADS %i",
+                               static_cast<int>(m_TileLights.size()),
+                               static_cast<int>(m_LightBinner.GetLightIndices().size()),
+                               m_LightBinner.GetMostLightsInTile(),
+                               m_LightBinner.GetDroppedCount(),
+                               m_LightBinner.GetLastBinSeconds() * 1000.0,
+                               m_LightBinner.GetWorkerCount() + 1 );
+
+    m_SectorStatsText.SetTextf( "SECTORS %i  KEPT %i  PARKED %i  KB %i  MS %.2f",
+                                m_Sectors.GetSectorCount(),
+                                m_Sectors.GetKeptSectorCount(),
+                                m_Sectors.GetTotalParkedCount(),
+                                static_cast<int>(m_Sectors.GetParkedBytes() / 1024),
+                                m_LastStreamSeconds * 1000.0 );
+}
 
-        visual.push_back( VertexMaster( Vec2( -1.5f, 0.f ), PLAYER_SHIP_COLOR_1 ) );
-        visual.push_back( VertexMaster( Vec2( 1.5f, -1.f ), PLAYER_SHIP_COLOR_1 ) );
-        visual.push_back( VertexMaster( Vec2( 1.5f, 1.f ), PLAYER_SHIP_COLOR_1 ));
+//-----------------------------------------------------------------------------
+void Game::UpdateLivesVisual()
+{
+    int livesRemaining = MAX_NUMBER_OF_LIVES - m_PlayerShipCurrentLife;
+    if( livesRemaining == m_LivesVisualCount )
+    {
+        return;
+    }
+    m_LivesVisualCount = livesRemaining;
 
-        visual.push_back( VertexMaster( Vec2( -1.5f, 0.f ), PLAYER_SHIP_COLOR_2 ) );
-        visual.push_back( VertexMaster( Vec2( -1.5f, -2.f ), PLAYER_SHIP_COLOR_2 ) );
-        visual.push_back( VertexMaster( Vec2( 1.5f, -1.f ), PLAYER_SHIP_COLOR_2 ));
+    m_LivesVisual.clear();
+    Vec2 liveDisplayPosition = Vec2( 5.f, SCREEN_SIZE_Y - 5.f );
+    float scale = .5f;
+    Vec2 displacement = Vec2( 7.f * scale, 0.f );
+    std::vector<VertexMaster> lifeVisual;
+    for( int liveIndex = 0; liveIndex < livesRemaining; ++liveIndex )
+    {
+        lifeVisual = m_LifeIconVisual;
+        Vec2 livePosition = liveDisplayPosition + displacement * (float)liveIndex;
+        TransformVertexArray( lifeVisual, livePosition, 90.f, scale );
+        m_LivesVisual.insert( m_LivesVisual.end(), lifeVisual.begin(), lifeVisual.end() );
+    }
+}
 
-        visual.push_back( VertexMaster( Vec2( 1.5f, 1.f ), PLAYER_SHIP_COLOR_1 ) );
-        visual.push_back( VertexMaster( Vec2( 1.5f, -1.f ), PLAYER_SHIP_COLOR_1 ) );
-        visual.push_back( VertexMaster( Vec2( 2.5f, 0.f ), PLAYER_SHIP_COLOR_1 ));
+//-----------------------------------------------------------------------------
+void Game::RenderLives() const
+{
+    if( m_LivesVisual.empty() )
+    {
+        return;
+    }
+    m_Context.renderer->DrawVertexArray( m_LivesVisual );
+    CountDraw( static_cast<int>(m_LivesVisual.size()) );
+}
 
-        visual.push_back( VertexMaster( Vec2( -1.5f, -1.f ), PLAYER_SHIP_COLOR_1 ) );
-        visual.push_back( VertexMaster( Vec2( -2.5f, -2.f ), PLAYER_SHIP_COLOR_1 ) );
-        visual.push_back( VertexMaster( Vec2( -1.5f, -2.f ), PLAYER_SHIP_COLOR_1 ));
+//-----------------------------------------------------------------------------
+void Game::RenderHud() const
+{
+    if( m_IsDemo )
+    {
+        m_DemoText.Render( *m_Context.renderer, Vec2( SCREEN_CENTER_X, SCREEN_SIZE_Y - 2.f ), 0.f, 1.f, Rgba8::WHITE );
+    }
 
-        Vec2 liveDisplayPosition = Vec2( 5.f, WORLD_SIZE_Y - 5.f );
-        float scale = .5f;
-        Vec2 displacement = Vec2( 7.f * scale, 0.f );
-        Vec2 livePosition = liveDisplayPosition + displacement * (float)liveIndex;
-        TransformVertexArray( visual, livePosition, 90.f, scale );
+    if( !m_IsAttractMode )
+    {
+        m_WaveText.Render( *m_Context.renderer, Vec2( SCREEN_SIZE_X - 2.f, SCREEN_SIZE_Y - 2.f ), 0.f, .75f, Rgba8::WHITE );
+    }
 
-        g_Renderer->DrawVertexArray( visual );
+    if( m_IsDebug )
+    {
+        m_SectorStatsText.Render( *m_Context.renderer, Vec2( 2.f, 38.f ), 0.f, .75f, HUD_DEBUG_TEXT_COLOR );
+        m_LightStatsText.Render( *m_Context.renderer, Vec2( 2.f, 34.f ), 0.f, .75f, HUD_DEBUG_TEXT_COLOR );
+        m_InputStatsText.Render( *m_Context.renderer, Vec2( 2.f, 30.f ), 0.f, .75f, HUD_DEBUG_TEXT_COLOR );
+        m_AllocationStatsText.Render( *m_Context.renderer, Vec2( 2.f, 26.f ), 0.f, .75f, HUD_DEBUG_TEXT_COLOR );
+        m_PacerStatsText.Render( *m_Context.renderer, Vec2( 2.f, 22.f ), 0.f, .75f, HUD_DEBUG_TEXT_COLOR );
+        m_ThreadStatsText.Render( *m_Context.renderer, Vec2( 2.f, 18.f ), 0.f, .75f, HUD_DEBUG_TEXT_COLOR );
+        m_NetStatsText.Render( *m_Context.renderer, Vec2( 2.f, 14.f ), 0.f, .75f, HUD_DEBUG_TEXT_COLOR );
+        m_SnapshotStatsText.Render( *m_Context.renderer, Vec2( 2.f, 10.f ), 0.f, .75f, HUD_DEBUG_TEXT_COLOR );
+        m_FrameTimeText.Render( *m_Context.renderer, Vec2( 2.f, 6.f ), 0.f, .75f, HUD_DEBUG_TEXT_COLOR );
+        m_RenderStatsText.Render( *m_Context.renderer, Vec2( 2.f, 2.f ), 0.f, .75f, HUD_DEBUG_TEXT_COLOR );
     }
 }
 
@@ -990,16 +1721,26 @@ void Game::RenderLives() const
 void Game::CreateAstroidInArray( int x )
 {
     Vec3 startingPoint = Vec3::ZERO;
+    bool isTooCloseToShip = false;
     do
     {
-        startingPoint.x = m_Rng->FloatInRange( SAFEZONE, WORLD_SIZE_X - SAFEZONE );
-        startingPoint.y = m_Rng->FloatInRange( SAFEZONE, WORLD_SIZE_Y - SAFEZONE );
-    }
-    while( Vec3::GetDistance( startingPoint, m_PlayerShip->GetPosition() ) < CLOSEST_ASTEROID_SPAWN_TO_SHIP );
+        startingPoint.x = m_CameraMins.x + m_Rng->FloatInRange( SAFEZONE, SCREEN_SIZE_X - SAFEZONE );
+        startingPoint.y = m_CameraMins.y + m_Rng->FloatInRange( SAFEZONE, SCREEN_SIZE_Y - SAFEZONE );
 
-    m_Asteroids[ x ] = new Asteroid( this, startingPoint );
+        isTooCloseToShip = false;
+        for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+        {
+            const PlayerShip* playerShip = m_PlayerShips[ playerIndex ];
+            if( playerShip != nullptr &&
+                Vec3::GetDistance( startingPoint, playerShip->GetPosition() ) < CLOSEST_ASTEROID_SPAWN_TO_SHIP )
+            {
+                isTooCloseToShip = true;
+            }
+        }
+    }
+    while( isTooCloseToShip );
 
-    Entity* thisAstroid = m_Asteroids[ x ];
+    Entity* thisAstroid = m_AsteroidPool.Create<Asteroid>( x, this, startingPoint );
     thisAstroid->Create();
     float degree = m_Rng->FloatInRange( 0.f, 360.f );
     float angularVelocity = m_Rng->FloatInRange( -200.f, 200.f );
@@ -1012,6 +1753,7 @@ void Game::CreateDebrisClusterAt( const Vec3& position,
                                   float scale, int number,
                                   float lifeSpan )
 {
+    AddCounter( GAME_COUNTER_DEBRIS_CLUSTERS_REQUESTED );
     for( int debrisIndex = 0; debrisIndex < MAX_DEBRIS; ++debrisIndex )
     {
         if( number <= 0 ) { return; }
@@ -1019,146 +1761,267 @@ void Game::CreateDebrisClusterAt( const Vec3& position,
         Entity*& currentDebris = m_Debris[ debrisIndex ];
         if( currentDebris == nullptr )
         {
-            currentDebris = new Debris( this, position, color, lifeSpan );
+            currentDebris = m_DebrisPool.Create<Debris>( debrisIndex, this, position, color, lifeSpan );
             currentDebris->Create();
             // currentDebris->SetUniformScale( scale );
+            ScheduleExpiry( *currentDebris, ENTITY_KIND_DEBRIS, debrisIndex, lifeSpan );
+            PublishSpawn( ENTITY_KIND_DEBRIS, *currentDebris );
+            AddCounter( GAME_COUNTER_SPAWNS );
             number--;
         }
     }
+
+    if( number > 0 )
+    {
+        AddCounter( GAME_COUNTER_DEBRIS_CLUSTERS_TRUNCATED );
+    }
 }
 
 //-------------------------------------------------------------------------------
+// Everything a bullet or ship can hit goes in one grid; each bullet and live
+//  ship then tests only what shares its cell. Candidates come back in the
+//  same asteroid, beetle, wasp order the old full scans used.
+//
+//  Detection never changes the world, so every contact is found against the
+//  same state and the response pass sees them bullets first, in slot order,
+//  then ships. Detecting bullets in chunks and appending the chunks in order
+//  gives the same stream.
 void Game::PhysicsCollisions()
 {
-    for( int bulletIndex = 0; bulletIndex < MAX_BULLETS; ++bulletIndex )
+    BuildCollisionGrid();
+
+    m_Contacts.clear();
+    int narrowphaseTests = DetectBulletContacts( 0, MAX_BULLETS, m_Contacts );
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
     {
-        Entity*& currentBullet = m_Bullets[ bulletIndex ];
-        if( currentBullet != nullptr )
+        PlayerShip* playerShip = m_PlayerShips[ playerIndex ];
+        if( playerShip != nullptr && !playerShip->IsDead() )
         {
-            for( int asteroidIndex = 0; asteroidIndex < MAX_ASTEROIDS; ++asteroidIndex )
-            {
-                Entity*& currentAsteroid = m_Asteroids[ asteroidIndex ];
-                if( currentAsteroid != nullptr )
-                {
-                    if( currentAsteroid->OverlapsEntity( *currentBullet ) )
-                    {
-                        currentAsteroid->DamageEntity( 1 );
-                        currentBullet->DamageEntity( 1 );
-
-                        CreateDebrisClusterAt( currentAsteroid->GetPosition(),
-                                               ASTEROID_COLOR,
-                                               1.5f,
-                                               2,
-                                               .5f
-                                             );
-                    }
-                }
-            }
+            narrowphaseTests += DetectContacts( *playerShip, ENTITY_KIND_PLAYER_SHIP, m_Contacts );
+        }
+    }
+    AddCounter( GAME_COUNTER_NARROWPHASE_TESTS, narrowphaseTests );
 
-            for( int beetleIndex = 0; beetleIndex < MAX_BEETLES; ++beetleIndex )
-            {
-                Entity*& currentBeetle = m_Beetles[ beetleIndex ];
-                if( currentBeetle != nullptr )
-                {
-                    if( currentBeetle->OverlapsEntity( *currentBullet ) )
-                    {
-                        currentBeetle->DamageEntity( 1 );
-                        currentBullet->DamageEntity( 1 );
-
-                        CreateDebrisClusterAt( currentBeetle->GetPosition(),
-                                               BEETLE_COLOR,
-                                               1.f,
-                                               4,
-                                               .5f
-                                             );
-                    }
-                }
-            }
+    RespondToContacts();
+}
 
-            for( int waspIndex = 0; waspIndex < MAX_WASPS; ++waspIndex )
-            {
-                Entity*& currentWasp = m_Wasps[ waspIndex ];
-                if( currentWasp != nullptr )
-                {
-                    if( currentWasp->OverlapsEntity( *currentBullet ) )
-                    {
-                        currentWasp->DamageEntity( 1 );
-                        currentBullet->DamageEntity( 1 );
-
-                        CreateDebrisClusterAt( currentWasp->GetPosition(),
-                                               WASP_COLOR,
-                                               1.f,
-                                               4,
-                                               .5f
-                                             );
-                    }
-                }
-            }
+//-------------------------------------------------------------------------------
+void Game::BuildCollisionGrid()
+{
+    m_CollisionGrid.Clear();
+    for( int asteroidIndex = 0; asteroidIndex < MAX_ASTEROIDS; ++asteroidIndex )
+    {
+        if( m_Asteroids[ asteroidIndex ] != nullptr )
+        {
+            m_CollisionGrid.Insert( m_Asteroids[ asteroidIndex ], ENTITY_KIND_ASTEROID );
+        }
+    }
+    for( int beetleIndex = 0; beetleIndex < MAX_BEETLES; ++beetleIndex )
+    {
+        if( m_Beetles[ beetleIndex ] != nullptr )
+        {
+            m_CollisionGrid.Insert( m_Beetles[ beetleIndex ], ENTITY_KIND_BEETLE );
+        }
+    }
+    for( int waspIndex = 0; waspIndex < MAX_WASPS; ++waspIndex )
+    {
+        if( m_Wasps[ waspIndex ] != nullptr )
+        {
+            m_CollisionGrid.Insert( m_Wasps[ waspIndex ], ENTITY_KIND_WASP );
         }
     }
+    m_CollisionGrid.Build();
+}
 
-    if( m_PlayerShip != nullptr && !m_PlayerShip->IsDead() )
+//-------------------------------------------------------------------------------
+// Reads only the grid and the bullets in [firstBullet, endBullet), so
+//  disjoint ranges can be detected at the same time into separate lists.
+//  Returns the narrowphase tests run.
+int Game::DetectBulletContacts( int firstBullet,
+                                int endBullet,
+                                std::vector<ContactEvent>& outContacts ) const
+{
+    int narrowphaseTests = 0;
+    for( int bulletIndex = firstBullet; bulletIndex < endBullet; ++bulletIndex )
     {
-        // Player Asteroid Collision
-        for( int asteroidIndex = 0; asteroidIndex < MAX_ASTEROIDS; ++asteroidIndex )
+        Entity* currentBullet = m_Bullets[ bulletIndex ];
+        if( currentBullet != nullptr )
         {
-            Entity*& currentAsteroid = m_Asteroids[ asteroidIndex ];
-            if( currentAsteroid != nullptr && currentAsteroid->OverlapsEntity( *m_PlayerShip ) )
-            {
-                currentAsteroid->DamageEntity( 1 );
-                m_PlayerShip->DamageEntity( 1 );
-
-                CreateDebrisClusterAt( currentAsteroid->GetPosition(),
-                                       ASTEROID_COLOR,
-                                       1.5f,
-                                       2,
-                                       .5f
-                                     );
-            }
+            narrowphaseTests += DetectContacts( *currentBullet, ENTITY_KIND_BULLET, outContacts );
         }
+    }
+    return narrowphaseTests;
+}
 
-        // Player Beetle Collision
-        for( int beetleIndex = 0; beetleIndex < MAX_BEETLES; ++beetleIndex )
+//-------------------------------------------------------------------------------
+int Game::DetectContacts( Entity& entity,
+                          EntityKind kind,
+                          std::vector<ContactEvent>& outContacts ) const
+{
+    const CollisionCandidate* candidates = nullptr;
+    int candidateCount = m_CollisionGrid.GetCandidates( static_cast<Vec2>(entity.GetPosition()), &candidates );
+    for( int candidateIndex = 0; candidateIndex < candidateCount; ++candidateIndex )
+    {
+        Entity& target = *candidates[ candidateIndex ].entity;
+        if( target.OverlapsEntity( entity ) )
         {
-            Entity*& currentBeetle = m_Beetles[ beetleIndex ];
-            if( currentBeetle != nullptr && currentBeetle->OverlapsEntity( *m_PlayerShip ) )
-            {
-                currentBeetle->DamageEntity( 1 );
-                m_PlayerShip->DamageEntity( 1 );
-
-                CreateDebrisClusterAt( currentBeetle->GetPosition(),
-                                       BEETLE_COLOR,
-                                       1.f,
-                                       4,
-                                       .5f
-                                     );
-            }
+            ContactEvent contact;
+            contact.entityA = &entity;
+            contact.entityB = &target;
+            contact.point = (static_cast<Vec2>(entity.GetPosition()) + static_cast<Vec2>(target.GetPosition())) * .5f;
+            contact.type = MakeContactType( kind, static_cast<EntityKind>(candidates[ candidateIndex ].tag) );
+            outContacts.push_back( contact );
         }
+    }
+    return candidateCount;
+}
+
+//-------------------------------------------------------------------------------
+// Both sides take a point of damage and the target sheds a little debris.
+//  Only the contact that takes a target from alive to dead counts as a kill.
+void Game::RespondToContacts()
+{
+    AddCounter( GAME_COUNTER_HITS, static_cast<int>(m_Contacts.size()) );
+    for( const ContactEvent& contact : m_Contacts )
+    {
+        Entity& target = *contact.entityB;
+        bool wasTargetAlive = !target.IsDead();
+        target.DamageEntity( 1 );
+        contact.entityA->DamageEntity( 1 );
 
-        // Player Wasp Collision
-        for( int waspIndex = 0; waspIndex < MAX_WASPS; ++waspIndex )
+        GameHitEvent hit;
+        hit.type = contact.type;
+        hit.point = contact.point;
+        m_Events.Publish( hit );
+
+        if( wasTargetAlive && target.IsDead() )
         {
-            Entity*& currentWasp = m_Wasps[ waspIndex ];
-            if( currentWasp != nullptr && currentWasp->OverlapsEntity( *m_PlayerShip ) )
-            {
-                currentWasp->DamageEntity( 1 );
-                m_PlayerShip->DamageEntity( 1 );
-
-                CreateDebrisClusterAt( currentWasp->GetPosition(),
-                                       WASP_COLOR,
-                                       1.f,
-                                       4,
-                                       .5f
-                                     );
-            }
+            GameKillEvent kill;
+            kill.killedKind = GetContactTargetKind( contact.type );
+            kill.killerKind = GetContactQueryKind( contact.type );
+            kill.position = Vec2( target.GetPosition().x, target.GetPosition().y );
+            m_Events.Publish( kill );
+        }
+
+        switch( contact.type )
+        {
+            case CONTACT_TYPE_BULLET_ASTEROID:
+            case CONTACT_TYPE_SHIP_ASTEROID:
+                CreateDebrisClusterAt( target.GetPosition(), ASTEROID_COLOR, 1.5f, 2, .5f );
+                break;
+            case CONTACT_TYPE_BULLET_BEETLE:
+            case CONTACT_TYPE_SHIP_BEETLE:
+                CreateDebrisClusterAt( target.GetPosition(), BEETLE_COLOR, 1.f, 4, .5f );
+                break;
+            default:
+                CreateDebrisClusterAt( target.GetPosition(), WASP_COLOR, 1.f, 4, .5f );
+                break;
         }
     }
 }
 
+//-----------------------------------------------------------------------------
+void Game::PublishSpawn( EntityKind kind, const Entity& entity )
+{
+    GameSpawnEvent spawn;
+    spawn.kind = kind;
+    spawn.position = Vec2( entity.GetPosition().x, entity.GetPosition().y );
+    m_Events.Publish( spawn );
+}
+
+//-----------------------------------------------------------------------------
+int Game::GetExpiryClockTick() const
+{
+    return static_cast<int>(m_ExpiryClockSeconds / EXPIRY_CLOCK_TICK_SECONDS);
+}
+
+//-----------------------------------------------------------------------------
+// At least one, so nothing is retired on the tick it was scheduled
+static int GetExpiryLifetimeTicks( float lifetimeSeconds )
+{
+    int lifetimeTicks = static_cast<int>(ceil( static_cast<double>(lifetimeSeconds) / EXPIRY_CLOCK_TICK_SECONDS ));
+    return lifetimeTicks > 1 ? lifetimeTicks : 1;
+}
+
+//-----------------------------------------------------------------------------
+// The expiry tick lives on the entity too, so it is saved with it and a
+//  stale wheel entry for a reused slot can be told apart
+void Game::ScheduleExpiry( Entity& entity, EntityKind kind, int slotIndex, float lifetimeSeconds )
+{
+    ExpiryEntry entry;
+    entry.expiryTick = GetExpiryClockTick() + GetExpiryLifetimeTicks( lifetimeSeconds );
+    entry.slotIndex = slotIndex;
+    entry.kind = kind;
+
+    entity.SetExpiryTick( entry.expiryTick );
+    m_ExpiryWheel.Schedule( entry );
+}
 
 //-----------------------------------------------------------------------------
+// Only what is due this tick is touched. Entries whose entity already died
+//  (and maybe had its slot reused) no longer match and are dropped.
+void Game::ExpireEntities()
+{
+    m_ExpiredEntries.clear();
+    m_ExpiryWheel.Advance( GetExpiryClockTick(), m_ExpiredEntries );
+
+    for( const ExpiryEntry& entry : m_ExpiredEntries )
+    {
+        Entity* entity = entry.kind == ENTITY_KIND_BULLET ? m_Bullets[ entry.slotIndex ] : m_Debris[ entry.slotIndex ];
+        if( entity != nullptr && entity->GetExpiryTick() == entry.expiryTick )
+        {
+            entity->Expire();
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// After a restore the wheel is refilled from the expiry ticks the restored
+//  entities carry, so it matches the original exactly
+void Game::RebuildExpiryWheel()
+{
+    m_ExpiryWheel.Reset( GetExpiryClockTick() );
+
+    for( int bulletIndex = 0; bulletIndex < MAX_BULLETS; ++bulletIndex )
+    {
+        const Entity* bullet = m_Bullets[ bulletIndex ];
+        if( bullet != nullptr && bullet->GetExpiryTick() != 0 )
+        {
+            ExpiryEntry entry;
+            entry.expiryTick = bullet->GetExpiryTick();
+            entry.slotIndex = bulletIndex;
+            entry.kind = ENTITY_KIND_BULLET;
+            m_ExpiryWheel.Schedule( entry );
+        }
+    }
+
+    for( int debrisIndex = 0; debrisIndex < MAX_DEBRIS; ++debrisIndex )
+    {
+        const Entity* debris = m_Debris[ debrisIndex ];
+        if( debris != nullptr && debris->GetExpiryTick() != 0 )
+        {
+            ExpiryEntry entry;
+            entry.expiryTick = debris->GetExpiryTick();
+            entry.slotIndex = debrisIndex;
+            entry.kind = ENTITY_KIND_DEBRIS;
+            m_ExpiryWheel.Schedule( entry );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Every slot is visited here anyway, so this is also where the tick's live
+//  counts are taken
 void Game::DeleteGarbageEntities()
 {
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+    {
+        if( m_PlayerShips[ playerIndex ] != nullptr && !m_PlayerShips[ playerIndex ]->IsDead() )
+        {
+            AddCounter( GAME_COUNTER_LIVE_PLAYER_SHIPS );
+        }
+    }
+
     for( int astroidIndex = 0; astroidIndex < MAX_ASTEROIDS; ++astroidIndex )
     {
         Entity*& currentAsteroid = m_Asteroids[ astroidIndex ];
@@ -1167,8 +2030,12 @@ void Game::DeleteGarbageEntities()
             if( currentAsteroid->IsGarbage() )
             {
                 currentAsteroid->Destroy();
-                delete currentAsteroid;
-                currentAsteroid = nullptr;
+                m_AsteroidPool.Release( astroidIndex );
+                AddCounter( GAME_COUNTER_REMOVALS );
+            }
+            else
+            {
+                AddCounter( GAME_COUNTER_LIVE_ASTEROIDS );
             }
         }
     }
@@ -1181,8 +2048,12 @@ void Game::DeleteGarbageEntities()
             if( currentBullet->IsGarbage() )
             {
                 currentBullet->Destroy();
-                delete currentBullet;
-                currentBullet = nullptr;
+                m_BulletPool.Release( bulletIndex );
+                AddCounter( GAME_COUNTER_REMOVALS );
+            }
+            else
+            {
+                AddCounter( GAME_COUNTER_LIVE_BULLETS );
             }
         }
     }
@@ -1195,8 +2066,12 @@ void Game::DeleteGarbageEntities()
             if( currentDebris->IsGarbage() )
             {
                 currentDebris->Destroy();
-                delete currentDebris;
-                currentDebris = nullptr;
+                m_DebrisPool.Release( debrisIndex );
+                AddCounter( GAME_COUNTER_REMOVALS );
+            }
+            else
+            {
+                AddCounter( GAME_COUNTER_LIVE_DEBRIS );
             }
         }
     }
@@ -1209,8 +2084,12 @@ void Game::DeleteGarbageEntities()
             if( currentBeetle->IsGarbage() )
             {
                 currentBeetle->Destroy();
-                delete currentBeetle;
-                currentBeetle = nullptr;
+                m_BeetlePool.Release( beetleIndex );
+                AddCounter( GAME_COUNTER_REMOVALS );
+            }
+            else
+            {
+                AddCounter( GAME_COUNTER_LIVE_BEETLES );
             }
         }
     }
@@ -1223,8 +2102,12 @@ void Game::DeleteGarbageEntities()
             if( currentWasp->IsGarbage() )
             {
                 currentWasp->Destroy();
-                delete currentWasp;
-                currentWasp = nullptr;
+                m_WaspPool.Release( waspIndex );
+                AddCounter( GAME_COUNTER_REMOVALS );
+            }
+            else
+            {
+                AddCounter( GAME_COUNTER_LIVE_WASPS );
             }
         }
     }
@@ -1238,8 +2121,7 @@ void Game::DeleteAllEntities()
         if( currentAsteroid != nullptr )
         {
             currentAsteroid->Destroy();
-            delete currentAsteroid;
-            currentAsteroid = nullptr;
+            m_AsteroidPool.Release( astroidIndex );
         }
     }
 
@@ -1249,8 +2131,7 @@ void Game::DeleteAllEntities()
         if( currentBullet != nullptr )
         {
             currentBullet->Destroy();
-            delete currentBullet;
-            currentBullet = nullptr;
+            m_BulletPool.Release( bulletIndex );
         }
     }
 
@@ -1260,8 +2141,7 @@ void Game::DeleteAllEntities()
         if( currentDebris != nullptr )
         {
             currentDebris->Destroy();
-            delete currentDebris;
-            currentDebris = nullptr;
+            m_DebrisPool.Release( debrisIndex );
         }
     }
 
@@ -1271,8 +2151,7 @@ void Game::DeleteAllEntities()
         if( currentBeetle != nullptr )
         {
             currentBeetle->Destroy();
-            delete currentBeetle;
-            currentBeetle = nullptr;
+            m_BeetlePool.Release( beetleIndex );
         }
     }
 
@@ -1282,8 +2161,616 @@ void Game::DeleteAllEntities()
         if( currentWasp != nullptr )
         {
             currentWasp->Destroy();
-            delete currentWasp;
-            currentWasp = nullptr;
+            m_WaspPool.Release( waspIndex );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Parks what has left the sectors around the players and brings back what
+//  they came near. Runs after garbage is deleted so nothing parked is already
+//  dead, and sends no events: to the rest of the game a parked entity simply
+//  is not there. Parked time runs on the expiry clock, which stops with the
+//  world.
+void Game::StreamSectors()
+{
+    if( !m_Sectors.IsStreaming() )
+    {
+        return;
+    }
+
+    double startSeconds = GetCurrentTimeSeconds();
+
+    Vec2 anchors[ MAX_SECTOR_ANCHORS ];
+    int anchorCount = 0;
+    anchors[ anchorCount++ ] = GetCameraCenter();
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+    {
+        const PlayerShip* playerShip = m_PlayerShips[ playerIndex ];
+        if( playerShip != nullptr && !playerShip->IsDead() )
+        {
+            anchors[ anchorCount++ ] = static_cast<Vec2>(playerShip->GetPosition());
+        }
+    }
+    m_Sectors.UpdateActivity( anchors, anchorCount, m_Context.asteroidsWrapScreen );
+
+    ParkEntities( m_AsteroidPool, ENTITY_KIND_ASTEROID );
+    ParkEntities( m_BeetlePool, ENTITY_KIND_BEETLE );
+    ParkEntities( m_WaspPool, ENTITY_KIND_WASP );
+
+    m_Sectors.StepParked( static_cast<float>(m_ExpiryClockSeconds), m_Context.asteroidsWrapScreen );
+    for( int sectorIndex : m_Sectors.GetActiveSectors() )
+    {
+        UnparkSector( sectorIndex );
+    }
+
+    AddCounter( GAME_COUNTER_PARKED, m_Sectors.GetTotalParkedCount() );
+    m_LastStreamSeconds = GetCurrentTimeSeconds() - startSeconds;
+}
+
+//-----------------------------------------------------------------------------
+void Game::ParkEntities( EntityPool& pool, EntityKind kind )
+{
+    for( int entityIndex = 0; entityIndex < pool.GetSlotCount(); ++entityIndex )
+    {
+        Entity* currentEntity = pool.GetEntity( entityIndex );
+        if( currentEntity == nullptr ||
+            currentEntity->IsDead() ||
+            m_Sectors.IsKeptAt( static_cast<Vec2>(currentEntity->GetPosition()) ) )
+        {
+            continue;
+        }
+
+        EntityState state;
+        EntityShapeState shape;
+        memset( static_cast<void*>(&state), 0, sizeof( EntityState ) );
+        memset( static_cast<void*>(&shape), 0, sizeof( EntityShapeState ) );
+        currentEntity->SaveState( state );
+        currentEntity->SaveShape( shape );
+        state.kind = kind;
+
+        SectorEntity record;
+        PackSectorEntity( state, shape.cornerCount > 0 ? &shape : nullptr, static_cast<float>(m_ExpiryClockSeconds), record );
+        m_Sectors.Park( record );
+
+        // Only the asteroid's Destroy() is pure cleanup; a wasp's would leave
+        //  debris behind out where nobody can see it
+        if( kind == ENTITY_KIND_ASTEROID )
+        {
+            currentEntity->Destroy();
+        }
+        pool.Release( entityIndex );
+        AddCounter( GAME_COUNTER_PARKS );
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Walks the sector backwards so RemoveParked only ever swaps in a record that
+//  was already looked at. A record with no free slot for its kind waits for
+//  a later tick.
+void Game::UnparkSector( int sectorIndex )
+{
+    for( int recordIndex = m_Sectors.GetParkedCount( sectorIndex ) - 1; recordIndex >= 0; --recordIndex )
+    {
+        const SectorEntity& record = m_Sectors.GetParked( sectorIndex, recordIndex );
+
+        EntityPool* pool = &m_AsteroidPool;
+        if( record.kind == ENTITY_KIND_BEETLE )
+        {
+            pool = &m_BeetlePool;
+        }
+        else if( record.kind == ENTITY_KIND_WASP )
+        {
+            pool = &m_WaspPool;
+        }
+
+        int freeIndex = 0;
+        while( freeIndex < pool->GetSlotCount() && pool->GetEntity( freeIndex ) != nullptr )
+        {
+            freeIndex++;
+        }
+        if( freeIndex == pool->GetSlotCount() )
+        {
+            continue;
+        }
+
+        EntityState state = m_SectorDefaults[ record.kind ];
+        EntityShapeState shape;
+        memset( static_cast<void*>(&shape), 0, sizeof( EntityShapeState ) );
+        UnpackSectorEntity( record, state, shape );
+
+        Entity* entity = CreateEntityForRestore( *pool, freeIndex, record.kind, state.position );
+        entity->LoadState( state );
+        if( shape.cornerCount > 0 )
+        {
+            entity->LoadShape( shape );
+        }
+
+        m_Sectors.RemoveParked( sectorIndex, recordIndex );
+        AddCounter( GAME_COUNTER_UNPARKS );
+    }
+}
+
+//-----------------------------------------------------------------------------
+// A streamed world starts with asteroids scattered over every sector away
+//  from the players. They come from a generator of their own so the game's
+//  stream, and everything a one sector game rolls from it, is untouched.
+void Game::PopulateSectors()
+{
+    m_Sectors.Clear();
+    if( !m_Sectors.IsStreaming() )
+    {
+        return;
+    }
+
+    RandomNumberGenerator fieldRng( m_Context.rngSeed );
+    m_Sectors.Populate( fieldRng,
+                        SECTOR_FIELD_ASTEROIDS,
+                        m_SectorDefaults[ ENTITY_KIND_ASTEROID ],
+                        static_cast<Vec2>(GetPlayerSpawnPosition( 0 )),
+                        0.f );
+}
+
+//-----------------------------------------------------------------------------
+void Game::CaptureWorldState( WorldState& outState ) const
+{
+    // Zero first so padding and empty slots are identical between captures
+    memset( static_cast<void*>(&outState), 0, sizeof( WorldState ) );
+
+    WorldStateHeader& header = outState.header;
+    header.magic = WORLD_STATE_MAGIC;
+    header.version = WORLD_STATE_VERSION;
+    header.stateBytes = sizeof( WorldState );
+
+    header.playerShipDestroyedTime = m_PlayerShipDestroyedTime;
+    header.expiryClockSeconds = m_ExpiryClockSeconds;
+    header.gameTime = m_GameTime;
+    header.currentScreenShakePercentage = m_CurrentScreenShakePercentage;
+    header.titleTime = m_TitleTime;
+    header.lastColorChangeTime = m_LastColorChangeTime;
+    header.titleColor = m_TitleColor;
+    header.playerShipCurrentLife = m_PlayerShipCurrentLife;
+    header.waveNumber = m_WaveNumber;
+    header.explosionLightCount = static_cast<int>(m_ExplosionLights.size());
+    header.spawnNextWave = m_SpawnNextWave;
+    header.isAttractMode = m_IsAttractMode;
+    header.wasJustAttractMode = m_WasJustAttractMode;
+    memcpy( header.rng, m_Rng, sizeof( RandomNumberGenerator ) );
+
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+    {
+        if( m_PlayerShips[ playerIndex ] != nullptr )
+        {
+            m_PlayerShips[ playerIndex ]->SaveState( outState.playerShips[ playerIndex ] );
+            outState.playerShips[ playerIndex ].kind = ENTITY_KIND_PLAYER_SHIP;
+        }
+    }
+
+    CaptureEntities( m_Asteroids, outState.asteroids, outState.asteroidShapes, MAX_ASTEROIDS, ENTITY_KIND_ASTEROID );
+    CaptureEntities( m_Bullets, outState.bullets, nullptr, MAX_BULLETS, ENTITY_KIND_BULLET );
+    CaptureEntities( m_Debris, outState.debris, outState.debrisShapes, MAX_DEBRIS, ENTITY_KIND_DEBRIS );
+    CaptureEntities( m_Beetles, outState.beetles, nullptr, MAX_BEETLES, ENTITY_KIND_BEETLE );
+    CaptureEntities( m_Wasps, outState.wasps, nullptr, MAX_WASPS, ENTITY_KIND_WASP );
+
+    if( !m_ExplosionLights.empty() )
+    {
+        memcpy( outState.explosionLights, m_ExplosionLights.data(), m_ExplosionLights.size() * sizeof( ExplosionLightState ) );
+    }
+}
+
+//-----------------------------------------------------------------------------
+void Game::RestoreWorldState( const WorldState& state )
+{
+    const WorldStateHeader& header = state.header;
+    if( header.magic != WORLD_STATE_MAGIC ||
+        header.version != WORLD_STATE_VERSION ||
+        header.stateBytes != sizeof( WorldState ) )
+    {
+        ErrorRecoverable( "WorldState does not match this build; ignoring restore" );
+        return;
+    }
+
+    // Removing entities can feed back into the game (a wasp leaves debris and
+    //  shakes the screen, an asteroid lights its explosion), so debris, rng,
+    //  lights and the header are written last to overwrite anything those
+    //  side effects touched. The spawn events and
+    //  counters they raise never happened either; a mirror game, which never
+    //  dispatches or flushes, would otherwise pile them up forever.
+    float controllerLeftVibration = m_CurrentControllerLeftVibration;
+    float controllerRightVibration = m_CurrentControllerRightVibration;
+    int queuedEventCount = m_Events.GetQueuedCount();
+    GameCounterFrame counters = m_Counters;
+
+    RestoreEntities( m_AsteroidPool, state.asteroids, state.asteroidShapes );
+    RestoreEntities( m_BulletPool, state.bullets, nullptr );
+    RestoreEntities( m_BeetlePool, state.beetles, nullptr );
+    RestoreEntities( m_WaspPool, state.wasps, nullptr );
+    RestorePlayerShips( state.playerShips );
+    UpdateCameraFocus();
+    MoveSpatialGrids();
+    m_NearestPlayerGrid.Build( m_PlayerShips, MAX_PLAYERS );     // May hold ships that were just deleted
+    RestoreEntities( m_DebrisPool, state.debris, state.debrisShapes );
+
+    m_PlayerShipDestroyedTime = header.playerShipDestroyedTime;
+    m_ExpiryClockSeconds = header.expiryClockSeconds;
+    m_GameTime = header.gameTime;
+    m_CurrentScreenShakePercentage = header.currentScreenShakePercentage;
+    m_TitleTime = header.titleTime;
+    m_LastColorChangeTime = header.lastColorChangeTime;
+    m_TitleColor = header.titleColor;
+    m_PlayerShipCurrentLife = header.playerShipCurrentLife;
+    m_WaveNumber = header.waveNumber;
+    m_SpawnNextWave = header.spawnNextWave;
+    m_IsAttractMode = header.isAttractMode;
+    m_WasJustAttractMode = header.wasJustAttractMode;
+    memcpy( m_Rng, header.rng, sizeof( RandomNumberGenerator ) );
+
+    m_CurrentControllerLeftVibration = controllerLeftVibration;
+    m_CurrentControllerRightVibration = controllerRightVibration;
+    m_Events.DiscardEventsAfter( queuedEventCount );
+    m_Counters = counters;
+
+    int explosionLightCount = header.explosionLightCount < MAX_EXPLOSION_LIGHTS ? header.explosionLightCount : MAX_EXPLOSION_LIGHTS;
+    m_ExplosionLights.assign( state.explosionLights, state.explosionLights + (explosionLightCount > 0 ? explosionLightCount : 0) );
+
+    // Anything the removals above scheduled is gone again with this
+    RebuildExpiryWheel();
+}
+
+//-----------------------------------------------------------------------------
+// Only the counts and the entries below them are written; the rest of the
+//  snapshot keeps whatever an older frame left there
+void Game::CaptureRenderSnapshot( RenderSnapshot& outSnapshot ) const
+{
+    outSnapshot.gameTime = m_GameTime;
+    outSnapshot.cameraMins = m_CameraMins;
+    outSnapshot.screenShakeOffset = m_ScreenShakeOffset;
+    outSnapshot.titleColor = m_TitleColor;
+    outSnapshot.titleRotation = m_TitleRotaiton;
+    outSnapshot.titleScale = m_TitleScale;
+    outSnapshot.playerShipCurrentLife = m_PlayerShipCurrentLife;
+    outSnapshot.waveNumber = m_WaveNumber;
+    outSnapshot.isAttractMode = m_IsAttractMode;
+    outSnapshot.entityCount = 0;
+    outSnapshot.shapeCount = 0;
+
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+    {
+        const PlayerShip* playerShip = m_PlayerShips[ playerIndex ];
+        if( playerShip == nullptr || playerShip->IsDead() )
+        {
+            continue;
+        }
+
+        RenderEntityState& state = outSnapshot.entities[ outSnapshot.entityCount++ ];
+        playerShip->SaveRenderState( state );
+        state.kind = ENTITY_KIND_PLAYER_SHIP;
+    }
+
+    CaptureRenderEntities( m_Asteroids, MAX_ASTEROIDS, ENTITY_KIND_ASTEROID, outSnapshot );
+    CaptureRenderEntities( m_Bullets, MAX_BULLETS, ENTITY_KIND_BULLET, outSnapshot );
+    CaptureRenderEntities( m_Debris, MAX_DEBRIS, ENTITY_KIND_DEBRIS, outSnapshot );
+    CaptureRenderEntities( m_Beetles, MAX_BEETLES, ENTITY_KIND_BEETLE, outSnapshot );
+    CaptureRenderEntities( m_Wasps, MAX_WASPS, ENTITY_KIND_WASP, outSnapshot );
+
+    int explosionLightCount = static_cast<int>(m_ExplosionLights.size());
+    outSnapshot.explosionLightCount = explosionLightCount < MAX_EXPLOSION_LIGHTS ? explosionLightCount : MAX_EXPLOSION_LIGHTS;
+    if( outSnapshot.explosionLightCount > 0 )
+    {
+        memcpy( outSnapshot.explosionLights, m_ExplosionLights.data(), outSnapshot.explosionLightCount * sizeof( ExplosionLightState ) );
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Only what the HUD, camera and lighting read is copied over; the entities
+//  are drawn from the snapshot itself
+void Game::ShowRenderSnapshot( const RenderSnapshot* snapshot )
+{
+    m_RenderSnapshot = snapshot;
+    if( snapshot == nullptr )
+    {
+        return;
+    }
+
+    m_GameTime = snapshot->gameTime;
+    m_CameraMins = snapshot->cameraMins;
+    m_ScreenShakeOffset = snapshot->screenShakeOffset;
+    m_TitleColor = snapshot->titleColor;
+    m_TitleRotaiton = snapshot->titleRotation;
+    m_TitleScale = snapshot->titleScale;
+    m_PlayerShipCurrentLife = snapshot->playerShipCurrentLife;
+    m_WaveNumber = snapshot->waveNumber;
+    m_IsAttractMode = snapshot->isAttractMode;
+    m_ExplosionLights.assign( snapshot->explosionLights, snapshot->explosionLights + snapshot->explosionLightCount );
+}
+
+//-----------------------------------------------------------------------------
+// What a freshly constructed entity of this kind would save, for filling in
+//  fields a state source (like the network) does not carry. Built on the
+//  stack, since the pools' slots belong to the live world.
+void Game::BuildDefaultEntityState( EntityKind kind, EntityState& outState )
+{
+    memset( static_cast<void*>(&outState), 0, sizeof( EntityState ) );
+
+    switch( kind )
+    {
+        case ENTITY_KIND_PLAYER_SHIP:   PlayerShip( this, Vec3::ZERO ).SaveState( outState ); break;
+        case ENTITY_KIND_ASTEROID:      Asteroid( this, Vec3::ZERO ).SaveState( outState ); break;
+        case ENTITY_KIND_BULLET:        Bullet( this, Vec3::ZERO ).SaveState( outState ); break;
+        case ENTITY_KIND_DEBRIS:        Debris( this, Vec3::ZERO ).SaveState( outState ); break;
+        case ENTITY_KIND_BEETLE:        Beetle( this, Vec3::ZERO ).SaveState( outState ); break;
+        case ENTITY_KIND_WASP:          Wasp( this, Vec3::ZERO ).SaveState( outState ); break;
+        default:                        return;
+    }
+    outState.kind = kind;
+}
+
+//-----------------------------------------------------------------------------
+bool Game::SaveWorld( const char* filePath )
+{
+    CaptureWorldState( *m_SnapshotScratch );
+    if( !WriteWorldStateFile( filePath, *m_SnapshotScratch ) )
+    {
+        ErrorRecoverable( "Failed to write world file" );
+        return false;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool Game::LoadWorld( const char* filePath )
+{
+    if( !TryLoadWorld( filePath ) )
+    {
+        ErrorRecoverable( "Failed to load world file; missing or written by another build" );
+        return false;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// The scenario is generated on first use and loaded from disk every time after,
+//  so each benchmark run cold starts from identical bytes at full load
+void Game::LoadBulletStormScenario()
+{
+    if( TryLoadWorld( BULLET_STORM_SCENARIO_FILE_PATH ) )
+    {
+        return;
+    }
+
+    if( !WriteBulletStormScenario( BULLET_STORM_SCENARIO_FILE_PATH ) )
+    {
+        ErrorRecoverable( "Failed to write bullet storm scenario" );
+        return;
+    }
+    LoadWorld( BULLET_STORM_SCENARIO_FILE_PATH );
+}
+
+//-----------------------------------------------------------------------------
+bool Game::TryLoadWorld( const char* filePath )
+{
+    MappedWorldStateFile worldFile;
+    if( !worldFile.Open( filePath ) )
+    {
+        return false;
+    }
+
+    RestoreWorldState( *worldFile.GetState() );
+
+    // History from before the load does not lead to this world, and neither
+    //  does anything parked out of it; the file holds only what was live
+    m_Snapshots.Clear();
+    m_Sectors.Clear();
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Current world with every bullet slot filled, scattered over the screen and
+//  flying in random directions. Each bullet is stamped with a full lifetime
+//  from the saved clock, as if just fired, so the storm clears itself.
+bool Game::WriteBulletStormScenario( const char* filePath )
+{
+    WorldState& state = *m_SnapshotScratch;
+    CaptureWorldState( state );
+
+    state.header.isAttractMode = false;
+    state.header.wasJustAttractMode = false;
+    state.header.spawnNextWave = false;
+
+    // Saved from a real bullet so every slot carries the constructor defaults
+    EntityState bulletTemplate;
+    memset( static_cast<void*>(&bulletTemplate), 0, sizeof( EntityState ) );
+    Bullet templateBullet( this, Vec3::ZERO );
+    templateBullet.SaveState( bulletTemplate );
+    bulletTemplate.kind = ENTITY_KIND_BULLET;
+    bulletTemplate.expiryTick = static_cast<int>(state.header.expiryClockSeconds / EXPIRY_CLOCK_TICK_SECONDS) +
+                                GetExpiryLifetimeTicks( BULLET_LIFETIME_SECONDS );
+
+    for( int bulletIndex = 0; bulletIndex < MAX_BULLETS; ++bulletIndex )
+    {
+        EntityState& bullet = state.bullets[ bulletIndex ];
+        bullet = bulletTemplate;
+
+        float degrees = m_Rng->FloatLessThan( 360.f );
+        bullet.position = Vec3( m_Rng->FloatInRange( 0.f, SCREEN_SIZE_X ),
+                                m_Rng->FloatInRange( 0.f, SCREEN_SIZE_Y ),
+                                0.f );
+        bullet.angleDegrees = degrees;
+        bullet.velocity = Vec3::MakeFromPolarDegreesXY( degrees, BULLET_SPEED );
+    }
+
+    return WriteWorldStateFile( filePath, state );
+}
+
+//-----------------------------------------------------------------------------
+void Game::CaptureSnapshot()
+{
+    if( !m_Context.keepsRewindHistory )
+    {
+        return;
+    }
+
+    double startSeconds = GetCurrentTimeSeconds();
+
+    {
+        NoAllocationScope noAllocation( "Game::CaptureSnapshot" );
+        CaptureWorldState( *m_SnapshotScratch );
+        m_Snapshots.Push( m_SnapshotScratch );
+    }
+
+    m_LastSnapshotSeconds = GetCurrentTimeSeconds() - startSeconds;
+    if( m_LastSnapshotSeconds > m_PeakSnapshotSeconds )
+    {
+        m_PeakSnapshotSeconds = m_LastSnapshotSeconds;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Steps are cheap (one delta decode each), the restore is paid once at the end
+void Game::RewindSnapshots( int ticks )
+{
+    bool steppedBack = false;
+    for( int tickIndex = 0; tickIndex < ticks; ++tickIndex )
+    {
+        if( !m_Snapshots.StepBack( m_SnapshotScratch ) )
+        {
+            break;
+        }
+        steppedBack = true;
+    }
+
+    if( steppedBack )
+    {
+        RestoreWorldState( *m_SnapshotScratch );
+    }
+}
+
+//-----------------------------------------------------------------------------
+void Game::CaptureEntities( const Entity* const* entities,
+                            EntityState* outStates,
+                            EntityShapeState* outShapes,
+                            int entitiesSize,
+                            EntityKind kind ) const
+{
+    for( int entityIndex = 0; entityIndex < entitiesSize; ++entityIndex )
+    {
+        const Entity* const& currentEntity = entities[ entityIndex ];
+        if( currentEntity == nullptr )
+        {
+            continue;
+        }
+
+        currentEntity->SaveState( outStates[ entityIndex ] );
+        outStates[ entityIndex ].kind = kind;
+        if( outShapes != nullptr )
+        {
+            currentEntity->SaveShape( outShapes[ entityIndex ] );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void Game::CaptureRenderEntities( const Entity* const* entities,
+                                  int entitiesSize,
+                                  EntityKind kind,
+                                  RenderSnapshot& outSnapshot ) const
+{
+    const bool hasShape = kind == ENTITY_KIND_ASTEROID || kind == ENTITY_KIND_DEBRIS;
+    for( int entityIndex = 0; entityIndex < entitiesSize; ++entityIndex )
+    {
+        const Entity* const& currentEntity = entities[ entityIndex ];
+        if( currentEntity == nullptr )
+        {
+            continue;
+        }
+
+        RenderEntityState& state = outSnapshot.entities[ outSnapshot.entityCount++ ];
+        currentEntity->SaveRenderState( state );
+        state.kind = kind;
+        if( hasShape )
+        {
+            state.shapeIndex = static_cast<short>(outSnapshot.shapeCount);
+            currentEntity->SaveShape( outSnapshot.shapes[ outSnapshot.shapeCount++ ] );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Entities made here skip Create(); everything Create() would roll comes
+//  from the saved state and shape instead
+Entity* Game::CreateEntityForRestore( EntityPool& pool, int slotIndex, EntityKind kind, const Vec3& position )
+{
+    switch( kind )
+    {
+        case ENTITY_KIND_ASTEROID:      return pool.Create<Asteroid>( slotIndex, this, position );
+        case ENTITY_KIND_BULLET:        return pool.Create<Bullet>( slotIndex, this, position );
+        case ENTITY_KIND_DEBRIS:        return pool.Create<Debris>( slotIndex, this, position );
+        case ENTITY_KIND_BEETLE:        return pool.Create<Beetle>( slotIndex, this, position );
+        case ENTITY_KIND_WASP:          return pool.Create<Wasp>( slotIndex, this, position );
+        default:                        return nullptr;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Ships keep their slot as their player index, so they are made here rather
+//  than through CreateEntityForRestore
+void Game::RestorePlayerShips( const EntityState* states )
+{
+    m_PlayerCount = 0;
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+    {
+        PlayerShip*& playerShip = m_PlayerShips[ playerIndex ];
+        const EntityState& shipState = states[ playerIndex ];
+
+        if( shipState.kind != ENTITY_KIND_PLAYER_SHIP )
+        {
+            delete playerShip;
+            playerShip = nullptr;
+            continue;
+        }
+
+        if( playerShip == nullptr )
+        {
+            playerShip = new PlayerShip( this, shipState.position, playerIndex );
+        }
+        playerShip->LoadState( shipState );
+        m_PlayerCount = playerIndex + 1;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void Game::RestoreEntities( EntityPool& pool,
+                            const EntityState* states,
+                            const EntityShapeState* shapes )
+{
+    for( int entityIndex = 0; entityIndex < pool.GetSlotCount(); ++entityIndex )
+    {
+        Entity* currentEntity = pool.GetEntity( entityIndex );
+        const EntityState& entityState = states[ entityIndex ];
+
+        if( entityState.kind == ENTITY_KIND_NONE )
+        {
+            if( currentEntity != nullptr )
+            {
+                currentEntity->Destroy();
+                pool.Release( entityIndex );
+            }
+            continue;
+        }
+
+        if( currentEntity == nullptr )
+        {
+            currentEntity = CreateEntityForRestore( pool, entityIndex, entityState.kind, entityState.position );
+            if( currentEntity == nullptr )
+            {
+                continue;
+            }
+        }
+
+        currentEntity->LoadState( entityState );
+        if( shapes != nullptr )
+        {
+            currentEntity->LoadShape( shapes[ entityIndex ] );
         }
     }
 }
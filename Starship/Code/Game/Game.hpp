@@ -3,9 +3,27 @@
 #include "Engine/Core/Rgba8.hpp"
 
 class Camera;
+struct RenderSnapshot;
 struct Vec3;
 
+#include "Game/BotPilot.hpp"
+#include "Game/CollisionGrid.hpp"
+#include "Game/ContactEvent.hpp"
+#include "Game/DebugRenderBatch.hpp"
+#include "Game/EntityPool.hpp"
+#include "Game/ExpiryWheel.hpp"
+#include "Game/GameEventQueue.hpp"
+#include "Game/GameCounters.hpp"
 #include "Game/GameCommon.hpp"
+#include "Game/GameContext.hpp"
+#include "Game/NearestPlayerGrid.hpp"
+#include "Game/PlayerInput.hpp"
+#include "Game/StateSnapshotRing.hpp"
+#include "Game/TileLightBinner.hpp"
+#include "Game/VectorFont.hpp"
+#include "Game/VectorText.hpp"
+#include "Game/WorldSectors.hpp"
+#include "Game/WorldState.hpp"
 
 
 class Entity;
@@ -17,16 +35,20 @@ class Debris;
 class Game
 {
 public:
-    Game();
+    explicit Game( const GameContext& context );
     ~Game();
 
-    void Startup();
+    void Startup( int playerCount = 1 );
+    void Reset( unsigned int rngSeed );
     void Update( float deltaSeconds );
+    void UpdateAsClient( float deltaSeconds );
+    float SimulateTick( float deltaSeconds );
     void Render() const;
     void Shutdown();
 
     
     RandomNumberGenerator* GetRng();
+    const GameContext& GetContext() const { return m_Context; }
 
     bool RequestSpawnAstroid();
     bool RequestSpawnBeetle();
@@ -37,8 +59,69 @@ public:
     void AddControllerVibration( int contollerId,
                                  float leftVibrationPercent,
                                  float rightVibrationPercent );
-
-    const PlayerShip* GetAlivePlayer() const;
+    void AddExplosionLight( const Vec2& position, const Rgba8& color, float radius, float intensity );
+
+    int GetPlayerCount() const { return m_PlayerCount; }
+    int GetWaveNumber() const { return m_WaveNumber; }
+    int GetLivesUsed() const { return m_PlayerShipCurrentLife; }
+    bool IsAttractMode() const { return m_IsAttractMode; }
+    const PlayerShip* GetPlayerShip( int playerIndex ) const;
+    const PlayerShip* GetNearestAlivePlayer( const Vec3& position ) const;
+    Vec3 GetPlayerSpawnPosition( int playerIndex ) const;
+
+    // The screen unless the context asks for more sectors
+    const Vec2& GetWorldSize() const { return m_Sectors.GetWorldSize(); }
+    const WorldSectors& GetSectors() const { return m_Sectors; }
+    Vec2 GetCameraCenter() const { return m_CameraMins + Vec2( SCREEN_CENTER_X, SCREEN_CENTER_Y ); }
+
+    void SetPlayerInput( int playerIndex, const PlayerInput& input );
+    const PlayerInput& GetPlayerInput( int playerIndex ) const;
+    void SetPlayerPilot( int playerIndex, PlayerPilot* pilot );
+    bool IsDemo() const { return m_IsDemo; }
+
+    int GetEnemiesInDisc( const Vec3& center,
+                          float radius,
+                          const Entity** outEnemies,
+                          int maxEnemies ) const;
+    const Entity* GetNearestEnemy( const Vec3& position ) const;
+
+    // What the last tick's collision detection found, in response order;
+    //  see ContactEvent for how long the entity pointers last
+    const std::vector<ContactEvent>& GetContacts() const { return m_Contacts; }
+
+    // Spawns, hits and kills, dispatched together at the end of each
+    //  SimulateTick. A rollback peer dispatches its resimulated ticks again.
+    GameEventQueue& GetEvents() { return m_Events; }
+
+    // Explosion lights as the tiled lit shader reads them, rebinned over the
+    //  game camera by every Render
+    const std::vector<TileLight>& GetTileLights() const { return m_TileLights; }
+    const TileLightBinner& GetLightBinner() const { return m_LightBinner; }
+
+    void SetNetStatsText( const char* text );
+    void SetThreadStatsText( const char* text );
+    void SetPacerStatsText( const char* text );
+
+    // Const so render paths can count what they submit
+    void AddCounter( GameCounter counter, int amount = 1 ) const { m_Counters.values[ counter ] += amount; }
+    void CountDraw( int vertexCount ) const;
+
+    int GetEntitiesDrawnLastFrame() const { return m_EntitiesDrawnThisFrame; }
+    int GetEntitiesCulledLastFrame() const { return m_EntitiesCulledThisFrame; }
+
+    void CaptureWorldState( WorldState& outState ) const;
+    void RestoreWorldState( const WorldState& state );
+    void BuildDefaultEntityState( EntityKind kind, EntityState& outState );
+
+    // For a renderer running apart from the simulation: the capturing game
+    //  packs what is alive, and the showing game draws that instead of its
+    //  own entities until handed null. The snapshot has to outlive the frame.
+    void CaptureRenderSnapshot( RenderSnapshot& outSnapshot ) const;
+    void ShowRenderSnapshot( const RenderSnapshot* snapshot );
+
+    bool SaveWorld( const char* filePath );
+    bool LoadWorld( const char* filePath );
+    void LoadBulletStormScenario();
 
     void CreateDebrisClusterAt( const Vec3& position,
                                 const Rgba8& color,
@@ -47,19 +130,62 @@ public:
                                 float lifeSpan = MAX_DEBRIS_LIFESPAN );
 
 private:
-    Camera* m_GameCamera = nullptr;
+    GameContext m_Context;
+    Camera* m_GameCamera = nullptr;         // Null when headless, like m_UICamera
+
     Camera* m_UICamera = nullptr;
     RandomNumberGenerator* m_Rng = nullptr;
 
-    PlayerShip* m_PlayerShip = nullptr;
+    PlayerShip* m_PlayerShips[ MAX_PLAYERS ] = { nullptr };
+    int m_PlayerCount = 0;
     Entity* m_Bullets[ MAX_BULLETS ] = { nullptr };
     Entity* m_Asteroids[ MAX_ASTEROIDS ] = { nullptr };
     Entity* m_Debris[ MAX_DEBRIS ] = { nullptr };
     Entity* m_Beetles[ MAX_BEETLES ] = { nullptr };
     Entity* m_Wasps[ MAX_WASPS ] = { nullptr };
 
+    // Where the entities in the arrays above live; see EntityPool
+    EntityPool m_BulletPool;
+    EntityPool m_AsteroidPool;
+    EntityPool m_DebrisPool;
+    EntityPool m_BeetlePool;
+    EntityPool m_WaspPool;
+
     float m_GameTime = 0.f;
 
+    // Everything outside the sectors around the players waits here. Parked
+    //  records are not part of the WorldState, which only carries the live
+    //  arrays, so a streamed world has no rewind and does not replicate.
+    WorldSectors m_Sectors;
+    EntityState m_SectorDefaults[ ENTITY_KIND_COUNT ];     // What a parked record unpacks over
+    Vec2 m_CameraMins = Vec2( 0.f, 0.f );                   // Follows the ships, kept inside the world
+    double m_LastStreamSeconds = 0.0;
+
+    PlayerInput m_PlayerInputs[ MAX_PLAYERS ];
+    PlayerPilot* m_PlayerPilots[ MAX_PLAYERS ] = { nullptr };   // Not owned; null flies from local devices
+
+    // Attract mode hands the ships to bots after a while with no one playing
+    BotPilot m_DemoPilots[ MAX_PLAYERS ];
+    bool m_IsDemo = false;
+    float m_AttractIdleSeconds = 0.f;
+
+    // Rebuilt every tick: who each enemy chases, and what can hit what
+    NearestPlayerGrid m_NearestPlayerGrid;
+    CollisionGrid m_CollisionGrid;
+    std::vector<ContactEvent> m_Contacts;
+
+    // Bullets and debris are retired by lifetime from here, not by polling
+    //  their ages. The clock only runs while the world does.
+    ExpiryWheel m_ExpiryWheel;
+    std::vector<ExpiryEntry> m_ExpiredEntries;
+    double m_ExpiryClockSeconds = 0.0;
+
+    GameEventQueue m_Events;
+
+    std::vector<ExplosionLightState> m_ExplosionLights;        // Saved with the world
+    mutable std::vector<TileLight> m_TileLights;
+    mutable TileLightBinner m_LightBinner;
+
     Rgba8 m_TitleColor = Rgba8::RED;
     float m_TitleRotaiton = 0.f;
     float m_TitleScale = 3.f;
@@ -82,12 +208,57 @@ private:
     float m_SlowMoPercentage = .1f;
 
     float m_CurrentScreenShakePercentage = 0.f;
+    Vec2 m_ScreenShakeOffset = Vec2( 0.f, 0.f );    // This tick's shake, on top of m_CameraMins
     float m_CurrentControllerLeftVibration = 0.f;
     float m_CurrentControllerRightVibration = 0.f;
 
+    mutable DebugRenderBatch m_DebugBatch;
+
+    mutable GameCounterFrame m_Counters;
+    bool m_HasCounterFrame = false;
+
+    mutable int m_EntitiesDrawnThisFrame = 0;
+    mutable int m_EntitiesCulledThisFrame = 0;
+    const RenderSnapshot* m_RenderSnapshot = nullptr;      // Not owned; see ShowRenderSnapshot
+
+    VectorFont m_TitleFont;
+    VectorFont m_HudFont;
+    VectorText m_TitleText;
+    VectorText m_WaveText;
+    VectorText m_FrameTimeText;
+    VectorText m_RenderStatsText;
+    VectorText m_SnapshotStatsText;
+    VectorText m_NetStatsText;
+    VectorText m_ThreadStatsText;
+    VectorText m_PacerStatsText;
+    VectorText m_AllocationStatsText;
+    VectorText m_InputStatsText;
+    VectorText m_LightStatsText;
+    VectorText m_SectorStatsText;
+    float m_InputStatsSeconds = 0.f;
+    VectorText m_DemoText;
+    float m_SmoothedFrameSeconds = 0.f;
+
+    // Rewind history; m_SnapshotScratch is the one full WorldState reused for
+    //  every capture and restore
+    StateSnapshotRing m_Snapshots;
+    WorldState* m_SnapshotScratch = nullptr;
+    double m_LastSnapshotSeconds = 0.0;
+    double m_PeakSnapshotSeconds = 0.0;
+
+    std::vector<VertexMaster> m_LifeIconVisual;
+    std::vector<VertexMaster> m_LivesVisual;
+    int m_LivesVisualCount = -1;
+
     void DebugRender() const;
+    AABB2 GetGameCameraBounds() const;
+    void UpdateCameraFocus();
+    void MoveSpatialGrids();
 
     void HandleUserInput();
+    void UpdateDemo( float deltaSeconds );
+    void EndDemo();
+    void UpdatePlayerInputs();
 
     void AttractionMode( float deltaSeconds );
     void PostAttractionExplosion();
@@ -101,6 +272,8 @@ private:
     bool CheckWaveComplete();
 
     void ScreenShakeAblation( float deltaSeconds );
+    void UpdateExplosionLights( float deltaSeconds );
+    void BinExplosionLights() const;
     void ControllerVibrationAblation( float deltaSeconds );
 
     void UpdateEntities( float deltaSeconds,
@@ -108,17 +281,66 @@ private:
                          entities,
                          int entitiesSize );
     void RenderEntities( const Entity* const* entities,
-                         int entitiesSize ) const;
+                         int entitiesSize,
+                         const AABB2& viewBounds ) const;
+    bool RenderEntityIfVisible( const Entity& entity,
+                                const AABB2& viewBounds ) const;
     void DebugRenderEntities( const Entity* const* entities,
                               int entitiesSize ) const;
-
-    void RequestShipRespawn();
+    void RenderSnapshotEntities( const AABB2& viewBounds ) const;
+    void DebugRenderSnapshotEntities() const;
+
+    bool TryLoadWorld( const char* filePath );
+    bool WriteBulletStormScenario( const char* filePath );
+
+    void FlushCounters();
+    void CaptureSnapshot();
+    void RewindSnapshots( int ticks );
+    void CaptureEntities( const Entity* const* entities,
+                          EntityState* outStates,
+                          EntityShapeState* outShapes,
+                          int entitiesSize,
+                          EntityKind kind ) const;
+    void CaptureRenderEntities( const Entity* const* entities,
+                                int entitiesSize,
+                                EntityKind kind,
+                                RenderSnapshot& outSnapshot ) const;
+    Entity* CreateEntityForRestore( EntityPool& pool, int slotIndex, EntityKind kind, const Vec3& position );
+    void RestorePlayerShips( const EntityState* states );
+    void RestoreEntities( EntityPool& pool,
+                          const EntityState* states,
+                          const EntityShapeState* shapes );
+
+    void RequestShipRespawn( int playerIndex );
+    bool AreAllPlayersDead() const;
+    void StartupHud();
+    void UpdateHud( float deltaSeconds );
+    void UpdateLivesVisual();
     void RenderLives() const;
+    void RenderHud() const;
 
     void CreateAstroidInArray( int x );
 
     void PhysicsCollisions();
+    void BuildCollisionGrid();
+    int DetectBulletContacts( int firstBullet,
+                              int endBullet,
+                              std::vector<ContactEvent>& outContacts ) const;
+    int DetectContacts( Entity& entity,
+                        EntityKind kind,
+                        std::vector<ContactEvent>& outContacts ) const;
+    void RespondToContacts();
+    void PublishSpawn( EntityKind kind, const Entity& entity );
+
+    int GetExpiryClockTick() const;
+    void ScheduleExpiry( Entity& entity, EntityKind kind, int slotIndex, float lifetimeSeconds );
+    void ExpireEntities();
+    void RebuildExpiryWheel();
     void DeleteGarbageEntities();
+    void StreamSectors();
+    void ParkEntities( EntityPool& pool, EntityKind kind );
+    void UnparkSector( int sectorIndex );
+    void PopulateSectors();
     void DeleteAllEntities();
 
     void ErrorRecoverable( const char* message );
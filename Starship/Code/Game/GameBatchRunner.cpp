@@ -0,0 +1,196 @@
+#include "GameBatchRunner.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include "Game/BotPilot.hpp"
+#include "Game/Game.hpp"
+#include "Game/GameCommon.hpp"
+#include "Game/GameContext.hpp"
+
+//-----------------------------------------------------------------------------
+GameBatchRunner::GameBatchRunner()
+    : m_NextGameIndex( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+GameBatchRunner::~GameBatchRunner()
+{
+    Shutdown();
+}
+
+//-----------------------------------------------------------------------------
+void GameBatchRunner::Startup( int threadCount )
+{
+    if( threadCount <= 0 )
+    {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+        threadCount = threadCount > 0 ? threadCount : 1;
+    }
+
+    m_IsQuitting = false;
+    m_Workers.reserve( threadCount );
+    for( int threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+    {
+        m_Workers.emplace_back( &GameBatchRunner::WorkerMain, this );
+    }
+}
+
+//-----------------------------------------------------------------------------
+void GameBatchRunner::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_Mutex );
+        m_IsQuitting = true;
+    }
+    m_WorkReady.notify_all();
+
+    for( std::thread& worker : m_Workers )
+    {
+        worker.join();
+    }
+    m_Workers.clear();
+}
+
+//-----------------------------------------------------------------------------
+void GameBatchRunner::Run( const GameBatchSettings& settings, std::vector<GameBatchResult>& outResults )
+{
+    GUARANTEE_OR_DIE( !m_Workers.empty(), "GameBatchRunner needs Startup before Run" );
+
+    outResults.assign( settings.gameCount, GameBatchResult() );
+    if( settings.gameCount <= 0 )
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock( m_Mutex );
+    m_Settings = settings;
+    m_Results = outResults.data();
+    m_GamesFinished = 0;
+    m_NextGameIndex = 0;
+    m_BatchId++;
+    m_WorkReady.notify_all();
+
+    // Idle as well as finished, so no worker still holds m_Results on return
+    m_WorkDone.wait( lock, [this]() { return m_GamesFinished == m_Settings.gameCount && m_BusyWorkers == 0; } );
+    m_Results = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void GameBatchRunner::WorkerMain()
+{
+    int lastBatchId = 0;
+    for( ;; )
+    {
+        GameBatchSettings settings;
+        GameBatchResult* results = nullptr;
+        {
+            std::unique_lock<std::mutex> lock( m_Mutex );
+            m_WorkReady.wait( lock, [&]() { return m_IsQuitting || m_BatchId != lastBatchId; } );
+            if( m_IsQuitting )
+            {
+                return;
+            }
+            lastBatchId = m_BatchId;
+            settings = m_Settings;
+            results = m_Results;
+            m_BusyWorkers++;
+        }
+
+        int gamesFinished = 0;
+        Game* game = nullptr;
+        for( ;; )
+        {
+            int gameIndex = m_NextGameIndex.fetch_add( 1 );
+            if( gameIndex >= settings.gameCount )
+            {
+                break;
+            }
+
+            if( game == nullptr )
+            {
+                GameContext context;
+                context.keepsRewindHistory = false;
+                game = new Game( context );
+                game->Startup( settings.playerCount );
+            }
+            RunGame( *game, settings, gameIndex, results[ gameIndex ] );
+            gamesFinished++;
+        }
+
+        if( game != nullptr )
+        {
+            game->Shutdown();
+            delete game;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock( m_Mutex );
+            m_GamesFinished += gamesFinished;
+            m_BusyWorkers--;
+        }
+        m_WorkDone.notify_all();
+    }
+}
+
+//-----------------------------------------------------------------------------
+namespace
+{
+    struct BatchKillTally
+    {
+        int kills = 0;
+
+        void HandleKill( const GameKillEvent& ) { kills++; }
+    };
+}
+
+//-----------------------------------------------------------------------------
+// Bots press start whenever their ship is dead, until the shared lives run
+//  out; the game dropping back to attract mode after that is game over.
+//  Reset on the game's seed leaves it exactly as a new one would be, so
+//  which worker ran the game before makes no difference.
+void GameBatchRunner::RunGame( Game& game, const GameBatchSettings& settings, int gameIndex, GameBatchResult& outResult )
+{
+    game.Reset( settings.firstSeed + static_cast<unsigned int>(gameIndex) );
+
+    BatchKillTally killTally;
+    game.GetEvents().Subscribe<GameKillEvent, BatchKillTally, &BatchKillTally::HandleKill>( &killTally );
+
+    BotPilot pilots[ MAX_PLAYERS ];
+
+    double startSeconds = GetCurrentTimeSeconds();
+    bool hasStarted = false;
+    int tick = 0;
+    for( ; tick < settings.ticksPerGame; ++tick )
+    {
+        if( hasStarted && game.IsAttractMode() )
+        {
+            outResult.isGameOver = true;
+            break;
+        }
+
+        for( int playerIndex = 0; playerIndex < game.GetPlayerCount(); ++playerIndex )
+        {
+            game.SetPlayerInput( playerIndex, pilots[ playerIndex ].UpdatePilot( game, playerIndex ) );
+        }
+
+        double tickStartSeconds = GetCurrentTimeSeconds();
+        game.SimulateTick( GAME_BATCH_TICK_SECONDS );
+        double tickSeconds = GetCurrentTimeSeconds() - tickStartSeconds;
+        if( tickSeconds > outResult.worstTickSeconds )
+        {
+            outResult.worstTickSeconds = tickSeconds;
+        }
+        hasStarted = true;
+    }
+
+    outResult.seed = game.GetContext().rngSeed;
+    outResult.ticksSimulated = tick;
+    outResult.wavesReached = game.GetWaveNumber();
+    outResult.livesUsed = game.GetLivesUsed();
+    outResult.kills = killTally.kills;
+    outResult.simulateSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+    game.GetEvents().UnsubscribeAll( &killTally );
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Game;
+
+//-----------------------------------------------------------------------------
+// Steps many headless Games on a pool of worker threads, for balance runs and
+//  soak tests. Each game is independent: it gets its own GameContext with
+//  seed firstSeed + gameIndex, is flown by a BotPilot per player and runs
+//  until every life is spent or ticksPerGame is reached. Workers pull
+//  whole games from a shared counter so uneven games still keep every core
+//  busy, and a given settings block always produces the same results no
+//  matter how many threads run it. Each worker makes one Game per batch and
+//  Resets it between games rather than building a new one.
+constexpr float GAME_BATCH_TICK_SECONDS = 1.f / 60.f;
+
+struct GameBatchSettings
+{
+    int gameCount = 0;
+    int ticksPerGame = 60 * 60 * 5;     // Five minutes of play
+    int playerCount = 1;
+    unsigned int firstSeed = 0;
+};
+
+struct GameBatchResult
+{
+    unsigned int seed = 0;
+    int ticksSimulated = 0;
+    int wavesReached = 0;
+    int livesUsed = 0;
+    int kills = 0;                      // Tallied from the game's kill events
+    bool isGameOver = false;            // Spent every life before the tick limit
+    double simulateSeconds = 0.0;
+    double worstTickSeconds = 0.0;      // Slowest single SimulateTick, for frame time stability
+};
+
+class GameBatchRunner
+{
+public:
+    GameBatchRunner();
+    ~GameBatchRunner();
+
+    void Startup( int threadCount );    // 0 picks one per hardware thread
+    void Shutdown();
+
+    // Blocks until every game in the batch has finished
+    void Run( const GameBatchSettings& settings, std::vector<GameBatchResult>& outResults );
+
+    int GetThreadCount() const { return static_cast<int>(m_Workers.size()); }
+
+private:
+    std::vector<std::thread> m_Workers;
+
+    // Everything below is shared with the workers and guarded by m_Mutex,
+    //  except m_NextGameIndex which they claim games from without it
+    std::mutex m_Mutex;
+    std::condition_variable m_WorkReady;
+    std::condition_variable m_WorkDone;
+    bool m_IsQuitting = false;
+    int m_BatchId = 0;                  // Bumped per Run so sleeping workers see new work
+    GameBatchSettings m_Settings;
+    GameBatchResult* m_Results = nullptr;
+    int m_GamesFinished = 0;
+    int m_BusyWorkers = 0;
+    std::atomic<int> m_NextGameIndex;
+
+    void WorkerMain();
+    static void RunGame( Game& game, const GameBatchSettings& settings, int gameIndex, GameBatchResult& outResult );
+};
@@ -1,87 +1,32 @@
 #include "GameCommon.hpp"
 
 #include "Engine/Core/Rgba8.hpp"
-#include "Engine/Core/VertexTypes/VertexMaster.hpp"
 #include "Engine/Core/Math/Primatives/Vec2.hpp"
 #include "Engine/Core/Math/RandomNumberGenerator.hpp"
-#include "Engine/Renderer/RenderContext.hpp"
 
 //-------------------------------------------------------------------------------
-void DrawDebugLine( const Vec2& start,
-                    const Vec2& end,
-                    const Rgba8& color,
-                    float thickness )
+const Vec2* GetDebugUnitCircle()
 {
-    Vec2 displacement = end - start;
-    float lineRadius = thickness * .5f;
-
-    Vec2 forward = lineRadius * displacement.GetNormalized();
-    Vec2 left = forward.GetRotated90Degrees();
-
-    std::vector<VertexMaster> visual;
-    visual.push_back( VertexMaster( start - forward - left, color ) );
-    visual.push_back( VertexMaster( end + forward - left, color ) );
-    visual.push_back( VertexMaster( end + forward + left, color ) );
-
-    visual.push_back( VertexMaster( end + forward + left, color ) );
-    visual.push_back( VertexMaster( start - forward + left, color ) );
-    visual.push_back( VertexMaster( start - forward - left, color ) );
-
-    g_Renderer->DrawVertexArray( visual );
-}
-
-//-------------------------------------------------------------------------------
-void DrawDebugCircle( const Vec2& center,
-                      float radius,
-                      const Rgba8& color,
-                      float thickness )
-{
-    float degreesPerRadius = 360.f / DEBUG_CIRCLE_RADIUSES;
-    float lineRadius = thickness * .5f;
-    Vec2 currShort = Vec2::MakeFromPolarDegrees( 0.f,
-                                                 radius - lineRadius
-                                               ) + center;
-    Vec2 currLong = Vec2::MakeFromPolarDegrees( 0.f,
-                                                radius + lineRadius
-                                              ) + center;
-
-    std::vector<VertexMaster> debugCircle;
-    // Start at the second radius because current is defined above.
-    //  Loop up to <= DEBUG_CIRCLE_RADIUSES because 360 = 0 degrees
-    //  This finishes the last group of triangles
-    for( int currentRadius = 1; currentRadius <= DEBUG_CIRCLE_RADIUSES; ++currentRadius )
+    static Vec2 s_UnitCircle[ DEBUG_CIRCLE_RADIUSES + 1 ];
+    static bool s_IsBuilt = false;
+    if( !s_IsBuilt )
     {
-        float currentDegrees = degreesPerRadius * currentRadius;
-        Vec2 nextShort = Vec2::MakeFromPolarDegrees( currentDegrees,
-                                                     radius - lineRadius
-                                                   ) + center;
-        Vec2 nextLong = Vec2::MakeFromPolarDegrees( currentDegrees,
-                                                    radius + lineRadius
-                                                  ) + center;
-
-        // Draw two circles per radius so 6 vertexes
-        //  Because of the first definition of currShort is above the for
-        //  minus one offset here
-        // First triangle
-        debugCircle.push_back( VertexMaster( currShort, color ) );
-        debugCircle.push_back( VertexMaster( currLong, color ) );
-        debugCircle.push_back( VertexMaster( nextShort, color ) );
-        // Second Triangle
-        debugCircle.push_back( VertexMaster( nextShort, color ));
-        debugCircle.push_back( VertexMaster( currLong, color ));
-        debugCircle.push_back( VertexMaster( nextLong, color ));
-
-        currShort = nextShort;
-        currLong = nextLong;
+        float degreesPerRadius = 360.f / DEBUG_CIRCLE_RADIUSES;
+        for( int radiusIndex = 0; radiusIndex < DEBUG_CIRCLE_RADIUSES; ++radiusIndex )
+        {
+            s_UnitCircle[ radiusIndex ] = Vec2::MakeFromPolarDegrees( degreesPerRadius * radiusIndex, 1.f );
+        }
+        // 360 = 0 degrees, close the loop exactly
+        s_UnitCircle[ DEBUG_CIRCLE_RADIUSES ] = s_UnitCircle[ 0 ];
+        s_IsBuilt = true;
     }
-
-    g_Renderer->DrawVertexArray( debugCircle );
+    return s_UnitCircle;
 }
 
-Vec2 PointJustOffScreen( float furthestBound )
+//-------------------------------------------------------------------------------
+// Draws from the caller's generator so spawns replay with the world
+Vec2 PointJustOffScreen( RandomNumberGenerator& rng, float furthestBound, const Vec2& screenMins )
 {
-    RandomNumberGenerator rng = RandomNumberGenerator();
-
     float xLocation = 0.f;
     if( rng.FiftyFifty() )
     {
@@ -91,8 +36,8 @@ Vec2 PointJustOffScreen( float furthestBound )
     }
     else
     {
-        xLocation = rng.FloatInRange( WORLD_SIZE_X + MAX_SCREEN_SHAKE,
-                                      WORLD_SIZE_X + MAX_SCREEN_SHAKE + furthestBound
+        xLocation = rng.FloatInRange( SCREEN_SIZE_X + MAX_SCREEN_SHAKE,
+                                      SCREEN_SIZE_X + MAX_SCREEN_SHAKE + furthestBound
                                     );
     }
 
@@ -105,12 +50,12 @@ Vec2 PointJustOffScreen( float furthestBound )
     }
     else
     {
-        yLocation = rng.FloatInRange( WORLD_SIZE_Y + MAX_SCREEN_SHAKE,
-                                      WORLD_SIZE_Y + MAX_SCREEN_SHAKE + furthestBound
+        yLocation = rng.FloatInRange( SCREEN_SIZE_Y + MAX_SCREEN_SHAKE,
+                                      SCREEN_SIZE_Y + MAX_SCREEN_SHAKE + furthestBound
                                     );
     }
 
-    return Vec2( xLocation, yLocation );
+    return Vec2( screenMins.x + xLocation, screenMins.y + yLocation );
 }
 
 Rgba8 PLAYER_SHIP_COLOR_1 = Rgba8( 132, 156, 165 );
@@ -128,3 +73,4 @@ Rgba8 DEBUG_FORWARD_VECTOR_COLOR = Rgba8( 255, 255, 0 );
 Rgba8 DEBUG_POSITOIN_VECTOR_COLOR = Rgba8( 50, 50, 50 );
 Rgba8 DEBUG_COSMETIC_CIRCLE = Rgba8( 255, 0, 255 );
 Rgba8 DEBUG_PHYSICS_CIRCLE = Rgba8( 0, 255, 255 );
+Rgba8 HUD_DEBUG_TEXT_COLOR = Rgba8( 255, 255, 0 );
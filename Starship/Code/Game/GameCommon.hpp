@@ -1,26 +1,18 @@
 #pragma once
 
-class App;
-class InputSystem;
 class RenderContext;
 class RandomNumberGenerator;
 
 struct Vec2;
 struct Rgba8;
-//-------------------------------------------------------------------------------
-// Global advertisement of the App  & RenderContext singletons
-extern App* g_App;
-extern InputSystem* g_InputSystem;
-extern RenderContext* g_Renderer;
-
 //-------------------------------------------------------------------------------
 // Constants for the Game
 constexpr float CLIENT_ASPECT = 2.f;                    // We are requesting a 1:1 aspect (square) window area
-constexpr float WORLD_SIZE_X = 200.f;
-constexpr float WORLD_SIZE_Y = 100.f;
-constexpr float WORLD_CENTER_X = WORLD_SIZE_X / 2.f;
-constexpr float WORLD_CENTER_Y = WORLD_SIZE_Y / 2.f;
-constexpr float SAFEZONE = 10.f;                        // Asteroids can not spawn this close to the world edge
+constexpr float SCREEN_SIZE_X = 200.f;                  // What the camera sees, and one world sector
+constexpr float SCREEN_SIZE_Y = 100.f;
+constexpr float SCREEN_CENTER_X = SCREEN_SIZE_X / 2.f;
+constexpr float SCREEN_CENTER_Y = SCREEN_SIZE_Y / 2.f;
+constexpr float SAFEZONE = 10.f;                        // Asteroids can not spawn this close to the screen edge
 constexpr float MAX_SCREEN_SHAKE = 10.f;
 constexpr float SCREEN_SHAKE_ABLATION_PER_SECOND = 1.f;
 constexpr float CONTROLLER_VIBRATION_ABLATION_PER_SECOND = .5f;
@@ -38,6 +30,10 @@ constexpr int MAX_WASPS = 10;
 constexpr int MAX_NUMBER_OF_WAVES = 5;
 constexpr int MAX_NUMBER_OF_LIVES = 4;
 constexpr double TIME_AFTER_DEATH_BEFORE_ATTRACT = 3.f;
+constexpr float ATTRACT_DEMO_DELAY_SECONDS = 10.f;      // Idle time on the title before bots play
+constexpr int MAX_ENTITY_SHAPE_CORNERS = 16;             // Largest random outline (asteroids)
+constexpr int MAX_PLAYERS = 4;                          // Ships, each steered by its own PlayerInput
+constexpr float PLAYER_SPAWN_SPACING = 12.f;            // Between ships spawned side by side
 
 //-----------------------------------------------------------------------------
 // Title Rules
@@ -57,6 +53,7 @@ constexpr float ASTEROID_SPEED = 15.f;
 constexpr float ASTEROID_MAX_ROTATION = 200.f;
 constexpr float ASTEROID_PHYSICS_RADIUS = 2.0f;
 constexpr float ASTEROID_COSMETIC_RADIUS = 3.0f;
+constexpr int ASTEROID_TRIANGLES = 16;
 
 //-------------------------------------------------------------------------------
 // Bullet Rules
@@ -64,6 +61,7 @@ constexpr float BULLET_LIFETIME_SECONDS = 2.0f;
 constexpr float BULLET_SPEED = 130.f;
 constexpr float BULLET_PHYSICS_RADIUS = .5f;
 constexpr float BULLET_COSMETIC_RADIUS = 2.0f;
+constexpr int BULLET_VERTEXES = 6;
 
 //-------------------------------------------------------------------------------
 // Ship Rules
@@ -95,6 +93,38 @@ constexpr float DEBRIS_COSMETIC_RADIUS = 1.f;
 constexpr float DEBRIS_MIN_SPEED = 2.f;
 constexpr float DEBRIS_MAX_SPEED = 55.f;
 
+//-------------------------------------------------------------------------------
+// Explosion lights, short lived and cosmetic like debris
+constexpr int MAX_EXPLOSION_LIGHTS = 1024;
+constexpr float EXPLOSION_LIGHT_SECONDS = .5f;          // Fades out linearly over this
+constexpr float EXPLOSION_LIGHT_HEIGHT = 3.f;           // Off the play plane so flat shapes under it still catch it
+constexpr float ASTEROID_EXPLOSION_LIGHT_RADIUS = 20.f;
+constexpr float ASTEROID_EXPLOSION_LIGHT_INTENSITY = 40.f;
+constexpr float PLAYER_SHIP_EXPLOSION_LIGHT_RADIUS = 35.f;
+constexpr float PLAYER_SHIP_EXPLOSION_LIGHT_INTENSITY = 80.f;
+
+//-------------------------------------------------------------------------------
+// Spatial grids cover the world plus the margin enemies spawn into
+constexpr float SPATIAL_GRID_MARGIN = 50.f;
+constexpr float COLLISION_GRID_CELL_SIZE = 10.f;
+constexpr float NEAREST_PLAYER_GRID_CELL_SIZE = 20.f;
+constexpr int CONTACT_EVENTS_RESERVED = 1024;         // Grows past this only in extreme ticks
+
+//-------------------------------------------------------------------------------
+// Resolution of the clock bullet and debris lifetimes are kept on
+constexpr double EXPIRY_CLOCK_TICK_SECONDS = 1.0 / 60.0;
+
+//-------------------------------------------------------------------------------
+// Rewind history, one snapshot per tick
+constexpr int MAX_SNAPSHOTS = 60 * 10;                     // ~10 seconds at 60hz
+constexpr int SNAPSHOT_DELTA_BUDGET_BYTES = 64 * 1024 * 1024;
+constexpr int SNAPSHOT_REWIND_TICKS_PER_FRAME = 4;          // While holding rewind
+
+//-------------------------------------------------------------------------------
+// World files, relative to the Run directory
+constexpr const char* QUICK_SAVE_FILE_PATH = "Data/QuickSave.world";
+constexpr const char* BULLET_STORM_SCENARIO_FILE_PATH = "Data/BulletStorm.world";
+
 
 //-------------------------------------------------------------------------------
 extern Rgba8 PLAYER_SHIP_COLOR_1;
@@ -112,20 +142,17 @@ extern Rgba8 DEBUG_FORWARD_VECTOR_COLOR;
 extern Rgba8 DEBUG_POSITOIN_VECTOR_COLOR;
 extern Rgba8 DEBUG_COSMETIC_CIRCLE;
 extern Rgba8 DEBUG_PHYSICS_CIRCLE;
+extern Rgba8 HUD_DEBUG_TEXT_COLOR;
 
 //-------------------------------------------------------------------------------
 // Debug drawing utility functions
 constexpr int DEBUG_CIRCLE_RADIUSES = 64;
 constexpr int DEBUG_CIRCLE_VERTEXES = DEBUG_CIRCLE_RADIUSES * 6;
-void DrawDebugLine( const Vec2& start, 
-                    const Vec2& end, 
-                    const Rgba8& color, 
-                    float thickness );
-void DrawDebugCircle( const Vec2& center, 
-                      float radius, 
-                      const Rgba8& color, 
-                      float thickness );
+
+// Unit circle sampled at DEBUG_CIRCLE_RADIUSES + 1 points (last == first),
+//  computed once so debug circles never pay for trig per frame
+const Vec2* GetDebugUnitCircle();
 
 //-------------------------------------------------------------------------------
 // Gameplay Utility Functions
-Vec2 PointJustOffScreen(float furthestBound);
+Vec2 PointJustOffScreen( RandomNumberGenerator& rng, float furthestBound, const Vec2& screenMins );
@@ -0,0 +1,32 @@
+#pragma once
+
+class GameCounterWriter;
+class InputSystem;
+class InputThread;
+class RenderContext;
+
+//-----------------------------------------------------------------------------
+// Everything a Game used to reach through process globals, handed to it at
+//  construction instead. Nothing in a Game touches state outside its own
+//  instance and this, so any number of them can step on their own threads.
+//
+//  A headless game leaves renderer and input null: it never builds cameras,
+//  never reads devices and must not be rendered. Its players only ever move
+//  through Game::SetPlayerInput.
+struct GameContext
+{
+    RenderContext* renderer = nullptr;
+    InputSystem* input = nullptr;
+    GameCounterWriter* counterWriter = nullptr;     // Optional; gets one row per tick
+    InputThread* inputThread = nullptr;             // Optional; when set local players latch from it
+                                                    //  instead of reading input
+
+    unsigned int rngSeed = 0;
+    bool asteroidsWrapScreen = true;
+    bool bulletsWrapAround = false;
+    bool keepsRewindHistory = true;     // Costs SNAPSHOT_DELTA_BUDGET_BYTES per game
+    int worldSectorsPerSide = 1;        // Screens per side; past 1 the world streams through
+                                        //  WorldSectors and only plays locally
+
+    bool IsHeadless() const { return renderer == nullptr; }
+};
@@ -0,0 +1,109 @@
+#define _CRT_SECURE_NO_WARNINGS    // fopen; the file is only ever written from one thread
+#include "GameCounterWriter.hpp"
+
+#include <chrono>
+
+//-----------------------------------------------------------------------------
+GameCounterWriter::GameCounterWriter()
+{
+}
+
+//-----------------------------------------------------------------------------
+GameCounterWriter::~GameCounterWriter()
+{
+    Shutdown();
+}
+
+//-----------------------------------------------------------------------------
+bool GameCounterWriter::Startup( const char* filePath )
+{
+    m_File = fopen( filePath, "w" );
+    if( m_File == nullptr )
+    {
+        return false;
+    }
+
+    fprintf( m_File, "tick,game_time" );
+    for( int counterIndex = 0; counterIndex < GAME_COUNTER_COUNT; ++counterIndex )
+    {
+        fprintf( m_File, ",%s", GAME_COUNTER_NAMES[ counterIndex ] );
+    }
+    fprintf( m_File, "\n" );
+
+    m_IsQuitting = false;
+    m_Thread = std::thread( &GameCounterWriter::ThreadMain, this );
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void GameCounterWriter::Shutdown()
+{
+    if( !m_Thread.joinable() )
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( m_Mutex );
+        m_IsQuitting = true;
+    }
+    m_WorkReady.notify_all();
+    m_Thread.join();
+
+    fclose( m_File );
+    m_File = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void GameCounterWriter::Push( const GameCounterFrame& frame )
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    m_PendingFrames.push_back( frame );
+}
+
+//-----------------------------------------------------------------------------
+// Pushers are never woken for; the thread just drains on a timer, and once
+//  more on the way out
+void GameCounterWriter::ThreadMain()
+{
+    const std::chrono::duration<double> flushInterval( GAME_COUNTER_WRITER_FLUSH_SECONDS );
+    for( ;; )
+    {
+        bool isQuitting = false;
+        {
+            std::unique_lock<std::mutex> lock( m_Mutex );
+            m_WorkReady.wait_for( lock, flushInterval, [this]() { return m_IsQuitting; } );
+            isQuitting = m_IsQuitting;
+            m_WritingFrames.swap( m_PendingFrames );
+        }
+
+        WriteFrames();
+        if( isQuitting )
+        {
+            return;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void GameCounterWriter::WriteFrames()
+{
+    if( m_WritingFrames.empty() )
+    {
+        return;
+    }
+
+    for( const GameCounterFrame& frame : m_WritingFrames )
+    {
+        fprintf( m_File, "%i,%.4f", frame.tick, frame.gameTime );
+        for( int counterIndex = 0; counterIndex < GAME_COUNTER_COUNT; ++counterIndex )
+        {
+            fprintf( m_File, ",%i", frame.values[ counterIndex ] );
+        }
+        fprintf( m_File, "\n" );
+    }
+    fflush( m_File );
+
+    // Keeps its capacity, so steady state pushes and swaps never allocate
+    m_WritingFrames.clear();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Game/GameCounters.hpp"
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Streams GameCounterFrames to a CSV file from its own thread. Push only
+//  copies the frame into a pending list under a lock; the thread swaps that
+//  list out every GAME_COUNTER_WRITER_FLUSH_SECONDS and does the formatting
+//  and file writes, so the game never waits on the disk.
+constexpr double GAME_COUNTER_WRITER_FLUSH_SECONDS = .25;
+
+class GameCounterWriter
+{
+public:
+    GameCounterWriter();
+    ~GameCounterWriter();
+
+    bool Startup( const char* filePath );
+    void Shutdown();                        // Writes whatever is still pending
+
+    void Push( const GameCounterFrame& frame );     // Any thread
+
+private:
+    FILE* m_File = nullptr;
+    std::thread m_Thread;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_WorkReady;
+    bool m_IsQuitting = false;
+    std::vector<GameCounterFrame> m_PendingFrames;
+
+    std::vector<GameCounterFrame> m_WritingFrames;  // Writer thread only
+
+    void ThreadMain();
+    void WriteFrames();
+};
@@ -0,0 +1,34 @@
+#include "GameCounters.hpp"
+
+//-----------------------------------------------------------------------------
+// Column headers, in GameCounter order
+const char* const GAME_COUNTER_NAMES[ GAME_COUNTER_COUNT ] =
+{
+    "live_player_ships",
+    "live_asteroids",
+    "live_bullets",
+    "live_debris",
+    "live_beetles",
+    "live_wasps",
+    "spawns",
+    "removals",
+    "parked",
+    "parks",
+    "unparks",
+    "narrowphase_tests",
+    "hits",
+    "debris_clusters_requested",
+    "debris_clusters_truncated",
+    "draws",
+    "vertexes",
+    "vertex_bytes",
+};
+
+//-----------------------------------------------------------------------------
+void GameCounterFrame::Clear()
+{
+    for( int counterIndex = 0; counterIndex < GAME_COUNTER_COUNT; ++counterIndex )
+    {
+        values[ counterIndex ] = 0;
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+// Plain per tick tallies bumped straight from the hot paths, so a slow frame
+//  can be lined up with what the game was doing at the time. A frame is a
+//  fixed block of ints; incrementing one is a single add, and the Game hands
+//  the whole block to a GameCounterWriter once per tick.
+//
+//  Live counts are taken after the tick's garbage is deleted. Render counters
+//  land in the row of the tick that was being shown.
+enum GameCounter
+{
+    GAME_COUNTER_LIVE_PLAYER_SHIPS = 0,
+    GAME_COUNTER_LIVE_ASTEROIDS,
+    GAME_COUNTER_LIVE_BULLETS,
+    GAME_COUNTER_LIVE_DEBRIS,
+    GAME_COUNTER_LIVE_BEETLES,
+    GAME_COUNTER_LIVE_WASPS,
+    GAME_COUNTER_SPAWNS,
+    GAME_COUNTER_REMOVALS,
+    GAME_COUNTER_PARKED,                        // Waiting in WorldSectors, outside the live arrays
+    GAME_COUNTER_PARKS,
+    GAME_COUNTER_UNPARKS,
+    GAME_COUNTER_NARROWPHASE_TESTS,
+    GAME_COUNTER_HITS,
+    GAME_COUNTER_DEBRIS_CLUSTERS_REQUESTED,
+    GAME_COUNTER_DEBRIS_CLUSTERS_TRUNCATED,     // Ran out of MAX_DEBRIS slots part way
+    GAME_COUNTER_DRAWS,
+    GAME_COUNTER_VERTEXES,
+    GAME_COUNTER_VERTEX_BYTES,                  // As handed to the renderer
+    GAME_COUNTER_COUNT
+};
+
+extern const char* const GAME_COUNTER_NAMES[ GAME_COUNTER_COUNT ];
+
+//-----------------------------------------------------------------------------
+struct GameCounterFrame
+{
+    int tick = 0;
+    float gameTime = 0.f;
+    int values[ GAME_COUNTER_COUNT ] = { 0 };
+
+    void Clear();
+};
@@ -0,0 +1,84 @@
+#include "GameEventQueue.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+//-----------------------------------------------------------------------------
+GameEventQueue::GameEventQueue()
+{
+    m_Events.reserve( GAME_EVENT_QUEUE_RESERVED );
+}
+
+//-----------------------------------------------------------------------------
+GameEventQueue::~GameEventQueue()
+{
+}
+
+//-----------------------------------------------------------------------------
+bool GameEventQueue::SubscribeCallback( GameEventId id, void* subscriber, GameEventCallback callback )
+{
+    if( m_SubscriberCount >= GAME_EVENT_MAX_SUBSCRIBERS )
+    {
+        ERROR_RECOVERABLE( "Too many game event subscribers; raise GAME_EVENT_MAX_SUBSCRIBERS" );
+        return false;
+    }
+
+    Subscription& subscription = m_Subscriptions[ m_SubscriberCount++ ];
+    subscription.id = id;
+    subscription.subscriber = subscriber;
+    subscription.callback = callback;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Keeps the order the rest subscribed in
+void GameEventQueue::UnsubscribeAll( void* subscriber )
+{
+    int keptCount = 0;
+    for( int subscriptionIndex = 0; subscriptionIndex < m_SubscriberCount; ++subscriptionIndex )
+    {
+        if( m_Subscriptions[ subscriptionIndex ].subscriber != subscriber )
+        {
+            m_Subscriptions[ keptCount++ ] = m_Subscriptions[ subscriptionIndex ];
+        }
+    }
+    m_SubscriberCount = keptCount;
+}
+
+//-----------------------------------------------------------------------------
+// Each event is copied out before its handlers run, since one that publishes
+//  may grow the queue under it
+int GameEventQueue::DispatchEvents()
+{
+    int dispatchedCount = 0;
+    for( size_t eventIndex = 0; eventIndex < m_Events.size(); ++eventIndex )
+    {
+        const GameEvent event = m_Events[ eventIndex ];
+        for( int subscriptionIndex = 0; subscriptionIndex < m_SubscriberCount; ++subscriptionIndex )
+        {
+            const Subscription& subscription = m_Subscriptions[ subscriptionIndex ];
+            if( subscription.id == event.id )
+            {
+                subscription.callback( subscription.subscriber, event );
+            }
+        }
+        dispatchedCount++;
+    }
+
+    m_Events.clear();
+    return dispatchedCount;
+}
+
+//-----------------------------------------------------------------------------
+void GameEventQueue::ClearEvents()
+{
+    m_Events.clear();
+}
+
+//-----------------------------------------------------------------------------
+void GameEventQueue::DiscardEventsAfter( int queuedCount )
+{
+    if( queuedCount < static_cast<int>(m_Events.size()) )
+    {
+        m_Events.resize( static_cast<size_t>(queuedCount) );
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Game/GameEvents.hpp"
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Gameplay events published during a tick and handed out together once it
+//  is over. Publishing copies the payload into a queue reserved up front, so
+//  it never allocates or looks anything up; DispatchEvents then walks the
+//  queue in publish order and calls every subscriber of each event's ID.
+//  Events published by a handler go out in the same dispatch, after the rest.
+//
+//  Subscribers live in a small fixed table and are matched by a linear scan,
+//  which beats any map at the handful of subscribers the game has.
+//
+//  The string named g_EventSystem is still the place for rare app level
+//  events like quitting; this is for the ones that happen many times a tick.
+constexpr int GAME_EVENT_PAYLOAD_BYTES = 24;
+constexpr int GAME_EVENT_QUEUE_RESERVED = 1024;     // Grows past this only in extreme ticks
+constexpr int GAME_EVENT_MAX_SUBSCRIBERS = 32;
+
+struct GameEvent
+{
+    GameEventId id = 0;
+    alignas( 8 ) unsigned char payload[ GAME_EVENT_PAYLOAD_BYTES ];
+
+    template<typename Payload>
+    Payload GetPayload() const
+    {
+        static_assert( sizeof( Payload ) <= GAME_EVENT_PAYLOAD_BYTES, "Game event payload is too big" );
+        Payload value;
+        memcpy( &value, payload, sizeof( Payload ) );
+        return value;
+    }
+};
+
+typedef void (*GameEventCallback)( void* subscriber, const GameEvent& event );
+
+class GameEventQueue
+{
+public:
+    GameEventQueue();
+    ~GameEventQueue();
+
+    template<typename Payload>
+    void Publish( const Payload& payload )
+    {
+        static_assert( sizeof( Payload ) <= GAME_EVENT_PAYLOAD_BYTES, "Game event payload is too big" );
+        static_assert( std::is_trivially_copyable<Payload>::value, "Game event payloads are copied as bytes" );
+
+        m_Events.emplace_back();
+        GameEvent& event = m_Events.back();
+        event.id = Payload::ID;
+        memcpy( event.payload, &payload, sizeof( Payload ) );
+    }
+
+    // Handler is a member taking the payload, e.g.
+    //  Subscribe<GameKillEvent, KillTally, &KillTally::HandleKill>( &tally )
+    template<typename Payload, typename Subscriber, void (Subscriber::*Handler)( const Payload& )>
+    bool Subscribe( Subscriber* subscriber )
+    {
+        return SubscribeCallback( Payload::ID, subscriber, &InvokeHandler<Payload, Subscriber, Handler> );
+    }
+    bool SubscribeCallback( GameEventId id, void* subscriber, GameEventCallback callback );
+    void UnsubscribeAll( void* subscriber );
+
+    int DispatchEvents();                           // Returns how many went out
+    void ClearEvents();
+    void DiscardEventsAfter( int queuedCount );     // Drops anything published since GetQueuedCount said this
+
+    int GetQueuedCount() const { return static_cast<int>(m_Events.size()); }
+    int GetSubscriberCount() const { return m_SubscriberCount; }
+
+private:
+    struct Subscription
+    {
+        GameEventId id = 0;
+        void* subscriber = nullptr;
+        GameEventCallback callback = nullptr;
+    };
+
+    std::vector<GameEvent> m_Events;
+    Subscription m_Subscriptions[ GAME_EVENT_MAX_SUBSCRIBERS ];
+    int m_SubscriberCount = 0;
+
+    template<typename Payload, typename Subscriber, void (Subscriber::*Handler)( const Payload& )>
+    static void InvokeHandler( void* subscriber, const GameEvent& event )
+    {
+        (static_cast<Subscriber*>(subscriber)->*Handler)( event.GetPayload<Payload>() );
+    }
+};
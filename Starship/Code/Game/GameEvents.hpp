@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Engine/Core/Math/Primatives/Vec2.hpp"
+
+#include "Game/ContactEvent.hpp"
+#include "Game/WorldState.hpp"
+
+//-----------------------------------------------------------------------------
+// Gameplay events are named by a 32 bit FNV-1a hash of their name, worked out
+//  at compile time, so publishing never touches a string. Each payload is a
+//  small trivially copyable struct carrying its own ID; GameEventQueue checks
+//  both at compile time, and two names hashing alike fails to build below.
+typedef unsigned int GameEventId;
+
+constexpr GameEventId HashGameEventName( const char* name )
+{
+    GameEventId hash = 2166136261u;
+    for( ; *name != '\0'; ++name )
+    {
+        hash = (hash ^ static_cast<unsigned char>(*name)) * 16777619u;
+    }
+    return hash;
+}
+
+//-----------------------------------------------------------------------------
+// An entity entered the world; debris included
+struct GameSpawnEvent
+{
+    static constexpr GameEventId ID = HashGameEventName( "Spawn" );
+
+    EntityKind kind;
+    Vec2 position;
+};
+
+//-----------------------------------------------------------------------------
+// One contact's response was applied, whether or not anything died of it
+struct GameHitEvent
+{
+    static constexpr GameEventId ID = HashGameEventName( "Hit" );
+
+    ContactType type;
+    Vec2 point;
+};
+
+//-----------------------------------------------------------------------------
+// A contact took the last of an enemy's health
+struct GameKillEvent
+{
+    static constexpr GameEventId ID = HashGameEventName( "Kill" );
+
+    EntityKind killedKind;
+    EntityKind killerKind;                      // Bullet or player ship
+    Vec2 position;
+};
+
+static_assert( GameSpawnEvent::ID != GameHitEvent::ID && GameSpawnEvent::ID != GameKillEvent::ID && GameHitEvent::ID != GameKillEvent::ID,
+               "Game event names must hash apart" );
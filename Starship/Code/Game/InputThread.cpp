@@ -0,0 +1,290 @@
+#define WIN32_LEAN_AND_MEAN		// Always #define this before #including <windows.h>
+#include <windows.h>
+#include <Xinput.h>
+#pragma comment( lib, "xinput.lib" )
+
+#include "InputThread.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Math/MathUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <chrono>
+#include <cmath>
+
+static constexpr unsigned char INPUT_THREAD_PRESS_BUTTONS = LOCAL_DEVICE_KEY_FIRE | LOCAL_DEVICE_KEY_RESPAWN |
+                                                            LOCAL_DEVICE_PAD_FIRE | LOCAL_DEVICE_PAD_START;
+static constexpr float INPUT_THREAD_STICK_INNER_DEADZONE = static_cast<float>(XINPUT_GAMEPAD_LEFT_THUMB_DEADZONE) / 32767.f;
+static constexpr float INPUT_THREAD_STICK_OUTER_DEADZONE = .95f;
+
+//-----------------------------------------------------------------------------
+bool LocalDeviceState::operator==( const LocalDeviceState& other ) const
+{
+    return held == other.held && stickThrust == other.stickThrust && stickAngle == other.stickAngle;
+}
+
+//-----------------------------------------------------------------------------
+int InputLatencyHistogram::GetTotalCount() const
+{
+    int totalCount = 0;
+    for( int count : counts )
+    {
+        totalCount += count;
+    }
+    return totalCount;
+}
+
+//-----------------------------------------------------------------------------
+double InputLatencyHistogram::GetPercentileMilliseconds( float fraction ) const
+{
+    int totalCount = GetTotalCount();
+    if( totalCount == 0 )
+    {
+        return 0.0;
+    }
+
+    int targetCount = static_cast<int>(ceilf( fraction * static_cast<float>(totalCount) ));
+    int runningCount = 0;
+    for( int bucketIndex = 0; bucketIndex < INPUT_LATENCY_BUCKETS; ++bucketIndex )
+    {
+        runningCount += counts[ bucketIndex ];
+        if( runningCount >= targetCount )
+        {
+            return static_cast<double>(bucketIndex + 1);
+        }
+    }
+    return static_cast<double>(INPUT_LATENCY_BUCKETS);
+}
+
+//-----------------------------------------------------------------------------
+InputThread::InputThread()
+    : m_IsQuitting( false )
+    , m_WorstLatencyMicroseconds( 0 )
+    , m_DroppedCount( 0 )
+{
+    for( std::atomic<int>& count : m_LatencyCounts )
+    {
+        count.store( 0, std::memory_order_relaxed );
+    }
+}
+
+//-----------------------------------------------------------------------------
+InputThread::~InputThread()
+{
+    Shutdown();
+}
+
+//-----------------------------------------------------------------------------
+void InputThread::Startup( int playerCount )
+{
+    GUARANTEE_OR_DIE( playerCount > 0 && playerCount <= MAX_PLAYERS, "Player count out of range" );
+
+    m_PlayerCount = playerCount;
+    m_IsQuitting = false;
+    m_Thread = std::thread( &InputThread::ThreadMain, this );
+}
+
+//-----------------------------------------------------------------------------
+void InputThread::Shutdown()
+{
+    if( !m_Thread.joinable() )
+    {
+        return;
+    }
+
+    m_IsQuitting = true;
+    m_Thread.join();
+}
+
+//-----------------------------------------------------------------------------
+// A transition stamped after latchSeconds stays queued for the next latch,
+//  and everything queued behind it with it
+void InputThread::LatchInputs( double latchSeconds, PlayerInput* outInputs, int playerCount )
+{
+    double nowSeconds = GetCurrentTimeSeconds();
+    while( const InputTransition* transition = m_Transitions.Peek() )
+    {
+        if( transition->timeSeconds > latchSeconds )
+        {
+            break;
+        }
+
+        LocalDeviceState& latchedState = m_LatchedStates[ transition->playerIndex ];
+        unsigned char newlyHeld = transition->state.held & ~latchedState.held;
+        m_UnlatchedPresses[ transition->playerIndex ] |= newlyHeld & INPUT_THREAD_PRESS_BUTTONS;
+        latchedState = transition->state;
+
+        RecordLatency( nowSeconds - transition->timeSeconds );
+        m_Transitions.Pop();
+    }
+
+    for( int playerIndex = 0; playerIndex < playerCount; ++playerIndex )
+    {
+        outInputs[ playerIndex ] = MakePlayerInput( m_LatchedStates[ playerIndex ], m_UnlatchedPresses[ playerIndex ] );
+        m_UnlatchedPresses[ playerIndex ] = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void InputThread::TakeLatencyHistogram( InputLatencyHistogram& outHistogram )
+{
+    for( int bucketIndex = 0; bucketIndex < INPUT_LATENCY_BUCKETS; ++bucketIndex )
+    {
+        outHistogram.counts[ bucketIndex ] = m_LatencyCounts[ bucketIndex ].exchange( 0, std::memory_order_relaxed );
+    }
+    outHistogram.worstSeconds = static_cast<double>(m_WorstLatencyMicroseconds.exchange( 0, std::memory_order_relaxed )) * 1e-6;
+}
+
+//-----------------------------------------------------------------------------
+// A full queue leaves the change unsent, so the next poll tries it again
+//  with a later stamp; late, but never lost
+void InputThread::ThreadMain()
+{
+    while( !m_IsQuitting )
+    {
+        double sampleSeconds = GetCurrentTimeSeconds();
+        for( int playerIndex = 0; playerIndex < m_PlayerCount; ++playerIndex )
+        {
+            InputTransition transition;
+            transition.timeSeconds = sampleSeconds;
+            transition.playerIndex = playerIndex;
+            transition.state = SampleLocalDevices( playerIndex, playerIndex == 0 );
+            if( transition.state == m_SampledStates[ playerIndex ] )
+            {
+                continue;
+            }
+
+            if( m_Transitions.TryPush( transition ) )
+            {
+                m_SampledStates[ playerIndex ] = transition.state;
+            }
+            else
+            {
+                m_DroppedCount.fetch_add( 1, std::memory_order_relaxed );
+            }
+        }
+
+        std::this_thread::sleep_for( std::chrono::duration<double>( INPUT_THREAD_POLL_SECONDS ) );
+    }
+}
+
+//-----------------------------------------------------------------------------
+void InputThread::RecordLatency( double latencySeconds )
+{
+    latencySeconds = latencySeconds > 0.0 ? latencySeconds : 0.0;
+    int bucketIndex = static_cast<int>(latencySeconds * 1000.0);
+    bucketIndex = bucketIndex < INPUT_LATENCY_BUCKETS ? bucketIndex : INPUT_LATENCY_BUCKETS - 1;
+    m_LatencyCounts[ bucketIndex ].fetch_add( 1, std::memory_order_relaxed );
+
+    // Only the latching thread raises it, so a plain compare is enough
+    long long latencyMicroseconds = static_cast<long long>(latencySeconds * 1e6);
+    if( latencyMicroseconds > m_WorstLatencyMicroseconds.load( std::memory_order_relaxed ) )
+    {
+        m_WorstLatencyMicroseconds.store( latencyMicroseconds, std::memory_order_relaxed );
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Same bindings as SampleLocalPlayerInput, read from the OS rather than the
+//  InputSystem's once a frame copy
+LocalDeviceState InputThread::SampleLocalDevices( int playerIndex, bool includeKeyboard )
+{
+    LocalDeviceState state;
+
+    DWORD foregroundProcessId = 0;
+    GetWindowThreadProcessId( GetForegroundWindow(), &foregroundProcessId );
+    if( includeKeyboard && foregroundProcessId == GetCurrentProcessId() )
+    {
+        auto isKeyDown = []( int virtualKey ) { return (GetAsyncKeyState( virtualKey ) & 0x8000) != 0; };
+        if( isKeyDown( 'W' ) || isKeyDown( VK_UP ) )
+        {
+            state.held |= LOCAL_DEVICE_THRUST;
+        }
+        if( isKeyDown( 'A' ) || isKeyDown( VK_LEFT ) )
+        {
+            state.held |= LOCAL_DEVICE_TURN_LEFT;
+        }
+        if( isKeyDown( 'D' ) || isKeyDown( VK_RIGHT ) )
+        {
+            state.held |= LOCAL_DEVICE_TURN_RIGHT;
+        }
+        if( isKeyDown( VK_SPACE ) )
+        {
+            state.held |= LOCAL_DEVICE_KEY_FIRE;
+        }
+        if( isKeyDown( 'N' ) )
+        {
+            state.held |= LOCAL_DEVICE_KEY_RESPAWN;
+        }
+    }
+
+    XINPUT_STATE padState = {};
+    if( XInputGetState( static_cast<DWORD>(playerIndex), &padState ) != ERROR_SUCCESS )
+    {
+        return state;
+    }
+
+    const XINPUT_GAMEPAD& gamepad = padState.Gamepad;
+    if( (gamepad.wButtons & XINPUT_GAMEPAD_A) != 0 )
+    {
+        state.held |= LOCAL_DEVICE_PAD_FIRE;
+    }
+    if( (gamepad.wButtons & XINPUT_GAMEPAD_START) != 0 )
+    {
+        state.held |= LOCAL_DEVICE_PAD_START;
+    }
+
+    // Remapped between the deadzones, as the InputSystem's joysticks are
+    float stickX = static_cast<float>(gamepad.sThumbLX) / 32767.f;
+    float stickY = static_cast<float>(gamepad.sThumbLY) / 32767.f;
+    float rawMagnitude = sqrtf( stickX * stickX + stickY * stickY );
+    float magnitude = (rawMagnitude - INPUT_THREAD_STICK_INNER_DEADZONE) /
+                      (INPUT_THREAD_STICK_OUTER_DEADZONE - INPUT_THREAD_STICK_INNER_DEADZONE);
+    if( magnitude > 0.f )
+    {
+        PlayerInput stickInput;
+        stickInput.SetThrustFraction( magnitude < 1.f ? magnitude : 1.f );
+        stickInput.SetSteerAngleDegrees( atan2fDegrees( stickY, stickX ) );
+        state.stickThrust = stickInput.thrust > 0 ? stickInput.thrust : 1;
+        state.stickAngle = stickInput.steerAngle;
+    }
+
+    return state;
+}
+
+//-----------------------------------------------------------------------------
+// The stick overrides the keyboard, as in SampleLocalPlayerInput
+PlayerInput InputThread::MakePlayerInput( const LocalDeviceState& state, unsigned char presses )
+{
+    PlayerInput input;
+    if( (state.held & LOCAL_DEVICE_THRUST) != 0 )
+    {
+        input.thrust = PLAYER_INPUT_THRUST_MAX;
+    }
+
+    int turn = 0;
+    turn += (state.held & LOCAL_DEVICE_TURN_LEFT) != 0 ? 1 : 0;
+    turn -= (state.held & LOCAL_DEVICE_TURN_RIGHT) != 0 ? 1 : 0;
+    input.turn = static_cast<signed char>(turn);
+
+    if( state.stickThrust > 0 )
+    {
+        input.thrust = state.stickThrust;
+        input.steerAngle = state.stickAngle;
+        input.buttons |= PLAYER_INPUT_STEER;
+    }
+
+    if( (presses & (LOCAL_DEVICE_KEY_FIRE | LOCAL_DEVICE_PAD_FIRE)) != 0 )
+    {
+        input.buttons |= PLAYER_INPUT_FIRE;
+    }
+    if( (presses & LOCAL_DEVICE_PAD_START) != 0 )
+    {
+        input.buttons |= PLAYER_INPUT_START;
+    }
+    if( (presses & LOCAL_DEVICE_KEY_RESPAWN) != 0 )
+    {
+        input.buttons |= PLAYER_INPUT_RESPAWN;
+    }
+    return input;
+}
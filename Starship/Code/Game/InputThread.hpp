@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Game/GameCommon.hpp"
+#include "Game/PlayerInput.hpp"
+#include "Game/SpscQueue.hpp"
+
+#include <atomic>
+#include <thread>
+
+//-----------------------------------------------------------------------------
+// Reads the keyboard and pads straight from the OS about once a millisecond
+//  on its own thread, instead of once a frame in InputSystem::BeginFrame, and
+//  queues every change with the time it was seen. A tick then latches only
+//  the changes stamped at or before its own time: a press is turned into one
+//  edge by the first tick that reaches it, so it is never dropped between two
+//  ticks and never seen by two, at a fixed step or a variable one.
+//
+//  The queue has one producer and one consumer, so at any time exactly one
+//  thread may latch: the main thread for a local game, the simulation thread
+//  while threaded. Debug keys and menus still go through the InputSystem.
+//
+//  Player 0 also gets the keyboard, and only while the game has focus.
+constexpr double INPUT_THREAD_POLL_SECONDS = .001;
+constexpr int INPUT_THREAD_QUEUE_CAPACITY = 1024;
+constexpr int INPUT_LATENCY_BUCKETS = 64;               // Whole milliseconds; the last takes everything slower
+constexpr double INPUT_LATENCY_STATS_SECONDS = .5;
+
+enum LocalDeviceButton: unsigned char
+{
+    LOCAL_DEVICE_THRUST = 1 << 0,
+    LOCAL_DEVICE_TURN_LEFT = 1 << 1,
+    LOCAL_DEVICE_TURN_RIGHT = 1 << 2,
+    LOCAL_DEVICE_KEY_FIRE = 1 << 3,
+    LOCAL_DEVICE_KEY_RESPAWN = 1 << 4,
+    LOCAL_DEVICE_PAD_FIRE = 1 << 5,         // Kept apart from the keys so both
+    LOCAL_DEVICE_PAD_START = 1 << 6,        //  devices get their own presses
+};
+
+// Everything of one player's devices that becomes a PlayerInput, already
+//  quantized so jitter below what the game can see is not a change
+struct LocalDeviceState
+{
+    unsigned char held = 0;                 // LocalDeviceButton bits
+    unsigned char stickThrust = 0;          // Zero with the stick at rest
+    unsigned short stickAngle = 0;          // PLAYER_INPUT_ANGLE_QUANTA
+
+    bool operator==( const LocalDeviceState& other ) const;
+    bool operator!=( const LocalDeviceState& other ) const { return !(*this == other); }
+};
+
+struct InputTransition
+{
+    double timeSeconds = 0.0;
+    int playerIndex = 0;
+    LocalDeviceState state;
+};
+
+//-----------------------------------------------------------------------------
+// How long transitions waited between being seen and being latched
+struct InputLatencyHistogram
+{
+    int counts[ INPUT_LATENCY_BUCKETS ] = { 0 };
+    double worstSeconds = 0.0;
+
+    int GetTotalCount() const;
+    double GetPercentileMilliseconds( float fraction ) const;     // Upper edge of the bucket
+};
+
+class InputThread
+{
+public:
+    InputThread();
+    ~InputThread();
+
+    void Startup( int playerCount );
+    void Shutdown();
+
+    // Latching thread only. Applies every transition up to latchSeconds and
+    //  fills one input per player, each press since the last latch included.
+    void LatchInputs( double latchSeconds, PlayerInput* outInputs, int playerCount );
+
+    // Any thread; hands back what was gathered since the last call
+    void TakeLatencyHistogram( InputLatencyHistogram& outHistogram );
+    int GetDroppedCount() const { return m_DroppedCount.load( std::memory_order_relaxed ); }
+
+private:
+    std::thread m_Thread;
+    std::atomic<bool> m_IsQuitting;
+    int m_PlayerCount = 0;
+    SpscQueue<InputTransition, INPUT_THREAD_QUEUE_CAPACITY> m_Transitions;
+
+    // Input thread only
+    LocalDeviceState m_SampledStates[ MAX_PLAYERS ];
+
+    // Latching thread only
+    LocalDeviceState m_LatchedStates[ MAX_PLAYERS ];
+    unsigned char m_UnlatchedPresses[ MAX_PLAYERS ] = { 0 };
+
+    std::atomic<int> m_LatencyCounts[ INPUT_LATENCY_BUCKETS ];
+    std::atomic<long long> m_WorstLatencyMicroseconds;
+    std::atomic<int> m_DroppedCount;            // Polls that found the queue full and retried
+
+    void ThreadMain();
+    void RecordLatency( double latencySeconds );
+    static LocalDeviceState SampleLocalDevices( int playerIndex, bool includeKeyboard );
+    static PlayerInput MakePlayerInput( const LocalDeviceState& state, unsigned char presses );
+};
@@ -1,5 +1,7 @@
 #define WIN32_LEAN_AND_MEAN		// Always #define this before #including <windows.h>
 #include <windows.h>			// #include this (massive, platform-specific) header in very few places
+#include <timeapi.h>
+#pragma comment( lib, "winmm.lib" )
 
 #include "Game/App.hpp"
 
@@ -22,18 +24,22 @@ Window* g_Window = nullptr;
 // Handles application startup event like initializing the console, loading
 //  configs from GameConfig.xml and creating the OSWindow and RenderContext before
 //  the app is created.
-void Startup()
+void Startup( const char* commandLine )
 {
     //Initialize the event system
     g_EventSystem = new EventSystem();
     g_EventSystem->Startup();
 
+    // The frame pacer sleeps most of each frame; by default Windows wakes
+    //  sleepers on a ~15ms tick, far too coarse for a 16.7ms frame
+    timeBeginPeriod( 1 );
+
     g_Window = new Window();
     g_Window->Open( APP_NAME, 1.77f );
 
     // Creates the app and starts it up
     g_App = new App();
-    g_App->Startup();
+    g_App->Startup( commandLine );
 }
 
 
@@ -50,15 +56,16 @@ void Shutdown()
     g_EventSystem->Shutdown();
     delete g_EventSystem;
     g_EventSystem = nullptr;
+
+    timeEndPeriod( 1 );
 }
 
 //-------------------------------------------------------------------------------
 int WINAPI WinMain( _In_ HINSTANCE applicationInstanceHandle, _In_opt_ HINSTANCE, _In_ LPSTR commandLineString, _In_ int )
 {
-    UNUSED( commandLineString );
     UNUSED( applicationInstanceHandle );
 
-    Startup();
+    Startup( commandLineString );
 
     // Program main loop; keep running frames until it's time to quit
     while ( !g_App->IsQuitting() )
@@ -0,0 +1,203 @@
+#include "NearestPlayerGrid.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include "Game/Entity/PlayerShip.hpp"
+
+//-----------------------------------------------------------------------------
+static float GetDistanceSquaredToRange( float value, float rangeMin, float rangeMax )
+{
+    float outside = 0.f;
+    if( value < rangeMin )
+    {
+        outside = rangeMin - value;
+    }
+    else if( value > rangeMax )
+    {
+        outside = value - rangeMax;
+    }
+    return outside * outside;
+}
+
+//-----------------------------------------------------------------------------
+static float GetFarthestDistanceSquaredInRange( float value, float rangeMin, float rangeMax )
+{
+    float toMin = value - rangeMin;
+    float toMax = rangeMax - value;
+    float farthest = toMin * toMin > toMax * toMax ? toMin : toMax;
+    return farthest * farthest;
+}
+
+//-----------------------------------------------------------------------------
+NearestPlayerGrid::NearestPlayerGrid()
+{
+}
+
+//-----------------------------------------------------------------------------
+NearestPlayerGrid::~NearestPlayerGrid()
+{
+}
+
+//-----------------------------------------------------------------------------
+void NearestPlayerGrid::Startup( const AABB2& bounds, float cellSize )
+{
+    GUARANTEE_OR_DIE( cellSize > 0.f, "NearestPlayerGrid cells need a size" );
+
+    m_Bounds = bounds;
+    m_CellSize = cellSize;
+    m_InverseCellSize = 1.f / cellSize;
+    m_CellCountX = static_cast<int>((bounds.maxs.x - bounds.mins.x) * m_InverseCellSize) + 1;
+    m_CellCountY = static_cast<int>((bounds.maxs.y - bounds.mins.y) * m_InverseCellSize) + 1;
+
+    m_CellShipMasks.assign( m_CellCountX * m_CellCountY, 0 );
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+    {
+        m_Ships[ playerIndex ] = nullptr;
+    }
+    m_AllShipsMask = 0;
+}
+
+//-----------------------------------------------------------------------------
+void NearestPlayerGrid::Shutdown()
+{
+    m_CellShipMasks.clear();
+    m_CellShipMasks.shrink_to_fit();
+}
+
+//-----------------------------------------------------------------------------
+void NearestPlayerGrid::MoveBounds( const Vec2& mins )
+{
+    m_Bounds.maxs = m_Bounds.maxs + (mins - m_Bounds.mins);
+    m_Bounds.mins = mins;
+}
+
+//-----------------------------------------------------------------------------
+// A ship can only be nearest somewhere in a cell if its closest point of the
+//  cell is no farther than the best "farthest point" of any ship
+void NearestPlayerGrid::Build( PlayerShip* const* ships, int shipCount )
+{
+    int liveShipCount = 0;
+    m_AllShipsMask = 0;
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+    {
+        const PlayerShip* ship = playerIndex < shipCount ? ships[ playerIndex ] : nullptr;
+        if( ship != nullptr && !ship->IsDead() )
+        {
+            m_Ships[ playerIndex ] = ship;
+            m_AllShipsMask |= static_cast<unsigned char>(1 << playerIndex);
+            liveShipCount++;
+        }
+        else
+        {
+            m_Ships[ playerIndex ] = nullptr;
+        }
+    }
+
+    if( liveShipCount <= 1 )
+    {
+        m_CellShipMasks.assign( m_CellShipMasks.size(), m_AllShipsMask );
+        return;
+    }
+
+    float nearestDistancesSquared[ MAX_PLAYERS ];
+    for( int cellY = 0; cellY < m_CellCountY; ++cellY )
+    {
+        const float cellMinY = m_Bounds.mins.y + static_cast<float>(cellY) * m_CellSize;
+        const float cellMaxY = cellMinY + m_CellSize;
+        const bool isEdgeRow = cellY == 0 || cellY == m_CellCountY - 1;
+
+        for( int cellX = 0; cellX < m_CellCountX; ++cellX )
+        {
+            unsigned char& cellMask = m_CellShipMasks[ cellY * m_CellCountX + cellX ];
+            if( isEdgeRow || cellX == 0 || cellX == m_CellCountX - 1 )
+            {
+                cellMask = m_AllShipsMask;
+                continue;
+            }
+
+            const float cellMinX = m_Bounds.mins.x + static_cast<float>(cellX) * m_CellSize;
+            const float cellMaxX = cellMinX + m_CellSize;
+
+            float bestFarthestSquared = 0.f;
+            bool hasBest = false;
+            for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+            {
+                const PlayerShip* ship = m_Ships[ playerIndex ];
+                if( ship == nullptr )
+                {
+                    continue;
+                }
+
+                const Vec3 position = ship->GetPosition();
+                nearestDistancesSquared[ playerIndex ] = GetDistanceSquaredToRange( position.x, cellMinX, cellMaxX ) +
+                                                         GetDistanceSquaredToRange( position.y, cellMinY, cellMaxY );
+                float farthestSquared = GetFarthestDistanceSquaredInRange( position.x, cellMinX, cellMaxX ) +
+                                        GetFarthestDistanceSquaredInRange( position.y, cellMinY, cellMaxY );
+                if( !hasBest || farthestSquared < bestFarthestSquared )
+                {
+                    bestFarthestSquared = farthestSquared;
+                    hasBest = true;
+                }
+            }
+
+            cellMask = 0;
+            for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+            {
+                if( m_Ships[ playerIndex ] != nullptr && nearestDistancesSquared[ playerIndex ] <= bestFarthestSquared )
+                {
+                    cellMask |= static_cast<unsigned char>(1 << playerIndex);
+                }
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Ties go to the lower player index so every peer picks the same ship
+const PlayerShip* NearestPlayerGrid::FindNearest( const Vec2& position ) const
+{
+    const unsigned char cellMask = m_CellShipMasks[ GetCellY( position.y ) * m_CellCountX + GetCellX( position.x ) ];
+
+    const PlayerShip* nearestShip = nullptr;
+    float nearestDistanceSquared = 0.f;
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+    {
+        if( (cellMask & (1 << playerIndex)) == 0 )
+        {
+            continue;
+        }
+
+        const Vec3 shipPosition = m_Ships[ playerIndex ]->GetPosition();
+        float displacementX = shipPosition.x - position.x;
+        float displacementY = shipPosition.y - position.y;
+        float distanceSquared = displacementX * displacementX + displacementY * displacementY;
+        if( nearestShip == nullptr || distanceSquared < nearestDistanceSquared )
+        {
+            nearestShip = m_Ships[ playerIndex ];
+            nearestDistanceSquared = distanceSquared;
+        }
+    }
+    return nearestShip;
+}
+
+//-----------------------------------------------------------------------------
+int NearestPlayerGrid::GetCellX( float x ) const
+{
+    int cellX = static_cast<int>((x - m_Bounds.mins.x) * m_InverseCellSize);
+    if( x < m_Bounds.mins.x || cellX < 0 )
+    {
+        return 0;
+    }
+    return cellX < m_CellCountX ? cellX : m_CellCountX - 1;
+}
+
+//-----------------------------------------------------------------------------
+int NearestPlayerGrid::GetCellY( float y ) const
+{
+    int cellY = static_cast<int>((y - m_Bounds.mins.y) * m_InverseCellSize);
+    if( y < m_Bounds.mins.y || cellY < 0 )
+    {
+        return 0;
+    }
+    return cellY < m_CellCountY ? cellY : m_CellCountY - 1;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Engine/Core/Math/Primatives/AABB2.hpp"
+
+#include "Game/GameCommon.hpp"
+
+#include <vector>
+
+class PlayerShip;
+
+//-----------------------------------------------------------------------------
+// Answers "which live ship is closest" for every enemy in a tick. Build does
+//  one pass over a coarse grid and keeps, per cell, only the ships that could
+//  be nearest to some point in that cell (usually one). A lookup then tests
+//  just those instead of every ship, so the per tick cost is cells x ships
+//  once plus about one distance per enemy.
+//
+//  Edge cells stand in for everything beyond the bounds, so they keep every
+//  live ship and stay exact there too.
+class NearestPlayerGrid
+{
+public:
+    NearestPlayerGrid();
+    ~NearestPlayerGrid();
+
+    void Startup( const AABB2& bounds, float cellSize );
+    void Shutdown();
+    void MoveBounds( const Vec2& mins );    // Same size and cells, taken up by the next Build
+
+    void Build( PlayerShip* const* ships, int shipCount );
+    const PlayerShip* FindNearest( const Vec2& position ) const;
+
+private:
+    AABB2 m_Bounds;
+    float m_CellSize = 1.f;
+    float m_InverseCellSize = 1.f;
+    int m_CellCountX = 0;
+    int m_CellCountY = 0;
+
+    const PlayerShip* m_Ships[ MAX_PLAYERS ] = { nullptr };    // Live ships only, by player index
+    unsigned char m_AllShipsMask = 0;
+    std::vector<unsigned char> m_CellShipMasks;                 // Bit per player index
+
+    int GetCellX( float x ) const;
+    int GetCellY( float y ) const;
+};
+
+static_assert( MAX_PLAYERS <= 8, "NearestPlayerGrid keeps one bit per player" );
@@ -0,0 +1,249 @@
+#include "GameClient.hpp"
+
+#include "Engine/Core/Time.hpp"
+
+#include "Game/Game.hpp"
+#include "Game/GameContext.hpp"
+#include "Game/Net/NetBuffer.hpp"
+#include "Game/PlayerPilot.hpp"
+
+//-----------------------------------------------------------------------------
+GameClient::GameClient( Game* game )
+    : m_Game( game )
+{
+}
+
+//-----------------------------------------------------------------------------
+GameClient::~GameClient()
+{
+    Shutdown();
+}
+
+//-----------------------------------------------------------------------------
+bool GameClient::Startup( const NetAddress& serverAddress )
+{
+    if( !m_Socket.Open( 0 ) )
+    {
+        return false;
+    }
+    m_ServerAddress = serverAddress;
+
+    m_Views = new NetWorld[ NET_HISTORY_TICKS ];
+    ResetConnection();
+
+    // Start from the local game's own state so the header and rng are valid;
+    //  replication only ever overwrites the entity slots and world fields
+    m_WorldState = new WorldState();
+    m_Game->CaptureWorldState( *m_WorldState );
+
+    for( int kindIndex = 0; kindIndex < ENTITY_KIND_COUNT; ++kindIndex )
+    {
+        m_Game->BuildDefaultEntityState( static_cast<EntityKind>(kindIndex), m_DefaultStates[ kindIndex ] );
+    }
+
+    SendConnect();
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void GameClient::Shutdown()
+{
+    if( m_Socket.IsOpen() )
+    {
+        unsigned char buffer[ 8 ];
+        NetBufferWriter writer( buffer, sizeof( buffer ) );
+        writer.WriteI32( static_cast<int>(NET_PROTOCOL_ID) );
+        writer.WriteU8( NET_PACKET_DISCONNECT );
+        m_Socket.SendTo( m_ServerAddress, buffer, writer.GetBytesWritten() );
+    }
+    m_Socket.Close();
+
+    delete[] m_Views;
+    m_Views = nullptr;
+
+    delete m_WorldState;
+    m_WorldState = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void GameClient::Update( float deltaSeconds )
+{
+    ReceivePackets();
+
+    double currentSeconds = GetCurrentTimeSeconds();
+    if( IsConnected() && currentSeconds - m_LastHeardSeconds > NET_CLIENT_TIMEOUT_SECONDS )
+    {
+        ResetConnection();
+    }
+
+    if( !IsConnected() && currentSeconds - m_LastConnectSeconds > NET_CONNECT_RETRY_SECONDS )
+    {
+        SendConnect();
+    }
+
+    // Several snapshots may land in one frame; only the newest is shown
+    if( m_HasNewWorld )
+    {
+        NetWorldToWorldState( m_Views[ m_LatestTick % NET_HISTORY_TICKS ], m_DefaultStates, *m_WorldState );
+        m_Game->RestoreWorldState( *m_WorldState );
+        m_HasNewWorld = false;
+    }
+
+    if( IsConnected() && m_PlayerIndex >= 0 )
+    {
+        SendInput();
+    }
+
+    m_Game->UpdateAsClient( deltaSeconds );
+}
+
+//-----------------------------------------------------------------------------
+void GameClient::ReceivePackets()
+{
+    unsigned char buffer[ NET_MAX_PACKET_BYTES ];
+    NetAddress fromAddress;
+    int bytesReceived = m_Socket.ReceiveFrom( fromAddress, buffer, NET_MAX_PACKET_BYTES );
+    while( bytesReceived > 0 )
+    {
+        NetBufferReader reader( buffer, bytesReceived );
+        unsigned int protocolId = static_cast<unsigned int>(reader.ReadI32());
+        unsigned char packetType = reader.ReadU8();
+        if( fromAddress == m_ServerAddress &&
+            protocolId == NET_PROTOCOL_ID &&
+            packetType == NET_PACKET_SNAPSHOT )
+        {
+            ReadSnapshot( reader );
+        }
+
+        bytesReceived = m_Socket.ReceiveFrom( fromAddress, buffer, NET_MAX_PACKET_BYTES );
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool GameClient::ReadSnapshot( NetBufferReader& reader )
+{
+    int tick = reader.ReadI32();
+    int baselineTick = reader.ReadI32();
+    unsigned char playerIndex = reader.ReadU8();
+    if( reader.HasOverflowed() || tick <= m_LatestTick )
+    {
+        // Late or duplicated, a newer world is already applied
+        return false;
+    }
+
+    NetWorld& view = m_Views[ tick % NET_HISTORY_TICKS ];
+    if( baselineTick == 0 )
+    {
+        ClearNetWorld( view );
+        view.tick = tick;
+    }
+    else
+    {
+        if( tick - baselineTick >= NET_HISTORY_TICKS || baselineTick > tick )
+        {
+            return false;
+        }
+
+        const NetWorld& baseline = m_Views[ baselineTick % NET_HISTORY_TICKS ];
+        if( baseline.tick != baselineTick )
+        {
+            return false;
+        }
+        ExtrapolateNetWorld( baseline, tick - baselineTick, view );
+    }
+
+    ReadNetWorldHeader( reader, view );
+    int entityCount = reader.ReadU16();
+    for( int entityIndex = 0; entityIndex < entityCount && !reader.HasOverflowed(); ++entityIndex )
+    {
+        int netIndex = reader.ReadU16();
+        int fields = reader.ReadU8();
+        if( netIndex >= NET_MAX_ENTITIES )
+        {
+            break;
+        }
+        ReadNetEntityFields( reader, view.entities[ netIndex ], fields );
+    }
+
+    if( reader.HasOverflowed() || reader.GetBytesRemaining() != 0 )
+    {
+        // Never use a half decoded world as a baseline
+        view.tick = -1;
+        return false;
+    }
+
+    m_LatestTick = tick;
+    m_PlayerIndex = playerIndex < MAX_PLAYERS ? playerIndex : -1;
+    m_LastHeardSeconds = GetCurrentTimeSeconds();
+    m_HasNewWorld = true;
+    SendAck( tick );
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void GameClient::SendConnect()
+{
+    unsigned char buffer[ 8 ];
+    NetBufferWriter writer( buffer, sizeof( buffer ) );
+    writer.WriteI32( static_cast<int>(NET_PROTOCOL_ID) );
+    writer.WriteU8( NET_PACKET_CONNECT );
+    m_Socket.SendTo( m_ServerAddress, buffer, writer.GetBytesWritten() );
+
+    m_LastConnectSeconds = GetCurrentTimeSeconds();
+}
+
+//-----------------------------------------------------------------------------
+void GameClient::SendAck( int tick )
+{
+    unsigned char buffer[ 12 ];
+    NetBufferWriter writer( buffer, sizeof( buffer ) );
+    writer.WriteI32( static_cast<int>(NET_PROTOCOL_ID) );
+    writer.WriteU8( NET_PACKET_ACK );
+    writer.WriteI32( tick );
+    m_Socket.SendTo( m_ServerAddress, buffer, writer.GetBytesWritten() );
+}
+
+//-----------------------------------------------------------------------------
+// Once per update, whatever the server's tick rate; the server keeps presses
+//  until a tick takes them. Repeats the last few so a lost packet costs
+//  nothing as long as one of the next few lands.
+void GameClient::SendInput()
+{
+    PlayerInput input;
+    if( m_Pilot != nullptr )
+    {
+        input = m_Pilot->UpdatePilot( *m_Game, m_PlayerIndex );
+    }
+    else if( m_Game->GetContext().input != nullptr )
+    {
+        input = SampleLocalPlayerInput( *m_Game->GetContext().input, 0, true );
+    }
+
+    m_InputSequence++;
+    m_SentInputs[ m_InputSequence % NET_INPUT_REDUNDANCY ] = input;
+    int inputCount = m_InputSequence < NET_INPUT_REDUNDANCY ? m_InputSequence : NET_INPUT_REDUNDANCY;
+
+    unsigned char buffer[ 16 + NET_INPUT_REDUNDANCY * 8 ];
+    NetBufferWriter writer( buffer, sizeof( buffer ) );
+    writer.WriteI32( static_cast<int>(NET_PROTOCOL_ID) );
+    writer.WriteU8( NET_PACKET_INPUT );
+    writer.WriteI32( m_InputSequence );
+    writer.WriteU8( static_cast<unsigned char>(inputCount) );
+    for( int inputIndex = 0; inputIndex < inputCount; ++inputIndex )
+    {
+        WritePlayerInput( writer, m_SentInputs[ (m_InputSequence - inputIndex) % NET_INPUT_REDUNDANCY ] );
+    }
+    m_Socket.SendTo( m_ServerAddress, buffer, writer.GetBytesWritten() );
+}
+
+//-----------------------------------------------------------------------------
+void GameClient::ResetConnection()
+{
+    m_LatestTick = 0;
+    m_HasNewWorld = false;
+    m_PlayerIndex = -1;
+    for( int viewIndex = 0; viewIndex < NET_HISTORY_TICKS; ++viewIndex )
+    {
+        ClearNetWorld( m_Views[ viewIndex ] );
+    }
+}
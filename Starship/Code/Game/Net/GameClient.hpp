@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Game/Net/NetSocket.hpp"
+#include "Game/Net/Replication.hpp"
+#include "Game/PlayerInput.hpp"
+#include "Game/WorldState.hpp"
+
+class Game;
+class NetBufferReader;
+class PlayerPilot;
+
+//-----------------------------------------------------------------------------
+// Mirrors a GameServer into a local Game. The local game never simulates;
+//  each new snapshot is rebuilt into a WorldState and restored, and the game
+//  only renders and updates its HUD.
+//
+//  Once the server has given it a ship, every update sends that ship's input:
+//  controller 0 and the keyboard, or the pilot if one is set.
+class GameClient
+{
+public:
+    explicit GameClient( Game* game );
+    ~GameClient();
+
+    // Not owned; flies the server's ship from the mirrored world
+    void SetPlayerPilot( PlayerPilot* pilot ) { m_Pilot = pilot; }
+
+    bool Startup( const NetAddress& serverAddress );
+    void Shutdown();
+    void Update( float deltaSeconds );
+
+    bool IsConnected() const { return m_LatestTick > 0; }
+    int GetLatestTick() const { return m_LatestTick; }
+    int GetPlayerIndex() const { return m_PlayerIndex; }
+    const WorldState& GetWorldState() const { return *m_WorldState; }  // Newest one restored
+
+private:
+    Game* m_Game = nullptr;
+    UdpSocket m_Socket;
+    NetAddress m_ServerAddress;
+
+    NetWorld* m_Views = nullptr;            // Decoded worlds, ring indexed by tick
+    int m_LatestTick = 0;
+    bool m_HasNewWorld = false;
+    int m_PlayerIndex = -1;                 // Ship the server gave us, -1 when spectating
+
+    PlayerPilot* m_Pilot = nullptr;
+    PlayerInput m_SentInputs[ NET_INPUT_REDUNDANCY ];   // Ring indexed by sequence
+    int m_InputSequence = 0;
+
+    double m_LastConnectSeconds = 0.0;
+    double m_LastHeardSeconds = 0.0;
+
+    WorldState* m_WorldState = nullptr;
+    EntityState m_DefaultStates[ ENTITY_KIND_COUNT ];
+
+    void ReceivePackets();
+    bool ReadSnapshot( NetBufferReader& reader );
+    void SendConnect();
+    void SendAck( int tick );
+    void SendInput();
+    void ResetConnection();
+};
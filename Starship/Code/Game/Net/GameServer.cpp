@@ -0,0 +1,429 @@
+#include "GameServer.hpp"
+
+#include "Engine/Core/Time.hpp"
+
+#include "Game/Game.hpp"
+#include "Game/Net/NetBuffer.hpp"
+#include "Game/WorldState.hpp"
+
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+GameServer::GameServer( Game* game, int firstRemotePlayer )
+    : m_Game( game )
+    , m_FirstRemotePlayer( firstRemotePlayer )
+{
+}
+
+//-----------------------------------------------------------------------------
+GameServer::~GameServer()
+{
+    Shutdown();
+}
+
+//-----------------------------------------------------------------------------
+bool GameServer::Startup( unsigned short port )
+{
+    if( !m_Socket.Open( port ) )
+    {
+        return false;
+    }
+
+    m_WorldState = new WorldState();
+    m_CurrentWorld = new NetWorld();
+    ClearNetWorld( *m_CurrentWorld );
+
+    // Remote ships never read local devices, joined or not
+    for( int playerIndex = m_FirstRemotePlayer; playerIndex < m_Game->GetPlayerCount(); ++playerIndex )
+    {
+        m_RemotePilots[ playerIndex ].Reset();
+        m_Game->SetPlayerPilot( playerIndex, &m_RemotePilots[ playerIndex ] );
+    }
+
+    // Tick 0 is reserved to mean "no baseline"
+    m_Tick = 0;
+    m_TickAccumulator = 0.f;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void GameServer::Shutdown()
+{
+    for( int clientIndex = 0; clientIndex < NET_MAX_CLIENTS; ++clientIndex )
+    {
+        DisconnectClient( m_Clients[ clientIndex ] );
+    }
+
+    if( m_Socket.IsOpen() )
+    {
+        for( int playerIndex = m_FirstRemotePlayer; playerIndex < m_Game->GetPlayerCount(); ++playerIndex )
+        {
+            m_Game->SetPlayerPilot( playerIndex, nullptr );
+        }
+    }
+    m_Socket.Close();
+
+    delete m_CurrentWorld;
+    m_CurrentWorld = nullptr;
+
+    delete m_WorldState;
+    m_WorldState = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void GameServer::Update( float deltaSeconds )
+{
+    ReceivePackets();
+    DropTimedOutClients();
+
+    m_TickAccumulator += deltaSeconds;
+    int ticksThisUpdate = 0;
+    while( m_TickAccumulator >= NET_TICK_SECONDS )
+    {
+        m_TickAccumulator -= NET_TICK_SECONDS;
+        if( ticksThisUpdate == NET_MAX_TICKS_PER_UPDATE )
+        {
+            // Too far behind to catch up; let the simulation run slow instead
+            m_TickAccumulator = 0.f;
+            break;
+        }
+
+        StepTick();
+        ticksThisUpdate++;
+    }
+}
+
+//-----------------------------------------------------------------------------
+int GameServer::GetClientCount() const
+{
+    int clientCount = 0;
+    for( int clientIndex = 0; clientIndex < NET_MAX_CLIENTS; ++clientIndex )
+    {
+        if( m_Clients[ clientIndex ].isConnected )
+        {
+            clientCount++;
+        }
+    }
+    return clientCount;
+}
+
+//-----------------------------------------------------------------------------
+void GameServer::ReceivePackets()
+{
+    unsigned char buffer[ NET_MAX_PACKET_BYTES ];
+    NetAddress fromAddress;
+    int bytesReceived = m_Socket.ReceiveFrom( fromAddress, buffer, NET_MAX_PACKET_BYTES );
+    while( bytesReceived > 0 )
+    {
+        NetBufferReader reader( buffer, bytesReceived );
+        unsigned int protocolId = static_cast<unsigned int>(reader.ReadI32());
+        unsigned char packetType = reader.ReadU8();
+        if( !reader.HasOverflowed() && protocolId == NET_PROTOCOL_ID )
+        {
+            switch( packetType )
+            {
+                case NET_PACKET_CONNECT:    HandleConnect( fromAddress );           break;
+                case NET_PACKET_ACK:        HandleAck( fromAddress, reader );       break;
+                case NET_PACKET_DISCONNECT: HandleDisconnect( fromAddress );        break;
+                case NET_PACKET_INPUT:      HandleInput( fromAddress, reader );     break;
+                default:                                                            break;
+            }
+        }
+
+        bytesReceived = m_Socket.ReceiveFrom( fromAddress, buffer, NET_MAX_PACKET_BYTES );
+    }
+}
+
+//-----------------------------------------------------------------------------
+void GameServer::HandleConnect( const NetAddress& address )
+{
+    // Clients repeat connect until the first snapshot lands
+    ClientConnection* client = FindClient( address );
+    if( client != nullptr )
+    {
+        client->lastHeardSeconds = GetCurrentTimeSeconds();
+        return;
+    }
+
+    for( int clientIndex = 0; clientIndex < NET_MAX_CLIENTS; ++clientIndex )
+    {
+        ClientConnection& newClient = m_Clients[ clientIndex ];
+        if( newClient.isConnected )
+        {
+            continue;
+        }
+
+        newClient.isConnected = true;
+        newClient.address = address;
+        newClient.lastAckedTick = 0;
+        newClient.lastHeardSeconds = GetCurrentTimeSeconds();
+        newClient.playerIndex = FindFreePlayer();
+        if( newClient.playerIndex >= 0 )
+        {
+            m_RemotePilots[ newClient.playerIndex ].Reset();
+        }
+
+        newClient.views = new NetWorld[ NET_HISTORY_TICKS ];
+        for( int viewIndex = 0; viewIndex < NET_HISTORY_TICKS; ++viewIndex )
+        {
+            ClearNetWorld( newClient.views[ viewIndex ] );
+        }
+        newClient.priorities.assign( NET_MAX_ENTITIES, 0.f );
+        newClient.pending.reserve( NET_MAX_ENTITIES );
+        return;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void GameServer::HandleAck( const NetAddress& address, NetBufferReader& reader )
+{
+    ClientConnection* client = FindClient( address );
+    int ackedTick = reader.ReadI32();
+    if( client == nullptr || reader.HasOverflowed() || ackedTick > m_Tick )
+    {
+        return;
+    }
+
+    client->lastHeardSeconds = GetCurrentTimeSeconds();
+    if( ackedTick > client->lastAckedTick )
+    {
+        client->lastAckedTick = ackedTick;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void GameServer::HandleDisconnect( const NetAddress& address )
+{
+    ClientConnection* client = FindClient( address );
+    if( client != nullptr )
+    {
+        DisconnectClient( *client );
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Newest first, each one sequence older than the one before it; the pilot
+//  skips what it already has, so they are fed oldest first
+void GameServer::HandleInput( const NetAddress& address, NetBufferReader& reader )
+{
+    ClientConnection* client = FindClient( address );
+    int sequence = reader.ReadI32();
+    int inputCount = reader.ReadU8();
+    if( client == nullptr || inputCount > NET_INPUT_REDUNDANCY )
+    {
+        return;
+    }
+
+    PlayerInput inputs[ NET_INPUT_REDUNDANCY ];
+    for( int inputIndex = 0; inputIndex < inputCount; ++inputIndex )
+    {
+        ReadPlayerInput( reader, inputs[ inputIndex ] );
+    }
+    if( reader.HasOverflowed() )
+    {
+        return;
+    }
+
+    client->lastHeardSeconds = GetCurrentTimeSeconds();
+    if( client->playerIndex < 0 )
+    {
+        return;
+    }
+
+    RemotePilot& pilot = m_RemotePilots[ client->playerIndex ];
+    for( int inputIndex = inputCount - 1; inputIndex >= 0; --inputIndex )
+    {
+        pilot.ReceiveInput( sequence - inputIndex, inputs[ inputIndex ] );
+    }
+}
+
+//-----------------------------------------------------------------------------
+void GameServer::DropTimedOutClients()
+{
+    double currentSeconds = GetCurrentTimeSeconds();
+    for( int clientIndex = 0; clientIndex < NET_MAX_CLIENTS; ++clientIndex )
+    {
+        ClientConnection& client = m_Clients[ clientIndex ];
+        if( client.isConnected &&
+            currentSeconds - client.lastHeardSeconds > NET_CLIENT_TIMEOUT_SECONDS )
+        {
+            DisconnectClient( client );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void GameServer::StepTick()
+{
+    // Remote ships take whatever their clients sent since the last tick
+    m_Game->Update( NET_TICK_SECONDS );
+    m_Tick++;
+
+    m_Game->CaptureWorldState( *m_WorldState );
+    QuantizeWorldState( *m_WorldState, *m_CurrentWorld );
+    m_CurrentWorld->tick = m_Tick;
+
+    m_LastPacketBytes = 0;
+    m_LastPacketEntities = 0;
+    m_LastPendingEntities = 0;
+    for( int clientIndex = 0; clientIndex < NET_MAX_CLIENTS; ++clientIndex )
+    {
+        if( m_Clients[ clientIndex ].isConnected )
+        {
+            SendSnapshot( m_Clients[ clientIndex ] );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void GameServer::SendSnapshot( ClientConnection& client )
+{
+    // Start from what the client is known to have, moved forward to now. An
+    //  ack older than the history means starting from nothing.
+    int baselineTick = client.lastAckedTick;
+    const NetWorld* baseline = nullptr;
+    if( baselineTick > 0 && m_Tick - baselineTick < NET_HISTORY_TICKS )
+    {
+        const NetWorld& candidate = client.views[ baselineTick % NET_HISTORY_TICKS ];
+        if( candidate.tick == baselineTick )
+        {
+            baseline = &candidate;
+        }
+    }
+
+    NetWorld& view = client.views[ m_Tick % NET_HISTORY_TICKS ];
+    if( baseline != nullptr )
+    {
+        ExtrapolateNetWorld( *baseline, m_Tick - baselineTick, view );
+    }
+    else
+    {
+        baselineTick = 0;
+        ClearNetWorld( view );
+        view.tick = m_Tick;
+    }
+    view.gameTime = m_CurrentWorld->gameTime;
+    view.waveNumber = m_CurrentWorld->waveNumber;
+    view.playerShipCurrentLife = m_CurrentWorld->playerShipCurrentLife;
+    view.flags = m_CurrentWorld->flags;
+
+    // Anything out of date gains priority every tick it is not sent, so low
+    //  weight entities still get through once the important ones are current
+    client.pending.clear();
+    for( int netIndex = 0; netIndex < NET_MAX_ENTITIES; ++netIndex )
+    {
+        const NetEntity& current = m_CurrentWorld->entities[ netIndex ];
+        const NetEntity& predicted = view.entities[ netIndex ];
+        if( GetNetEntityChangedFields( current, predicted ) == 0 )
+        {
+            client.priorities[ netIndex ] = 0.f;
+            continue;
+        }
+
+        EntityKind kind = current.kind != ENTITY_KIND_NONE ? current.kind : predicted.kind;
+        client.priorities[ netIndex ] += GetNetEntityPriority( kind );
+        client.pending.push_back( netIndex );
+    }
+
+    const std::vector<float>& priorities = client.priorities;
+    std::sort( client.pending.begin(), client.pending.end(), [&priorities]( int indexA, int indexB )
+    {
+        return priorities[ indexA ] > priorities[ indexB ];
+    } );
+
+    unsigned char buffer[ NET_MAX_PACKET_BYTES ];
+    NetBufferWriter writer( buffer, NET_MAX_PACKET_BYTES );
+    writer.WriteI32( static_cast<int>(NET_PROTOCOL_ID) );
+    writer.WriteU8( NET_PACKET_SNAPSHOT );
+    writer.WriteI32( m_Tick );
+    writer.WriteI32( baselineTick );
+    writer.WriteU8( client.playerIndex >= 0 ? static_cast<unsigned char>(client.playerIndex) : NET_NO_PLAYER );
+    WriteNetWorldHeader( writer, view );
+    int entityCountOffset = writer.GetBytesWritten();
+    writer.WriteU16( 0 );
+
+    constexpr int entityHeaderBytes = 3;        // Id and field mask
+    int entitiesWritten = 0;
+    for( int pendingIndex = 0; pendingIndex < static_cast<int>(client.pending.size()); ++pendingIndex )
+    {
+        int netIndex = client.pending[ pendingIndex ];
+        const NetEntity& current = m_CurrentWorld->entities[ netIndex ];
+        NetEntity& predicted = view.entities[ netIndex ];
+        int fields = GetNetEntityChangedFields( current, predicted );
+
+        int entityBytes = entityHeaderBytes + GetNetEntityFieldBytes( current, fields );
+        if( entityBytes > writer.GetBytesRemaining() )
+        {
+            // A smaller update further down may still fit
+            continue;
+        }
+
+        writer.WriteU16( static_cast<unsigned short>(netIndex) );
+        writer.WriteU8( static_cast<unsigned char>(fields) );
+        WriteNetEntityFields( writer, current, fields );
+
+        // Keep our copy of the client's view identical to what it will decode
+        ApplyNetEntityFields( predicted, current, fields );
+        client.priorities[ netIndex ] = 0.f;
+        entitiesWritten++;
+    }
+    writer.OverwriteU16( entityCountOffset, static_cast<unsigned short>(entitiesWritten) );
+
+    m_Socket.SendTo( client.address, buffer, writer.GetBytesWritten() );
+
+    m_LastPacketBytes = std::max( m_LastPacketBytes, writer.GetBytesWritten() );
+    m_LastPacketEntities = std::max( m_LastPacketEntities, entitiesWritten );
+    m_LastPendingEntities = std::max( m_LastPendingEntities, static_cast<int>(client.pending.size()) - entitiesWritten );
+}
+
+//-----------------------------------------------------------------------------
+GameServer::ClientConnection* GameServer::FindClient( const NetAddress& address )
+{
+    for( int clientIndex = 0; clientIndex < NET_MAX_CLIENTS; ++clientIndex )
+    {
+        ClientConnection& client = m_Clients[ clientIndex ];
+        if( client.isConnected && client.address == address )
+        {
+            return &client;
+        }
+    }
+    return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+int GameServer::FindFreePlayer() const
+{
+    for( int playerIndex = m_FirstRemotePlayer; playerIndex < m_Game->GetPlayerCount(); ++playerIndex )
+    {
+        bool isTaken = false;
+        for( int clientIndex = 0; clientIndex < NET_MAX_CLIENTS; ++clientIndex )
+        {
+            isTaken |= m_Clients[ clientIndex ].isConnected && m_Clients[ clientIndex ].playerIndex == playerIndex;
+        }
+        if( !isTaken )
+        {
+            return playerIndex;
+        }
+    }
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+void GameServer::DisconnectClient( ClientConnection& client )
+{
+    // Its ship stays in the world, idle, for the next client to take over
+    if( client.playerIndex >= 0 )
+    {
+        m_RemotePilots[ client.playerIndex ].Reset();
+        client.playerIndex = -1;
+    }
+
+    client.isConnected = false;
+    client.lastAckedTick = 0;
+
+    delete[] client.views;
+    client.views = nullptr;
+
+    client.priorities.clear();
+    client.pending.clear();
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Game/Net/NetSocket.hpp"
+#include "Game/Net/RemotePilot.hpp"
+#include "Game/Net/Replication.hpp"
+
+#include <vector>
+
+class Game;
+class NetBufferReader;
+
+//-----------------------------------------------------------------------------
+// Authoritative server: steps the Game at a fixed tick and replicates it to
+//  every connected client. Each client gets one packet per tick holding only
+//  what differs from its last acknowledged world. When there is more than
+//  fits, entities that have waited longest (weighted by kind) go first.
+//
+//  Ships from firstRemotePlayer up to the game's player count belong to
+//  clients, one each in the order they connect; later clients spectate. A
+//  ship nobody has joined sits idle, like a local ship with no pad.
+class GameServer
+{
+public:
+    GameServer( Game* game, int firstRemotePlayer );
+    ~GameServer();
+
+    bool Startup( unsigned short port );
+    void Shutdown();
+    void Update( float deltaSeconds );
+
+    int GetTick() const { return m_Tick; }
+    int GetClientCount() const;
+    int GetLastPacketBytes() const { return m_LastPacketBytes; }
+    int GetLastPacketEntities() const { return m_LastPacketEntities; }
+    int GetLastPendingEntities() const { return m_LastPendingEntities; }
+
+private:
+    struct ClientConnection
+    {
+        bool isConnected = false;
+        NetAddress address;
+        int lastAckedTick = 0;
+        double lastHeardSeconds = 0.0;
+        int playerIndex = -1;               // Ship it flies, -1 when spectating
+
+        NetWorld* views = nullptr;          // What the client has, ring indexed by tick
+        std::vector<float> priorities;      // Per entity, grows each tick it waits
+        std::vector<int> pending;           // Scratch, entities out of date this tick
+    };
+
+    Game* m_Game = nullptr;
+    int m_FirstRemotePlayer = 0;
+    UdpSocket m_Socket;
+    ClientConnection m_Clients[ NET_MAX_CLIENTS ];
+    RemotePilot m_RemotePilots[ MAX_PLAYERS ];
+
+    WorldState* m_WorldState = nullptr;
+    NetWorld* m_CurrentWorld = nullptr;
+
+    int m_Tick = 0;
+    float m_TickAccumulator = 0.f;
+
+    int m_LastPacketBytes = 0;
+    int m_LastPacketEntities = 0;
+    int m_LastPendingEntities = 0;
+
+    void ReceivePackets();
+    void HandleConnect( const NetAddress& address );
+    void HandleAck( const NetAddress& address, NetBufferReader& reader );
+    void HandleDisconnect( const NetAddress& address );
+    void HandleInput( const NetAddress& address, NetBufferReader& reader );
+    void DropTimedOutClients();
+
+    void StepTick();
+    void SendSnapshot( ClientConnection& client );
+
+    ClientConnection* FindClient( const NetAddress& address );
+    int FindFreePlayer() const;
+    void DisconnectClient( ClientConnection& client );
+};
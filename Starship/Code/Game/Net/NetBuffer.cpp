@@ -0,0 +1,172 @@
+#include "NetBuffer.hpp"
+
+#include <cstring>
+
+//-----------------------------------------------------------------------------
+NetBufferWriter::NetBufferWriter( unsigned char* buffer, int capacityBytes )
+    : m_Buffer( buffer )
+    , m_Capacity( capacityBytes )
+{
+}
+
+//-----------------------------------------------------------------------------
+void NetBufferWriter::WriteU8( unsigned char value )
+{
+    if( Reserve( 1 ) )
+    {
+        m_Buffer[ m_Offset++ ] = value;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void NetBufferWriter::WriteU16( unsigned short value )
+{
+    if( Reserve( 2 ) )
+    {
+        m_Buffer[ m_Offset++ ] = static_cast<unsigned char>(value);
+        m_Buffer[ m_Offset++ ] = static_cast<unsigned char>(value >> 8);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void NetBufferWriter::WriteI16( short value )
+{
+    WriteU16( static_cast<unsigned short>(value) );
+}
+
+//-----------------------------------------------------------------------------
+void NetBufferWriter::WriteI32( int value )
+{
+    unsigned int bits = static_cast<unsigned int>(value);
+    if( Reserve( 4 ) )
+    {
+        m_Buffer[ m_Offset++ ] = static_cast<unsigned char>(bits);
+        m_Buffer[ m_Offset++ ] = static_cast<unsigned char>(bits >> 8);
+        m_Buffer[ m_Offset++ ] = static_cast<unsigned char>(bits >> 16);
+        m_Buffer[ m_Offset++ ] = static_cast<unsigned char>(bits >> 24);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void NetBufferWriter::WriteF32( float value )
+{
+    int bits = 0;
+    memcpy( &bits, &value, sizeof( float ) );
+    WriteI32( bits );
+}
+
+//-----------------------------------------------------------------------------
+void NetBufferWriter::WriteBytes( const void* data, int dataBytes )
+{
+    if( Reserve( dataBytes ) )
+    {
+        memcpy( &m_Buffer[ m_Offset ], data, dataBytes );
+        m_Offset += dataBytes;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Used to patch counts that are only known after the body is written
+void NetBufferWriter::OverwriteU16( int offset, unsigned short value )
+{
+    if( offset < 0 || offset + 2 > m_Offset )
+    {
+        m_HasOverflowed = true;
+        return;
+    }
+
+    m_Buffer[ offset ] = static_cast<unsigned char>(value);
+    m_Buffer[ offset + 1 ] = static_cast<unsigned char>(value >> 8);
+}
+
+//-----------------------------------------------------------------------------
+bool NetBufferWriter::Reserve( int bytes )
+{
+    if( m_HasOverflowed || m_Offset + bytes > m_Capacity )
+    {
+        m_HasOverflowed = true;
+        return false;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+NetBufferReader::NetBufferReader( const unsigned char* buffer, int sizeBytes )
+    : m_Buffer( buffer )
+    , m_Size( sizeBytes )
+{
+}
+
+//-----------------------------------------------------------------------------
+unsigned char NetBufferReader::ReadU8()
+{
+    if( !Consume( 1 ) )
+    {
+        return 0;
+    }
+    return m_Buffer[ m_Offset - 1 ];
+}
+
+//-----------------------------------------------------------------------------
+unsigned short NetBufferReader::ReadU16()
+{
+    if( !Consume( 2 ) )
+    {
+        return 0;
+    }
+    const unsigned char* bytes = &m_Buffer[ m_Offset - 2 ];
+    return static_cast<unsigned short>(bytes[ 0 ] | (bytes[ 1 ] << 8));
+}
+
+//-----------------------------------------------------------------------------
+short NetBufferReader::ReadI16()
+{
+    return static_cast<short>(ReadU16());
+}
+
+//-----------------------------------------------------------------------------
+int NetBufferReader::ReadI32()
+{
+    if( !Consume( 4 ) )
+    {
+        return 0;
+    }
+    const unsigned char* bytes = &m_Buffer[ m_Offset - 4 ];
+    unsigned int bits = static_cast<unsigned int>(bytes[ 0 ]) |
+                        (static_cast<unsigned int>(bytes[ 1 ]) << 8) |
+                        (static_cast<unsigned int>(bytes[ 2 ]) << 16) |
+                        (static_cast<unsigned int>(bytes[ 3 ]) << 24);
+    return static_cast<int>(bits);
+}
+
+//-----------------------------------------------------------------------------
+float NetBufferReader::ReadF32()
+{
+    int bits = ReadI32();
+    float value = 0.f;
+    memcpy( &value, &bits, sizeof( float ) );
+    return value;
+}
+
+//-----------------------------------------------------------------------------
+void NetBufferReader::ReadBytes( void* outData, int dataBytes )
+{
+    if( !Consume( dataBytes ) )
+    {
+        memset( outData, 0, dataBytes );
+        return;
+    }
+    memcpy( outData, &m_Buffer[ m_Offset - dataBytes ], dataBytes );
+}
+
+//-----------------------------------------------------------------------------
+bool NetBufferReader::Consume( int bytes )
+{
+    if( m_HasOverflowed || bytes < 0 || m_Offset + bytes > m_Size )
+    {
+        m_HasOverflowed = true;
+        return false;
+    }
+    m_Offset += bytes;
+    return true;
+}
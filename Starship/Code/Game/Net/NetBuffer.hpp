@@ -0,0 +1,59 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+// Little endian packing into a caller owned buffer. Writes past the end are
+//  dropped and flag the writer as overflowed instead of asserting, so callers
+//  can check once after building a whole packet.
+class NetBufferWriter
+{
+public:
+    NetBufferWriter( unsigned char* buffer, int capacityBytes );
+
+    void WriteU8( unsigned char value );
+    void WriteU16( unsigned short value );
+    void WriteI16( short value );
+    void WriteI32( int value );
+    void WriteF32( float value );
+    void WriteBytes( const void* data, int dataBytes );
+
+    void OverwriteU16( int offset, unsigned short value );
+
+    int GetBytesWritten() const { return m_Offset; }
+    int GetBytesRemaining() const { return m_Capacity - m_Offset; }
+    bool HasOverflowed() const { return m_HasOverflowed; }
+
+private:
+    unsigned char* m_Buffer = nullptr;
+    int m_Capacity = 0;
+    int m_Offset = 0;
+    bool m_HasOverflowed = false;
+
+    bool Reserve( int bytes );
+};
+
+//-----------------------------------------------------------------------------
+// Reads past the end return zero and flag the reader, so a truncated or
+//  malicious packet can be rejected after parsing without per field checks
+class NetBufferReader
+{
+public:
+    NetBufferReader( const unsigned char* buffer, int sizeBytes );
+
+    unsigned char ReadU8();
+    unsigned short ReadU16();
+    short ReadI16();
+    int ReadI32();
+    float ReadF32();
+    void ReadBytes( void* outData, int dataBytes );
+
+    int GetBytesRemaining() const { return m_Size - m_Offset; }
+    bool HasOverflowed() const { return m_HasOverflowed; }
+
+private:
+    const unsigned char* m_Buffer = nullptr;
+    int m_Size = 0;
+    int m_Offset = 0;
+    bool m_HasOverflowed = false;
+
+    bool Consume( int bytes );
+};
@@ -0,0 +1,186 @@
+#define WIN32_LEAN_AND_MEAN		// Always #define this before #including <windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment( lib, "ws2_32.lib" )
+
+#include "NetSocket.hpp"
+
+static int s_OpenSocketCount = 0;
+
+//-----------------------------------------------------------------------------
+static sockaddr_in MakeSocketAddress( const NetAddress& address )
+{
+    sockaddr_in socketAddress = {};
+    socketAddress.sin_family = AF_INET;
+    socketAddress.sin_port = htons( address.port );
+    socketAddress.sin_addr.s_addr = htonl( address.ipv4 );
+    return socketAddress;
+}
+
+//-----------------------------------------------------------------------------
+NetAddress NetAddress::MakeLoopback( unsigned short port )
+{
+    NetAddress address;
+    address.ipv4 = INADDR_LOOPBACK;
+    address.port = port;
+    return address;
+}
+
+//-----------------------------------------------------------------------------
+bool NetAddress::MakeFromString( const char* address,
+                                 unsigned short port,
+                                 NetAddress& outAddress )
+{
+    in_addr parsedAddress;
+    if( inet_pton( AF_INET, address, &parsedAddress ) != 1 )
+    {
+        return false;
+    }
+
+    outAddress.ipv4 = ntohl( parsedAddress.s_addr );
+    outAddress.port = port;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool NetAddress::operator==( const NetAddress& other ) const
+{
+    return ipv4 == other.ipv4 && port == other.port;
+}
+
+//-----------------------------------------------------------------------------
+bool NetAddress::operator!=( const NetAddress& other ) const
+{
+    return !(*this == other);
+}
+
+//-----------------------------------------------------------------------------
+UdpSocket::UdpSocket()
+    : m_Socket( INVALID_SOCKET )
+{
+}
+
+//-----------------------------------------------------------------------------
+UdpSocket::~UdpSocket()
+{
+    Close();
+}
+
+//-----------------------------------------------------------------------------
+bool UdpSocket::Open( unsigned short port )
+{
+    Close();
+
+    if( s_OpenSocketCount == 0 )
+    {
+        WSADATA wsaData;
+        if( WSAStartup( MAKEWORD( 2, 2 ), &wsaData ) != 0 )
+        {
+            return false;
+        }
+    }
+    s_OpenSocketCount++;
+    m_HoldsWinsock = true;
+
+    SOCKET newSocket = socket( AF_INET, SOCK_DGRAM, IPPROTO_UDP );
+    if( newSocket == INVALID_SOCKET )
+    {
+        Close();
+        return false;
+    }
+    m_Socket = newSocket;
+
+    sockaddr_in bindAddress = {};
+    bindAddress.sin_family = AF_INET;
+    bindAddress.sin_port = htons( port );
+    bindAddress.sin_addr.s_addr = htonl( INADDR_ANY );
+    if( bind( newSocket, reinterpret_cast<const sockaddr*>(&bindAddress), sizeof( bindAddress ) ) == SOCKET_ERROR )
+    {
+        Close();
+        return false;
+    }
+
+    // Games poll once per frame, never wait on the network
+    u_long isNonBlocking = 1;
+    if( ioctlsocket( newSocket, FIONBIO, &isNonBlocking ) == SOCKET_ERROR )
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void UdpSocket::Close()
+{
+    if( m_Socket != INVALID_SOCKET )
+    {
+        closesocket( static_cast<SOCKET>(m_Socket) );
+        m_Socket = INVALID_SOCKET;
+    }
+
+    // Open() counts itself before the socket exists, so a failed open still
+    //  balances its WSAStartup here
+    if( m_HoldsWinsock )
+    {
+        m_HoldsWinsock = false;
+        s_OpenSocketCount--;
+        if( s_OpenSocketCount == 0 )
+        {
+            WSACleanup();
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool UdpSocket::IsOpen() const
+{
+    return m_Socket != INVALID_SOCKET;
+}
+
+//-----------------------------------------------------------------------------
+bool UdpSocket::SendTo( const NetAddress& address, const void* data, int dataBytes )
+{
+    if( !IsOpen() )
+    {
+        return false;
+    }
+
+    sockaddr_in socketAddress = MakeSocketAddress( address );
+    int bytesSent = sendto( static_cast<SOCKET>(m_Socket),
+                            static_cast<const char*>(data),
+                            dataBytes,
+                            0,
+                            reinterpret_cast<const sockaddr*>(&socketAddress),
+                            sizeof( socketAddress ) );
+    return bytesSent == dataBytes;
+}
+
+//-----------------------------------------------------------------------------
+int UdpSocket::ReceiveFrom( NetAddress& outAddress, void* buffer, int bufferBytes )
+{
+    if( !IsOpen() )
+    {
+        return 0;
+    }
+
+    sockaddr_in socketAddress = {};
+    int socketAddressBytes = sizeof( socketAddress );
+    int bytesReceived = recvfrom( static_cast<SOCKET>(m_Socket),
+                                  static_cast<char*>(buffer),
+                                  bufferBytes,
+                                  0,
+                                  reinterpret_cast<sockaddr*>(&socketAddress),
+                                  &socketAddressBytes );
+    if( bytesReceived == SOCKET_ERROR )
+    {
+        // WSAEWOULDBLOCK is the normal empty queue; WSAECONNRESET is windows
+        //  reporting an earlier send hit a closed port. Neither is fatal for UDP.
+        return 0;
+    }
+
+    outAddress.ipv4 = ntohl( socketAddress.sin_addr.s_addr );
+    outAddress.port = ntohs( socketAddress.sin_port );
+    return bytesReceived;
+}
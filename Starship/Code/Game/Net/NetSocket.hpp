@@ -0,0 +1,40 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+// IPv4 address and port, both in host byte order
+struct NetAddress
+{
+    unsigned int ipv4 = 0;
+    unsigned short port = 0;
+
+    static NetAddress MakeLoopback( unsigned short port );
+    static bool MakeFromString( const char* address,
+                                unsigned short port,
+                                NetAddress& outAddress );
+
+    bool operator==( const NetAddress& other ) const;
+    bool operator!=( const NetAddress& other ) const;
+};
+
+//-----------------------------------------------------------------------------
+// Non-blocking UDP socket. Winsock is started by the first socket opened and
+//  cleaned up after the last one closes.
+class UdpSocket
+{
+public:
+    UdpSocket();
+    ~UdpSocket();
+
+    bool Open( unsigned short port );       // Port 0 lets the OS pick one
+    void Close();
+    bool IsOpen() const;
+
+    bool SendTo( const NetAddress& address, const void* data, int dataBytes );
+
+    // Returns the number of bytes received, 0 when nothing is waiting
+    int ReceiveFrom( NetAddress& outAddress, void* buffer, int bufferBytes );
+
+private:
+    unsigned long long m_Socket;            // SOCKET, kept opaque so winsock stays out of headers
+    bool m_HoldsWinsock = false;
+};
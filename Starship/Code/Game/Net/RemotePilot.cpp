@@ -0,0 +1,37 @@
+#include "RemotePilot.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+
+//-----------------------------------------------------------------------------
+void RemotePilot::Reset()
+{
+    m_HeldInput = PlayerInput();
+    m_PendingButtons = 0;
+    m_LastSequence = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Sequences start at 1; anything already seen is a redundant copy
+void RemotePilot::ReceiveInput( int sequence, const PlayerInput& input )
+{
+    if( sequence <= m_LastSequence )
+    {
+        return;
+    }
+
+    m_LastSequence = sequence;
+    m_HeldInput = input;
+    m_PendingButtons |= input.buttons & PLAYER_INPUT_EDGE_BUTTONS;
+}
+
+//-----------------------------------------------------------------------------
+PlayerInput RemotePilot::UpdatePilot( const Game& game, int playerIndex )
+{
+    UNUSED( game );
+    UNUSED( playerIndex );
+
+    PlayerInput input = m_HeldInput;
+    input.buttons = static_cast<unsigned char>((m_HeldInput.buttons & PLAYER_INPUT_STEER) | m_PendingButtons);
+    m_PendingButtons = 0;
+    return input;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Game/PlayerPilot.hpp"
+
+//-----------------------------------------------------------------------------
+// Flies a server ship from a client's input packets. Held controls are
+//  whatever arrived last; presses are kept until a tick takes
+//  them, since packets and ticks don't line up one to one. Idle (no client)
+//  it presses nothing.
+class RemotePilot: public PlayerPilot
+{
+public:
+    void Reset();
+    void ReceiveInput( int sequence, const PlayerInput& input );
+
+    int GetLastSequence() const { return m_LastSequence; }
+
+    virtual PlayerInput UpdatePilot( const Game& game, int playerIndex ) override;
+
+private:
+    PlayerInput m_HeldInput;
+    unsigned char m_PendingButtons = 0;
+    int m_LastSequence = 0;
+};
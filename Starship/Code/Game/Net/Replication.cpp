@@ -0,0 +1,503 @@
+#include "Replication.hpp"
+
+#include "Game/Net/NetBuffer.hpp"
+#include "Game/PlayerInput.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+//-----------------------------------------------------------------------------
+static int RoundToInt( float value )
+{
+    return static_cast<int>(floorf( value + .5f ));
+}
+
+//-----------------------------------------------------------------------------
+static int ClampInt( int value, int minValue, int maxValue )
+{
+    if( value < minValue ) { return minValue; }
+    if( value > maxValue ) { return maxValue; }
+    return value;
+}
+
+//-----------------------------------------------------------------------------
+// Shortest signed distance between two 16 bit wrapped values
+static int GetWrappedDifference( int from, int to )
+{
+    int difference = (to - from) & 0xFFFF;
+    return difference >= 0x8000 ? difference - 0x10000 : difference;
+}
+
+//-----------------------------------------------------------------------------
+static bool AreColorsEqual( const Rgba8& colorA, const Rgba8& colorB )
+{
+    return colorA.r == colorB.r &&
+           colorA.g == colorB.g &&
+           colorA.b == colorB.b &&
+           colorA.a == colorB.a;
+}
+
+//-----------------------------------------------------------------------------
+// Maps a net id back to its WorldState slot; shapes only exist for the kinds
+//  with random outlines
+static EntityState* GetEntityStateForNetIndex( WorldState& state,
+                                               int netIndex,
+                                               EntityShapeState** outShape )
+{
+    *outShape = nullptr;
+    if( netIndex < NET_FIRST_ASTEROID_INDEX )
+    {
+        return &state.playerShips[ netIndex - NET_FIRST_PLAYER_SHIP_INDEX ];
+    }
+    if( netIndex < NET_FIRST_BULLET_INDEX )
+    {
+        *outShape = &state.asteroidShapes[ netIndex - NET_FIRST_ASTEROID_INDEX ];
+        return &state.asteroids[ netIndex - NET_FIRST_ASTEROID_INDEX ];
+    }
+    if( netIndex < NET_FIRST_DEBRIS_INDEX )
+    {
+        return &state.bullets[ netIndex - NET_FIRST_BULLET_INDEX ];
+    }
+    if( netIndex < NET_FIRST_BEETLE_INDEX )
+    {
+        *outShape = &state.debrisShapes[ netIndex - NET_FIRST_DEBRIS_INDEX ];
+        return &state.debris[ netIndex - NET_FIRST_DEBRIS_INDEX ];
+    }
+    if( netIndex < NET_FIRST_WASP_INDEX )
+    {
+        return &state.beetles[ netIndex - NET_FIRST_BEETLE_INDEX ];
+    }
+    return &state.wasps[ netIndex - NET_FIRST_WASP_INDEX ];
+}
+
+//-----------------------------------------------------------------------------
+static const EntityState* GetEntityStateForNetIndex( const WorldState& state,
+                                                     int netIndex,
+                                                     const EntityShapeState** outShape )
+{
+    EntityShapeState* shape = nullptr;
+    const EntityState* entityState = GetEntityStateForNetIndex( const_cast<WorldState&>(state), netIndex, &shape );
+    *outShape = shape;
+    return entityState;
+}
+
+//-----------------------------------------------------------------------------
+static void QuantizeEntity( const EntityState& state,
+                            const EntityShapeState* shape,
+                            NetEntity& outEntity )
+{
+    memset( static_cast<void*>(&outEntity), 0, sizeof( NetEntity ) );
+    if( state.kind == ENTITY_KIND_NONE )
+    {
+        return;
+    }
+
+    constexpr float velocityScale = NET_TICK_SECONDS * NET_SUBQUANTA_PER_UNIT;
+    constexpr float angleScale = NET_ANGLE_QUANTA / 360.f;
+
+    outEntity.kind = state.kind;
+    outEntity.x = ClampInt( RoundToInt( state.position.x * NET_QUANTA_PER_UNIT ), -32768, 32767 ) * NET_SUBQUANTA_PER_QUANTUM;
+    outEntity.y = ClampInt( RoundToInt( state.position.y * NET_QUANTA_PER_UNIT ), -32768, 32767 ) * NET_SUBQUANTA_PER_QUANTUM;
+    outEntity.velocityX = ClampInt( RoundToInt( state.velocity.x * velocityScale ), -32768, 32767 );
+    outEntity.velocityY = ClampInt( RoundToInt( state.velocity.y * velocityScale ), -32768, 32767 );
+    outEntity.angle = RoundToInt( state.angleDegrees * angleScale ) & 0xFFFF;
+    outEntity.angularVelocity = ClampInt( RoundToInt( state.angularVelocity * NET_TICK_SECONDS * angleScale ), -32768, 32767 );
+    outEntity.ageTicks = RoundToInt( state.age / NET_TICK_SECONDS ) & 0xFFFF;
+    outEntity.lifeSpanTicks = ClampInt( RoundToInt( state.lifeSpan / NET_TICK_SECONDS ), 0, 65535 );
+
+    // Debris bakes its own color into its mesh, the entity color is unused
+    outEntity.color = state.kind == ENTITY_KIND_DEBRIS ? state.secondaryColor : state.color;
+    outEntity.health = static_cast<unsigned char>(ClampInt( state.health, 0, 255 ));
+    outEntity.flags = (state.isDead ? NET_ENTITY_FLAG_DEAD : 0) |
+                      (state.isThrusting ? NET_ENTITY_FLAG_THRUSTING : 0);
+
+    if( shape != nullptr )
+    {
+        // Outlines are evenly spaced corners, so only the lengths vary
+        outEntity.cornerCount = static_cast<unsigned char>(ClampInt( shape->cornerCount, 0, MAX_ENTITY_SHAPE_CORNERS ));
+        for( int cornerIndex = 0; cornerIndex < outEntity.cornerCount; ++cornerIndex )
+        {
+            float length = shape->corners[ cornerIndex ].GetLength();
+            outEntity.cornerLengths[ cornerIndex ] = static_cast<unsigned char>(ClampInt( RoundToInt( length * NET_CORNER_QUANTA_PER_UNIT ), 0, 255 ));
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void ClearNetWorld( NetWorld& outWorld )
+{
+    memset( static_cast<void*>(&outWorld), 0, sizeof( NetWorld ) );
+}
+
+//-----------------------------------------------------------------------------
+void QuantizeWorldState( const WorldState& state, NetWorld& outWorld )
+{
+    outWorld.gameTime = state.header.gameTime;
+    outWorld.waveNumber = static_cast<unsigned char>(ClampInt( state.header.waveNumber, 0, 255 ));
+    outWorld.playerShipCurrentLife = static_cast<unsigned char>(ClampInt( state.header.playerShipCurrentLife, 0, 255 ));
+    outWorld.flags = (state.header.isAttractMode ? NET_WORLD_FLAG_ATTRACT_MODE : 0) |
+                     (state.header.wasJustAttractMode ? NET_WORLD_FLAG_WAS_JUST_ATTRACT_MODE : 0);
+
+    for( int netIndex = 0; netIndex < NET_MAX_ENTITIES; ++netIndex )
+    {
+        const EntityShapeState* shape = nullptr;
+        const EntityState* entityState = GetEntityStateForNetIndex( state, netIndex, &shape );
+        QuantizeEntity( *entityState, shape, outWorld.entities[ netIndex ] );
+    }
+}
+
+//-----------------------------------------------------------------------------
+void ExtrapolateNetWorld( const NetWorld& baseline, int ticks, NetWorld& outWorld )
+{
+    if( &outWorld != &baseline )
+    {
+        memcpy( static_cast<void*>(&outWorld), &baseline, sizeof( NetWorld ) );
+    }
+    outWorld.tick = baseline.tick + ticks;
+
+    for( int netIndex = 0; netIndex < NET_MAX_ENTITIES; ++netIndex )
+    {
+        NetEntity& entity = outWorld.entities[ netIndex ];
+        if( entity.kind == ENTITY_KIND_NONE )
+        {
+            continue;
+        }
+
+        entity.x += entity.velocityX * ticks;
+        entity.y += entity.velocityY * ticks;
+        entity.angle = (entity.angle + entity.angularVelocity * ticks) & 0xFFFF;
+        entity.ageTicks = (entity.ageTicks + ticks) & 0xFFFF;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Only replicated fields are written; everything else comes from the per
+//  kind defaults (radii, scale) or is left as the caller had it (header, rng)
+void NetWorldToWorldState( const NetWorld& world,
+                           const EntityState* defaultStatesByKind,
+                           WorldState& inOutState )
+{
+    constexpr float velocityScale = 1.f / (NET_TICK_SECONDS * NET_SUBQUANTA_PER_UNIT);
+    constexpr float angleScale = 360.f / NET_ANGLE_QUANTA;
+
+    WorldStateHeader& header = inOutState.header;
+    header.gameTime = world.gameTime;
+    header.waveNumber = world.waveNumber;
+    header.playerShipCurrentLife = world.playerShipCurrentLife;
+    header.isAttractMode = (world.flags & NET_WORLD_FLAG_ATTRACT_MODE) != 0;
+    header.wasJustAttractMode = (world.flags & NET_WORLD_FLAG_WAS_JUST_ATTRACT_MODE) != 0;
+    header.spawnNextWave = false;
+    header.explosionLightCount = 0;         // Not replicated; clients draw no explosion lights
+
+    for( int netIndex = 0; netIndex < NET_MAX_ENTITIES; ++netIndex )
+    {
+        const NetEntity& entity = world.entities[ netIndex ];
+        EntityShapeState* shape = nullptr;
+        EntityState& entityState = *GetEntityStateForNetIndex( inOutState, netIndex, &shape );
+
+        if( entity.kind == ENTITY_KIND_NONE || entity.kind >= ENTITY_KIND_COUNT )
+        {
+            // Ships always exist locally; until the server sends one keep
+            //  whatever the local game already had
+            if( netIndex >= NET_FIRST_ASTEROID_INDEX )
+            {
+                memset( static_cast<void*>(&entityState), 0, sizeof( EntityState ) );
+            }
+            continue;
+        }
+
+        entityState = defaultStatesByKind[ entity.kind ];
+        entityState.kind = entity.kind;
+        entityState.position = Vec3( static_cast<float>(entity.x) / NET_SUBQUANTA_PER_UNIT,
+                                     static_cast<float>(entity.y) / NET_SUBQUANTA_PER_UNIT,
+                                     0.f );
+        entityState.velocity = Vec3( entity.velocityX * velocityScale,
+                                     entity.velocityY * velocityScale,
+                                     0.f );
+        entityState.angleDegrees = entity.angle * angleScale;
+        entityState.angularVelocity = entity.angularVelocity * angleScale / NET_TICK_SECONDS;
+        entityState.age = entity.ageTicks * NET_TICK_SECONDS;
+        entityState.lifeSpan = entity.lifeSpanTicks * NET_TICK_SECONDS;
+        entityState.health = entity.health;
+        entityState.isDead = (entity.flags & NET_ENTITY_FLAG_DEAD) != 0;
+        entityState.isThrusting = (entity.flags & NET_ENTITY_FLAG_THRUSTING) != 0;
+        if( entity.kind == ENTITY_KIND_DEBRIS )
+        {
+            entityState.secondaryColor = entity.color;
+        }
+        else
+        {
+            entityState.color = entity.color;
+        }
+
+        if( shape != nullptr )
+        {
+            shape->cornerCount = entity.cornerCount;
+            float degreesPerCorner = entity.cornerCount > 0 ? 360.f / entity.cornerCount : 0.f;
+            for( int cornerIndex = 0; cornerIndex < entity.cornerCount; ++cornerIndex )
+            {
+                float length = static_cast<float>(entity.cornerLengths[ cornerIndex ]) / NET_CORNER_QUANTA_PER_UNIT;
+                shape->corners[ cornerIndex ] = Vec2::MakeFromPolarDegrees( degreesPerCorner * cornerIndex, length );
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+int GetNetEntityChangedFields( const NetEntity& current, const NetEntity& predicted )
+{
+    constexpr int allFields = NET_FIELD_SPAWN | NET_FIELD_POSITION | NET_FIELD_VELOCITY |
+                              NET_FIELD_ANGLE | NET_FIELD_STATUS | NET_FIELD_AGE;
+
+    if( current.kind != predicted.kind )
+    {
+        return current.kind == ENTITY_KIND_NONE ? NET_FIELD_REMOVED : allFields;
+    }
+    if( current.kind == ENTITY_KIND_NONE )
+    {
+        return 0;
+    }
+
+    // A slot that was emptied and refilled since the baseline looks like the
+    //  same entity, but it is younger than the prediction and may have a new
+    //  color and outline
+    int ageDifference = GetWrappedDifference( predicted.ageTicks, current.ageTicks );
+    if( ageDifference < -NET_AGE_TOLERANCE_TICKS ||
+        !AreColorsEqual( current.color, predicted.color ) ||
+        current.lifeSpanTicks != predicted.lifeSpanTicks )
+    {
+        return allFields;
+    }
+
+    int fields = 0;
+    if( abs( current.x - predicted.x ) > NET_POSITION_TOLERANCE ||
+        abs( current.y - predicted.y ) > NET_POSITION_TOLERANCE )
+    {
+        fields |= NET_FIELD_POSITION;
+    }
+    if( current.velocityX != predicted.velocityX ||
+        current.velocityY != predicted.velocityY )
+    {
+        fields |= NET_FIELD_VELOCITY;
+    }
+    if( abs( GetWrappedDifference( predicted.angle, current.angle ) ) > NET_ANGLE_TOLERANCE ||
+        current.angularVelocity != predicted.angularVelocity )
+    {
+        fields |= NET_FIELD_ANGLE;
+    }
+    if( current.health != predicted.health ||
+        current.flags != predicted.flags )
+    {
+        fields |= NET_FIELD_STATUS;
+    }
+    if( ageDifference > NET_AGE_TOLERANCE_TICKS )
+    {
+        fields |= NET_FIELD_AGE;
+    }
+    return fields;
+}
+
+//-----------------------------------------------------------------------------
+// Matches WriteNetEntityFields, not counting the id and field mask
+int GetNetEntityFieldBytes( const NetEntity& entity, int fields )
+{
+    int bytes = 0;
+    if( fields & NET_FIELD_SPAWN ) { bytes += 1 + 4 + 2 + 1 + entity.cornerCount; }
+    if( fields & NET_FIELD_POSITION ) { bytes += 4; }
+    if( fields & NET_FIELD_VELOCITY ) { bytes += 4; }
+    if( fields & NET_FIELD_ANGLE ) { bytes += 4; }
+    if( fields & NET_FIELD_STATUS ) { bytes += 2; }
+    if( fields & NET_FIELD_AGE ) { bytes += 2; }
+    return bytes;
+}
+
+//-----------------------------------------------------------------------------
+// How fast an out of date entity climbs the send queue, per tick
+float GetNetEntityPriority( EntityKind kind )
+{
+    switch( kind )
+    {
+        case ENTITY_KIND_PLAYER_SHIP:   return 8.f;
+        case ENTITY_KIND_BEETLE:        return 4.f;
+        case ENTITY_KIND_WASP:          return 4.f;
+        case ENTITY_KIND_ASTEROID:      return 3.f;
+        case ENTITY_KIND_BULLET:        return 2.f;
+        case ENTITY_KIND_DEBRIS:        return .25f;
+        default:                        return 1.f;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void ApplyNetEntityFields( NetEntity& inOutEntity, const NetEntity& source, int fields )
+{
+    if( fields & NET_FIELD_REMOVED )
+    {
+        memset( static_cast<void*>(&inOutEntity), 0, sizeof( NetEntity ) );
+        return;
+    }
+
+    if( fields & NET_FIELD_SPAWN )
+    {
+        inOutEntity.kind = source.kind;
+        inOutEntity.color = source.color;
+        inOutEntity.lifeSpanTicks = source.lifeSpanTicks;
+        inOutEntity.cornerCount = source.cornerCount;
+        memcpy( inOutEntity.cornerLengths, source.cornerLengths, sizeof( source.cornerLengths ) );
+    }
+    if( fields & NET_FIELD_POSITION )
+    {
+        inOutEntity.x = source.x;
+        inOutEntity.y = source.y;
+    }
+    if( fields & NET_FIELD_VELOCITY )
+    {
+        inOutEntity.velocityX = source.velocityX;
+        inOutEntity.velocityY = source.velocityY;
+    }
+    if( fields & NET_FIELD_ANGLE )
+    {
+        inOutEntity.angle = source.angle;
+        inOutEntity.angularVelocity = source.angularVelocity;
+    }
+    if( fields & NET_FIELD_STATUS )
+    {
+        inOutEntity.health = source.health;
+        inOutEntity.flags = source.flags;
+    }
+    if( fields & NET_FIELD_AGE )
+    {
+        inOutEntity.ageTicks = source.ageTicks;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void WritePlayerInput( NetBufferWriter& writer, const PlayerInput& input )
+{
+    writer.WriteU8( input.thrust );
+    writer.WriteU8( static_cast<unsigned char>(input.turn) );
+    writer.WriteU8( input.buttons );
+    writer.WriteU16( input.steerAngle );
+}
+
+//-----------------------------------------------------------------------------
+void ReadPlayerInput( NetBufferReader& reader, PlayerInput& outInput )
+{
+    outInput = PlayerInput();
+    outInput.thrust = reader.ReadU8();
+    outInput.turn = static_cast<signed char>(reader.ReadU8());
+    outInput.buttons = reader.ReadU8();
+    outInput.steerAngle = reader.ReadU16();
+}
+
+//-----------------------------------------------------------------------------
+void WriteNetWorldHeader( NetBufferWriter& writer, const NetWorld& world )
+{
+    writer.WriteF32( world.gameTime );
+    writer.WriteU8( world.waveNumber );
+    writer.WriteU8( world.playerShipCurrentLife );
+    writer.WriteU8( world.flags );
+}
+
+//-----------------------------------------------------------------------------
+void ReadNetWorldHeader( NetBufferReader& reader, NetWorld& inOutWorld )
+{
+    inOutWorld.gameTime = reader.ReadF32();
+    inOutWorld.waveNumber = reader.ReadU8();
+    inOutWorld.playerShipCurrentLife = reader.ReadU8();
+    inOutWorld.flags = reader.ReadU8();
+}
+
+//-----------------------------------------------------------------------------
+void WriteNetEntityFields( NetBufferWriter& writer, const NetEntity& entity, int fields )
+{
+    if( fields & NET_FIELD_SPAWN )
+    {
+        writer.WriteU8( entity.kind );
+        writer.WriteU8( entity.color.r );
+        writer.WriteU8( entity.color.g );
+        writer.WriteU8( entity.color.b );
+        writer.WriteU8( entity.color.a );
+        writer.WriteU16( static_cast<unsigned short>(entity.lifeSpanTicks) );
+        writer.WriteU8( entity.cornerCount );
+        writer.WriteBytes( entity.cornerLengths, entity.cornerCount );
+    }
+    if( fields & NET_FIELD_POSITION )
+    {
+        writer.WriteI16( static_cast<short>(entity.x / NET_SUBQUANTA_PER_QUANTUM) );
+        writer.WriteI16( static_cast<short>(entity.y / NET_SUBQUANTA_PER_QUANTUM) );
+    }
+    if( fields & NET_FIELD_VELOCITY )
+    {
+        writer.WriteI16( static_cast<short>(entity.velocityX) );
+        writer.WriteI16( static_cast<short>(entity.velocityY) );
+    }
+    if( fields & NET_FIELD_ANGLE )
+    {
+        writer.WriteU16( static_cast<unsigned short>(entity.angle) );
+        writer.WriteI16( static_cast<short>(entity.angularVelocity) );
+    }
+    if( fields & NET_FIELD_STATUS )
+    {
+        writer.WriteU8( entity.health );
+        writer.WriteU8( entity.flags );
+    }
+    if( fields & NET_FIELD_AGE )
+    {
+        writer.WriteU16( static_cast<unsigned short>(entity.ageTicks) );
+    }
+}
+
+//-----------------------------------------------------------------------------
+void ReadNetEntityFields( NetBufferReader& reader, NetEntity& inOutEntity, int fields )
+{
+    if( fields & NET_FIELD_REMOVED )
+    {
+        memset( static_cast<void*>(&inOutEntity), 0, sizeof( NetEntity ) );
+        return;
+    }
+
+    if( fields & NET_FIELD_SPAWN )
+    {
+        unsigned char kind = reader.ReadU8();
+        inOutEntity.kind = kind < ENTITY_KIND_COUNT ? static_cast<EntityKind>(kind) : ENTITY_KIND_NONE;
+        inOutEntity.color.r = reader.ReadU8();
+        inOutEntity.color.g = reader.ReadU8();
+        inOutEntity.color.b = reader.ReadU8();
+        inOutEntity.color.a = reader.ReadU8();
+        inOutEntity.lifeSpanTicks = reader.ReadU16();
+
+        // Lengths past what fits are read and dropped to stay in step
+        int cornerCount = reader.ReadU8();
+        inOutEntity.cornerCount = static_cast<unsigned char>(ClampInt( cornerCount, 0, MAX_ENTITY_SHAPE_CORNERS ));
+        reader.ReadBytes( inOutEntity.cornerLengths, inOutEntity.cornerCount );
+        for( int extraIndex = inOutEntity.cornerCount; extraIndex < cornerCount; ++extraIndex )
+        {
+            reader.ReadU8();
+        }
+    }
+    if( fields & NET_FIELD_POSITION )
+    {
+        inOutEntity.x = reader.ReadI16() * NET_SUBQUANTA_PER_QUANTUM;
+        inOutEntity.y = reader.ReadI16() * NET_SUBQUANTA_PER_QUANTUM;
+    }
+    if( fields & NET_FIELD_VELOCITY )
+    {
+        inOutEntity.velocityX = reader.ReadI16();
+        inOutEntity.velocityY = reader.ReadI16();
+    }
+    if( fields & NET_FIELD_ANGLE )
+    {
+        inOutEntity.angle = reader.ReadU16();
+        inOutEntity.angularVelocity = reader.ReadI16();
+    }
+    if( fields & NET_FIELD_STATUS )
+    {
+        inOutEntity.health = reader.ReadU8();
+        inOutEntity.flags = reader.ReadU8();
+    }
+    if( fields & NET_FIELD_AGE )
+    {
+        inOutEntity.ageTicks = reader.ReadU16();
+    }
+}
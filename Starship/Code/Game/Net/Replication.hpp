@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Engine/Core/Rgba8.hpp"
+
+#include "Game/GameCommon.hpp"
+#include "Game/WorldState.hpp"
+
+class NetBufferReader;
+class NetBufferWriter;
+struct PlayerInput;
+
+//-----------------------------------------------------------------------------
+// Server to client replication. The server quantizes its WorldState into a
+//  NetWorld each tick and sends every client only what differs from what that
+//  client is known to have: the last acknowledged NetWorld, moved forward by
+//  its own velocities. Anything moving in a straight line (bullets, asteroids)
+//  costs bytes only when it spawns or dies.
+//
+//  Both sides extrapolate with the same integer math so a client's view and
+//  the server's copy of it never drift apart.
+//
+//  The other way, each client sends only its own ship's input, with the last
+//  few repeated in every packet so a lost one drops no presses.
+constexpr unsigned int NET_PROTOCOL_ID = 0x31504853;           // "SHP1"
+constexpr unsigned short NET_DEFAULT_PORT = 48000;
+constexpr float NET_TICK_SECONDS = 1.f / 60.f;
+constexpr int NET_MAX_TICKS_PER_UPDATE = 4;                     // Server drops time rather than spiral
+constexpr int NET_MAX_CLIENTS = 4;
+constexpr int NET_HISTORY_TICKS = 16;                           // Oldest baseline that can be acked
+constexpr int NET_MAX_PACKET_BYTES = 1200;                      // Under a typical MTU, never fragments
+constexpr float NET_CLIENT_TIMEOUT_SECONDS = 5.f;
+constexpr float NET_CONNECT_RETRY_SECONDS = .5f;
+constexpr int NET_INPUT_REDUNDANCY = 4;                         // Inputs per packet, newest first
+constexpr unsigned char NET_NO_PLAYER = 0xff;                   // Spectating, every ship is taken
+
+// Positions go over the wire in 1/64 unit quanta but are tracked in 1/4096
+//  unit sub quanta, so a velocity in sub quanta per tick extrapolates exactly
+constexpr int NET_QUANTA_PER_UNIT = 64;
+constexpr int NET_SUBQUANTA_PER_QUANTUM = 64;
+constexpr int NET_SUBQUANTA_PER_UNIT = NET_QUANTA_PER_UNIT * NET_SUBQUANTA_PER_QUANTUM;
+constexpr int NET_ANGLE_QUANTA = 65536;                         // Per 360 degrees
+constexpr int NET_CORNER_QUANTA_PER_UNIT = 32;
+
+// How far a prediction may drift before the real value is resent
+constexpr int NET_POSITION_TOLERANCE = NET_SUBQUANTA_PER_UNIT / 4;
+constexpr int NET_ANGLE_TOLERANCE = NET_ANGLE_QUANTA / 180;     // 2 degrees
+constexpr int NET_AGE_TOLERANCE_TICKS = 2;
+
+// Every entity slot has a fixed id, in the same order as WorldState
+constexpr int NET_FIRST_PLAYER_SHIP_INDEX = 0;
+constexpr int NET_FIRST_ASTEROID_INDEX = NET_FIRST_PLAYER_SHIP_INDEX + MAX_PLAYERS;
+constexpr int NET_FIRST_BULLET_INDEX = NET_FIRST_ASTEROID_INDEX + MAX_ASTEROIDS;
+constexpr int NET_FIRST_DEBRIS_INDEX = NET_FIRST_BULLET_INDEX + MAX_BULLETS;
+constexpr int NET_FIRST_BEETLE_INDEX = NET_FIRST_DEBRIS_INDEX + MAX_DEBRIS;
+constexpr int NET_FIRST_WASP_INDEX = NET_FIRST_BEETLE_INDEX + MAX_BEETLES;
+constexpr int NET_MAX_ENTITIES = NET_FIRST_WASP_INDEX + MAX_WASPS;
+static_assert( NET_MAX_ENTITIES <= 65536, "Entity ids are sent as 16 bits" );
+
+//-----------------------------------------------------------------------------
+enum NetPacketType: unsigned char
+{
+    NET_PACKET_CONNECT = 1,         // Client -> server, repeated until a snapshot arrives
+    NET_PACKET_SNAPSHOT,            // Server -> client
+    NET_PACKET_ACK,                 // Client -> server, newest snapshot tick applied
+    NET_PACKET_DISCONNECT,          // Client -> server
+    NET_PACKET_INPUT,               // Client -> server, its newest inputs
+};
+
+enum NetEntityField: unsigned char
+{
+    NET_FIELD_SPAWN = 1 << 0,       // Kind, color, life span and outline
+    NET_FIELD_POSITION = 1 << 1,
+    NET_FIELD_VELOCITY = 1 << 2,
+    NET_FIELD_ANGLE = 1 << 3,       // Angle and angular velocity
+    NET_FIELD_STATUS = 1 << 4,      // Health and flags
+    NET_FIELD_AGE = 1 << 5,
+    NET_FIELD_REMOVED = 1 << 6,
+};
+
+enum NetEntityFlag: unsigned char
+{
+    NET_ENTITY_FLAG_DEAD = 1 << 0,
+    NET_ENTITY_FLAG_THRUSTING = 1 << 1,
+};
+
+enum NetWorldFlag: unsigned char
+{
+    NET_WORLD_FLAG_ATTRACT_MODE = 1 << 0,
+    NET_WORLD_FLAG_WAS_JUST_ATTRACT_MODE = 1 << 1,
+};
+
+//-----------------------------------------------------------------------------
+struct NetEntity
+{
+    int x;                          // Sub quanta, always a whole number of quanta
+    int y;
+    int velocityX;                  // Sub quanta per tick
+    int velocityY;
+    int angle;                      // Angle quanta, wrapped to 16 bits
+    int angularVelocity;            // Angle quanta per tick
+    int ageTicks;                   // Wrapped to 16 bits
+    int lifeSpanTicks;
+
+    Rgba8 color;
+    EntityKind kind;
+    unsigned char health;
+    unsigned char flags;
+    unsigned char cornerCount;
+    unsigned char cornerLengths[ MAX_ENTITY_SHAPE_CORNERS ];
+};
+
+//-----------------------------------------------------------------------------
+struct NetWorld
+{
+    int tick;
+    float gameTime;
+    unsigned char waveNumber;
+    unsigned char playerShipCurrentLife;
+    unsigned char flags;
+
+    NetEntity entities[ NET_MAX_ENTITIES ];
+};
+
+//-----------------------------------------------------------------------------
+void ClearNetWorld( NetWorld& outWorld );
+void QuantizeWorldState( const WorldState& state, NetWorld& outWorld );
+void ExtrapolateNetWorld( const NetWorld& baseline, int ticks, NetWorld& outWorld );
+void NetWorldToWorldState( const NetWorld& world,
+                           const EntityState* defaultStatesByKind,
+                           WorldState& inOutState );
+
+int GetNetEntityChangedFields( const NetEntity& current, const NetEntity& predicted );
+int GetNetEntityFieldBytes( const NetEntity& entity, int fields );
+float GetNetEntityPriority( EntityKind kind );
+void ApplyNetEntityFields( NetEntity& inOutEntity, const NetEntity& source, int fields );
+
+void WritePlayerInput( NetBufferWriter& writer, const PlayerInput& input );
+void ReadPlayerInput( NetBufferReader& reader, PlayerInput& outInput );
+void WriteNetWorldHeader( NetBufferWriter& writer, const NetWorld& world );
+void ReadNetWorldHeader( NetBufferReader& reader, NetWorld& inOutWorld );
+void WriteNetEntityFields( NetBufferWriter& writer, const NetEntity& entity, int fields );
+void ReadNetEntityFields( NetBufferReader& reader, NetEntity& inOutEntity, int fields );
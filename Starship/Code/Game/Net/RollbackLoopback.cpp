@@ -0,0 +1,276 @@
+#include "RollbackLoopback.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Input/InputSystem.hpp"
+
+#include "Game/Game.hpp"
+#include "Game/Net/Replication.hpp"
+#include "Game/Net/RollbackSession.hpp"
+#include "Game/PlayerPilot.hpp"
+#include "Game/WorldState.hpp"
+
+#include <cstdio>
+
+//-----------------------------------------------------------------------------
+RollbackLoopback::RollbackLoopback( Game* localGame )
+{
+    m_Peers[ 0 ].game = localGame;
+}
+
+//-----------------------------------------------------------------------------
+RollbackLoopback::~RollbackLoopback()
+{
+    Shutdown();
+}
+
+//-----------------------------------------------------------------------------
+void RollbackLoopback::Startup( float latencySeconds, float jitterSeconds )
+{
+    m_LatencySeconds = latencySeconds;
+    m_JitterSeconds = jitterSeconds;
+    m_ClockSeconds = 0.0;
+    m_TickAccumulator = 0.f;
+
+    // Same rules as the local game, but nothing to draw and nobody at the keys
+    GameContext remoteContext = m_Peers[ 0 ].game->GetContext();
+    remoteContext.renderer = nullptr;
+    remoteContext.input = nullptr;
+    m_RemoteGame = new Game( remoteContext );
+    m_RemoteGame->Startup( ROLLBACK_LOOPBACK_PEERS );
+    m_Peers[ 1 ].game = m_RemoteGame;
+
+    // Peers must start from identical bytes, rng included
+    WorldState* startState = new WorldState();
+    m_Peers[ 0 ].game->CaptureWorldState( *startState );
+    m_RemoteGame->RestoreWorldState( *startState );
+    delete startState;
+
+    for( int peerIndex = 0; peerIndex < ROLLBACK_LOOPBACK_PEERS; ++peerIndex )
+    {
+        Peer& peer = m_Peers[ peerIndex ];
+        peer.session = new RollbackSession( peer.game );
+        peer.session->Startup( peerIndex, ROLLBACK_LOOPBACK_PEERS );
+        peer.session->SetChecksumsEnabled( true );
+        peer.inbox.clear();
+        peer.lastDeliverSeconds = 0.0;
+    }
+
+    m_PendingLocalButtons = 0;
+    m_ScriptedInput = PlayerInput();
+    m_ScriptedTicksLeft = 1;
+    m_NextCompareTick = 0;
+    m_ComparedTicks = 0;
+    m_DesyncCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+void RollbackLoopback::Shutdown()
+{
+    for( int peerIndex = 0; peerIndex < ROLLBACK_LOOPBACK_PEERS; ++peerIndex )
+    {
+        Peer& peer = m_Peers[ peerIndex ];
+        delete peer.session;
+        peer.session = nullptr;
+        peer.inbox.clear();
+    }
+
+    if( m_RemoteGame != nullptr )
+    {
+        m_RemoteGame->Shutdown();
+        delete m_RemoteGame;
+        m_RemoteGame = nullptr;
+    }
+    m_Peers[ 1 ].game = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void RollbackLoopback::Update( float deltaSeconds )
+{
+    if( m_Peers[ 0 ].session == nullptr )
+    {
+        return;
+    }
+
+    m_ClockSeconds += deltaSeconds;
+
+    // The sessions move the world; the rendered game only presents it here
+    m_Peers[ 0 ].game->UpdateAsClient( deltaSeconds );
+
+    DeliverInputs();
+
+    for( int peerIndex = 0; peerIndex < ROLLBACK_LOOPBACK_PEERS; ++peerIndex )
+    {
+        m_Peers[ peerIndex ].session->ResetFrameStats();
+    }
+
+    // Presses are kept until a tick actually takes them so none are lost on
+    //  frames that run no tick or stall
+    PlayerInput localInput;
+    if( m_LocalPilot != nullptr )
+    {
+        localInput = m_LocalPilot->UpdatePilot( *m_Peers[ 0 ].game, 0 );
+    }
+    else if( InputSystem* inputSystem = m_Peers[ 0 ].game->GetContext().input )
+    {
+        localInput = SampleLocalPlayerInput( *inputSystem, 0, true );
+    }
+    m_PendingLocalButtons |= localInput.buttons & PLAYER_INPUT_EDGE_BUTTONS;
+
+    m_TickAccumulator += deltaSeconds;
+    int ticksThisUpdate = 0;
+    while( m_TickAccumulator >= NET_TICK_SECONDS )
+    {
+        m_TickAccumulator -= NET_TICK_SECONDS;
+        if( ticksThisUpdate == NET_MAX_TICKS_PER_UPDATE )
+        {
+            m_TickAccumulator = 0.f;
+            break;
+        }
+
+        localInput.buttons |= m_PendingLocalButtons;
+        if( AdvancePeer( 0, localInput ) )
+        {
+            m_PendingLocalButtons = 0;
+            localInput.buttons &= ~PLAYER_INPUT_EDGE_BUTTONS;
+        }
+
+        if( AdvancePeer( 1, m_ScriptedInput ) )
+        {
+            AdvanceScriptedInput();
+        }
+
+        ticksThisUpdate++;
+    }
+
+    CompareChecksums();
+    UpdateStatsText();
+}
+
+//-----------------------------------------------------------------------------
+bool RollbackLoopback::AdvancePeer( int peerIndex, const PlayerInput& input )
+{
+    RollbackSession& session = *m_Peers[ peerIndex ].session;
+    if( !session.AdvanceTick( input ) )
+    {
+        return false;
+    }
+
+    SendInput( 1 - peerIndex, session.GetCurrentTick() - 1, input );
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Jitter never reorders; the link behaves like an ordered stream whose
+//  delay wobbles, which is what a real transport hands the session
+void RollbackLoopback::SendInput( int toPeerIndex, int tick, const PlayerInput& input )
+{
+    Peer& peer = m_Peers[ toPeerIndex ];
+
+    DelayedInput delayedInput;
+    delayedInput.deliverSeconds = m_ClockSeconds + m_LatencySeconds;
+    if( m_JitterSeconds > 0.f )
+    {
+        delayedInput.deliverSeconds += m_LinkRng.FloatInRange( 0.f, m_JitterSeconds );
+    }
+    if( delayedInput.deliverSeconds < peer.lastDeliverSeconds )
+    {
+        delayedInput.deliverSeconds = peer.lastDeliverSeconds;
+    }
+    delayedInput.tick = tick;
+    delayedInput.input = input;
+
+    peer.lastDeliverSeconds = delayedInput.deliverSeconds;
+    peer.inbox.push_back( delayedInput );
+}
+
+//-----------------------------------------------------------------------------
+void RollbackLoopback::DeliverInputs()
+{
+    for( int peerIndex = 0; peerIndex < ROLLBACK_LOOPBACK_PEERS; ++peerIndex )
+    {
+        Peer& peer = m_Peers[ peerIndex ];
+        while( !peer.inbox.empty() && peer.inbox.front().deliverSeconds <= m_ClockSeconds )
+        {
+            const DelayedInput& delayedInput = peer.inbox.front();
+            peer.session->AddRemoteInput( 1 - peerIndex, delayedInput.tick, delayedInput.input );
+            peer.inbox.pop_front();
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Holds each random input for a while, firing once at the start of it
+void RollbackLoopback::AdvanceScriptedInput()
+{
+    m_ScriptedInput.buttons &= ~PLAYER_INPUT_FIRE;
+
+    m_ScriptedTicksLeft--;
+    if( m_ScriptedTicksLeft > 0 )
+    {
+        return;
+    }
+
+    m_ScriptedTicksLeft = m_LinkRng.IntInRange( 10, 40 );
+    m_ScriptedInput.turn = static_cast<signed char>(m_LinkRng.IntInRange( -1, 1 ));
+    m_ScriptedInput.thrust = m_LinkRng.FiftyFifty() ? PLAYER_INPUT_THRUST_MAX : 0;
+    if( m_LinkRng.FiftyFifty() )
+    {
+        m_ScriptedInput.buttons |= PLAYER_INPUT_FIRE;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void RollbackLoopback::CompareChecksums()
+{
+    int newestTick = m_Peers[ 0 ].session->GetNewestChecksumTick();
+    for( int peerIndex = 1; peerIndex < ROLLBACK_LOOPBACK_PEERS; ++peerIndex )
+    {
+        int peerNewestTick = m_Peers[ peerIndex ].session->GetNewestChecksumTick();
+        if( peerNewestTick < newestTick )
+        {
+            newestTick = peerNewestTick;
+        }
+    }
+
+    for( ; m_NextCompareTick <= newestTick; ++m_NextCompareTick )
+    {
+        unsigned int localChecksum = 0;
+        unsigned int remoteChecksum = 0;
+        if( !m_Peers[ 0 ].session->GetChecksum( m_NextCompareTick, localChecksum ) ||
+            !m_Peers[ 1 ].session->GetChecksum( m_NextCompareTick, remoteChecksum ) )
+        {
+            continue;
+        }
+
+        m_ComparedTicks++;
+        if( localChecksum != remoteChecksum )
+        {
+            if( m_DesyncCount == 0 )
+            {
+                DebuggerPrintf( "Rollback loopback desync first seen at tick %i\n", m_NextCompareTick );
+            }
+            m_DesyncCount++;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void RollbackLoopback::UpdateStatsText()
+{
+    const RollbackSession& localSession = *m_Peers[ 0 ].session;
+    const RollbackSession& remoteSession = *m_Peers[ 1 ].session;
+
+    char statsText[ 128 ];
+    snprintf( statsText, sizeof( statsText ),
+              "RB %i MS %.2f PEAK %i %.2f  PEER %i %.2f  STALL %i  DESYNC %i OF %i",
+              localSession.GetFrameRollbackTicks(),
+              localSession.GetFrameResimulateSeconds() * 1000.0,
+              localSession.GetPeakRollbackTicks(),
+              localSession.GetPeakResimulateSeconds() * 1000.0,
+              remoteSession.GetFrameRollbackTicks(),
+              remoteSession.GetFrameResimulateSeconds() * 1000.0,
+              localSession.GetStalledTickCount(),
+              m_DesyncCount,
+              m_ComparedTicks );
+    m_Peers[ 0 ].game->SetNetStatsText( statsText );
+}
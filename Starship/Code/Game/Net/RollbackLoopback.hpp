@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Engine/Core/Math/RandomNumberGenerator.hpp"
+
+#include "Game/PlayerInput.hpp"
+
+#include <deque>
+
+class Game;
+class PlayerPilot;
+class RollbackSession;
+
+//-----------------------------------------------------------------------------
+// Two rollback peers in one process joined by a fake link with configurable
+//  latency and jitter. Peer 0 is the rendered game and plays from the local
+//  keyboard and controller (or a pilot); peer 1 plays a scripted pattern
+//  that changes often enough to keep both sides mispredicting.
+//
+//  Every tick both peers have fully confirmed is hashed and compared, so any
+//  non-determinism in Game::SimulateTick shows up as a desync count. Per
+//  frame rollback depth and re-simulation time go to the debug HUD (F1).
+constexpr int ROLLBACK_LOOPBACK_PEERS = 2;
+constexpr float ROLLBACK_LOOPBACK_DEFAULT_LATENCY_SECONDS = .06f;
+constexpr float ROLLBACK_LOOPBACK_DEFAULT_JITTER_SECONDS = .02f;
+
+class RollbackLoopback
+{
+public:
+    explicit RollbackLoopback( Game* localGame );
+    ~RollbackLoopback();
+
+    // Not owned; flies peer 0 instead of the local devices, once per update
+    void SetLocalPilot( PlayerPilot* pilot ) { m_LocalPilot = pilot; }
+
+    void Startup( float latencySeconds, float jitterSeconds );
+    void Shutdown();
+    void Update( float deltaSeconds );
+
+    int GetDesyncCount() const { return m_DesyncCount; }
+    int GetComparedTicks() const { return m_ComparedTicks; }
+    const RollbackSession* GetSession( int peerIndex ) const { return m_Peers[ peerIndex ].session; }
+
+private:
+    struct DelayedInput
+    {
+        double deliverSeconds = 0.0;
+        int tick = 0;
+        PlayerInput input;
+    };
+
+    struct Peer
+    {
+        Game* game = nullptr;
+        RollbackSession* session = nullptr;
+        std::deque<DelayedInput> inbox;         // Sent by the other peer, in order
+        double lastDeliverSeconds = 0.0;
+    };
+
+    Game* m_RemoteGame = nullptr;               // Peer 1's world, owned here
+    Peer m_Peers[ ROLLBACK_LOOPBACK_PEERS ];
+
+    float m_LatencySeconds = 0.f;
+    float m_JitterSeconds = 0.f;
+    double m_ClockSeconds = 0.0;
+    float m_TickAccumulator = 0.f;
+
+    // Link jitter and the scripted player; never touches either game's rng
+    RandomNumberGenerator m_LinkRng;
+
+    PlayerPilot* m_LocalPilot = nullptr;
+    unsigned char m_PendingLocalButtons = 0;    // Presses waiting for a tick to land in
+    PlayerInput m_ScriptedInput;
+    int m_ScriptedTicksLeft = 0;
+
+    int m_NextCompareTick = 0;
+    int m_ComparedTicks = 0;
+    int m_DesyncCount = 0;
+
+    bool AdvancePeer( int peerIndex, const PlayerInput& input );
+    void SendInput( int toPeerIndex, int tick, const PlayerInput& input );
+    void DeliverInputs();
+    void AdvanceScriptedInput();
+    void CompareChecksums();
+    void UpdateStatsText();
+};
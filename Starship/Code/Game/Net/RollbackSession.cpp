@@ -0,0 +1,309 @@
+#include "RollbackSession.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include "Game/Game.hpp"
+#include "Game/Net/Replication.hpp"
+#include "Game/WorldState.hpp"
+
+//-----------------------------------------------------------------------------
+// FNV-1a over whole words; captures are zeroed first so equal worlds hash equal
+static unsigned int HashWorldState( const WorldState& state )
+{
+    const unsigned int* words = reinterpret_cast<const unsigned int*>(&state);
+    const int wordCount = static_cast<int>(sizeof( WorldState ) / sizeof( unsigned int ));
+
+    unsigned int hash = 2166136261u;
+    for( int wordIndex = 0; wordIndex < wordCount; ++wordIndex )
+    {
+        hash = (hash ^ words[ wordIndex ]) * 16777619u;
+    }
+    return hash;
+}
+
+//-----------------------------------------------------------------------------
+RollbackSession::RollbackSession( Game* game )
+    : m_Game( game )
+{
+}
+
+//-----------------------------------------------------------------------------
+RollbackSession::~RollbackSession()
+{
+    Shutdown();
+}
+
+//-----------------------------------------------------------------------------
+void RollbackSession::Startup( int localPlayerIndex, int playerCount )
+{
+    GUARANTEE_OR_DIE( playerCount > 0 && playerCount <= MAX_PLAYERS, "Rollback player count out of range" );
+    GUARANTEE_OR_DIE( localPlayerIndex >= 0 && localPlayerIndex < playerCount, "Rollback local player out of range" );
+
+    m_LocalPlayerIndex = localPlayerIndex;
+    m_PlayerCount = playerCount;
+
+    m_CurrentTick = 0;
+    m_ConfirmedTick = -1;
+    m_FirstMispredictedTick = -1;
+    m_NextChecksumTick = 0;
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+    {
+        m_LastReceivedTick[ playerIndex ] = -1;
+    }
+
+    for( int inputIndex = 0; inputIndex < ROLLBACK_INPUT_HISTORY_TICKS; ++inputIndex )
+    {
+        m_Inputs[ inputIndex ] = TickInputs();
+    }
+    for( int checksumIndex = 0; checksumIndex < ROLLBACK_CHECKSUM_HISTORY_TICKS; ++checksumIndex )
+    {
+        m_Checksums[ checksumIndex ] = TickChecksum();
+    }
+
+    // Every saved world is allocated up front, rolling back never allocates
+    for( int stateIndex = 0; stateIndex < ROLLBACK_SAVED_STATES; ++stateIndex )
+    {
+        SavedState& savedState = m_SavedStates[ stateIndex ];
+        if( savedState.state == nullptr )
+        {
+            savedState.state = new WorldState();
+        }
+        savedState.tick = -1;
+    }
+
+    m_PeakRollbackTicks = 0;
+    m_PeakResimulateSeconds = 0.0;
+    m_RollbackCount = 0;
+    m_StalledTickCount = 0;
+    ResetFrameStats();
+}
+
+//-----------------------------------------------------------------------------
+void RollbackSession::Shutdown()
+{
+    for( int stateIndex = 0; stateIndex < ROLLBACK_SAVED_STATES; ++stateIndex )
+    {
+        delete m_SavedStates[ stateIndex ].state;
+        m_SavedStates[ stateIndex ].state = nullptr;
+        m_SavedStates[ stateIndex ].tick = -1;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Returns false without using the input when too far ahead of the slowest
+//  peer; sample again and retry next tick
+bool RollbackSession::AdvanceTick( const PlayerInput& localInput )
+{
+    if( m_FirstMispredictedTick >= 0 )
+    {
+        Rollback();
+    }
+
+    if( !CanAdvance() )
+    {
+        m_StalledTickCount++;
+        return false;
+    }
+
+    TickInputs& tickInputs = GetTickInputs( m_CurrentTick );
+    tickInputs.inputs[ m_LocalPlayerIndex ] = localInput;
+    tickInputs.isConfirmed[ m_LocalPlayerIndex ] = true;
+    m_LastReceivedTick[ m_LocalPlayerIndex ] = m_CurrentTick;
+    UpdateConfirmedTick();
+
+    SaveState( m_CurrentTick );
+    RecordChecksums();
+
+    SimulateTick( m_CurrentTick );
+    m_CurrentTick++;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool RollbackSession::AddRemoteInput( int playerIndex, int tick, const PlayerInput& input )
+{
+    if( playerIndex < 0 || playerIndex >= m_PlayerCount || playerIndex == m_LocalPlayerIndex )
+    {
+        return false;
+    }
+    // Duplicates and anything after a gap are dropped; the sender resends
+    if( tick != m_LastReceivedTick[ playerIndex ] + 1 )
+    {
+        return false;
+    }
+    if( tick - m_ConfirmedTick >= ROLLBACK_INPUT_HISTORY_TICKS )
+    {
+        return false;
+    }
+
+    TickInputs& tickInputs = GetTickInputs( tick );
+    if( tick < m_CurrentTick && tickInputs.inputs[ playerIndex ] != input )
+    {
+        if( m_FirstMispredictedTick < 0 || tick < m_FirstMispredictedTick )
+        {
+            m_FirstMispredictedTick = tick;
+        }
+    }
+
+    tickInputs.inputs[ playerIndex ] = input;
+    tickInputs.isConfirmed[ playerIndex ] = true;
+    m_LastReceivedTick[ playerIndex ] = tick;
+    UpdateConfirmedTick();
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool RollbackSession::CanAdvance() const
+{
+    return m_CurrentTick - m_ConfirmedTick <= ROLLBACK_MAX_PREDICTION_TICKS;
+}
+
+//-----------------------------------------------------------------------------
+bool RollbackSession::GetChecksum( int tick, unsigned int& outChecksum ) const
+{
+    const TickChecksum& tickChecksum = m_Checksums[ tick % ROLLBACK_CHECKSUM_HISTORY_TICKS ];
+    if( tick < 0 || tickChecksum.tick != tick )
+    {
+        return false;
+    }
+    outChecksum = tickChecksum.checksum;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void RollbackSession::ResetFrameStats()
+{
+    m_FrameRollbackTicks = 0;
+    m_FrameResimulateSeconds = 0.0;
+}
+
+//-----------------------------------------------------------------------------
+RollbackSession::TickInputs& RollbackSession::GetTickInputs( int tick )
+{
+    TickInputs& tickInputs = m_Inputs[ tick % ROLLBACK_INPUT_HISTORY_TICKS ];
+    if( tickInputs.tick != tick )
+    {
+        tickInputs = TickInputs();
+        tickInputs.tick = tick;
+    }
+    return tickInputs;
+}
+
+//-----------------------------------------------------------------------------
+// Back to the start of the first wrong tick, then forward again to where we
+//  were. Ticks re-simulated here also re-save their start state.
+void RollbackSession::Rollback()
+{
+    const int firstTick = m_FirstMispredictedTick;
+    m_FirstMispredictedTick = -1;
+
+    const SavedState& savedState = m_SavedStates[ firstTick % ROLLBACK_SAVED_STATES ];
+    if( savedState.tick != firstTick )
+    {
+        ERROR_RECOVERABLE( "Rollback target is no longer saved; peers may desync" );
+        return;
+    }
+
+    double startSeconds = GetCurrentTimeSeconds();
+
+    m_Game->RestoreWorldState( *savedState.state );
+    for( int tick = firstTick; tick < m_CurrentTick; ++tick )
+    {
+        if( tick != firstTick )
+        {
+            SaveState( tick );
+        }
+        SimulateTick( tick );
+    }
+
+    double resimulateSeconds = GetCurrentTimeSeconds() - startSeconds;
+    int rollbackTicks = m_CurrentTick - firstTick;
+
+    m_RollbackCount++;
+    m_FrameResimulateSeconds += resimulateSeconds;
+    if( rollbackTicks > m_FrameRollbackTicks )
+    {
+        m_FrameRollbackTicks = rollbackTicks;
+    }
+    if( rollbackTicks > m_PeakRollbackTicks )
+    {
+        m_PeakRollbackTicks = rollbackTicks;
+    }
+    if( resimulateSeconds > m_PeakResimulateSeconds )
+    {
+        m_PeakResimulateSeconds = resimulateSeconds;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Unconfirmed players repeat their last known input. Fire and start are
+//  edges, so repeating them would invent presses; the guess drops them.
+void RollbackSession::SimulateTick( int tick )
+{
+    TickInputs& tickInputs = GetTickInputs( tick );
+    for( int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex )
+    {
+        if( playerIndex < m_PlayerCount && !tickInputs.isConfirmed[ playerIndex ] )
+        {
+            PlayerInput prediction;
+            int lastReceivedTick = m_LastReceivedTick[ playerIndex ];
+            if( lastReceivedTick >= 0 )
+            {
+                prediction = GetTickInputs( lastReceivedTick ).inputs[ playerIndex ];
+                prediction.buttons &= ~PLAYER_INPUT_EDGE_BUTTONS;
+            }
+            tickInputs.inputs[ playerIndex ] = prediction;
+        }
+
+        m_Game->SetPlayerInput( playerIndex, tickInputs.inputs[ playerIndex ] );
+    }
+
+    m_Game->SimulateTick( NET_TICK_SECONDS );
+}
+
+//-----------------------------------------------------------------------------
+void RollbackSession::SaveState( int tick )
+{
+    SavedState& savedState = m_SavedStates[ tick % ROLLBACK_SAVED_STATES ];
+    m_Game->CaptureWorldState( *savedState.state );
+    savedState.tick = tick;
+}
+
+//-----------------------------------------------------------------------------
+// A tick's start state is final once every input before it is confirmed and
+//  any rollback they caused has run, which AdvanceTick guarantees by now
+void RollbackSession::RecordChecksums()
+{
+    if( !m_AreChecksumsEnabled )
+    {
+        m_NextChecksumTick = m_ConfirmedTick + 1;
+        return;
+    }
+
+    while( m_NextChecksumTick <= m_CurrentTick && m_NextChecksumTick - 1 <= m_ConfirmedTick )
+    {
+        const SavedState& savedState = m_SavedStates[ m_NextChecksumTick % ROLLBACK_SAVED_STATES ];
+        if( savedState.tick == m_NextChecksumTick )
+        {
+            TickChecksum& tickChecksum = m_Checksums[ m_NextChecksumTick % ROLLBACK_CHECKSUM_HISTORY_TICKS ];
+            tickChecksum.tick = m_NextChecksumTick;
+            tickChecksum.checksum = HashWorldState( *savedState.state );
+        }
+        m_NextChecksumTick++;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void RollbackSession::UpdateConfirmedTick()
+{
+    int confirmedTick = m_LastReceivedTick[ 0 ];
+    for( int playerIndex = 1; playerIndex < m_PlayerCount; ++playerIndex )
+    {
+        if( m_LastReceivedTick[ playerIndex ] < confirmedTick )
+        {
+            confirmedTick = m_LastReceivedTick[ playerIndex ];
+        }
+    }
+    m_ConfirmedTick = confirmedTick;
+}
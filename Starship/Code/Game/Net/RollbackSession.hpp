@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Game/GameCommon.hpp"
+#include "Game/PlayerInput.hpp"
+
+class Game;
+struct WorldState;
+
+//-----------------------------------------------------------------------------
+// Peer to peer rollback over a deterministic Game. The local player's input
+//  is applied the tick it is sampled; every other player's input is guessed
+//  (their last known input repeated) until the real one arrives. A guess that
+//  turns out wrong restores the world saved at the start of that tick and
+//  re-simulates up to the present with the corrected inputs, all before the
+//  next tick is shown.
+//
+//  Inputs for each remote player must arrive in tick order with no gaps; the
+//  transport is responsible for resending anything lost.
+constexpr int ROLLBACK_MAX_PREDICTION_TICKS = 8;        // Stall rather than guess further ahead
+constexpr int ROLLBACK_SAVED_STATES = ROLLBACK_MAX_PREDICTION_TICKS + 1;
+constexpr int ROLLBACK_INPUT_HISTORY_TICKS = 64;        // Room for remote inputs ahead of us too
+constexpr int ROLLBACK_CHECKSUM_HISTORY_TICKS = 64;
+
+class RollbackSession
+{
+public:
+    explicit RollbackSession( Game* game );
+    ~RollbackSession();
+
+    void Startup( int localPlayerIndex, int playerCount );
+    void Shutdown();
+
+    bool AdvanceTick( const PlayerInput& localInput );
+    bool AddRemoteInput( int playerIndex, int tick, const PlayerInput& input );
+
+    int GetCurrentTick() const { return m_CurrentTick; }
+    int GetConfirmedTick() const { return m_ConfirmedTick; }
+    bool CanAdvance() const;
+
+    // Checksums of worlds built only from confirmed inputs, for comparing
+    //  peers. Off by default; hashing the world is not free.
+    void SetChecksumsEnabled( bool isEnabled ) { m_AreChecksumsEnabled = isEnabled; }
+    bool GetChecksum( int tick, unsigned int& outChecksum ) const;
+    int GetNewestChecksumTick() const { return m_NextChecksumTick - 1; }
+
+    // Frame stats cover every AdvanceTick since the last ResetFrameStats
+    void ResetFrameStats();
+    int GetFrameRollbackTicks() const { return m_FrameRollbackTicks; }
+    double GetFrameResimulateSeconds() const { return m_FrameResimulateSeconds; }
+    int GetPeakRollbackTicks() const { return m_PeakRollbackTicks; }
+    double GetPeakResimulateSeconds() const { return m_PeakResimulateSeconds; }
+    int GetRollbackCount() const { return m_RollbackCount; }
+    int GetStalledTickCount() const { return m_StalledTickCount; }
+
+private:
+    struct TickInputs
+    {
+        int tick = -1;
+        PlayerInput inputs[ MAX_PLAYERS ];
+        bool isConfirmed[ MAX_PLAYERS ] = { false };
+    };
+
+    struct SavedState
+    {
+        int tick = -1;
+        WorldState* state = nullptr;
+    };
+
+    struct TickChecksum
+    {
+        int tick = -1;
+        unsigned int checksum = 0;
+    };
+
+    Game* m_Game = nullptr;
+    int m_LocalPlayerIndex = 0;
+    int m_PlayerCount = 0;
+
+    int m_CurrentTick = 0;                          // Next tick to simulate
+    int m_ConfirmedTick = -1;                       // Newest tick with every input known
+    int m_LastReceivedTick[ MAX_PLAYERS ] = {};         // Per player, -1 before any input
+    int m_FirstMispredictedTick = -1;
+
+    TickInputs m_Inputs[ ROLLBACK_INPUT_HISTORY_TICKS ];
+    SavedState m_SavedStates[ ROLLBACK_SAVED_STATES ];
+    TickChecksum m_Checksums[ ROLLBACK_CHECKSUM_HISTORY_TICKS ];
+    bool m_AreChecksumsEnabled = false;
+    int m_NextChecksumTick = 0;
+
+    int m_FrameRollbackTicks = 0;
+    double m_FrameResimulateSeconds = 0.0;
+    int m_PeakRollbackTicks = 0;
+    double m_PeakResimulateSeconds = 0.0;
+    int m_RollbackCount = 0;
+    int m_StalledTickCount = 0;
+
+    TickInputs& GetTickInputs( int tick );
+    void Rollback();
+    void SimulateTick( int tick );
+    void SaveState( int tick );
+    void RecordChecksums();
+    void UpdateConfirmedTick();
+};
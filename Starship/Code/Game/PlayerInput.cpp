@@ -0,0 +1,116 @@
+#include "PlayerInput.hpp"
+
+#include "Engine/Input/InputSystem.hpp"
+#include "Engine/Input/XboxController.hpp"
+
+#include "Game/GameCommon.hpp"
+
+//-----------------------------------------------------------------------------
+float PlayerInput::GetThrustFraction() const
+{
+    return static_cast<float>(thrust) / static_cast<float>(PLAYER_INPUT_THRUST_MAX);
+}
+
+//-----------------------------------------------------------------------------
+float PlayerInput::GetSteerAngleDegrees() const
+{
+    return static_cast<float>(steerAngle) * (360.f / static_cast<float>(PLAYER_INPUT_ANGLE_QUANTA));
+}
+
+//-----------------------------------------------------------------------------
+void PlayerInput::SetThrustFraction( float fraction )
+{
+    int quantizedThrust = static_cast<int>(fraction * PLAYER_INPUT_THRUST_MAX + .5f);
+    quantizedThrust = quantizedThrust < 0 ? 0 : quantizedThrust;
+    thrust = static_cast<unsigned char>(quantizedThrust > PLAYER_INPUT_THRUST_MAX ? PLAYER_INPUT_THRUST_MAX : quantizedThrust);
+}
+
+//-----------------------------------------------------------------------------
+void PlayerInput::SetSteerAngleDegrees( float angleDegrees )
+{
+    angleDegrees -= 360.f * static_cast<float>(static_cast<int>(angleDegrees / 360.f));
+    if( angleDegrees < 0.f )
+    {
+        angleDegrees += 360.f;
+    }
+    int angleQuanta = static_cast<int>(angleDegrees * (PLAYER_INPUT_ANGLE_QUANTA / 360.f) + .5f);
+
+    steerAngle = static_cast<unsigned short>(angleQuanta % PLAYER_INPUT_ANGLE_QUANTA);
+    buttons |= PLAYER_INPUT_STEER;
+}
+
+//-----------------------------------------------------------------------------
+bool operator==( const PlayerInput& inputA, const PlayerInput& inputB )
+{
+    return inputA.thrust == inputB.thrust &&
+           inputA.turn == inputB.turn &&
+           inputA.buttons == inputB.buttons &&
+           inputA.steerAngle == inputB.steerAngle;
+}
+
+//-----------------------------------------------------------------------------
+bool operator!=( const PlayerInput& inputA, const PlayerInput& inputB )
+{
+    return !(inputA == inputB);
+}
+
+//-----------------------------------------------------------------------------
+// Only one player can own the keyboard; the rest play on their controllers
+PlayerInput SampleLocalPlayerInput( InputSystem& inputSystem, int controllerId, bool includeKeyboard )
+{
+    PlayerInput input;
+
+    if( includeKeyboard )
+    {
+        if( inputSystem.IsKeyPressed( 'W' ) || inputSystem.IsKeyPressed( UP_ARROW ) )
+        {
+            input.thrust = PLAYER_INPUT_THRUST_MAX;
+        }
+
+        // Opposite keys held together cancel out
+        int turn = 0;
+        if( inputSystem.IsKeyPressed( 'A' ) || inputSystem.IsKeyPressed( LEFT_ARROW ) )
+        {
+            turn++;
+        }
+        if( inputSystem.IsKeyPressed( 'D' ) || inputSystem.IsKeyPressed( RIGHT_ARROW ) )
+        {
+            turn--;
+        }
+        input.turn = static_cast<signed char>(turn);
+
+        if( inputSystem.WasKeyJustPressed( SPACE ) )
+        {
+            input.buttons |= PLAYER_INPUT_FIRE;
+        }
+        if( inputSystem.WasKeyJustPressed( 'N' ) )
+        {
+            input.buttons |= PLAYER_INPUT_RESPAWN;
+        }
+    }
+
+    const XboxController& gamepad = inputSystem.GetXboxController( controllerId );
+    if( !gamepad.IsConnected() )
+    {
+        return input;
+    }
+
+    // The stick overrides the keyboard; it points the ship rather than turning it
+    const AnalogJoystick& joystick = gamepad.GetLeftJoystick();
+    if( joystick.GetMagnitude() > 0.f )
+    {
+        input.SetSteerAngleDegrees( joystick.GetAngleDegrees() );
+        input.SetThrustFraction( joystick.GetMagnitude() );
+    }
+
+    if( gamepad.IsButtonJustPressed( XBOX_BUTTON_A ) )
+    {
+        input.buttons |= PLAYER_INPUT_FIRE;
+    }
+    if( gamepad.IsButtonJustPressed( XBOX_BUTTON_START ) )
+    {
+        input.buttons |= PLAYER_INPUT_START;
+    }
+
+    return input;
+}
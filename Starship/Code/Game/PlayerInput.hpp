@@ -0,0 +1,46 @@
+#pragma once
+
+class InputSystem;
+
+//-----------------------------------------------------------------------------
+// Everything one player can do to the world in one tick. The simulation only
+//  ever reads these, never the InputSystem, so a tick can be replayed with
+//  the same result on any machine. Kept small and quantized so it is cheap
+//  to send and two inputs compare exactly.
+enum PlayerInputButton: unsigned char
+{
+    PLAYER_INPUT_FIRE = 1 << 0,         // Went down this tick
+    PLAYER_INPUT_START = 1 << 1,        // Went down this tick
+    PLAYER_INPUT_STEER = 1 << 2,        // steerAngle is valid (analog stick held)
+    PLAYER_INPUT_RESPAWN = 1 << 3,      // Went down this tick; the N key, only leaves attract mode there
+};
+
+// Presses rather than held state: whoever batches inputs keeps these until a
+//  tick takes them, and never repeats them into a prediction
+constexpr unsigned char PLAYER_INPUT_EDGE_BUTTONS = PLAYER_INPUT_FIRE | PLAYER_INPUT_START | PLAYER_INPUT_RESPAWN;
+
+constexpr int PLAYER_INPUT_THRUST_MAX = 255;
+constexpr int PLAYER_INPUT_ANGLE_QUANTA = 65536;        // Per 360 degrees
+
+struct PlayerInput
+{
+    unsigned char thrust = 0;           // 0 to PLAYER_INPUT_THRUST_MAX of full acceleration
+    signed char turn = 0;               // 1 left, -1 right
+    unsigned char buttons = 0;          // PlayerInputButton bits
+    unsigned char unused = 0;
+    unsigned short steerAngle = 0;      // Absolute heading in PLAYER_INPUT_ANGLE_QUANTA
+
+    bool IsPressed( PlayerInputButton button ) const { return (buttons & button) != 0; }
+    float GetThrustFraction() const;
+    float GetSteerAngleDegrees() const;
+
+    void SetThrustFraction( float fraction );
+    void SetSteerAngleDegrees( float angleDegrees );    // Also sets PLAYER_INPUT_STEER
+};
+
+bool operator==( const PlayerInput& inputA, const PlayerInput& inputB );
+bool operator!=( const PlayerInput& inputA, const PlayerInput& inputB );
+
+//-----------------------------------------------------------------------------
+// The given controller, plus the keyboard if asked, as they are this frame
+PlayerInput SampleLocalPlayerInput( InputSystem& inputSystem, int controllerId, bool includeKeyboard );
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Game/PlayerInput.hpp"
+
+class Game;
+
+//-----------------------------------------------------------------------------
+// Something that flies a ship: asked once per tick, before the simulation
+//  step, for the input its player presses. It only ever sees the world
+//  through a const Game and only ever acts through the PlayerInput it
+//  returns, so a piloted tick replays, rolls back and replicates exactly
+//  like one played from a controller.
+class PlayerPilot
+{
+public:
+    virtual ~PlayerPilot() {}
+
+    virtual PlayerInput UpdatePilot( const Game& game, int playerIndex ) = 0;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Engine/Core/Math/Primatives/Vec2.hpp"
+#include "Engine/Core/Rgba8.hpp"
+
+#include "Game/GameCommon.hpp"
+#include "Game/WorldState.hpp"
+
+//-----------------------------------------------------------------------------
+// Only what it takes to draw one frame of a world, for a renderer that runs
+//  apart from the simulation. Unlike a WorldState nothing here restores a
+//  Game: live entities are packed at the front and only the first
+//  entityCount, shapeCount and explosionLightCount entries are ever written
+//  or read, so a frame costs what is alive rather than every slot.
+constexpr int RENDER_SNAPSHOT_MAX_ENTITIES = MAX_PLAYERS + MAX_ASTEROIDS + MAX_BULLETS + MAX_DEBRIS + MAX_BEETLES + MAX_WASPS;
+constexpr int RENDER_SNAPSHOT_MAX_SHAPES = MAX_ASTEROIDS + MAX_DEBRIS;
+constexpr int RENDER_SNAPSHOT_NO_SHAPE = -1;
+
+//-----------------------------------------------------------------------------
+struct RenderEntityState
+{
+    Vec2 position;
+    Vec2 velocity;                  // Debug drawing only
+    float angleDegrees;
+    float uniformScale;
+    float physicsRadius;            // Debug drawing only
+    float cosmeticRadius;           // What it is culled by
+    Rgba8 color;                    // As it is drawn this frame, hit flashes and fades included
+    EntityKind kind;
+    unsigned char playerIndex;      // Player ships only
+    short shapeIndex;               // Asteroids and debris, into RenderSnapshot::shapes
+};
+
+//-----------------------------------------------------------------------------
+struct RenderSnapshot
+{
+    float gameTime;
+    Vec2 cameraMins;
+    Vec2 screenShakeOffset;
+    Rgba8 titleColor;
+    float titleRotation;
+    float titleScale;
+    int playerShipCurrentLife;
+    int waveNumber;
+    bool isAttractMode;
+
+    int entityCount;
+    int shapeCount;
+    int explosionLightCount;
+
+    RenderEntityState entities[ RENDER_SNAPSHOT_MAX_ENTITIES ];
+    EntityShapeState shapes[ RENDER_SNAPSHOT_MAX_SHAPES ];
+    ExplosionLightState explosionLights[ MAX_EXPLOSION_LIGHTS ];
+};
+
+static_assert( RENDER_SNAPSHOT_MAX_SHAPES <= 0x7fff, "Shape indexes must fit RenderEntityState::shapeIndex" );
@@ -0,0 +1,60 @@
+#include "RenderSnapshotBuffer.hpp"
+
+static constexpr int RENDER_SNAPSHOT_INDEX_MASK = 0x3;
+static constexpr int RENDER_SNAPSHOT_IS_FRESH_BIT = 0x4;
+
+//-----------------------------------------------------------------------------
+RenderSnapshotBuffer::RenderSnapshotBuffer()
+    : m_SharedIndex( 2 )
+{
+}
+
+//-----------------------------------------------------------------------------
+RenderSnapshotBuffer::~RenderSnapshotBuffer()
+{
+    Shutdown();
+}
+
+//-----------------------------------------------------------------------------
+void RenderSnapshotBuffer::Startup()
+{
+    for( int stateIndex = 0; stateIndex < 3; ++stateIndex )
+    {
+        m_States[ stateIndex ] = new RenderSnapshot();
+    }
+    m_WriteIndex = 0;
+    m_ReadIndex = 1;
+    m_SharedIndex = 2;
+}
+
+//-----------------------------------------------------------------------------
+void RenderSnapshotBuffer::Shutdown()
+{
+    for( int stateIndex = 0; stateIndex < 3; ++stateIndex )
+    {
+        delete m_States[ stateIndex ];
+        m_States[ stateIndex ] = nullptr;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// The exchange releases the writes to the state being handed over, and
+//  acquires whichever state comes back so it is safe to overwrite
+void RenderSnapshotBuffer::Publish()
+{
+    int previous = m_SharedIndex.exchange( m_WriteIndex | RENDER_SNAPSHOT_IS_FRESH_BIT, std::memory_order_acq_rel );
+    m_WriteIndex = previous & RENDER_SNAPSHOT_INDEX_MASK;
+}
+
+//-----------------------------------------------------------------------------
+const RenderSnapshot* RenderSnapshotBuffer::AcquireLatest()
+{
+    if( (m_SharedIndex.load( std::memory_order_relaxed ) & RENDER_SNAPSHOT_IS_FRESH_BIT) == 0 )
+    {
+        return nullptr;
+    }
+
+    int previous = m_SharedIndex.exchange( m_ReadIndex, std::memory_order_acq_rel );
+    m_ReadIndex = previous & RENDER_SNAPSHOT_INDEX_MASK;
+    return m_States[ m_ReadIndex ];
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Game/RenderSnapshot.hpp"
+
+#include <atomic>
+
+//-----------------------------------------------------------------------------
+// Hands RenderSnapshots from the simulation thread to the render thread
+//  without either one ever waiting. Three states rotate between roles: the
+//  writer fills its own, Publish swaps it with the shared middle one, and
+//  AcquireLatest swaps the middle one with the reader's when it is newer.
+//  A state the reader holds is never written until it lets go of it by
+//  acquiring again, so it can be read for a whole frame without a lock.
+//  Frames the reader is too slow to see are simply overwritten.
+class RenderSnapshotBuffer
+{
+public:
+    RenderSnapshotBuffer();
+    ~RenderSnapshotBuffer();
+
+    void Startup();
+    void Shutdown();
+
+    // Writer side
+    RenderSnapshot& GetWriteState() { return *m_States[ m_WriteIndex ]; }
+    void Publish();
+
+    // Reader side; null when nothing was published since the last acquire
+    const RenderSnapshot* AcquireLatest();
+
+private:
+    RenderSnapshot* m_States[ 3 ] = { nullptr };
+    int m_WriteIndex = 0;                   // Writer only
+    int m_ReadIndex = 1;                    // Reader only
+    std::atomic<int> m_SharedIndex;         // Index of the middle state, plus IS_FRESH_BIT once published
+};
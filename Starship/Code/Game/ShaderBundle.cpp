@@ -0,0 +1,261 @@
+#define _CRT_SECURE_NO_WARNINGS    // fopen
+#include "ShaderBundle.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+const char* const SHADER_STAGE_ENTRY_POINTS[ SHADER_STAGE_COUNT ] = { "vert_main", "frag_main" };
+const char* const SHADER_STAGE_PROFILES[ SHADER_STAGE_COUNT ] = { "vs_5_0", "ps_5_0" };
+
+//-----------------------------------------------------------------------------
+static bool ReadWholeFile( const char* filePath, std::vector<unsigned char>& outBytes )
+{
+    FILE* file = fopen( filePath, "rb" );
+    if( file == nullptr )
+    {
+        return false;
+    }
+
+    fseek( file, 0, SEEK_END );
+    long fileBytes = ftell( file );
+    fseek( file, 0, SEEK_SET );
+
+    outBytes.resize( fileBytes > 0 ? static_cast<size_t>(fileBytes) : 0 );
+    size_t bytesRead = outBytes.empty() ? 0 : fread( outBytes.data(), 1, outBytes.size(), file );
+    fclose( file );
+    return bytesRead == outBytes.size();
+}
+
+//-----------------------------------------------------------------------------
+static bool FlattenShaderSourceRecursive( const std::string& filePath,
+                                          std::vector<std::string>& includedPaths,
+                                          std::string& outSource )
+{
+    for( const std::string& includedPath : includedPaths )
+    {
+        if( includedPath == filePath )
+        {
+            return true;
+        }
+    }
+    includedPaths.push_back( filePath );
+
+    std::vector<unsigned char> fileBytes;
+    if( !ReadWholeFile( filePath.c_str(), fileBytes ) )
+    {
+        return false;
+    }
+
+    size_t lastSlash = filePath.find_last_of( "/\\" );
+    std::string directory = lastSlash == std::string::npos ? std::string() : filePath.substr( 0, lastSlash + 1 );
+
+    const char* text = reinterpret_cast<const char*>(fileBytes.data());
+    size_t textBytes = fileBytes.size();
+    size_t lineStart = 0;
+    while( lineStart < textBytes )
+    {
+        size_t lineEnd = lineStart;
+        while( lineEnd < textBytes && text[ lineEnd ] != '\n' )
+        {
+            lineEnd++;
+        }
+        size_t lineTrimmedEnd = lineEnd > lineStart && text[ lineEnd - 1 ] == '\r' ? lineEnd - 1 : lineEnd;
+        std::string line( text + lineStart, lineTrimmedEnd - lineStart );
+        lineStart = lineEnd + 1;
+
+        size_t directiveStart = line.find_first_not_of( " \t" );
+        if( directiveStart != std::string::npos && line.compare( directiveStart, 8, "#include" ) == 0 )
+        {
+            size_t nameStart = line.find( '"', directiveStart );
+            size_t nameEnd = nameStart == std::string::npos ? std::string::npos : line.find( '"', nameStart + 1 );
+            if( nameEnd != std::string::npos )
+            {
+                std::string includePath = directory + line.substr( nameStart + 1, nameEnd - nameStart - 1 );
+                if( !FlattenShaderSourceRecursive( includePath, includedPaths, outSource ) )
+                {
+                    return false;
+                }
+                continue;
+            }
+        }
+
+        outSource += line;
+        outSource += '\n';
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FlattenShaderSource( const std::string& filePath, std::string& outSource )
+{
+    std::vector<std::string> includedPaths;
+    outSource.clear();
+    return FlattenShaderSourceRecursive( filePath, includedPaths, outSource );
+}
+
+//-----------------------------------------------------------------------------
+unsigned long long HashShaderSource( const std::string& flattenedSource )
+{
+    unsigned long long hash = 14695981039346656037ull;
+    for( char character : flattenedSource )
+    {
+        hash = (hash ^ static_cast<unsigned char>(character)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+//-----------------------------------------------------------------------------
+ShaderBundle::ShaderBundle()
+{
+}
+
+//-----------------------------------------------------------------------------
+ShaderBundle::~ShaderBundle()
+{
+}
+
+//-----------------------------------------------------------------------------
+// Everything is checked against the file size before any entry is trusted,
+//  so a truncated or foreign file is simply not loaded
+bool ShaderBundle::Load( const char* filePath )
+{
+    Unload();
+    if( !ReadWholeFile( filePath, m_FileBytes ) || m_FileBytes.size() < sizeof( ShaderBundleHeader ) )
+    {
+        Unload();
+        return false;
+    }
+
+    memcpy( &m_Header, m_FileBytes.data(), sizeof( ShaderBundleHeader ) );
+    size_t indexEnd = sizeof( ShaderBundleHeader ) + static_cast<size_t>(m_Header.entryCount) * sizeof( ShaderBundleEntry );
+    if( m_Header.magic != SHADER_BUNDLE_MAGIC || m_Header.version != SHADER_BUNDLE_VERSION || indexEnd > m_FileBytes.size() )
+    {
+        Unload();
+        return false;
+    }
+
+    m_Entries.resize( m_Header.entryCount );
+    memcpy( m_Entries.data(), m_FileBytes.data() + sizeof( ShaderBundleHeader ), m_Entries.size() * sizeof( ShaderBundleEntry ) );
+    for( ShaderBundleEntry& entry : m_Entries )
+    {
+        entry.sourcePath[ SHADER_BUNDLE_PATH_BYTES - 1 ] = '\0';
+        if( entry.stage >= SHADER_STAGE_COUNT ||
+            static_cast<size_t>(entry.blobOffset) + entry.blobBytes > m_FileBytes.size() )
+        {
+            Unload();
+            return false;
+        }
+    }
+    m_Header.compiler[ SHADER_BUNDLE_COMPILER_BYTES - 1 ] = '\0';
+
+    m_IsStale.assign( m_Entries.size(), false );
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void ShaderBundle::Unload()
+{
+    m_FileBytes.clear();
+    m_Header = ShaderBundleHeader();
+    m_Entries.clear();
+    m_IsStale.clear();
+}
+
+//-----------------------------------------------------------------------------
+// Both stages of a source share its hash, so each file is flattened once
+int ShaderBundle::ValidateAgainstSources( const std::string& shaderRoot )
+{
+    int staleCount = 0;
+    for( size_t entryIndex = 0; entryIndex < m_Entries.size(); ++entryIndex )
+    {
+        const ShaderBundleEntry& entry = m_Entries[ entryIndex ];
+        size_t sameSourceIndex = 0;
+        while( strcmp( m_Entries[ sameSourceIndex ].sourcePath, entry.sourcePath ) != 0 )
+        {
+            sameSourceIndex++;
+        }
+
+        if( sameSourceIndex < entryIndex )
+        {
+            m_IsStale[ entryIndex ] = m_IsStale[ sameSourceIndex ] || m_Entries[ sameSourceIndex ].sourceHash != entry.sourceHash;
+        }
+        else
+        {
+            std::string source;
+            bool isFlattened = FlattenShaderSource( shaderRoot + entry.sourcePath, source );
+            m_IsStale[ entryIndex ] = !isFlattened || HashShaderSource( source ) != entry.sourceHash;
+        }
+        staleCount += m_IsStale[ entryIndex ] ? 1 : 0;
+    }
+    return staleCount;
+}
+
+//-----------------------------------------------------------------------------
+const void* ShaderBundle::FindCurrentBlob( const char* sourcePath, ShaderStage stage, size_t& outBytes ) const
+{
+    outBytes = 0;
+    int entryIndex = FindEntryIndex( sourcePath, stage );
+    if( entryIndex < 0 || m_IsStale[ entryIndex ] )
+    {
+        return nullptr;
+    }
+
+    outBytes = m_Entries[ entryIndex ].blobBytes;
+    return GetBlob( entryIndex );
+}
+
+//-----------------------------------------------------------------------------
+bool ShaderBundle::Write( const char* filePath,
+                          const char* compiler,
+                          const std::vector<ShaderBundleEntry>& entries,
+                          const std::vector<std::string>& blobs )
+{
+    if( entries.size() != blobs.size() )
+    {
+        return false;
+    }
+
+    ShaderBundleHeader header;
+    header.entryCount = static_cast<unsigned int>(entries.size());
+    strncpy( header.compiler, compiler, SHADER_BUNDLE_COMPILER_BYTES - 1 );
+
+    std::vector<ShaderBundleEntry> placedEntries = entries;
+    size_t blobOffset = sizeof( ShaderBundleHeader ) + placedEntries.size() * sizeof( ShaderBundleEntry );
+    for( size_t entryIndex = 0; entryIndex < placedEntries.size(); ++entryIndex )
+    {
+        placedEntries[ entryIndex ].blobOffset = static_cast<unsigned int>(blobOffset);
+        placedEntries[ entryIndex ].blobBytes = static_cast<unsigned int>(blobs[ entryIndex ].size());
+        blobOffset += blobs[ entryIndex ].size();
+    }
+
+    FILE* file = fopen( filePath, "wb" );
+    if( file == nullptr )
+    {
+        return false;
+    }
+
+    bool isWritten = fwrite( &header, sizeof( header ), 1, file ) == 1;
+    if( isWritten && !placedEntries.empty() )
+    {
+        isWritten = fwrite( placedEntries.data(), sizeof( ShaderBundleEntry ), placedEntries.size(), file ) == placedEntries.size();
+    }
+    for( const std::string& blob : blobs )
+    {
+        isWritten = isWritten && (blob.empty() || fwrite( blob.data(), 1, blob.size(), file ) == blob.size());
+    }
+    return fclose( file ) == 0 && isWritten;
+}
+
+//-----------------------------------------------------------------------------
+int ShaderBundle::FindEntryIndex( const char* sourcePath, ShaderStage stage ) const
+{
+    for( size_t entryIndex = 0; entryIndex < m_Entries.size(); ++entryIndex )
+    {
+        const ShaderBundleEntry& entry = m_Entries[ entryIndex ];
+        if( entry.stage == stage && strcmp( entry.sourcePath, sourcePath ) == 0 )
+        {
+            return static_cast<int>(entryIndex);
+        }
+    }
+    return -1;
+}
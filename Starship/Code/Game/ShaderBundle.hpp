@@ -0,0 +1,96 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Every shader program compiled ahead of time, packed into one file: a
+//  header, a fixed size index entry per source and stage, then the bytecode
+//  blobs back to back. The ShaderBundler tool builds it offline; the game
+//  loads it whole at startup.
+//
+//  An entry is keyed by the content hash of its source with every include
+//  pasted in, so a blob is only used while the .hlsl files on disk still
+//  flatten to exactly what it was compiled from. Anything stale falls back
+//  to compiling from source, and the tool only recompiles those next run.
+//
+//  Only the standard library in here, so the tool shares it as is.
+constexpr unsigned int SHADER_BUNDLE_MAGIC = 0x4e424853;   // "SHBN"
+constexpr unsigned int SHADER_BUNDLE_VERSION = 1;
+constexpr int SHADER_BUNDLE_PATH_BYTES = 64;
+constexpr int SHADER_BUNDLE_COMPILER_BYTES = 64;
+constexpr const char* SHADER_BUNDLE_FILE_NAME = "Shaders.bundle";
+
+enum ShaderStage: unsigned int
+{
+    SHADER_STAGE_VERTEX = 0,
+    SHADER_STAGE_FRAGMENT,
+    SHADER_STAGE_COUNT
+};
+
+// Every program in the project uses the same entry point names
+extern const char* const SHADER_STAGE_ENTRY_POINTS[ SHADER_STAGE_COUNT ];
+extern const char* const SHADER_STAGE_PROFILES[ SHADER_STAGE_COUNT ];
+
+struct ShaderBundleHeader
+{
+    unsigned int magic = SHADER_BUNDLE_MAGIC;
+    unsigned int version = SHADER_BUNDLE_VERSION;
+    unsigned int entryCount = 0;
+    unsigned int unused = 0;
+    char compiler[ SHADER_BUNDLE_COMPILER_BYTES ] = {};    // Version line of the compiler that built it
+};
+
+struct ShaderBundleEntry
+{
+    char sourcePath[ SHADER_BUNDLE_PATH_BYTES ] = {};      // Relative to the shader root, '/' separated
+    unsigned long long sourceHash = 0;
+    unsigned int stage = SHADER_STAGE_VERTEX;
+    unsigned int blobOffset = 0;                            // From the start of the file
+    unsigned int blobBytes = 0;
+    unsigned int unused = 0;
+};
+
+//-----------------------------------------------------------------------------
+// Pastes each #include "file" in place, relative to the file including it,
+//  the first time that file is reached and never again; the include guards
+//  around them are left as they are. Line endings come out as '\n'.
+bool FlattenShaderSource( const std::string& filePath, std::string& outSource );
+unsigned long long HashShaderSource( const std::string& flattenedSource );     // 64 bit FNV-1a
+
+//-----------------------------------------------------------------------------
+class ShaderBundle
+{
+public:
+    ShaderBundle();
+    ~ShaderBundle();
+
+    bool Load( const char* filePath );
+    void Unload();
+    bool IsLoaded() const { return !m_FileBytes.empty(); }
+
+    // Hashes each source under shaderRoot once and marks the entries it no
+    //  longer matches; returns how many are stale
+    int ValidateAgainstSources( const std::string& shaderRoot );
+
+    // Null when there is no entry, or when it went stale; compile from source then
+    const void* FindCurrentBlob( const char* sourcePath, ShaderStage stage, size_t& outBytes ) const;
+
+    int GetEntryCount() const { return static_cast<int>(m_Entries.size()); }
+    const ShaderBundleEntry& GetEntry( int entryIndex ) const { return m_Entries[ entryIndex ]; }
+    const void* GetBlob( int entryIndex ) const { return &m_FileBytes[ m_Entries[ entryIndex ].blobOffset ]; }
+    const char* GetCompiler() const { return m_Header.compiler; }
+
+    static bool Write( const char* filePath,
+                       const char* compiler,
+                       const std::vector<ShaderBundleEntry>& entries,
+                       const std::vector<std::string>& blobs );
+
+private:
+    std::vector<unsigned char> m_FileBytes;
+    ShaderBundleHeader m_Header;
+    std::vector<ShaderBundleEntry> m_Entries;
+    std::vector<bool> m_IsStale;
+
+    int FindEntryIndex( const char* sourcePath, ShaderStage stage ) const;
+};
@@ -0,0 +1,241 @@
+#include "SimulationThread.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include "Game/Game.hpp"
+#include "Game/GameContext.hpp"
+#include "Game/InputThread.hpp"
+#include "Game/PlayerPilot.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+//-----------------------------------------------------------------------------
+SimulationThread::SimulationThread( Game* renderGame )
+    : m_RenderGame( renderGame )
+    , m_IsQuitting( false )
+{
+}
+
+//-----------------------------------------------------------------------------
+SimulationThread::~SimulationThread()
+{
+    Shutdown();
+}
+
+//-----------------------------------------------------------------------------
+void SimulationThread::SetPlayerPilot( int playerIndex, PlayerPilot* pilot )
+{
+    GUARANTEE_OR_DIE( !m_Thread.joinable(), "Pilots have to be set before the simulation thread starts" );
+    m_PlayerPilots[ playerIndex ] = pilot;
+}
+
+//-----------------------------------------------------------------------------
+// Same rules and seed as the render game, so the first published snapshot
+//  picks up where the render game's own startup left off
+void SimulationThread::Startup( int playerCount )
+{
+    GameContext context = m_RenderGame->GetContext();
+    context.renderer = nullptr;
+    context.input = nullptr;
+    context.keepsRewindHistory = false;
+
+    m_PlayerCount = playerCount;
+    m_SimulationGame = new Game( context );
+    m_SimulationGame->Startup( playerCount );
+
+    m_Snapshots.Startup();
+    m_WindowStartSeconds = GetCurrentTimeSeconds();
+
+    m_IsQuitting = false;
+    m_Thread = std::thread( &SimulationThread::ThreadMain, this );
+}
+
+//-----------------------------------------------------------------------------
+void SimulationThread::Shutdown()
+{
+    if( !m_Thread.joinable() )
+    {
+        return;
+    }
+
+    m_IsQuitting = true;
+    m_Thread.join();
+
+    m_SimulationGame->Shutdown();
+    delete m_SimulationGame;
+    m_SimulationGame = nullptr;
+
+    m_RenderGame->ShowRenderSnapshot( nullptr );
+    m_Snapshots.Shutdown();
+    m_RenderGame->SetThreadStatsText( "" );
+}
+
+//-----------------------------------------------------------------------------
+void SimulationThread::Update( float deltaSeconds )
+{
+    double startSeconds = GetCurrentTimeSeconds();
+
+    SubmitLocalInputs();
+
+    if( const RenderSnapshot* snapshot = m_Snapshots.AcquireLatest() )
+    {
+        m_RenderGame->ShowRenderSnapshot( snapshot );
+        m_WindowSnapshotsShown++;
+    }
+    m_RenderGame->UpdateAsClient( deltaSeconds );
+
+    m_WindowRenderSeconds += GetCurrentTimeSeconds() - startSeconds;
+    m_WindowFrames++;
+    UpdateStats();
+}
+
+//-----------------------------------------------------------------------------
+// Also feeds the render game, so a locally flown ship's exhaust follows the
+//  stick without waiting for the simulation
+void SimulationThread::SubmitLocalInputs()
+{
+    InputSystem* inputSystem = m_RenderGame->GetContext().input;
+    if( inputSystem == nullptr )
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock( m_InputMutex );
+    for( int playerIndex = 0; playerIndex < m_PlayerCount; ++playerIndex )
+    {
+        if( m_PlayerPilots[ playerIndex ] != nullptr )
+        {
+            continue;
+        }
+
+        PlayerInput input = SampleLocalPlayerInput( *inputSystem, playerIndex, playerIndex == 0 );
+        m_RenderGame->SetPlayerInput( playerIndex, input );
+        if( m_RenderGame->GetContext().inputThread != nullptr )
+        {
+            continue;
+        }
+
+        PlayerInput& pending = m_PendingInputs[ playerIndex ];
+        unsigned char unconsumedEdges = pending.buttons & PLAYER_INPUT_EDGE_BUTTONS;
+        pending = input;
+        pending.buttons |= unconsumedEdges;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Wakes about once a millisecond and runs however many fixed ticks are due,
+//  then publishes only the last one; the renderer could not show the others
+void SimulationThread::ThreadMain()
+{
+    double lastSeconds = GetCurrentTimeSeconds();
+    double tickAccumulator = 0.0;
+    while( !m_IsQuitting )
+    {
+        double nowSeconds = GetCurrentTimeSeconds();
+        tickAccumulator += nowSeconds - lastSeconds;
+        lastSeconds = nowSeconds;
+        if( tickAccumulator < SIMULATION_THREAD_TICK_SECONDS )
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+            continue;
+        }
+
+        int ticksThisWake = 0;
+        while( tickAccumulator >= SIMULATION_THREAD_TICK_SECONDS )
+        {
+            tickAccumulator -= SIMULATION_THREAD_TICK_SECONDS;
+            if( ticksThisWake == SIMULATION_THREAD_MAX_TICKS_PER_WAKE )
+            {
+                tickAccumulator = 0.0;
+                break;
+            }
+            // Where this tick's slice of wall time ends
+            StepSimulation( nowSeconds - tickAccumulator );
+            ticksThisWake++;
+        }
+
+        m_SimulationGame->CaptureRenderSnapshot( m_Snapshots.GetWriteState() );
+        m_Snapshots.Publish();
+
+        double busySeconds = GetCurrentTimeSeconds() - nowSeconds;
+        std::lock_guard<std::mutex> lock( m_StatsMutex );
+        m_SimulateSeconds += busySeconds;
+        m_TicksSimulated += ticksThisWake;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void SimulationThread::StepSimulation( double tickEndSeconds )
+{
+    PlayerInput inputs[ MAX_PLAYERS ];
+    if( InputThread* inputThread = m_SimulationGame->GetContext().inputThread )
+    {
+        inputThread->LatchInputs( tickEndSeconds, inputs, m_PlayerCount );
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock( m_InputMutex );
+        for( int playerIndex = 0; playerIndex < m_PlayerCount; ++playerIndex )
+        {
+            inputs[ playerIndex ] = m_PendingInputs[ playerIndex ];
+            m_PendingInputs[ playerIndex ].buttons &= ~PLAYER_INPUT_EDGE_BUTTONS;
+        }
+    }
+
+    for( int playerIndex = 0; playerIndex < m_PlayerCount; ++playerIndex )
+    {
+        if( PlayerPilot* pilot = m_PlayerPilots[ playerIndex ] )
+        {
+            inputs[ playerIndex ] = pilot->UpdatePilot( *m_SimulationGame, playerIndex );
+        }
+        m_SimulationGame->SetPlayerInput( playerIndex, inputs[ playerIndex ] );
+    }
+
+    m_SimulationGame->SimulateTick( SIMULATION_THREAD_TICK_SECONDS );
+}
+
+//-----------------------------------------------------------------------------
+// Per frame costs over the last window. A serial frame would have paid the
+//  simulation and the render side one after the other; the difference is
+//  what running them side by side bought.
+void SimulationThread::UpdateStats()
+{
+    double nowSeconds = GetCurrentTimeSeconds();
+    double windowSeconds = nowSeconds - m_WindowStartSeconds;
+    if( windowSeconds < SIMULATION_THREAD_STATS_SECONDS || m_WindowFrames == 0 )
+    {
+        return;
+    }
+
+    double simulateSeconds = 0.0;
+    int ticksSimulated = 0;
+    {
+        std::lock_guard<std::mutex> lock( m_StatsMutex );
+        simulateSeconds = m_SimulateSeconds;
+        ticksSimulated = m_TicksSimulated;
+        m_SimulateSeconds = 0.0;
+        m_TicksSimulated = 0;
+    }
+
+    double frames = static_cast<double>(m_WindowFrames);
+    double simulateMilliseconds = simulateSeconds * 1000.0 / frames;
+    double renderMilliseconds = m_WindowRenderSeconds * 1000.0 / frames;
+    double frameMilliseconds = windowSeconds * 1000.0 / frames;
+
+    char text[ 128 ];
+    snprintf( text, sizeof( text ), "SIM %.2f  RENDER %.2f  SERIAL %.2f  FRAME %.2f  TICKS %i  SHOWN %i",
+              simulateMilliseconds,
+              renderMilliseconds,
+              simulateMilliseconds + renderMilliseconds,
+              frameMilliseconds,
+              ticksSimulated,
+              m_WindowSnapshotsShown );
+    m_RenderGame->SetThreadStatsText( text );
+
+    m_WindowStartSeconds = nowSeconds;
+    m_WindowRenderSeconds = 0.0;
+    m_WindowFrames = 0;
+    m_WindowSnapshotsShown = 0;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Game/GameCommon.hpp"
+#include "Game/PlayerInput.hpp"
+#include "Game/RenderSnapshotBuffer.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+class Game;
+class PlayerPilot;
+
+//-----------------------------------------------------------------------------
+// Runs the simulation on its own thread so it overlaps rendering instead of
+//  running before it every frame. A headless Game steps at a fixed tick and
+//  publishes a RenderSnapshot after each wake into a RenderSnapshotBuffer; the
+//  thread that owns the renderer hands the latest one to the game it draws,
+//  which draws the snapshot in place of its own entities. Local devices are
+//  still read on that thread and handed over through a small locked mailbox,
+//  so the InputSystem and RenderContext only ever see one thread. With an
+//  InputThread in the context the simulation thread latches it itself, each
+//  tick up to the moment that tick stands for.
+//
+//  The render game only draws, so pause, slow motion, rewind, save and
+//  load are not available while threaded.
+constexpr float SIMULATION_THREAD_TICK_SECONDS = 1.f / 60.f;
+constexpr int SIMULATION_THREAD_MAX_TICKS_PER_WAKE = 4;        // Drops time rather than spiral after a stall
+constexpr double SIMULATION_THREAD_STATS_SECONDS = .5;
+
+class SimulationThread
+{
+public:
+    explicit SimulationThread( Game* renderGame );
+    ~SimulationThread();
+
+    // Pilots are not owned and only ever called from the simulation thread
+    void SetPlayerPilot( int playerIndex, PlayerPilot* pilot );
+    void Startup( int playerCount );
+    void Shutdown();
+
+    // Render thread only, once per frame before the render game is drawn
+    void Update( float deltaSeconds );
+    void AddRenderSeconds( double seconds ) { m_WindowRenderSeconds += seconds; }
+
+private:
+    Game* m_RenderGame = nullptr;
+    Game* m_SimulationGame = nullptr;
+    PlayerPilot* m_PlayerPilots[ MAX_PLAYERS ] = { nullptr };
+    int m_PlayerCount = 0;
+
+    std::thread m_Thread;
+    std::atomic<bool> m_IsQuitting;
+    RenderSnapshotBuffer m_Snapshots;
+
+    // Latest local input per player; edge buttons stay set until a tick
+    //  consumes them so a press between two ticks is never lost
+    std::mutex m_InputMutex;
+    PlayerInput m_PendingInputs[ MAX_PLAYERS ];
+
+    // Written by the simulation thread, collected by the render thread
+    std::mutex m_StatsMutex;
+    double m_SimulateSeconds = 0.0;
+    int m_TicksSimulated = 0;
+
+    // Render thread only
+    double m_WindowStartSeconds = 0.0;
+    double m_WindowRenderSeconds = 0.0;
+    int m_WindowFrames = 0;
+    int m_WindowSnapshotsShown = 0;
+
+    void ThreadMain();
+    void StepSimulation( double tickEndSeconds );
+    void SubmitLocalInputs();
+    void UpdateStats();
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+
+//-----------------------------------------------------------------------------
+// Fixed size ring for exactly one producer thread and one consumer thread,
+//  with no locks. Each side owns one index and only reads the other's; an
+//  item is written before the release store that publishes it and read
+//  before the release store that frees its slot. Capacity must be a power
+//  of two, and a full queue refuses the push rather than overwrite.
+template<typename Item, int Capacity>
+class SpscQueue
+{
+    static_assert( Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two" );
+
+public:
+    SpscQueue()
+        : m_ReadIndex( 0 )
+        , m_WriteIndex( 0 )
+    {
+    }
+
+    // Producer only
+    bool TryPush( const Item& item )
+    {
+        unsigned int writeIndex = m_WriteIndex.load( std::memory_order_relaxed );
+        if( writeIndex - m_ReadIndex.load( std::memory_order_acquire ) == Capacity )
+        {
+            return false;
+        }
+
+        m_Items[ writeIndex & (Capacity - 1) ] = item;
+        m_WriteIndex.store( writeIndex + 1, std::memory_order_release );
+        return true;
+    }
+
+    // Consumer only; the front item stays valid until the next Pop
+    const Item* Peek() const
+    {
+        unsigned int readIndex = m_ReadIndex.load( std::memory_order_relaxed );
+        if( readIndex == m_WriteIndex.load( std::memory_order_acquire ) )
+        {
+            return nullptr;
+        }
+        return &m_Items[ readIndex & (Capacity - 1) ];
+    }
+
+    // Consumer only, after a Peek that found something
+    void Pop()
+    {
+        m_ReadIndex.store( m_ReadIndex.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+    }
+
+private:
+    Item m_Items[ Capacity ];
+
+    // Apart so the two threads are not forever stealing one cache line
+    alignas( 64 ) std::atomic<unsigned int> m_ReadIndex;
+    alignas( 64 ) std::atomic<unsigned int> m_WriteIndex;
+};
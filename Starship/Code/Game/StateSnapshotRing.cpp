@@ -0,0 +1,226 @@
+#include "StateSnapshotRing.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <cstring>
+
+//-----------------------------------------------------------------------------
+StateSnapshotRing::StateSnapshotRing()
+{
+}
+
+//-----------------------------------------------------------------------------
+StateSnapshotRing::~StateSnapshotRing()
+{
+}
+
+//-----------------------------------------------------------------------------
+void StateSnapshotRing::Startup( int stateBytes, int maxSnapshots, int deltaBudgetBytes )
+{
+    GUARANTEE_OR_DIE( stateBytes % sizeof( unsigned int ) == 0,
+                      "StateSnapshotRing states must be whole 32 bit words" );
+
+    m_StateWords = stateBytes / static_cast<int>(sizeof( unsigned int ));
+
+    // Everything is sized once here; Push and StepBack never allocate
+    m_Newest.resize( m_StateWords );
+    // Worst case is alternating changed and unchanged words, 3 words per 2
+    m_EncodeScratch.resize( m_StateWords * 2 + 4 );
+    m_DeltaStorage.resize( deltaBudgetBytes / sizeof( unsigned int ) );
+    m_Records.resize( maxSnapshots );
+
+    Clear();
+}
+
+//-----------------------------------------------------------------------------
+void StateSnapshotRing::Shutdown()
+{
+    m_Newest.clear();
+    m_Newest.shrink_to_fit();
+    m_EncodeScratch.clear();
+    m_EncodeScratch.shrink_to_fit();
+    m_DeltaStorage.clear();
+    m_DeltaStorage.shrink_to_fit();
+    m_Records.clear();
+    m_Records.shrink_to_fit();
+
+    Clear();
+}
+
+//-----------------------------------------------------------------------------
+void StateSnapshotRing::Clear()
+{
+    m_FirstRecord = 0;
+    m_RecordCount = 0;
+    m_WriteOffset = 0;
+    m_DeltaWordsUsed = 0;
+    m_LastDeltaWords = 0;
+    m_HasNewest = false;
+}
+
+//-----------------------------------------------------------------------------
+void StateSnapshotRing::Push( const void* state )
+{
+    const unsigned int* stateWords = static_cast<const unsigned int*>(state);
+    if( m_HasNewest && !m_Records.empty() )
+    {
+        // Record how to get from the incoming state back to the current newest
+        int deltaWords = EncodeDelta( stateWords, m_Newest.data() );
+        m_LastDeltaWords = deltaWords;
+
+        int offset = ReserveDeltaSpace( deltaWords );
+        if( offset >= 0 )
+        {
+            if( m_RecordCount == static_cast<int>(m_Records.size()) )
+            {
+                DropOldestRecord();
+            }
+
+            memcpy( &m_DeltaStorage[ offset ], m_EncodeScratch.data(), deltaWords * sizeof( unsigned int ) );
+
+            int recordIndex = (m_FirstRecord + m_RecordCount) % static_cast<int>(m_Records.size());
+            m_Records[ recordIndex ].offset = offset;
+            m_Records[ recordIndex ].words = deltaWords;
+            m_RecordCount++;
+            m_WriteOffset = offset + deltaWords;
+            m_DeltaWordsUsed += deltaWords;
+        }
+    }
+
+    memcpy( m_Newest.data(), stateWords, m_StateWords * sizeof( unsigned int ) );
+    m_HasNewest = true;
+}
+
+//-----------------------------------------------------------------------------
+bool StateSnapshotRing::StepBack( void* outState )
+{
+    if( m_RecordCount == 0 )
+    {
+        return false;
+    }
+
+    int recordIndex = (m_FirstRecord + m_RecordCount - 1) % static_cast<int>(m_Records.size());
+    const DeltaRecord& record = m_Records[ recordIndex ];
+    ApplyDelta( m_Newest.data(), &m_DeltaStorage[ record.offset ], record.words );
+
+    // The newest record is always the last one written, so popping it hands
+    //  its space straight back to the writer
+    m_WriteOffset = record.offset;
+    m_DeltaWordsUsed -= record.words;
+    m_RecordCount--;
+
+    memcpy( outState, m_Newest.data(), m_StateWords * sizeof( unsigned int ) );
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+int StateSnapshotRing::GetSnapshotCount() const
+{
+    return m_HasNewest ? m_RecordCount + 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+int StateSnapshotRing::EncodeDelta( const unsigned int* newer, const unsigned int* older )
+{
+    unsigned int* out = m_EncodeScratch.data();
+    int outWords = 0;
+    int wordIndex = 0;
+    while( wordIndex < m_StateWords )
+    {
+        int unchangedStart = wordIndex;
+        while( wordIndex < m_StateWords && newer[ wordIndex ] == older[ wordIndex ] )
+        {
+            ++wordIndex;
+        }
+
+        int changedStart = wordIndex;
+        while( wordIndex < m_StateWords && newer[ wordIndex ] != older[ wordIndex ] )
+        {
+            ++wordIndex;
+        }
+
+        int changedWords = wordIndex - changedStart;
+        if( changedWords == 0 )
+        {
+            // Only an unchanged tail is left, nothing to record
+            break;
+        }
+
+        out[ outWords++ ] = static_cast<unsigned int>(changedStart - unchangedStart);
+        out[ outWords++ ] = static_cast<unsigned int>(changedWords);
+        for( int changedIndex = changedStart; changedIndex < wordIndex; ++changedIndex )
+        {
+            out[ outWords++ ] = newer[ changedIndex ] ^ older[ changedIndex ];
+        }
+    }
+
+    return outWords;
+}
+
+//-----------------------------------------------------------------------------
+// XOR is its own inverse, so the same delta flips newer -> older
+void StateSnapshotRing::ApplyDelta( unsigned int* state, const unsigned int* delta, int deltaWords ) const
+{
+    int stateIndex = 0;
+    int deltaIndex = 0;
+    while( deltaIndex < deltaWords )
+    {
+        stateIndex += static_cast<int>(delta[ deltaIndex++ ]);
+        int changedWords = static_cast<int>(delta[ deltaIndex++ ]);
+        for( int changedIndex = 0; changedIndex < changedWords; ++changedIndex )
+        {
+            state[ stateIndex++ ] ^= delta[ deltaIndex++ ];
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Finds room for a delta at the write head, evicting the oldest records it
+//  would overwrite. Returns -1 if the delta is larger than the whole budget.
+int StateSnapshotRing::ReserveDeltaSpace( int words )
+{
+    int storageWords = static_cast<int>(m_DeltaStorage.size());
+    if( words > storageWords )
+    {
+        // History can not bridge a delta this large, start over from here
+        m_FirstRecord = 0;
+        m_RecordCount = 0;
+        m_WriteOffset = 0;
+        m_DeltaWordsUsed = 0;
+        return -1;
+    }
+
+    int offset = m_WriteOffset;
+    if( offset + words > storageWords )
+    {
+        // Records past the write head are the oldest; wrapping skips the
+        //  tail so they can no longer be reached from the newest state
+        while( m_RecordCount > 0 && m_Records[ m_FirstRecord ].offset >= offset )
+        {
+            DropOldestRecord();
+        }
+        offset = 0;
+    }
+
+    while( m_RecordCount > 0 )
+    {
+        const DeltaRecord& oldest = m_Records[ m_FirstRecord ];
+        bool overlaps = oldest.offset < offset + words &&
+                        offset < oldest.offset + oldest.words;
+        if( !overlaps )
+        {
+            break;
+        }
+        DropOldestRecord();
+    }
+
+    return offset;
+}
+
+//-----------------------------------------------------------------------------
+void StateSnapshotRing::DropOldestRecord()
+{
+    m_DeltaWordsUsed -= m_Records[ m_FirstRecord ].words;
+    m_FirstRecord = (m_FirstRecord + 1) % static_cast<int>(m_Records.size());
+    m_RecordCount--;
+}
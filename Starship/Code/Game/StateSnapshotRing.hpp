@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// History of fixed size state blobs kept as XOR deltas in a preallocated
+//  ring. Only the newest state is held in full; each record turns it into
+//  the state before it, so rewinding is one decode per step and the memory
+//  cost is proportional to how much actually changed per tick.
+//
+//  Delta encoding is over 32 bit words: runs of
+//      [ unchanged word count ][ changed word count ][ changed words XOR'd ]
+class StateSnapshotRing
+{
+public:
+    StateSnapshotRing();
+    ~StateSnapshotRing();
+
+    void Startup( int stateBytes, int maxSnapshots, int deltaBudgetBytes );
+    void Shutdown();
+    void Clear();
+
+    void Push( const void* state );
+    bool StepBack( void* outState );
+
+    int GetSnapshotCount() const;
+    int GetDeltaBytesUsed() const { return m_DeltaWordsUsed * static_cast<int>(sizeof( unsigned int )); }
+    int GetLastDeltaBytes() const { return m_LastDeltaWords * static_cast<int>(sizeof( unsigned int )); }
+
+private:
+    struct DeltaRecord
+    {
+        int offset = 0;
+        int words = 0;
+    };
+
+    std::vector<unsigned int> m_Newest;         // Full copy of the last pushed state
+    std::vector<unsigned int> m_EncodeScratch;  // Worst case sized delta buffer
+    std::vector<unsigned int> m_DeltaStorage;   // Ring of encoded deltas
+    std::vector<DeltaRecord> m_Records;         // Ring of records, oldest at m_FirstRecord
+
+    int m_StateWords = 0;
+    int m_FirstRecord = 0;
+    int m_RecordCount = 0;
+    int m_WriteOffset = 0;
+    int m_DeltaWordsUsed = 0;
+    int m_LastDeltaWords = 0;
+    bool m_HasNewest = false;
+
+    int EncodeDelta( const unsigned int* newer, const unsigned int* older );
+    void ApplyDelta( unsigned int* state, const unsigned int* delta, int deltaWords ) const;
+    int ReserveDeltaSpace( int words );
+    void DropOldestRecord();
+};
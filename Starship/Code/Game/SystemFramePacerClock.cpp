@@ -0,0 +1,24 @@
+#include "SystemFramePacerClock.hpp"
+
+#include "Engine/Core/Time.hpp"
+
+#include <chrono>
+#include <thread>
+
+//-----------------------------------------------------------------------------
+double SystemFramePacerClock::GetCurrentSeconds()
+{
+    return GetCurrentTimeSeconds();
+}
+
+//-----------------------------------------------------------------------------
+void SystemFramePacerClock::SleepSeconds( double seconds )
+{
+    std::this_thread::sleep_for( std::chrono::duration<double>( seconds ) );
+}
+
+//-----------------------------------------------------------------------------
+void SystemFramePacerClock::Spin()
+{
+    std::this_thread::yield();
+}
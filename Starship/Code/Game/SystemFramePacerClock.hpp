@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Game/FramePacer.hpp"
+
+//-----------------------------------------------------------------------------
+// GetCurrentTimeSeconds and a real thread sleep. Kept apart from FramePacer
+//  so the pacing itself builds without the engine.
+class SystemFramePacerClock: public FramePacerClock
+{
+public:
+    virtual double GetCurrentSeconds() override;
+    virtual void SleepSeconds( double seconds ) override;
+    virtual void Spin() override;
+};
@@ -0,0 +1,397 @@
+#include "TileLightBinner.hpp"
+
+#include <chrono>
+#include <cmath>
+
+#if defined( _M_X64 ) || defined( __SSE2__ )
+#include <emmintrin.h>
+#define TILE_LIGHT_BINNER_SSE
+#endif
+
+// Rounding at a tile's edge can only add a light to it, never lose one
+static constexpr float TILE_LIGHT_RADIUS_SLACK = TILE_LIGHT_TILE_SIZE * .001f;
+
+//-----------------------------------------------------------------------------
+// Just the vector math the shader uses, spelled out in the same order so the
+//  reference rounds the way it does
+namespace
+{
+    struct Float3
+    {
+        float x = 0.f;
+        float y = 0.f;
+        float z = 0.f;
+    };
+
+    Float3 MakeFloat3( const float values[ 3 ] ) { return Float3{ values[ 0 ], values[ 1 ], values[ 2 ] }; }
+    Float3 Add( const Float3& a, const Float3& b ) { return Float3{ a.x + b.x, a.y + b.y, a.z + b.z }; }
+    Float3 Subtract( const Float3& a, const Float3& b ) { return Float3{ a.x - b.x, a.y - b.y, a.z - b.z }; }
+    Float3 Multiply( const Float3& a, const Float3& b ) { return Float3{ a.x * b.x, a.y * b.y, a.z * b.z }; }
+    Float3 Scale( const Float3& a, float scale ) { return Float3{ a.x * scale, a.y * scale, a.z * scale }; }
+    float Dot( const Float3& a, const Float3& b ) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    float Saturate( float value ) { return value < 0.f ? 0.f : (value > 1.f ? 1.f : value); }
+    Float3 Saturate( const Float3& a ) { return Float3{ Saturate( a.x ), Saturate( a.y ), Saturate( a.z ) }; }
+    Float3 Pow( const Float3& a, float power ) { return Float3{ powf( a.x, power ), powf( a.y, power ), powf( a.z, power ) }; }
+
+    // safe_normalize in lighting_utils.hlsl
+    Float3 SafeNormalize( const Float3& a )
+    {
+        float lengthSquared = Dot( a, a );
+        return Scale( a, 1.f / sqrtf( lengthSquared > 1e-12f ? lengthSquared : 1e-12f ) );
+    }
+
+    float SmoothStep( float edge0, float edge1, float value )
+    {
+        float t = Saturate( (value - edge0) / (edge1 - edge0) );
+        return t * t * (3.f - 2.f * t);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// calculate_tile_light_factors_at_point
+static void EvaluateTileLightFactors( const TileLightingConstants& constants,
+                                      const Float3& worldPosition,
+                                      const Float3& worldNormal,
+                                      const TileLight& light,
+                                      float& outDiffuse,
+                                      float& outSpecular )
+{
+    Float3 toLight = Subtract( MakeFloat3( light.position ), worldPosition );
+    float toLightDistanceSquared = Dot( toLight, toLight );
+    Float3 toLightDirection = SafeNormalize( toLight );
+
+    float window = Saturate( 1.f - toLightDistanceSquared / (light.radius * light.radius) );
+    float attenuation = light.intensity * window * window / (1.f + toLightDistanceSquared);
+
+    float incidentAngle = Dot( toLightDirection, worldNormal );
+    float facing = SmoothStep( -.25f, .1f, incidentAngle );
+    float diffuse = incidentAngle > 0.f ? incidentAngle : 0.f;
+
+    Float3 viewDirection = SafeNormalize( Subtract( MakeFloat3( constants.cameraPosition ), worldPosition ) );
+    Float3 halfDirection = SafeNormalize( Add( toLightDirection, viewDirection ) );
+    float specular = Dot( worldNormal, halfDirection );
+    specular = powf( facing * (specular > 0.f ? specular : 0.f), constants.specularPower );
+
+    outDiffuse = attenuation * diffuse;
+    outSpecular = attenuation * specular;
+}
+
+//-----------------------------------------------------------------------------
+void EvaluateTileLighting( const TileLightingConstants& constants,
+                           const float worldPosition[ 3 ],
+                           const float worldNormal[ 3 ],
+                           const float textureColor[ 4 ],
+                           const float tint[ 4 ],
+                           const TileLight* lights,
+                           const unsigned int* lightIndices,
+                           int lightCount,
+                           float outColor[ 3 ] )
+{
+    const Float3 position = MakeFloat3( worldPosition );
+    const Float3 normal = MakeFloat3( worldNormal );
+    Float3 surfaceColor = Multiply( Pow( MakeFloat3( textureColor ), constants.gamma ), MakeFloat3( tint ) );
+
+    Float3 diffuse = Pow( Scale( MakeFloat3( constants.ambient ), constants.ambient[ 3 ] ), constants.gamma );
+    Float3 specular;
+    for( int listIndex = 0; listIndex < lightCount; ++listIndex )
+    {
+        const TileLight& light = lights[ lightIndices != nullptr ? lightIndices[ listIndex ] : static_cast<unsigned int>(listIndex) ];
+        Float3 lightColor = Pow( MakeFloat3( light.color ), constants.gamma );
+
+        float diffuseFactor = 0.f;
+        float specularFactor = 0.f;
+        EvaluateTileLightFactors( constants, position, normal, light, diffuseFactor, specularFactor );
+
+        diffuse = Add( diffuse, Scale( lightColor, diffuseFactor ) );
+        specular = Add( specular, Scale( lightColor, specularFactor ) );
+    }
+
+    diffuse = Saturate( diffuse );
+    specular = Scale( specular, constants.specularFactor );
+
+    Float3 finalColor = Add( Multiply( diffuse, surfaceColor ), specular );
+    outColor[ 0 ] = finalColor.x;
+    outColor[ 1 ] = finalColor.y;
+    outColor[ 2 ] = finalColor.z;
+}
+
+//-----------------------------------------------------------------------------
+// Floor of offset in tiles, clamped in float first so far away lights can't
+//  overflow the conversion
+static int GetTileCoordinate( float offset, int tileCount )
+{
+    float tile = floorf( offset * (1.f / TILE_LIGHT_TILE_SIZE) );
+    tile = tile < -1.f ? -1.f : (tile > static_cast<float>(tileCount) ? static_cast<float>(tileCount) : tile);
+    return static_cast<int>(tile);
+}
+
+//-----------------------------------------------------------------------------
+// One bit per tile in reach, for the four tiles of a row from firstTileMinX
+static int GetTilesInReachMask( float firstTileMinX, float lightX, float radiusSquared, float dySquared )
+{
+#if defined( TILE_LIGHT_BINNER_SSE )
+    const __m128 laneOffsets = _mm_setr_ps( 0.f, TILE_LIGHT_TILE_SIZE, 2.f * TILE_LIGHT_TILE_SIZE, 3.f * TILE_LIGHT_TILE_SIZE );
+    __m128 tileMins = _mm_add_ps( _mm_set1_ps( firstTileMinX ), laneOffsets );
+    __m128 tileMaxs = _mm_add_ps( tileMins, _mm_set1_ps( TILE_LIGHT_TILE_SIZE ) );
+    __m128 center = _mm_set1_ps( lightX );
+    __m128 dx = _mm_max_ps( _mm_max_ps( _mm_sub_ps( tileMins, center ), _mm_sub_ps( center, tileMaxs ) ), _mm_setzero_ps() );
+    __m128 distanceSquared = _mm_add_ps( _mm_mul_ps( dx, dx ), _mm_set1_ps( dySquared ) );
+    return _mm_movemask_ps( _mm_cmple_ps( distanceSquared, _mm_set1_ps( radiusSquared ) ) );
+#else
+    int mask = 0;
+    for( int lane = 0; lane < 4; ++lane )
+    {
+        float tileMinX = firstTileMinX + static_cast<float>(lane) * TILE_LIGHT_TILE_SIZE;
+        float tileMaxX = tileMinX + TILE_LIGHT_TILE_SIZE;
+        float dx = fmaxf( fmaxf( tileMinX - lightX, lightX - tileMaxX ), 0.f );
+        mask |= dx * dx + dySquared <= radiusSquared ? 1 << lane : 0;
+    }
+    return mask;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+TileLightBinner::TileLightBinner()
+    : m_NextBand( 0 )
+    , m_BandDroppedCount( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+TileLightBinner::~TileLightBinner()
+{
+    Shutdown();
+}
+
+//-----------------------------------------------------------------------------
+void TileLightBinner::Startup( int workerCount )
+{
+    if( workerCount < 0 )
+    {
+        workerCount = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+        workerCount = workerCount < TILE_LIGHT_MAX_WORKERS ? workerCount : TILE_LIGHT_MAX_WORKERS;
+        workerCount = workerCount > 0 ? workerCount : 0;
+    }
+
+    m_IsQuitting = false;
+    m_Workers.reserve( workerCount );
+    for( int workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+    {
+        m_Workers.emplace_back( &TileLightBinner::WorkerMain, this );
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TileLightBinner::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_Mutex );
+        m_IsQuitting = true;
+    }
+    m_WorkReady.notify_all();
+
+    for( std::thread& worker : m_Workers )
+    {
+        worker.join();
+    }
+    m_Workers.clear();
+}
+
+//-----------------------------------------------------------------------------
+void TileLightBinner::Bin( const TileLight* lights, int lightCount, const float viewMins[ 2 ], const float viewMaxs[ 2 ] )
+{
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    m_GridMins[ 0 ] = viewMins[ 0 ];
+    m_GridMins[ 1 ] = viewMins[ 1 ];
+    m_TileCountX = static_cast<int>(ceilf( (viewMaxs[ 0 ] - viewMins[ 0 ]) / TILE_LIGHT_TILE_SIZE ));
+    m_TileCountY = static_cast<int>(ceilf( (viewMaxs[ 1 ] - viewMins[ 1 ]) / TILE_LIGHT_TILE_SIZE ));
+    m_TileCountX = m_TileCountX > 0 ? m_TileCountX : 1;
+    m_TileCountY = m_TileCountY > 0 ? m_TileCountY : 1;
+    int tileCount = m_TileCountX * m_TileCountY;
+    m_TileCounts.assign( tileCount, 0 );
+    m_TileSlots.resize( static_cast<size_t>(tileCount) * TILE_LIGHT_MAX_PER_TILE );
+
+    m_Footprints.resize( lightCount );
+    for( int lightIndex = 0; lightIndex < lightCount; ++lightIndex )
+    {
+        const TileLight& light = lights[ lightIndex ];
+        LightFootprint& footprint = m_Footprints[ lightIndex ];
+        footprint = LightFootprint();
+        if( !(light.radius > 0.f) )
+        {
+            continue;
+        }
+
+        float reach = light.radius + TILE_LIGHT_RADIUS_SLACK;
+        footprint.x = light.position[ 0 ];
+        footprint.y = light.position[ 1 ];
+        footprint.radiusSquared = reach * reach;
+
+        int firstColumn = GetTileCoordinate( footprint.x - reach - m_GridMins[ 0 ], m_TileCountX );
+        int lastColumn = GetTileCoordinate( footprint.x + reach - m_GridMins[ 0 ], m_TileCountX );
+        int firstRow = GetTileCoordinate( footprint.y - reach - m_GridMins[ 1 ], m_TileCountY );
+        int lastRow = GetTileCoordinate( footprint.y + reach - m_GridMins[ 1 ], m_TileCountY );
+        if( lastColumn < 0 || firstColumn >= m_TileCountX || lastRow < 0 || firstRow >= m_TileCountY )
+        {
+            continue;
+        }
+
+        footprint.firstColumn = firstColumn > 0 ? firstColumn : 0;
+        footprint.lastColumn = lastColumn < m_TileCountX ? lastColumn : m_TileCountX - 1;
+        footprint.firstRow = firstRow > 0 ? firstRow : 0;
+        footprint.lastRow = lastRow < m_TileCountY ? lastRow : m_TileCountY - 1;
+    }
+
+    // Waking the workers costs more than a handful of lights does
+    int bandCount = lightCount >= TILE_LIGHT_PARALLEL_MIN_LIGHTS ? GetWorkerCount() + 1 : 1;
+    bandCount = bandCount < m_TileCountY ? bandCount : m_TileCountY;
+    m_BandDroppedCount = 0;
+    if( bandCount == 1 )
+    {
+        m_BandCount = 1;
+        BinBand( 0 );
+    }
+    else
+    {
+        std::unique_lock<std::mutex> lock( m_Mutex );
+        m_BandCount = bandCount;
+        m_BandsFinished = 0;
+        m_NextBand = 0;
+        m_JobId++;
+        m_WorkReady.notify_all();
+
+        lock.unlock();
+        int bandsFinished = BinClaimedBands();
+        lock.lock();
+
+        // Idle as well as finished, so no worker is still reading m_BandCount
+        m_BandsFinished += bandsFinished;
+        m_WorkDone.wait( lock, [this]() { return m_BandsFinished == m_BandCount && m_BusyWorkers == 0; } );
+    }
+    m_DroppedCount = m_BandDroppedCount;
+
+    m_TileRanges.resize( tileCount );
+    m_LightIndices.clear();
+    m_MostLightsInTile = 0;
+    for( int tileIndex = 0; tileIndex < tileCount; ++tileIndex )
+    {
+        int tileLightCount = m_TileCounts[ tileIndex ];
+        const unsigned int* tileSlots = &m_TileSlots[ static_cast<size_t>(tileIndex) * TILE_LIGHT_MAX_PER_TILE ];
+
+        m_TileRanges[ tileIndex ].offset = static_cast<unsigned int>(m_LightIndices.size());
+        m_TileRanges[ tileIndex ].count = static_cast<unsigned int>(tileLightCount);
+        m_LightIndices.insert( m_LightIndices.end(), tileSlots, tileSlots + tileLightCount );
+        m_MostLightsInTile = tileLightCount > m_MostLightsInTile ? tileLightCount : m_MostLightsInTile;
+    }
+
+    m_LastBinSeconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - startTime ).count();
+}
+
+//-----------------------------------------------------------------------------
+// Multiplies by the inverse size as the shader does, so both round alike
+int TileLightBinner::GetTileIndexAt( float x, float y ) const
+{
+    int column = static_cast<int>(floorf( (x - m_GridMins[ 0 ]) * (1.f / TILE_LIGHT_TILE_SIZE) ));
+    int row = static_cast<int>(floorf( (y - m_GridMins[ 1 ]) * (1.f / TILE_LIGHT_TILE_SIZE) ));
+    column = column < 0 ? 0 : (column >= m_TileCountX ? m_TileCountX - 1 : column);
+    row = row < 0 ? 0 : (row >= m_TileCountY ? m_TileCountY - 1 : row);
+    return row * m_TileCountX + column;
+}
+
+//-----------------------------------------------------------------------------
+void TileLightBinner::WorkerMain()
+{
+    int lastJobId = 0;
+    for( ;; )
+    {
+        {
+            std::unique_lock<std::mutex> lock( m_Mutex );
+            m_WorkReady.wait( lock, [&]() { return m_IsQuitting || m_JobId != lastJobId; } );
+            if( m_IsQuitting )
+            {
+                return;
+            }
+            lastJobId = m_JobId;
+            m_BusyWorkers++;
+        }
+
+        int bandsFinished = BinClaimedBands();
+
+        {
+            std::lock_guard<std::mutex> lock( m_Mutex );
+            m_BandsFinished += bandsFinished;
+            m_BusyWorkers--;
+        }
+        m_WorkDone.notify_all();
+    }
+}
+
+//-----------------------------------------------------------------------------
+int TileLightBinner::BinClaimedBands()
+{
+    int bandsFinished = 0;
+    for( int bandIndex = m_NextBand.fetch_add( 1 ); bandIndex < m_BandCount; bandIndex = m_NextBand.fetch_add( 1 ) )
+    {
+        BinBand( bandIndex );
+        bandsFinished++;
+    }
+    return bandsFinished;
+}
+
+//-----------------------------------------------------------------------------
+// Lights go in ascending order, so every tile's list comes out sorted
+void TileLightBinner::BinBand( int bandIndex )
+{
+    int rowsPerBand = (m_TileCountY + m_BandCount - 1) / m_BandCount;
+    int bandFirstRow = bandIndex * rowsPerBand;
+    int bandEndRow = bandFirstRow + rowsPerBand < m_TileCountY ? bandFirstRow + rowsPerBand : m_TileCountY;
+
+    int droppedCount = 0;
+    for( int lightIndex = 0; lightIndex < static_cast<int>(m_Footprints.size()); ++lightIndex )
+    {
+        const LightFootprint& footprint = m_Footprints[ lightIndex ];
+        int firstRow = footprint.firstRow > bandFirstRow ? footprint.firstRow : bandFirstRow;
+        int endRow = footprint.lastRow + 1 < bandEndRow ? footprint.lastRow + 1 : bandEndRow;
+        for( int row = firstRow; row < endRow; ++row )
+        {
+            float rowMinY = m_GridMins[ 1 ] + static_cast<float>(row) * TILE_LIGHT_TILE_SIZE;
+            float rowMaxY = rowMinY + TILE_LIGHT_TILE_SIZE;
+            float dy = fmaxf( fmaxf( rowMinY - footprint.y, footprint.y - rowMaxY ), 0.f );
+            float dySquared = dy * dy;
+            if( dySquared > footprint.radiusSquared )
+            {
+                continue;
+            }
+
+            int rowFirstTile = row * m_TileCountX;
+            for( int column = footprint.firstColumn; column <= footprint.lastColumn; column += 4 )
+            {
+                float firstTileMinX = m_GridMins[ 0 ] + static_cast<float>(column) * TILE_LIGHT_TILE_SIZE;
+                int tileMask = GetTilesInReachMask( firstTileMinX, footprint.x, footprint.radiusSquared, dySquared );
+
+                int lanesInRow = footprint.lastColumn - column + 1;
+                tileMask &= lanesInRow >= 4 ? 0xf : (1 << lanesInRow) - 1;
+                for( int lane = 0; tileMask != 0; ++lane, tileMask >>= 1 )
+                {
+                    if( (tileMask & 1) == 0 )
+                    {
+                        continue;
+                    }
+
+                    int tileIndex = rowFirstTile + column + lane;
+                    int& tileLightCount = m_TileCounts[ tileIndex ];
+                    if( tileLightCount == TILE_LIGHT_MAX_PER_TILE )
+                    {
+                        droppedCount++;
+                        continue;
+                    }
+                    m_TileSlots[ static_cast<size_t>(tileIndex) * TILE_LIGHT_MAX_PER_TILE + tileLightCount ] = static_cast<unsigned int>(lightIndex);
+                    tileLightCount++;
+                }
+            }
+        }
+    }
+
+    m_BandDroppedCount.fetch_add( droppedCount, std::memory_order_relaxed );
+}
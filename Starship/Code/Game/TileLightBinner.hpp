@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Cuts a view into a grid of square tiles and lists, per tile, every light
+//  whose range reaches into it, so default_lit_tiled.hlsl loops over the few
+//  lights that can touch a pixel instead of a fixed MAX_LIGHTS array. The
+//  output is laid out as the shader reads it: the lights as given, one
+//  TileLightRange per tile row by row from the view's mins, and the ranges'
+//  light indices back to back.
+//
+//  A light fades to exactly zero at its radius in the shader and in
+//  EvaluateTileLighting alike, so leaving it out of a tile it cannot reach
+//  changes nothing and binned lighting equals lighting from every light.
+//  Tiles are columns with no depth, so a light covers the disc of its radius
+//  whatever its height. Rows are split into bands binned at once by the
+//  caller and the workers, and each light is tested against four tiles of a
+//  row at a time. Lists keep ascending light order, so the result is the same
+//  however many threads built it.
+//
+//  Nothing here needs the engine, so the binning can be checked against
+//  EvaluateTileLighting by a standalone program; see Tools/LightBinningCheck.
+constexpr float TILE_LIGHT_TILE_SIZE = 10.f;                // World units, square
+constexpr int TILE_LIGHT_MAX_PER_TILE = 256;                // The rest are dropped and counted
+constexpr int TILE_LIGHT_PARALLEL_MIN_LIGHTS = 64;          // Fewer are binned on the caller alone
+constexpr int TILE_LIGHT_MAX_WORKERS = 3;
+
+struct TileLight                        // The shader's tile_light_t
+{
+    float position[ 3 ] = { 0.f, 0.f, 0.f };
+    float radius = 0.f;                 // Contributes nothing at or past this distance
+    float color[ 3 ] = { 1.f, 1.f, 1.f };
+    float intensity = 0.f;
+};
+static_assert( sizeof( TileLight ) == 32, "TileLight must match tile_light_t's stride" );
+
+struct TileLightRange
+{
+    unsigned int offset = 0;            // Into the light indices
+    unsigned int count = 0;
+};
+
+// What calculate_tiled_lighting_at_point reads from its constant buffers,
+//  besides the lights
+struct TileLightingConstants
+{
+    float cameraPosition[ 3 ] = { 0.f, 0.f, 0.f };
+    float ambient[ 4 ] = { 0.f, 0.f, 0.f, 0.f };     // w scales xyz
+    float gamma = 2.2f;
+    float specularFactor = 1.f;
+    float specularPower = 16.f;
+};
+
+//-----------------------------------------------------------------------------
+// C++ copy of calculate_tiled_lighting_at_point, so binning can be checked
+//  without a GPU. Reads lights[ lightIndices[ i ] ] for i below lightCount,
+//  as the shader walks a tile's list, or every light up to lightCount when
+//  lightIndices is null. Alpha is left out, the shader writes 1.
+void EvaluateTileLighting( const TileLightingConstants& constants,
+                           const float worldPosition[ 3 ],
+                           const float worldNormal[ 3 ],
+                           const float textureColor[ 4 ],
+                           const float tint[ 4 ],
+                           const TileLight* lights,
+                           const unsigned int* lightIndices,
+                           int lightCount,
+                           float outColor[ 3 ] );
+
+//-----------------------------------------------------------------------------
+class TileLightBinner
+{
+public:
+    TileLightBinner();
+    ~TileLightBinner();
+
+    void Startup( int workerCount );    // Besides the caller; -1 picks from the hardware
+    void Shutdown();
+
+    // Replaces the last result. The lights are only read during the call.
+    void Bin( const TileLight* lights, int lightCount, const float viewMins[ 2 ], const float viewMaxs[ 2 ] );
+
+    // The tile the shader picks for a point, clamped into the grid
+    int GetTileIndexAt( float x, float y ) const;
+
+    int GetTileCountX() const { return m_TileCountX; }
+    int GetTileCountY() const { return m_TileCountY; }
+    float GetGridMinX() const { return m_GridMins[ 0 ]; }
+    float GetGridMinY() const { return m_GridMins[ 1 ]; }
+    const std::vector<TileLightRange>& GetTileRanges() const { return m_TileRanges; }
+    const std::vector<unsigned int>& GetLightIndices() const { return m_LightIndices; }
+
+    int GetWorkerCount() const { return static_cast<int>(m_Workers.size()); }
+    int GetMostLightsInTile() const { return m_MostLightsInTile; }
+    int GetDroppedCount() const { return m_DroppedCount; }     // Last Bin's, past TILE_LIGHT_MAX_PER_TILE
+    double GetLastBinSeconds() const { return m_LastBinSeconds; }
+
+private:
+    // A light's reach in whole tiles, worked out once per Bin
+    struct LightFootprint
+    {
+        float x = 0.f;
+        float y = 0.f;
+        float radiusSquared = 0.f;
+        int firstColumn = 0;
+        int lastColumn = -1;            // Empty when it misses the grid
+        int firstRow = 0;
+        int lastRow = -1;
+    };
+
+    float m_GridMins[ 2 ] = { 0.f, 0.f };
+    int m_TileCountX = 0;
+    int m_TileCountY = 0;
+    std::vector<LightFootprint> m_Footprints;
+    std::vector<int> m_TileCounts;
+    std::vector<unsigned int> m_TileSlots;      // TILE_LIGHT_MAX_PER_TILE per tile, filled by the bands
+    std::vector<TileLightRange> m_TileRanges;
+    std::vector<unsigned int> m_LightIndices;
+    int m_MostLightsInTile = 0;
+    int m_DroppedCount = 0;
+    double m_LastBinSeconds = 0.0;
+
+    std::vector<std::thread> m_Workers;
+
+    // Guarded by m_Mutex, except the band counter which is claimed without it;
+    //  the bands themselves write disjoint rows
+    std::mutex m_Mutex;
+    std::condition_variable m_WorkReady;
+    std::condition_variable m_WorkDone;
+    bool m_IsQuitting = false;
+    int m_JobId = 0;                    // Bumped per Bin so sleeping workers see new work
+    int m_BandCount = 0;
+    int m_BandsFinished = 0;
+    int m_BusyWorkers = 0;
+    std::atomic<int> m_NextBand;
+    std::atomic<int> m_BandDroppedCount;
+
+    void WorkerMain();
+    int BinClaimedBands();
+    void BinBand( int bandIndex );
+};
@@ -0,0 +1,257 @@
+#include "VectorFont.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <cstring>
+
+//-----------------------------------------------------------------------------
+// Segment layout for the HUD glyphs. Each segment is a quad in the 2 x 3 cell.
+//
+//   aaaaaaa
+//  f j h k b
+//  f  jhk  b
+//   g1  g2
+//  e  lim  c
+//  e l i m c
+//   ddddddd
+enum GlyphSegment: unsigned int
+{
+    SEG_A = 1 << 0,     // Top
+    SEG_B = 1 << 1,     // Upper right
+    SEG_C = 1 << 2,     // Lower right
+    SEG_D = 1 << 3,     // Bottom
+    SEG_E = 1 << 4,     // Lower left
+    SEG_F = 1 << 5,     // Upper left
+    SEG_G1 = 1 << 6,    // Middle left
+    SEG_G2 = 1 << 7,    // Middle right
+    SEG_H = 1 << 8,     // Center upper
+    SEG_I = 1 << 9,     // Center lower
+    SEG_J = 1 << 10,    // Diagonal upper left
+    SEG_K = 1 << 11,    // Diagonal upper right
+    SEG_L = 1 << 12,    // Diagonal lower left
+    SEG_M = 1 << 13,    // Diagonal lower right
+    SEG_COLON = 1 << 14,
+    SEG_PERIOD = 1 << 15,
+
+    SEG_G = SEG_G1 | SEG_G2,
+};
+constexpr int SEGMENT_COUNT = 16;
+
+// Four corners per segment, counter-clockwise
+static const Vec2 SEGMENT_QUADS[ SEGMENT_COUNT ][ 4 ] = {
+    { Vec2( 0.f, 1.f ), Vec2( 2.f, 1.f ), Vec2( 2.f, 1.5f ), Vec2( 0.f, 1.5f ) },
+    { Vec2( 1.5f, 0.f ), Vec2( 2.f, 0.f ), Vec2( 2.f, 1.5f ), Vec2( 1.5f, 1.5f ) },
+    { Vec2( 1.5f, -1.5f ), Vec2( 2.f, -1.5f ), Vec2( 2.f, 0.f ), Vec2( 1.5f, 0.f ) },
+    { Vec2( 0.f, -1.5f ), Vec2( 2.f, -1.5f ), Vec2( 2.f, -1.f ), Vec2( 0.f, -1.f ) },
+    { Vec2( 0.f, -1.5f ), Vec2( .5f, -1.5f ), Vec2( .5f, 0.f ), Vec2( 0.f, 0.f ) },
+    { Vec2( 0.f, 0.f ), Vec2( .5f, 0.f ), Vec2( .5f, 1.5f ), Vec2( 0.f, 1.5f ) },
+    { Vec2( 0.f, -.25f ), Vec2( 1.f, -.25f ), Vec2( 1.f, .25f ), Vec2( 0.f, .25f ) },
+    { Vec2( 1.f, -.25f ), Vec2( 2.f, -.25f ), Vec2( 2.f, .25f ), Vec2( 1.f, .25f ) },
+    { Vec2( .75f, 0.f ), Vec2( 1.25f, 0.f ), Vec2( 1.25f, 1.5f ), Vec2( .75f, 1.5f ) },
+    { Vec2( .75f, -1.5f ), Vec2( 1.25f, -1.5f ), Vec2( 1.25f, 0.f ), Vec2( .75f, 0.f ) },
+    { Vec2( .75f, 0.f ), Vec2( 1.25f, 0.f ), Vec2( .5f, 1.5f ), Vec2( 0.f, 1.5f ) },
+    { Vec2( .75f, 0.f ), Vec2( 1.25f, 0.f ), Vec2( 2.f, 1.5f ), Vec2( 1.5f, 1.5f ) },
+    { Vec2( 0.f, -1.5f ), Vec2( .5f, -1.5f ), Vec2( 1.25f, 0.f ), Vec2( .75f, 0.f ) },
+    { Vec2( 1.5f, -1.5f ), Vec2( 2.f, -1.5f ), Vec2( 1.25f, 0.f ), Vec2( .75f, 0.f ) },
+    { Vec2( .75f, .5f ), Vec2( 1.25f, .5f ), Vec2( 1.25f, 1.f ), Vec2( .75f, 1.f ) },
+    { Vec2( .75f, -1.5f ), Vec2( 1.25f, -1.5f ), Vec2( 1.25f, -1.f ), Vec2( .75f, -1.f ) },
+};
+
+//-----------------------------------------------------------------------------
+// Chunky title letters, the same triangles the attract screen always used
+static const Vec2 TITLE_S[] = {
+    Vec2( 0.f, 1.5f ), Vec2( 2.f, .5f ), Vec2( 2.f, 1.5f ),
+    Vec2( 0.f, 1.5f ), Vec2( 1.f, -.5f ), Vec2( 1.f, .5f ),
+    Vec2( 1.f, .5f ), Vec2( 1.f, -.5f ), Vec2( 2.f, -1.5f ),
+    Vec2( 0.f, -.5f ), Vec2( 0.f, -1.5f ), Vec2( 2.f, -1.5f ),
+};
+static const Vec2 TITLE_T[] = {
+    Vec2( 0.f, 1.5f ), Vec2( 0.f, .5f ), Vec2( 1.f, 1.5f ),
+    Vec2( 2.f, .5f ), Vec2( 2.f, 1.5f ), Vec2( 1.f, 1.5f ),
+    Vec2( .5f, -1.5f ), Vec2( 1.5f, -1.5f ), Vec2( 1.f, 1.5f ),
+};
+static const Vec2 TITLE_A[] = {
+    Vec2( 0.f, 1.5f ), Vec2( 0.f, .5f ), Vec2( 2.f, 1.5f ),
+    Vec2( 0.f, 1.5f ), Vec2( 2.f, .5f ), Vec2( 2.f, 1.5f ),
+    Vec2( 0.f, 1.5f ), Vec2( 0.f, -1.5f ), Vec2( 1.f, 1.5f ),
+    Vec2( 1.f, 1.5f ), Vec2( 2.f, -1.5f ), Vec2( 2.f, 1.5f ),
+    Vec2( 0.f, -.5f ), Vec2( 1.f, -1.f ), Vec2( 1.f, 0.f ),
+    Vec2( 2.f, -.5f ), Vec2( 1.f, 0.f ), Vec2( 1.f, -1.f ),
+};
+static const Vec2 TITLE_R[] = {
+    Vec2( 0.f, 1.5f ), Vec2( 0.f, -1.5f ), Vec2( 1.f, 1.5f ),
+    Vec2( 0.f, 1.5f ), Vec2( 2.f, .5f ), Vec2( 2.f, 1.5f ),
+    Vec2( 0.f, -.5f ), Vec2( 2.f, -.5f ), Vec2( 2.f, .5f ),
+    Vec2( 0.f, .5f ), Vec2( 0.f, -.5f ), Vec2( 2.f, -1.5f ),
+};
+static const Vec2 TITLE_H[] = {
+    Vec2( 0.f, 1.5f ), Vec2( 0.f, -1.5f ), Vec2( 1.f, 1.5f ),
+    Vec2( 1.f, -1.5f ), Vec2( 2.f, -1.5f ), Vec2( 2.f, 1.5f ),
+    Vec2( 0.f, 0.f ), Vec2( 1.f, -.5f ), Vec2( 1.f, .5f ),
+    Vec2( 1.f, .5f ), Vec2( 1.f, -.5f ), Vec2( 2.f, 0.f ),
+};
+static const Vec2 TITLE_I[] = {
+    Vec2( 0.f, 1.5f ), Vec2( 0.f, .5f ), Vec2( 1.f, 1.5f ),
+    Vec2( 1.f, 1.5f ), Vec2( 2.f, .5f ), Vec2( 2.f, 1.5f ),
+    Vec2( .5f, 1.5f ), Vec2( 1.f, -1.5f ), Vec2( 1.5f, 1.5f ),
+    Vec2( .5f, -1.5f ), Vec2( 1.f, 1.5f ), Vec2( 1.5f, -1.5f ),
+    Vec2( 0.f, -.5f ), Vec2( 0.f, -1.5f ), Vec2( 1.f, -1.5f ),
+    Vec2( 1.f, -1.5f ), Vec2( 2.f, -1.5f ), Vec2( 2.f, -.5f ),
+};
+static const Vec2 TITLE_P[] = {
+    Vec2( 0.f, 1.5f ), Vec2( 0.f, -1.5f ), Vec2( 1.f, 1.5f ),
+    Vec2( 0.f, 1.5f ), Vec2( 2.f, .5f ), Vec2( 2.f, 1.5f ),
+    Vec2( 0.f, -.5f ), Vec2( 2.f, -.5f ), Vec2( 2.f, .5f ),
+};
+
+//-----------------------------------------------------------------------------
+VectorFont::VectorFont()
+{
+}
+
+//-----------------------------------------------------------------------------
+VectorFont::~VectorFont()
+{
+}
+
+//-----------------------------------------------------------------------------
+void VectorFont::AddGlyph( char character, const Vec2* trianglePoints, int pointCount )
+{
+    int glyphIndex = static_cast<unsigned char>(character);
+    GUARANTEE_OR_DIE( glyphIndex < VECTOR_FONT_GLYPHS, "VectorFont only supports ASCII glyphs" );
+    GUARANTEE_OR_DIE( pointCount % 3 == 0, "VectorFont glyphs must be made of triangles" );
+
+    // Replaced glyphs leave their old points behind; fonts are built once
+    GlyphRange& glyph = m_Glyphs[ glyphIndex ];
+    glyph.firstPoint = static_cast<int>(m_GlyphPoints.size());
+    glyph.pointCount = pointCount;
+    m_GlyphPoints.insert( m_GlyphPoints.end(), trianglePoints, trianglePoints + pointCount );
+}
+
+//-----------------------------------------------------------------------------
+void VectorFont::AddSegmentGlyphs()
+{
+    AddSegmentGlyph( '0', SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F | SEG_K | SEG_L );
+    AddSegmentGlyph( '1', SEG_B | SEG_C );
+    AddSegmentGlyph( '2', SEG_A | SEG_B | SEG_G | SEG_E | SEG_D );
+    AddSegmentGlyph( '3', SEG_A | SEG_B | SEG_G2 | SEG_C | SEG_D );
+    AddSegmentGlyph( '4', SEG_F | SEG_G | SEG_B | SEG_C );
+    AddSegmentGlyph( '5', SEG_A | SEG_F | SEG_G | SEG_C | SEG_D );
+    AddSegmentGlyph( '6', SEG_A | SEG_F | SEG_G | SEG_E | SEG_C | SEG_D );
+    AddSegmentGlyph( '7', SEG_A | SEG_B | SEG_C );
+    AddSegmentGlyph( '8', SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F | SEG_G );
+    AddSegmentGlyph( '9', SEG_A | SEG_B | SEG_C | SEG_D | SEG_F | SEG_G );
+
+    AddSegmentGlyph( 'A', SEG_A | SEG_B | SEG_C | SEG_E | SEG_F | SEG_G );
+    AddSegmentGlyph( 'B', SEG_A | SEG_B | SEG_C | SEG_D | SEG_H | SEG_I | SEG_G2 );
+    AddSegmentGlyph( 'C', SEG_A | SEG_D | SEG_E | SEG_F );
+    AddSegmentGlyph( 'D', SEG_A | SEG_B | SEG_C | SEG_D | SEG_H | SEG_I );
+    AddSegmentGlyph( 'E', SEG_A | SEG_D | SEG_E | SEG_F | SEG_G1 );
+    AddSegmentGlyph( 'F', SEG_A | SEG_E | SEG_F | SEG_G1 );
+    AddSegmentGlyph( 'G', SEG_A | SEG_C | SEG_D | SEG_E | SEG_F | SEG_G2 );
+    AddSegmentGlyph( 'H', SEG_B | SEG_C | SEG_E | SEG_F | SEG_G );
+    AddSegmentGlyph( 'I', SEG_A | SEG_D | SEG_H | SEG_I );
+    AddSegmentGlyph( 'J', SEG_B | SEG_C | SEG_D | SEG_E );
+    AddSegmentGlyph( 'K', SEG_E | SEG_F | SEG_G1 | SEG_K | SEG_M );
+    AddSegmentGlyph( 'L', SEG_D | SEG_E | SEG_F );
+    AddSegmentGlyph( 'M', SEG_B | SEG_C | SEG_E | SEG_F | SEG_J | SEG_K );
+    AddSegmentGlyph( 'N', SEG_B | SEG_C | SEG_E | SEG_F | SEG_J | SEG_M );
+    AddSegmentGlyph( 'O', SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F );
+    AddSegmentGlyph( 'P', SEG_A | SEG_B | SEG_E | SEG_F | SEG_G );
+    AddSegmentGlyph( 'Q', SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F | SEG_M );
+    AddSegmentGlyph( 'R', SEG_A | SEG_B | SEG_E | SEG_F | SEG_G | SEG_M );
+    AddSegmentGlyph( 'S', SEG_A | SEG_F | SEG_G | SEG_C | SEG_D );
+    AddSegmentGlyph( 'T', SEG_A | SEG_H | SEG_I );
+    AddSegmentGlyph( 'U', SEG_B | SEG_C | SEG_D | SEG_E | SEG_F );
+    AddSegmentGlyph( 'V', SEG_E | SEG_F | SEG_L | SEG_K );
+    AddSegmentGlyph( 'W', SEG_B | SEG_C | SEG_E | SEG_F | SEG_L | SEG_M );
+    AddSegmentGlyph( 'X', SEG_J | SEG_K | SEG_L | SEG_M );
+    AddSegmentGlyph( 'Y', SEG_J | SEG_K | SEG_I );
+    AddSegmentGlyph( 'Z', SEG_A | SEG_K | SEG_L | SEG_D );
+
+    AddSegmentGlyph( ':', SEG_COLON | SEG_PERIOD );
+    AddSegmentGlyph( '.', SEG_PERIOD );
+    AddSegmentGlyph( '-', SEG_G );
+    AddSegmentGlyph( '/', SEG_K | SEG_L );
+}
+
+//-----------------------------------------------------------------------------
+void VectorFont::AddTitleGlyphs()
+{
+    AddGlyph( 'S', TITLE_S, sizeof( TITLE_S ) / sizeof( Vec2 ) );
+    AddGlyph( 'T', TITLE_T, sizeof( TITLE_T ) / sizeof( Vec2 ) );
+    AddGlyph( 'A', TITLE_A, sizeof( TITLE_A ) / sizeof( Vec2 ) );
+    AddGlyph( 'R', TITLE_R, sizeof( TITLE_R ) / sizeof( Vec2 ) );
+    AddGlyph( 'H', TITLE_H, sizeof( TITLE_H ) / sizeof( Vec2 ) );
+    AddGlyph( 'I', TITLE_I, sizeof( TITLE_I ) / sizeof( Vec2 ) );
+    AddGlyph( 'P', TITLE_P, sizeof( TITLE_P ) / sizeof( Vec2 ) );
+}
+
+//-----------------------------------------------------------------------------
+void VectorFont::SetGlyphSpacing( float spacing )
+{
+    m_GlyphSpacing = spacing;
+}
+
+//-----------------------------------------------------------------------------
+float VectorFont::GetTextWidth( const char* text ) const
+{
+    int length = static_cast<int>(strlen( text ));
+    if( length == 0 )
+    {
+        return 0.f;
+    }
+    return length * (VECTOR_GLYPH_WIDTH + m_GlyphSpacing) - m_GlyphSpacing;
+}
+
+//-----------------------------------------------------------------------------
+// Alignment is (0,0) for the bottom left of the text at the origin and
+//  (1,1) for the top right, so (.5,.5) centers the text on the origin
+void VectorFont::AppendVertexesForText( std::vector<VertexMaster>& vertexes,
+                                        const char* text,
+                                        const Vec2& alignment ) const
+{
+    Vec2 cursor = Vec2( -GetTextWidth( text ) * alignment.x,
+                        VECTOR_GLYPH_HEIGHT * (.5f - alignment.y) );
+    float advance = VECTOR_GLYPH_WIDTH + m_GlyphSpacing;
+
+    for( const char* character = text; *character != '\0'; ++character )
+    {
+        int glyphIndex = static_cast<unsigned char>(*character);
+        if( glyphIndex < VECTOR_FONT_GLYPHS )
+        {
+            const GlyphRange& glyph = m_Glyphs[ glyphIndex ];
+            for( int pointIndex = 0; pointIndex < glyph.pointCount; ++pointIndex )
+            {
+                const Vec2& point = m_GlyphPoints[ glyph.firstPoint + pointIndex ];
+                vertexes.emplace_back( cursor + point, Rgba8::WHITE );
+            }
+        }
+        cursor.x += advance;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void VectorFont::AddSegmentGlyph( char character, unsigned int segmentMask )
+{
+    Vec2 trianglePoints[ SEGMENT_COUNT * 6 ];
+    int pointCount = 0;
+    for( int segment = 0; segment < SEGMENT_COUNT; ++segment )
+    {
+        if( (segmentMask & (1u << segment)) == 0 )
+        {
+            continue;
+        }
+
+        const Vec2* quad = SEGMENT_QUADS[ segment ];
+        trianglePoints[ pointCount++ ] = quad[ 0 ];
+        trianglePoints[ pointCount++ ] = quad[ 1 ];
+        trianglePoints[ pointCount++ ] = quad[ 2 ];
+
+        trianglePoints[ pointCount++ ] = quad[ 0 ];
+        trianglePoints[ pointCount++ ] = quad[ 2 ];
+        trianglePoints[ pointCount++ ] = quad[ 3 ];
+    }
+
+    AddGlyph( character, trianglePoints, pointCount );
+}
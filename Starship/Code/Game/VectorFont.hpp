@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Engine/Core/Math/Primatives/Vec2.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/VertexTypes/VertexMaster.hpp"
+
+#include <vector>
+
+constexpr int VECTOR_FONT_GLYPHS = 128;
+constexpr float VECTOR_GLYPH_WIDTH = 2.f;       // Every glyph lives in a 2 x 3 cell
+constexpr float VECTOR_GLYPH_HEIGHT = 3.f;      //  centered vertically on y = 0
+
+//-----------------------------------------------------------------------------
+// Triangle meshes for ASCII glyphs, built once. Glyphs are white so a laid out
+//  string can be colored with the model tint instead of rebuilding it.
+class VectorFont
+{
+public:
+    VectorFont();
+    ~VectorFont();
+
+    void AddGlyph( char character, const Vec2* trianglePoints, int pointCount );
+    void AddSegmentGlyphs();
+    void AddTitleGlyphs();
+
+    void SetGlyphSpacing( float spacing );
+
+    float GetTextWidth( const char* text ) const;
+    void AppendVertexesForText( std::vector<VertexMaster>& vertexes,
+                                const char* text,
+                                const Vec2& alignment ) const;
+
+private:
+    struct GlyphRange
+    {
+        int firstPoint = 0;
+        int pointCount = 0;
+    };
+
+    std::vector<Vec2> m_GlyphPoints;
+    GlyphRange m_Glyphs[ VECTOR_FONT_GLYPHS ];
+    float m_GlyphSpacing = .5f;
+
+    void AddSegmentGlyph( char character, unsigned int segmentMask );
+};
@@ -0,0 +1,112 @@
+#include "VectorText.hpp"
+
+#include "Engine/Core/Math/Transform.hpp"
+#include "Engine/Renderer/RenderContext.hpp"
+
+#include "Game/GameCommon.hpp"
+#include "Game/VectorFont.hpp"
+
+#include <cstdarg>
+#include <cstdio>
+
+constexpr int VECTOR_TEXT_MAX_FORMATTED_LENGTH = 256;
+
+//-----------------------------------------------------------------------------
+VectorText::VectorText()
+{
+}
+
+//-----------------------------------------------------------------------------
+VectorText::VectorText( const VectorFont* font, const Vec2& alignment )
+    : m_Font( font )
+    , m_Alignment( alignment )
+{
+}
+
+//-----------------------------------------------------------------------------
+VectorText::~VectorText()
+{
+}
+
+//-----------------------------------------------------------------------------
+void VectorText::SetFont( const VectorFont* font )
+{
+    if( m_Font != font )
+    {
+        m_Font = font;
+        Rebuild();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void VectorText::SetAlignment( const Vec2& alignment )
+{
+    if( m_Alignment != alignment )
+    {
+        m_Alignment = alignment;
+        Rebuild();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void VectorText::SetText( const char* text )
+{
+    // Counters are set every frame but usually read the same, so only pay for
+    //  the layout when the string actually differs
+    if( m_Text == text )
+    {
+        return;
+    }
+
+    m_Text = text;
+    Rebuild();
+}
+
+//-----------------------------------------------------------------------------
+void VectorText::SetTextf( const char* format, ... )
+{
+    char buffer[ VECTOR_TEXT_MAX_FORMATTED_LENGTH ];
+
+    va_list arguments;
+    va_start( arguments, format );
+    vsnprintf( buffer, VECTOR_TEXT_MAX_FORMATTED_LENGTH, format, arguments );
+    va_end( arguments );
+
+    SetText( buffer );
+}
+
+//-----------------------------------------------------------------------------
+void VectorText::Render( RenderContext& renderer,
+                         const Vec2& position,
+                         float rotationDegrees,
+                         float scale,
+                         const Rgba8& tint ) const
+{
+    if( m_Vertexes.empty() )
+    {
+        return;
+    }
+
+    Transform transform;
+    transform.position = Vec3( position.x, position.y, 0.f );
+    transform.rotationAroundAxis.z = rotationDegrees;
+    transform.scale = Vec3( scale, scale, 1.f );
+
+    renderer.SetModelUBO( transform.GetAsMatrix(), tint );
+    renderer.DrawVertexArray( m_Vertexes );
+    renderer.SetModelUBO();
+}
+
+//-----------------------------------------------------------------------------
+void VectorText::Rebuild()
+{
+    // clear() keeps capacity, so a counter that changes every frame settles
+    //  into reusing the same storage
+    m_Vertexes.clear();
+    if( m_Font == nullptr )
+    {
+        return;
+    }
+
+    m_Font->AppendVertexesForText( m_Vertexes, m_Text.c_str(), m_Alignment );
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Engine/Core/Math/Primatives/Vec2.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/VertexTypes/VertexMaster.hpp"
+
+#include <string>
+#include <vector>
+
+class RenderContext;
+class VectorFont;
+
+//-----------------------------------------------------------------------------
+// A laid out string that keeps its vertexes until the text changes. Position,
+//  rotation, scale and color are applied at draw time through the model
+//  constants so animating them never touches the mesh.
+class VectorText
+{
+public:
+    VectorText();
+    VectorText( const VectorFont* font, const Vec2& alignment );
+    ~VectorText();
+
+    void SetFont( const VectorFont* font );
+    void SetAlignment( const Vec2& alignment );
+    void SetText( const char* text );
+    void SetTextf( const char* format, ... );
+
+    const std::string& GetText() const { return m_Text; }
+    int GetVertexCount() const { return static_cast<int>(m_Vertexes.size()); }
+
+    void Render( RenderContext& renderer,
+                 const Vec2& position,
+                 float rotationDegrees,
+                 float scale,
+                 const Rgba8& tint ) const;
+
+private:
+    const VectorFont* m_Font = nullptr;
+    Vec2 m_Alignment = Vec2( 0.f, 0.f );
+    std::string m_Text;
+    std::vector<VertexMaster> m_Vertexes;
+
+    void Rebuild();
+};
@@ -0,0 +1,391 @@
+#include "WorldSectors.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Math/RandomNumberGenerator.hpp"
+
+#include <cmath>
+
+//-----------------------------------------------------------------------------
+void PackSectorEntity( const EntityState& state,
+                       const EntityShapeState* shape,
+                       float gameTime,
+                       SectorEntity& outRecord )
+{
+    outRecord = SectorEntity();
+    outRecord.position = Vec2( state.position.x, state.position.y );
+    outRecord.velocity = Vec2( state.velocity.x, state.velocity.y );
+    outRecord.angleDegrees = state.angleDegrees;
+    outRecord.angularVelocity = state.angularVelocity;
+    outRecord.steppedTime = gameTime;
+    outRecord.kind = state.kind;
+    outRecord.health = static_cast<unsigned char>(state.health < 0 ? 0 : (state.health > 255 ? 255 : state.health));
+    outRecord.flags = state.isSectorField ? SECTOR_ENTITY_FLAG_FIELD : 0;
+
+    if( shape == nullptr || state.cosmeticRadius <= 0.f )
+    {
+        return;
+    }
+
+    outRecord.cornerCount = static_cast<unsigned char>(shape->cornerCount);
+    for( int cornerIndex = 0; cornerIndex < shape->cornerCount; ++cornerIndex )
+    {
+        float lengthFraction = shape->corners[ cornerIndex ].GetLength() / state.cosmeticRadius;
+        lengthFraction = lengthFraction < 0.f ? 0.f : (lengthFraction > 1.f ? 1.f : lengthFraction);
+        outRecord.cornerLengths[ cornerIndex ] = static_cast<unsigned char>(lengthFraction * 255.f + .5f);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void UnpackSectorEntity( const SectorEntity& record,
+                         EntityState& inOutState,
+                         EntityShapeState& outShape )
+{
+    inOutState.position = Vec3( record.position.x, record.position.y, 0.f );
+    inOutState.velocity = Vec3( record.velocity.x, record.velocity.y, 0.f );
+    inOutState.angleDegrees = record.angleDegrees;
+    inOutState.angularVelocity = record.angularVelocity;
+    inOutState.health = record.health;
+    inOutState.kind = record.kind;
+    inOutState.isSectorField = (record.flags & SECTOR_ENTITY_FLAG_FIELD) != 0;
+
+    outShape.cornerCount = record.cornerCount;
+    for( int cornerIndex = 0; cornerIndex < record.cornerCount; ++cornerIndex )
+    {
+        float degrees = 360.f * static_cast<float>(cornerIndex) / static_cast<float>(record.cornerCount);
+        float length = static_cast<float>(record.cornerLengths[ cornerIndex ]) / 255.f * inOutState.cosmeticRadius;
+        outShape.corners[ cornerIndex ] = Vec2::MakeFromPolarDegrees( degrees, length );
+    }
+}
+
+//-----------------------------------------------------------------------------
+WorldSectors::WorldSectors()
+{
+}
+
+//-----------------------------------------------------------------------------
+WorldSectors::~WorldSectors()
+{
+}
+
+//-----------------------------------------------------------------------------
+void WorldSectors::Startup( int sectorsPerSide )
+{
+    GUARANTEE_OR_DIE( sectorsPerSide > 0 && sectorsPerSide <= MAX_WORLD_SECTORS_PER_SIDE, "World sector count out of range" );
+
+    m_SectorCountX = sectorsPerSide;
+    m_SectorCountY = sectorsPerSide;
+    m_WorldSize = Vec2( SCREEN_SIZE_X * static_cast<float>(m_SectorCountX),
+                        SCREEN_SIZE_Y * static_cast<float>(m_SectorCountY) );
+
+    m_Sectors.clear();
+    m_Sectors.resize( GetSectorCount() );
+    m_Activity.assign( GetSectorCount(), SECTOR_ACTIVITY_PARKED );
+    m_ActiveSectors.clear();
+    m_MarkedSectors.clear();
+    m_KeptSectorCount = 0;
+    m_TotalParkedCount = 0;
+    m_ParkedWaveCount = 0;
+    m_MaxParkedSpeed = 0.f;
+    m_NextSteppedSector = 0;
+    m_LastSweepTime = 0.f;
+    m_SweepSteps = 0.f;
+}
+
+//-----------------------------------------------------------------------------
+void WorldSectors::Shutdown()
+{
+    m_Sectors.clear();
+    m_Sectors.shrink_to_fit();
+    m_Activity.clear();
+    m_Activity.shrink_to_fit();
+    m_ActiveSectors.clear();
+    m_MarkedSectors.clear();
+    m_KeptSectorCount = 0;
+    m_TotalParkedCount = 0;
+    m_ParkedWaveCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+void WorldSectors::Clear()
+{
+    for( std::vector<SectorEntity>& records : m_Sectors )
+    {
+        records.clear();
+    }
+    m_TotalParkedCount = 0;
+    m_ParkedWaveCount = 0;
+    m_MaxParkedSpeed = 0.f;
+    m_NextSteppedSector = 0;
+    m_LastSweepTime = 0.f;
+    m_SweepSteps = 0.f;
+}
+
+//-----------------------------------------------------------------------------
+int WorldSectors::GetSectorIndexAt( const Vec2& position ) const
+{
+    int sectorX = static_cast<int>(floorf( position.x / SCREEN_SIZE_X ));
+    int sectorY = static_cast<int>(floorf( position.y / SCREEN_SIZE_Y ));
+    sectorX = sectorX < 0 ? 0 : (sectorX >= m_SectorCountX ? m_SectorCountX - 1 : sectorX);
+    sectorY = sectorY < 0 ? 0 : (sectorY >= m_SectorCountY ? m_SectorCountY - 1 : sectorY);
+    return sectorY * m_SectorCountX + sectorX;
+}
+
+//-----------------------------------------------------------------------------
+// The outlines are rolled the way Asteroid::Create rolls them
+void WorldSectors::Populate( RandomNumberGenerator& rng,
+                             int asteroidsPerSector,
+                             const EntityState& asteroidDefaults,
+                             const Vec2& clearAround,
+                             float gameTime )
+{
+    const int clearSector = GetSectorIndexAt( clearAround );
+    const int clearX = clearSector % m_SectorCountX;
+    const int clearY = clearSector / m_SectorCountX;
+
+    EntityState state = asteroidDefaults;
+    state.kind = ENTITY_KIND_ASTEROID;
+    state.isSectorField = true;
+    EntityShapeState shape;
+    shape.cornerCount = ASTEROID_TRIANGLES;
+    for( int sectorY = 0; sectorY < m_SectorCountY; ++sectorY )
+    {
+        for( int sectorX = 0; sectorX < m_SectorCountX; ++sectorX )
+        {
+            if( abs( sectorX - clearX ) <= SECTOR_KEEP_RADIUS && abs( sectorY - clearY ) <= SECTOR_KEEP_RADIUS )
+            {
+                continue;
+            }
+
+            std::vector<SectorEntity>& records = m_Sectors[ sectorY * m_SectorCountX + sectorX ];
+            records.reserve( records.size() + asteroidsPerSector );
+            for( int asteroidIndex = 0; asteroidIndex < asteroidsPerSector; ++asteroidIndex )
+            {
+                state.position = Vec3( SCREEN_SIZE_X * (static_cast<float>(sectorX) + rng.FloatZeroToOne()),
+                                       SCREEN_SIZE_Y * (static_cast<float>(sectorY) + rng.FloatZeroToOne()),
+                                       0.f );
+                state.velocity = Vec3::MakeFromPolarDegreesXY( rng.FloatLessThan( 360.f ), ASTEROID_SPEED );
+                state.angleDegrees = rng.FloatLessThan( 360.f );
+                state.angularVelocity = rng.FloatInRange( -ASTEROID_MAX_ROTATION, ASTEROID_MAX_ROTATION );
+                for( int cornerIndex = 0; cornerIndex < ASTEROID_TRIANGLES; ++cornerIndex )
+                {
+                    float degrees = 360.f * static_cast<float>(cornerIndex) / static_cast<float>(ASTEROID_TRIANGLES);
+                    shape.corners[ cornerIndex ] = Vec2::MakeFromPolarDegrees( degrees,
+                                                                               rng.FloatInRange( state.physicsRadius, state.cosmeticRadius ) );
+                }
+
+                SectorEntity record;
+                PackSectorEntity( state, &shape, gameTime, record );
+                records.push_back( record );
+                NoteParkedSpeed( record );
+                m_TotalParkedCount++;
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void WorldSectors::UpdateActivity( const Vec2* anchors, int anchorCount, bool asteroidsWrap )
+{
+    for( int sectorIndex : m_MarkedSectors )
+    {
+        m_Activity[ sectorIndex ] = SECTOR_ACTIVITY_PARKED;
+    }
+    m_MarkedSectors.clear();
+    m_ActiveSectors.clear();
+    m_KeptSectorCount = 0;
+
+    for( int anchorIndex = 0; anchorIndex < anchorCount; ++anchorIndex )
+    {
+        int sectorIndex = GetSectorIndexAt( anchors[ anchorIndex ] );
+        int sectorX = sectorIndex % m_SectorCountX;
+        int sectorY = sectorIndex / m_SectorCountX;
+        MarkAround( sectorX, sectorY, SECTOR_STEP_RADIUS, SECTOR_ACTIVITY_STEPPED, asteroidsWrap );
+        MarkAround( sectorX, sectorY, SECTOR_KEEP_RADIUS, SECTOR_ACTIVITY_KEPT, false );
+        MarkAround( sectorX, sectorY, SECTOR_ACTIVE_RADIUS, SECTOR_ACTIVITY_ACTIVE, false );
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool WorldSectors::IsKeptAt( const Vec2& position ) const
+{
+    return m_Activity[ GetSectorIndexAt( position ) ] >= SECTOR_ACTIVITY_KEPT;
+}
+
+//-----------------------------------------------------------------------------
+void WorldSectors::Park( const SectorEntity& record )
+{
+    m_Sectors[ GetSectorIndexAt( record.position ) ].push_back( record );
+    NoteParkedSpeed( record );
+    m_TotalParkedCount++;
+    m_ParkedWaveCount += (record.flags & SECTOR_ENTITY_FLAG_FIELD) != 0 ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+// The sweep is paced by game time rather than ticks, so a slow or uneven
+//  tick rate still visits every sector within SECTOR_SWEEP_DRIFT of drift.
+//  Marked sectors met by the sweep were stepped already and are passed over.
+void WorldSectors::StepParked( float gameTime, bool asteroidsWrap )
+{
+    for( int sectorIndex : m_MarkedSectors )
+    {
+        StepSector( sectorIndex, gameTime, asteroidsWrap );
+    }
+
+    const int sectorCount = GetSectorCount();
+    float elapsedSeconds = gameTime - m_LastSweepTime;
+    m_LastSweepTime = gameTime;
+    if( elapsedSeconds > 0.f && m_MaxParkedSpeed > 0.f )
+    {
+        float sweepSeconds = SECTOR_SWEEP_DRIFT / m_MaxParkedSpeed;
+        m_SweepSteps += static_cast<float>(sectorCount) * elapsedSeconds / sweepSeconds;
+    }
+
+    int steppedCount = static_cast<int>(m_SweepSteps);
+    steppedCount = steppedCount > SECTOR_MIN_SWEEP_STEPS ? steppedCount : SECTOR_MIN_SWEEP_STEPS;
+    steppedCount = steppedCount < sectorCount ? steppedCount : sectorCount;
+    m_SweepSteps -= static_cast<float>(steppedCount);
+    m_SweepSteps = m_SweepSteps > 0.f ? m_SweepSteps : 0.f;
+    for( int stepIndex = 0; stepIndex < steppedCount; ++stepIndex )
+    {
+        if( m_Activity[ m_NextSteppedSector ] == SECTOR_ACTIVITY_PARKED )
+        {
+            StepSector( m_NextSteppedSector, gameTime, asteroidsWrap );
+        }
+        m_NextSteppedSector = m_NextSteppedSector + 1 < sectorCount ? m_NextSteppedSector + 1 : 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void WorldSectors::RemoveParked( int sectorIndex, int recordIndex )
+{
+    std::vector<SectorEntity>& records = m_Sectors[ sectorIndex ];
+    m_ParkedWaveCount -= (records[ recordIndex ].flags & SECTOR_ENTITY_FLAG_FIELD) != 0 ? 0 : 1;
+    records[ recordIndex ] = records.back();
+    records.pop_back();
+    m_TotalParkedCount--;
+}
+
+//-----------------------------------------------------------------------------
+size_t WorldSectors::GetParkedBytes() const
+{
+    size_t parkedBytes = m_Sectors.capacity() * sizeof( std::vector<SectorEntity> );
+    for( const std::vector<SectorEntity>& records : m_Sectors )
+    {
+        parkedBytes += records.capacity() * sizeof( SectorEntity );
+    }
+    return parkedBytes;
+}
+
+//-----------------------------------------------------------------------------
+// Stepped is the outermost ring, then kept, then active; a sector already
+//  marked higher by another anchor stays that way. A wrapping mark never
+//  visits a sector twice, even on a world narrower than the ring.
+void WorldSectors::MarkAround( int sectorX, int sectorY, int radius, SectorActivity activity, bool wraps )
+{
+    const int spanX = 2 * radius + 1 < m_SectorCountX ? 2 * radius + 1 : m_SectorCountX;
+    const int spanY = 2 * radius + 1 < m_SectorCountY ? 2 * radius + 1 : m_SectorCountY;
+    const int firstX = wraps ? sectorX - spanX / 2 : sectorX - radius;
+    const int firstY = wraps ? sectorY - spanY / 2 : sectorY - radius;
+    const int lastX = wraps ? firstX + spanX - 1 : sectorX + radius;
+    const int lastY = wraps ? firstY + spanY - 1 : sectorY + radius;
+    for( int markY = firstY; markY <= lastY; ++markY )
+    {
+        for( int markX = firstX; markX <= lastX; ++markX )
+        {
+            int wrappedX = markX;
+            int wrappedY = markY;
+            if( wraps )
+            {
+                wrappedX = (markX + m_SectorCountX) % m_SectorCountX;
+                wrappedY = (markY + m_SectorCountY) % m_SectorCountY;
+            }
+            if( wrappedX < 0 || wrappedX >= m_SectorCountX || wrappedY < 0 || wrappedY >= m_SectorCountY )
+            {
+                continue;
+            }
+
+            int sectorIndex = wrappedY * m_SectorCountX + wrappedX;
+            SectorActivity& sectorActivity = m_Activity[ sectorIndex ];
+            if( sectorActivity >= activity )
+            {
+                continue;
+            }
+
+            if( sectorActivity == SECTOR_ACTIVITY_PARKED )
+            {
+                m_MarkedSectors.push_back( sectorIndex );
+            }
+            if( activity >= SECTOR_ACTIVITY_KEPT && sectorActivity < SECTOR_ACTIVITY_KEPT )
+            {
+                m_KeptSectorCount++;
+            }
+            if( activity == SECTOR_ACTIVITY_ACTIVE )
+            {
+                m_ActiveSectors.push_back( sectorIndex );
+            }
+            sectorActivity = activity;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Only asteroids drift, so only they set how fast the sweep has to go
+void WorldSectors::NoteParkedSpeed( const SectorEntity& record )
+{
+    if( record.kind != ENTITY_KIND_ASTEROID )
+    {
+        return;
+    }
+
+    float speed = record.velocity.GetLength();
+    m_MaxParkedSpeed = speed > m_MaxParkedSpeed ? speed : m_MaxParkedSpeed;
+}
+
+//-----------------------------------------------------------------------------
+// A record refiled into a sector later in the same pass is stepped again by
+//  zero seconds, so it never moves twice
+void WorldSectors::StepSector( int sectorIndex, float gameTime, bool asteroidsWrap )
+{
+    std::vector<SectorEntity>& records = m_Sectors[ sectorIndex ];
+    for( size_t recordIndex = 0; recordIndex < records.size(); )
+    {
+        SectorEntity& record = records[ recordIndex ];
+        float elapsedSeconds = gameTime - record.steppedTime;
+        record.steppedTime = gameTime;
+        if( record.kind != ENTITY_KIND_ASTEROID || elapsedSeconds <= 0.f )
+        {
+            recordIndex++;
+            continue;
+        }
+
+        record.position.x += record.velocity.x * elapsedSeconds;
+        record.position.y += record.velocity.y * elapsedSeconds;
+        record.angleDegrees = fmodf( record.angleDegrees + record.angularVelocity * elapsedSeconds, 360.f );
+
+        bool isOffWorld = record.position.x < 0.f || record.position.x >= m_WorldSize.x ||
+                          record.position.y < 0.f || record.position.y >= m_WorldSize.y;
+        if( isOffWorld && !asteroidsWrap )
+        {
+            RemoveParked( sectorIndex, static_cast<int>(recordIndex) );
+            continue;
+        }
+        if( isOffWorld )
+        {
+            record.position.x = fmodf( record.position.x, m_WorldSize.x );
+            record.position.y = fmodf( record.position.y, m_WorldSize.y );
+            record.position.x += record.position.x < 0.f ? m_WorldSize.x : 0.f;
+            record.position.y += record.position.y < 0.f ? m_WorldSize.y : 0.f;
+        }
+
+        int steppedSectorIndex = GetSectorIndexAt( record.position );
+        if( steppedSectorIndex == sectorIndex )
+        {
+            recordIndex++;
+            continue;
+        }
+
+        m_Sectors[ steppedSectorIndex ].push_back( record );
+        records[ recordIndex ] = records.back();
+        records.pop_back();
+    }
+}
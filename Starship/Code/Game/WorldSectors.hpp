@@ -0,0 +1,150 @@
+#pragma once
+
+#include "Engine/Core/Math/Primatives/Vec2.hpp"
+
+#include "Game/GameCommon.hpp"
+#include "Game/WorldState.hpp"
+
+#include <cstddef>
+#include <vector>
+
+class RandomNumberGenerator;
+
+//-----------------------------------------------------------------------------
+// The world as a grid of screen sized sectors. Entities only stay live in
+//  the sectors around the players; further out, asteroids, beetles and wasps
+//  are parked here as a SectorEntity, 48 bytes where a live asteroid is an
+//  Entity plus its outline, and cost nothing per tick until they come back.
+//
+//  Sectors within SECTOR_ACTIVE_RADIUS of an anchor (a live ship, or the
+//  camera) are active, and whatever is parked in them is restored. Sectors
+//  within SECTOR_KEEP_RADIUS are kept: what is live in them stays live, so
+//  something drifting along the edge of the active block is not parked and
+//  restored every other tick. Everything else is parked.
+//
+//  Parked asteroids keep drifting in closed form, by velocity over the time
+//  since they were last stepped, and are refiled under whichever sector they
+//  drift into. Every sector within SECTOR_STEP_RADIUS of an anchor is stepped
+//  each tick (across the world edge too when asteroids wrap). The rest are
+//  swept round robin, as many per tick as it takes to visit each one before
+//  the fastest parked asteroid can drift half a sector, so a record is never
+//  filed more than one sector from where it really is. One that has drifted
+//  into the kept ring is therefore still filed inside the stepped band, and
+//  is refiled the tick it arrives rather than whenever the sweep comes back
+//  around. The sweep costs more per tick the bigger the world. Beetles and
+//  wasps wait where they were parked; what they chase is far away.
+//
+//  A 1x1 world never parks anything and plays exactly as before sectors.
+constexpr int SECTOR_ACTIVE_RADIUS = 1;                 // 3x3 around each anchor restores
+constexpr int SECTOR_KEEP_RADIUS = 2;                   // 5x5 keeps what is already live
+constexpr int SECTOR_STEP_RADIUS = SECTOR_KEEP_RADIUS + 1; // 7x7 stepped every tick
+constexpr int SECTOR_MIN_SWEEP_STEPS = 64;              // Sectors swept per tick at the least
+constexpr float SECTOR_SWEEP_DRIFT = .5f * SCREEN_SIZE_Y;   // Most a record may drift between sweeps
+constexpr int SECTOR_FIELD_ASTEROIDS = 4;               // Scattered over each sector of a streamed world
+constexpr int MAX_WORLD_SECTORS_PER_SIDE = 1024;
+constexpr int MAX_SECTOR_ANCHORS = MAX_PLAYERS + 1;     // Every ship and the camera
+
+enum SectorEntityFlag: unsigned char
+{
+    SECTOR_ENTITY_FLAG_FIELD = 1 << 0,      // Scattered by Populate; never part of a wave
+};
+
+struct SectorEntity
+{
+    Vec2 position;
+    Vec2 velocity;
+    float angleDegrees = 0.f;
+    float angularVelocity = 0.f;
+    float steppedTime = 0.f;                // World clock the position is current at
+    EntityKind kind = ENTITY_KIND_NONE;
+    unsigned char health = 0;
+    unsigned char cornerCount = 0;
+    unsigned char flags = 0;                // SectorEntityFlag
+    unsigned char cornerLengths[ MAX_ENTITY_SHAPE_CORNERS ] = {};     // In 255ths of the cosmetic radius
+};
+static_assert( sizeof( SectorEntity ) == 48, "SectorEntity is meant to stay compact" );
+
+//-----------------------------------------------------------------------------
+// Outlines are stored as one length per corner; the corners sit at even
+//  angles, as Asteroid::Create lays them out. Unpacking only writes what a
+//  record carries, so start from the kind's default state.
+void PackSectorEntity( const EntityState& state,
+                       const EntityShapeState* shape,
+                       float gameTime,
+                       SectorEntity& outRecord );
+void UnpackSectorEntity( const SectorEntity& record,
+                         EntityState& inOutState,
+                         EntityShapeState& outShape );
+
+//-----------------------------------------------------------------------------
+class WorldSectors
+{
+public:
+    WorldSectors();
+    ~WorldSectors();
+
+    void Startup( int sectorsPerSide );
+    void Shutdown();
+    void Clear();                           // Drops every parked record
+
+    bool IsStreaming() const { return m_SectorCountX * m_SectorCountY > 1; }
+    const Vec2& GetWorldSize() const { return m_WorldSize; }
+    int GetSectorCount() const { return m_SectorCountX * m_SectorCountY; }
+    int GetSectorIndexAt( const Vec2& position ) const;     // Clamped into the grid
+
+    // Parks asteroidsPerSector random asteroids in every sector not within
+    //  SECTOR_KEEP_RADIUS of clearAround
+    void Populate( RandomNumberGenerator& rng,
+                   int asteroidsPerSector,
+                   const EntityState& asteroidDefaults,
+                   const Vec2& clearAround,
+                   float gameTime );
+
+    // The stepped band wraps around the world edges when asteroidsWrap
+    void UpdateActivity( const Vec2* anchors, int anchorCount, bool asteroidsWrap );
+    bool IsKeptAt( const Vec2& position ) const;
+    const std::vector<int>& GetActiveSectors() const { return m_ActiveSectors; }
+    int GetKeptSectorCount() const { return m_KeptSectorCount; }
+
+    void Park( const SectorEntity& record );
+
+    // Brings the stepped band and the next sectors of the sweep up to
+    //  gameTime. Asteroids that drift off the world wrap, or are dropped.
+    void StepParked( float gameTime, bool asteroidsWrap );
+
+    int GetParkedCount( int sectorIndex ) const { return static_cast<int>(m_Sectors[ sectorIndex ].size()); }
+    const SectorEntity& GetParked( int sectorIndex, int recordIndex ) const { return m_Sectors[ sectorIndex ][ recordIndex ]; }
+    void RemoveParked( int sectorIndex, int recordIndex );     // Moves the last record into its place
+
+    int GetTotalParkedCount() const { return m_TotalParkedCount; }
+    int GetParkedWaveCount() const { return m_ParkedWaveCount; }       // Everything parked but the field
+    size_t GetParkedBytes() const;
+
+private:
+    enum SectorActivity: unsigned char
+    {
+        SECTOR_ACTIVITY_PARKED = 0,
+        SECTOR_ACTIVITY_STEPPED,
+        SECTOR_ACTIVITY_KEPT,
+        SECTOR_ACTIVITY_ACTIVE,
+    };
+
+    Vec2 m_WorldSize = Vec2( SCREEN_SIZE_X, SCREEN_SIZE_Y );
+    int m_SectorCountX = 1;
+    int m_SectorCountY = 1;
+    std::vector<std::vector<SectorEntity>> m_Sectors;
+    std::vector<SectorActivity> m_Activity;
+    std::vector<int> m_ActiveSectors;
+    std::vector<int> m_MarkedSectors;       // Every marked sector, so the next update clears only these
+    int m_KeptSectorCount = 0;
+    int m_TotalParkedCount = 0;
+    int m_ParkedWaveCount = 0;
+    float m_MaxParkedSpeed = 0.f;           // Fastest asteroid parked since the last Clear
+    int m_NextSteppedSector = 0;
+    float m_LastSweepTime = 0.f;
+    float m_SweepSteps = 0.f;               // Owed to the sweep, carried between ticks
+
+    void MarkAround( int sectorX, int sectorY, int radius, SectorActivity activity, bool wraps );
+    void NoteParkedSpeed( const SectorEntity& record );
+    void StepSector( int sectorIndex, float gameTime, bool asteroidsWrap );
+};
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "Engine/Core/Math/Primatives/Vec2.hpp"
+#include "Engine/Core/Math/Primatives/Vec3.hpp"
+#include "Engine/Core/Math/RandomNumberGenerator.hpp"
+#include "Engine/Core/Rgba8.hpp"
+
+#include "Game/GameCommon.hpp"
+
+#include <type_traits>
+
+//-----------------------------------------------------------------------------
+// Flat, pointer free copy of everything needed to put a Game back exactly as
+//  it was. Every array slot is always present (empty slots are zeroed) so two
+//  captures line up byte for byte and delta well against each other.
+enum EntityKind: unsigned char
+{
+    ENTITY_KIND_NONE = 0,
+    ENTITY_KIND_PLAYER_SHIP,
+    ENTITY_KIND_ASTEROID,
+    ENTITY_KIND_BULLET,
+    ENTITY_KIND_DEBRIS,
+    ENTITY_KIND_BEETLE,
+    ENTITY_KIND_WASP,
+
+    ENTITY_KIND_COUNT
+};
+
+//-----------------------------------------------------------------------------
+struct EntityState
+{
+    Vec3 position;
+    Vec3 velocity;
+    Vec3 acceleration;
+
+    float uniformScale;
+    float angleDegrees;
+    float angularVelocity;
+    float angularAcceleration;
+    float physicsRadius;
+    float cosmeticRadius;
+
+    float age;
+    float lengthHitTime;
+    float lastHitTime;
+    float lifeSpan;                 // Debris only
+
+    int expiryTick;                 // Tick of the game's expiry clock it is retired on, 0 for never
+    int health;
+    Rgba8 color;
+    Rgba8 secondaryColor;           // Debris only, the fading debris color
+
+    EntityKind kind;
+    bool isDead;
+    bool isGarbage;
+    bool isThrusting;
+    bool isSectorField;             // Asteroids only, scattered by WorldSectors rather than sent in a wave
+};
+
+//-----------------------------------------------------------------------------
+// Random outline of asteroids and debris, kept apart from EntityState so the
+//  20000 bullet slots do not carry corners they never use
+struct EntityShapeState
+{
+    Vec2 corners[ MAX_ENTITY_SHAPE_CORNERS ];
+    int cornerCount;
+};
+
+//-----------------------------------------------------------------------------
+// Only ever drawn, but kept with the world so a rolled back tick doesn't light
+//  an explosion twice and a mirror game has lights to bin
+struct ExplosionLightState
+{
+    Vec2 position;
+    Rgba8 color;
+    float radius;
+    float intensity;
+    float ageSeconds;
+};
+
+//-----------------------------------------------------------------------------
+struct WorldStateHeader
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned int stateBytes;
+
+    double playerShipDestroyedTime;
+    double expiryClockSeconds;
+    float gameTime;
+    float currentScreenShakePercentage;
+    float titleTime;
+    float lastColorChangeTime;
+    Rgba8 titleColor;               // Colors the explosion when attract mode ends
+
+    int playerShipCurrentLife;
+    int waveNumber;
+    int explosionLightCount;
+
+    bool spawnNextWave;
+    bool isAttractMode;
+    bool wasJustAttractMode;
+
+    unsigned char rng[ sizeof( RandomNumberGenerator ) ];
+};
+
+//-----------------------------------------------------------------------------
+struct WorldState
+{
+    WorldStateHeader header;
+
+    EntityState playerShips[ MAX_PLAYERS ];
+    EntityState asteroids[ MAX_ASTEROIDS ];
+    EntityState bullets[ MAX_BULLETS ];
+    EntityState debris[ MAX_DEBRIS ];
+    EntityState beetles[ MAX_BEETLES ];
+    EntityState wasps[ MAX_WASPS ];
+
+    EntityShapeState asteroidShapes[ MAX_ASTEROIDS ];
+    EntityShapeState debrisShapes[ MAX_DEBRIS ];
+
+    ExplosionLightState explosionLights[ MAX_EXPLOSION_LIGHTS ];
+};
+
+constexpr unsigned int WORLD_STATE_MAGIC = 0x50485353;     // "SSHP"
+constexpr unsigned int WORLD_STATE_VERSION = 6;
+
+static_assert( std::is_trivially_copyable<RandomNumberGenerator>::value,
+               "RandomNumberGenerator is captured by copying its bytes" );
+static_assert( std::is_trivially_copyable<WorldState>::value,
+               "WorldState must stay a flat block of bytes" );
+static_assert( sizeof( WorldState ) % sizeof( unsigned int ) == 0,
+               "Snapshot deltas work on whole 32 bit words" );
@@ -0,0 +1,114 @@
+#define WIN32_LEAN_AND_MEAN		// Always #define this before #including <windows.h>
+#include <windows.h>
+
+#include "WorldStateFile.hpp"
+
+#include "Game/WorldState.hpp"
+
+//-----------------------------------------------------------------------------
+bool WriteWorldStateFile( const char* filePath, const WorldState& state )
+{
+    HANDLE file = CreateFileA( filePath,
+                               GENERIC_WRITE,
+                               0,
+                               nullptr,
+                               CREATE_ALWAYS,
+                               FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                               nullptr );
+    if( file == INVALID_HANDLE_VALUE )
+    {
+        return false;
+    }
+
+    DWORD bytesWritten = 0;
+    BOOL wasWritten = WriteFile( file, &state, sizeof( WorldState ), &bytesWritten, nullptr );
+    CloseHandle( file );
+
+    return wasWritten && bytesWritten == sizeof( WorldState );
+}
+
+//-----------------------------------------------------------------------------
+MappedWorldStateFile::MappedWorldStateFile()
+{
+}
+
+//-----------------------------------------------------------------------------
+MappedWorldStateFile::~MappedWorldStateFile()
+{
+    Close();
+}
+
+//-----------------------------------------------------------------------------
+bool MappedWorldStateFile::Open( const char* filePath )
+{
+    Close();
+
+    HANDLE file = CreateFileA( filePath,
+                               GENERIC_READ,
+                               FILE_SHARE_READ,
+                               nullptr,
+                               OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                               nullptr );
+    if( file == INVALID_HANDLE_VALUE )
+    {
+        return false;
+    }
+    m_FileHandle = file;
+
+    // Size is checked before mapping so a truncated file never gets read past
+    LARGE_INTEGER fileSize;
+    if( !GetFileSizeEx( file, &fileSize ) ||
+        fileSize.QuadPart != static_cast<LONGLONG>(sizeof( WorldState )) )
+    {
+        Close();
+        return false;
+    }
+
+    m_MappingHandle = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if( m_MappingHandle == nullptr )
+    {
+        Close();
+        return false;
+    }
+
+    m_State = static_cast<const WorldState*>(MapViewOfFile( m_MappingHandle, FILE_MAP_READ, 0, 0, 0 ));
+    if( m_State == nullptr )
+    {
+        Close();
+        return false;
+    }
+
+    const WorldStateHeader& header = m_State->header;
+    if( header.magic != WORLD_STATE_MAGIC ||
+        header.version != WORLD_STATE_VERSION ||
+        header.stateBytes != sizeof( WorldState ) )
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void MappedWorldStateFile::Close()
+{
+    if( m_State != nullptr )
+    {
+        UnmapViewOfFile( m_State );
+        m_State = nullptr;
+    }
+
+    if( m_MappingHandle != nullptr )
+    {
+        CloseHandle( m_MappingHandle );
+        m_MappingHandle = nullptr;
+    }
+
+    if( m_FileHandle != nullptr )
+    {
+        CloseHandle( m_FileHandle );
+        m_FileHandle = nullptr;
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+struct WorldState;
+
+//-----------------------------------------------------------------------------
+// A world file is a WorldState written out verbatim: header first, then one
+//  POD array per entity kind. Saving is a single sequential write and loading
+//  maps the file and reads those arrays in place, so there is no per entity
+//  parsing and a 20000 bullet world opens as fast as the disk can page it in.
+//
+//  Files are only valid for the build that wrote them; the header's magic,
+//  version and state size are all checked before the mapping is handed out.
+bool WriteWorldStateFile( const char* filePath, const WorldState& state );
+
+//-----------------------------------------------------------------------------
+class MappedWorldStateFile
+{
+public:
+    MappedWorldStateFile();
+    ~MappedWorldStateFile();
+
+    bool Open( const char* filePath );
+    void Close();
+
+    // Points straight into the mapped file, valid until Close()
+    const WorldState* GetState() const { return m_State; }
+
+private:
+    void* m_FileHandle = nullptr;
+    void* m_MappingHandle = nullptr;
+    const WorldState* m_State = nullptr;
+};
@@ -0,0 +1,165 @@
+//-----------------------------------------------------------------------------
+// Headless check of FramePacer against a fake clock: nothing really sleeps,
+//  so it runs in a moment and gives the same answer on any machine. Build
+//  and run from Starship/Code with
+//
+//      g++ -std=c++17 -O2 -I. Tools/FramePacerCheck/FramePacerCheck.cpp Game/FramePacer.cpp -o FramePacerCheck
+//      ./FramePacerCheck
+//
+//  Prints one line per case and exits non zero if any fail.
+#include "Game/FramePacer.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+//-----------------------------------------------------------------------------
+// Time only moves when the pacer waits or a case does some "work". Sleeps
+//  overshoot by a fixed amount, like a coarse OS scheduler would.
+class FakeFramePacerClock: public FramePacerClock
+{
+public:
+    double m_NowSeconds = 100.0;
+    double m_SleepOvershootSeconds = 0.0;
+    double m_SpinStepSeconds = .00001;
+    int m_SleepCount = 0;
+    int m_SpinCount = 0;
+
+    virtual double GetCurrentSeconds() override { return m_NowSeconds; }
+    virtual void SleepSeconds( double seconds ) override
+    {
+        m_NowSeconds += seconds + m_SleepOvershootSeconds;
+        m_SleepCount++;
+    }
+    virtual void Spin() override
+    {
+        m_NowSeconds += m_SpinStepSeconds;
+        m_SpinCount++;
+    }
+
+    void Work( double seconds ) { m_NowSeconds += seconds; }
+};
+
+static int s_FailureCount = 0;
+
+//-----------------------------------------------------------------------------
+static void Check( bool passed, const char* caseName, const char* what )
+{
+    fprintf( passed ? stdout : stderr, "%s %s: %s\n", passed ? "ok  " : "FAIL", caseName, what );
+    s_FailureCount += passed ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+static bool IsNear( double value, double expected, double tolerance )
+{
+    return fabs( value - expected ) <= tolerance;
+}
+
+//-----------------------------------------------------------------------------
+// Light frames land on the grid: sleep most of the wait, spin the rest
+static void CheckSteadyFrames()
+{
+    FakeFramePacerClock clock;
+    FramePacer pacer( clock );
+    pacer.SetTargetFramesPerSecond( 60.f );
+    double periodSeconds = 1.0 / 60.0;
+
+    pacer.WaitForNextFrame();
+    for( int frameIndex = 0; frameIndex < FRAME_PACER_HISTORY_FRAMES; ++frameIndex )
+    {
+        clock.Work( .005 );
+        pacer.WaitForNextFrame();
+    }
+
+    FramePacerStats stats = pacer.GetStats();
+    Check( stats.frameCount == FRAME_PACER_HISTORY_FRAMES, "steady", "history is full" );
+    Check( IsNear( stats.averageSeconds, periodSeconds, .0001 ), "steady", "average is the period" );
+    Check( stats.jitterSeconds < .0001, "steady", "no jitter" );
+    Check( stats.overrunCount == 0, "steady", "no late frames" );
+    Check( clock.m_SleepCount == FRAME_PACER_HISTORY_FRAMES, "steady", "one sleep per frame" );
+}
+
+//-----------------------------------------------------------------------------
+// A sleep that wakes up late by less than the spin margin is still on time
+static void CheckSleepOvershoot()
+{
+    FakeFramePacerClock clock;
+    clock.m_SleepOvershootSeconds = .001;
+    FramePacer pacer( clock );
+    pacer.SetTargetFramesPerSecond( 60.f );
+
+    pacer.WaitForNextFrame();
+    for( int frameIndex = 0; frameIndex < 30; ++frameIndex )
+    {
+        clock.Work( .002 );
+        pacer.WaitForNextFrame();
+    }
+
+    FramePacerStats stats = pacer.GetStats();
+    Check( IsNear( stats.averageSeconds, 1.0 / 60.0, .0001 ), "overshoot", "average is the period" );
+    Check( stats.overrunCount == 0, "overshoot", "no late frames" );
+    Check( clock.m_SpinCount > 0, "overshoot", "spins out the remainder" );
+}
+
+//-----------------------------------------------------------------------------
+// A little late is made up by the next frame; a lot late restarts the grid
+//  rather than running a burst of short frames
+static void CheckLateFrames()
+{
+    FakeFramePacerClock clock;
+    FramePacer pacer( clock );
+    pacer.SetTargetFramesPerSecond( 60.f );
+    double periodSeconds = 1.0 / 60.0;
+
+    pacer.WaitForNextFrame();
+    clock.Work( periodSeconds + .003 );
+    double lateFrameSeconds = pacer.WaitForNextFrame();
+    clock.Work( .001 );
+    double catchUpFrameSeconds = pacer.WaitForNextFrame();
+    Check( IsNear( lateFrameSeconds, periodSeconds + .003, .0001 ), "late", "slow frame runs long" );
+    Check( IsNear( catchUpFrameSeconds, periodSeconds - .003, .0001 ), "late", "next frame makes it up" );
+    Check( pacer.GetStats().overrunCount == 1, "late", "counted past the tolerance" );
+
+    clock.Work( .05 );
+    pacer.WaitForNextFrame();
+    clock.Work( .001 );
+    double afterHitchSeconds = pacer.WaitForNextFrame();
+    Check( IsNear( afterHitchSeconds, periodSeconds, .0001 ), "late", "hitch restarts the grid" );
+    Check( pacer.GetStats().overrunCount == 2, "late", "hitch counted" );
+}
+
+//-----------------------------------------------------------------------------
+static void CheckUnpaced()
+{
+    FakeFramePacerClock clock;
+    FramePacer pacer( clock );
+    pacer.SetTargetFramesPerSecond( 0.f );
+
+    pacer.WaitForNextFrame();
+    for( int frameIndex = 0; frameIndex < 10; ++frameIndex )
+    {
+        clock.Work( .001 );
+        pacer.WaitForNextFrame();
+    }
+
+    FramePacerStats stats = pacer.GetStats();
+    Check( clock.m_SleepCount == 0 && clock.m_SpinCount == 0, "unpaced", "never waits" );
+    Check( IsNear( stats.averageSeconds, .001, .00001 ), "unpaced", "frame time is the work" );
+    Check( stats.overrunCount == 0, "unpaced", "nothing is late" );
+}
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    CheckSteadyFrames();
+    CheckSleepOvershoot();
+    CheckLateFrames();
+    CheckUnpaced();
+
+    if( s_FailureCount > 0 )
+    {
+        fprintf( stderr, "%i checks failed\n", s_FailureCount );
+        return 1;
+    }
+    printf( "all frame pacer checks passed\n" );
+    return 0;
+}
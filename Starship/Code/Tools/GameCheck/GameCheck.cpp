@@ -0,0 +1,384 @@
+//-----------------------------------------------------------------------------
+// Headless checks of whole games: no window, renderer or devices, so they
+//  run from a console or a CI job. The GameCheck project in Starship.sln
+//  builds every Game source but App and Main_Windows against the Engine and
+//  copies the exe to Starship/Run; run it from there so Data/ resolves:
+//
+//      GameCheck_x64.exe [check...]
+//
+//  With no arguments every check runs. Prints one line per check and exits
+//  non zero if any fail or a name is unknown.
+//
+//      bulletstorm     every bullet the storm scenario loads expires within
+//                      its lifetime, with bullets wrapping
+//      reset           a Game Reset after other games plays a seed exactly
+//                      as a new Game does, with one ship and MAX_PLAYERS
+//      loopback        a server and a bot flown client over 127.0.0.1: the
+//                      client's ship is flown, and whenever a snapshot
+//                      left nothing pending the client's world matches the
+//                      server's within the replication tolerances
+//      rollback        two rollback peers over a fake link with latency and
+//                      jitter never disagree on a confirmed tick; prints the
+//                      deepest rollback and the worst re-simulation time
+#include "Game/BotPilot.hpp"
+#include "Game/Game.hpp"
+#include "Game/GameBatchRunner.hpp"
+#include "Game/GameContext.hpp"
+#include "Game/Net/GameClient.hpp"
+#include "Game/Net/GameServer.hpp"
+#include "Game/Net/Replication.hpp"
+#include "Game/Net/RollbackLoopback.hpp"
+#include "Game/Net/RollbackSession.hpp"
+#include "Game/WorldState.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+constexpr int RESET_CHECK_GAMES = 8;
+constexpr int RESET_CHECK_TICKS = 60 * 60 * 2;      // Long enough for wasp waves
+constexpr int LOOPBACK_CHECK_TICKS = 60 * 60;
+constexpr unsigned short LOOPBACK_CHECK_PORT = NET_DEFAULT_PORT + 1;    // Clear of a running server
+constexpr int ROLLBACK_CHECK_TICKS = 60 * 60 * 2;
+constexpr float ROLLBACK_CHECK_ROUGH_LATENCY_SECONDS = .12f;             // Past the prediction window, so it stalls
+constexpr float ROLLBACK_CHECK_ROUGH_JITTER_SECONDS = .06f;
+
+//-----------------------------------------------------------------------------
+struct GameCheck
+{
+    const char* name;
+    bool (*run)();
+};
+
+//-----------------------------------------------------------------------------
+static int CountSavedEntities( const EntityState* states, int stateCount )
+{
+    int savedCount = 0;
+    for( int stateIndex = 0; stateIndex < stateCount; ++stateIndex )
+    {
+        savedCount += states[ stateIndex ].kind != ENTITY_KIND_NONE ? 1 : 0;
+    }
+    return savedCount;
+}
+
+//-----------------------------------------------------------------------------
+// Wrapping bullets can't leave by flying off the screen, so only their
+//  lifetime can retire them
+static bool CheckBulletStormExpiry()
+{
+    std::unique_ptr<WorldState> scratchState( new WorldState() );
+
+    GameContext context;
+    context.bulletsWrapAround = true;
+    context.keepsRewindHistory = false;
+    Game game( context );
+    game.Startup( 1 );
+    game.LoadBulletStormScenario();
+
+    game.CaptureWorldState( *scratchState );
+    int loadedCount = CountSavedEntities( scratchState->bullets, MAX_BULLETS );
+
+    int tickCount = static_cast<int>(ceil( BULLET_LIFETIME_SECONDS / GAME_BATCH_TICK_SECONDS )) + 2;
+    for( int tick = 0; tick < tickCount; ++tick )
+    {
+        game.SimulateTick( GAME_BATCH_TICK_SECONDS );
+    }
+
+    game.CaptureWorldState( *scratchState );
+    int remainingCount = CountSavedEntities( scratchState->bullets, MAX_BULLETS );
+    game.Shutdown();
+
+    printf( "  loaded %i bullets, %i left after %i ticks\n", loadedCount, remainingCount, tickCount );
+    return loadedCount > 0 && remainingCount == 0;
+}
+
+//-----------------------------------------------------------------------------
+static bool IsSameBatchResult( const GameBatchResult& a, const GameBatchResult& b )
+{
+    return a.seed == b.seed &&
+           a.ticksSimulated == b.ticksSimulated &&
+           a.wavesReached == b.wavesReached &&
+           a.livesUsed == b.livesUsed &&
+           a.kills == b.kills &&
+           a.isGameOver == b.isGameOver;
+}
+
+//-----------------------------------------------------------------------------
+// Otherwise batch results would depend on which worker ran what. One worker
+//  runs the whole batch on one Game, Reset between games; a batch of one
+//  always runs on a new Game.
+static int CountResetMismatches( GameBatchRunner& runner, int playerCount )
+{
+    GameBatchSettings settings;
+    settings.gameCount = RESET_CHECK_GAMES;
+    settings.ticksPerGame = RESET_CHECK_TICKS;
+    settings.playerCount = playerCount;
+
+    std::vector<GameBatchResult> resetResults;
+    runner.Run( settings, resetResults );
+
+    int mismatchCount = 0;
+    std::vector<GameBatchResult> newResults;
+    for( int gameIndex = 0; gameIndex < settings.gameCount; ++gameIndex )
+    {
+        GameBatchSettings singleSettings = settings;
+        singleSettings.gameCount = 1;
+        singleSettings.firstSeed = settings.firstSeed + static_cast<unsigned int>(gameIndex);
+        runner.Run( singleSettings, newResults );
+        mismatchCount += IsSameBatchResult( resetResults[ gameIndex ], newResults[ 0 ] ) ? 0 : 1;
+    }
+
+    printf( "  %i players: %i of %i reset games differ from a new game on the same seed\n",
+            playerCount,
+            mismatchCount,
+            settings.gameCount );
+    return mismatchCount;
+}
+
+//-----------------------------------------------------------------------------
+static bool CheckResetMatchesNew()
+{
+    GameBatchRunner runner;
+    runner.Startup( 1 );
+    int mismatchCount = CountResetMismatches( runner, 1 );
+    mismatchCount += CountResetMismatches( runner, MAX_PLAYERS );
+    runner.Shutdown();
+    return mismatchCount == 0;
+}
+
+//-----------------------------------------------------------------------------
+static int GetAngleQuantaBetween( int angleA, int angleB )
+{
+    int difference = (angleA - angleB) & (NET_ANGLE_QUANTA - 1);
+    return difference > NET_ANGLE_QUANTA / 2 ? NET_ANGLE_QUANTA - difference : difference;
+}
+
+//-----------------------------------------------------------------------------
+// Both sides quantized the same way; the client's is already whole quanta,
+//  so beyond the tolerance only the float round trip may add a quantum
+static int CountDivergedEntities( const WorldState& serverState, const WorldState& clientState )
+{
+    std::unique_ptr<NetWorld> serverWorld( new NetWorld() );
+    std::unique_ptr<NetWorld> clientWorld( new NetWorld() );
+    QuantizeWorldState( serverState, *serverWorld );
+    QuantizeWorldState( clientState, *clientWorld );
+
+    constexpr int positionTolerance = NET_POSITION_TOLERANCE + NET_SUBQUANTA_PER_QUANTUM;
+    int divergedCount = 0;
+    for( int netIndex = 0; netIndex < NET_MAX_ENTITIES; ++netIndex )
+    {
+        const NetEntity& serverEntity = serverWorld->entities[ netIndex ];
+        const NetEntity& clientEntity = clientWorld->entities[ netIndex ];
+        if( serverEntity.kind != clientEntity.kind )
+        {
+            divergedCount++;
+            continue;
+        }
+        if( serverEntity.kind == ENTITY_KIND_NONE )
+        {
+            continue;
+        }
+
+        bool isDiverged = abs( serverEntity.x - clientEntity.x ) > positionTolerance ||
+                          abs( serverEntity.y - clientEntity.y ) > positionTolerance ||
+                          GetAngleQuantaBetween( serverEntity.angle, clientEntity.angle ) > NET_ANGLE_TOLERANCE;
+        divergedCount += isDiverged ? 1 : 0;
+    }
+    return divergedCount;
+}
+
+//-----------------------------------------------------------------------------
+// One tick per update on both sides, so over loopback every snapshot lands
+//  in the update that sent it. Ticks the packet budget left entities out of
+//  date on can't be held to the tolerances and are only counted.
+static bool CheckLoopbackReplication()
+{
+    GameContext headlessContext;
+    Game serverGame( headlessContext );
+    serverGame.Startup( 1 );
+    GameServer server( &serverGame, 0 );
+    if( !server.Startup( LOOPBACK_CHECK_PORT ) )
+    {
+        printf( "  could not open port %i\n", LOOPBACK_CHECK_PORT );
+        serverGame.Shutdown();
+        return false;
+    }
+
+    BotPilot clientPilot;
+    Game clientGame( headlessContext );
+    clientGame.Startup( 1 );
+    GameClient client( &clientGame );
+    client.SetPlayerPilot( &clientPilot );
+    if( !client.Startup( NetAddress::MakeLoopback( LOOPBACK_CHECK_PORT ) ) )
+    {
+        printf( "  could not open a client socket\n" );
+        server.Shutdown();
+        serverGame.Shutdown();
+        return false;
+    }
+
+    std::unique_ptr<WorldState> serverState( new WorldState() );
+    int comparedTicks = 0;
+    int behindTicks = 0;
+    int divergedTicks = 0;
+    int serverBulletTicks = 0;
+    for( int tick = 0; tick < LOOPBACK_CHECK_TICKS; ++tick )
+    {
+        server.Update( NET_TICK_SECONDS );
+        serverGame.CaptureWorldState( *serverState );
+        client.Update( NET_TICK_SECONDS );
+
+        serverBulletTicks += CountSavedEntities( serverState->bullets, MAX_BULLETS ) > 0 ? 1 : 0;
+        if( client.GetLatestTick() != server.GetTick() || server.GetLastPendingEntities() > 0 )
+        {
+            behindTicks++;
+            continue;
+        }
+
+        comparedTicks++;
+        divergedTicks += CountDivergedEntities( *serverState, client.GetWorldState() ) > 0 ? 1 : 0;
+    }
+
+    int playerIndex = client.GetPlayerIndex();
+    client.Shutdown();
+    server.Shutdown();
+    clientGame.Shutdown();
+    serverGame.Shutdown();
+
+    printf( "  client flew ship %i, server fired on %i ticks; compared %i ticks, %i diverged, %i behind\n",
+            playerIndex,
+            serverBulletTicks,
+            comparedTicks,
+            divergedTicks,
+            behindTicks );
+    return playerIndex == 0 && serverBulletTicks > 0 && comparedTicks >= LOOPBACK_CHECK_TICKS / 2 && divergedTicks == 0;
+}
+
+//-----------------------------------------------------------------------------
+// The link's clock only moves by what Update is given, so latency and
+//  jitter are in game time and the run doesn't depend on the machine's speed
+static bool RunRollbackLink( float latencySeconds, float jitterSeconds )
+{
+    GameContext headlessContext;
+    Game localGame( headlessContext );
+    localGame.Startup( ROLLBACK_LOOPBACK_PEERS );
+
+    BotPilot localPilot;
+    RollbackLoopback loopback( &localGame );
+    loopback.SetLocalPilot( &localPilot );
+    loopback.Startup( latencySeconds, jitterSeconds );
+    for( int tick = 0; tick < ROLLBACK_CHECK_TICKS; ++tick )
+    {
+        loopback.Update( NET_TICK_SECONDS );
+    }
+
+    int comparedTicks = loopback.GetComparedTicks();
+    int desyncCount = loopback.GetDesyncCount();
+    int rollbackCount = 0;
+    int peakRollbackTicks = 0;
+    double peakResimulateSeconds = 0.0;
+    int stalledTicks = 0;
+    for( int peerIndex = 0; peerIndex < ROLLBACK_LOOPBACK_PEERS; ++peerIndex )
+    {
+        const RollbackSession& session = *loopback.GetSession( peerIndex );
+        rollbackCount += session.GetRollbackCount();
+        stalledTicks += session.GetStalledTickCount();
+        peakRollbackTicks = std::max( peakRollbackTicks, session.GetPeakRollbackTicks() );
+        peakResimulateSeconds = std::max( peakResimulateSeconds, session.GetPeakResimulateSeconds() );
+    }
+
+    loopback.Shutdown();
+    localGame.Shutdown();
+
+    printf( "  %.0fms +%.0fms: %i of %i ticks desynced, %i rollbacks, deepest %i ticks, worst re-simulation %.3fms, %i stalls\n",
+            latencySeconds * 1000.f,
+            jitterSeconds * 1000.f,
+            desyncCount,
+            comparedTicks,
+            rollbackCount,
+            peakRollbackTicks,
+            peakResimulateSeconds * 1000.0,
+            stalledTicks );
+    return desyncCount == 0 && comparedTicks >= ROLLBACK_CHECK_TICKS / 2 && rollbackCount > 0;
+}
+
+//-----------------------------------------------------------------------------
+// Once inside the prediction window and once past it, where peers stall
+static bool CheckRollbackDeterminism()
+{
+    bool passed = RunRollbackLink( ROLLBACK_LOOPBACK_DEFAULT_LATENCY_SECONDS, ROLLBACK_LOOPBACK_DEFAULT_JITTER_SECONDS );
+    passed &= RunRollbackLink( ROLLBACK_CHECK_ROUGH_LATENCY_SECONDS, ROLLBACK_CHECK_ROUGH_JITTER_SECONDS );
+    return passed;
+}
+
+//-----------------------------------------------------------------------------
+static const GameCheck GAME_CHECKS[] =
+{
+    { "bulletstorm", &CheckBulletStormExpiry },
+    { "reset", &CheckResetMatchesNew },
+    { "loopback", &CheckLoopbackReplication },
+    { "rollback", &CheckRollbackDeterminism },
+};
+
+//-----------------------------------------------------------------------------
+static const GameCheck* FindGameCheck( const char* name )
+{
+    for( const GameCheck& check : GAME_CHECKS )
+    {
+        if( strcmp( check.name, name ) == 0 )
+        {
+            return &check;
+        }
+    }
+    return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+static bool RunGameCheck( const GameCheck& check )
+{
+    printf( "%s\n", check.name );
+    fflush( stdout );
+    bool passed = check.run();
+    fprintf( passed ? stdout : stderr, "%s %s\n", passed ? "ok  " : "FAIL", check.name );
+    return passed;
+}
+
+//-----------------------------------------------------------------------------
+int main( int argumentCount, char** arguments )
+{
+    int failedCount = 0;
+    int runCount = 0;
+    if( argumentCount <= 1 )
+    {
+        for( const GameCheck& check : GAME_CHECKS )
+        {
+            failedCount += RunGameCheck( check ) ? 0 : 1;
+            runCount++;
+        }
+    }
+
+    for( int argumentIndex = 1; argumentIndex < argumentCount; ++argumentIndex )
+    {
+        const GameCheck* check = FindGameCheck( arguments[ argumentIndex ] );
+        if( check == nullptr )
+        {
+            fprintf( stderr, "Unknown check %s\n", arguments[ argumentIndex ] );
+            failedCount++;
+            continue;
+        }
+        failedCount += RunGameCheck( *check ) ? 0 : 1;
+        runCount++;
+    }
+
+    if( failedCount > 0 )
+    {
+        fprintf( stderr, "%i of %i checks failed\n", failedCount, runCount );
+        return 1;
+    }
+    printf( "all %i game checks passed\n", runCount );
+    return 0;
+}
@@ -0,0 +1,200 @@
+//-----------------------------------------------------------------------------
+// Headless check of TileLightBinner: no window, renderer or GPU. Build and
+//  run from Starship/Code with
+//
+//      g++ -std=c++17 -O2 -pthread -I. Tools/LightBinningCheck/LightBinningCheck.cpp Game/TileLightBinner.cpp -o LightBinningCheck
+//      ./LightBinningCheck [lights] [scenes]
+//
+//  Each scene spreads random lights over the screen and a margin past it,
+//  the way explosions just off screen still reach in, under a randomly
+//  placed view. The binning is checked two ways: one thread and every
+//  worker must build the same lists, and every sample point lit from its
+//  tile's list alone must come out exactly as lit from all the lights,
+//  since a light that can't reach a point adds exactly zero there. Prints
+//  the binning times and exits non zero if any scene fails.
+#include "Game/GameCommon.hpp"
+#include "Game/TileLightBinner.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+constexpr int DEFAULT_LIGHT_COUNT = 1000;
+constexpr int DEFAULT_SCENE_COUNT = 20;
+constexpr int BIN_PASSES = 20;
+constexpr int SAMPLES_PER_TILE = 64;
+
+//-----------------------------------------------------------------------------
+struct SceneResult
+{
+    bool isSameBinning = false;
+    int sampleCount = 0;
+    int mismatchCount = 0;
+    float worstError = 0.f;
+};
+
+//-----------------------------------------------------------------------------
+static float RandomInRange( std::mt19937& rng, float minValue, float maxValue )
+{
+    return std::uniform_real_distribution<float>( minValue, maxValue )( rng );
+}
+
+//-----------------------------------------------------------------------------
+static bool IsSameBinning( const TileLightBinner& a, const TileLightBinner& b )
+{
+    const std::vector<TileLightRange>& aRanges = a.GetTileRanges();
+    const std::vector<TileLightRange>& bRanges = b.GetTileRanges();
+    if( a.GetLightIndices() != b.GetLightIndices() || aRanges.size() != bRanges.size() )
+    {
+        return false;
+    }
+
+    for( size_t tileIndex = 0; tileIndex < aRanges.size(); ++tileIndex )
+    {
+        if( aRanges[ tileIndex ].offset != bRanges[ tileIndex ].offset ||
+            aRanges[ tileIndex ].count != bRanges[ tileIndex ].count )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+static SceneResult CheckScene( std::mt19937& rng,
+                               int lightCount,
+                               TileLightBinner& serialBinner,
+                               TileLightBinner& parallelBinner,
+                               double& inOutSerialSeconds,
+                               double& inOutParallelSeconds )
+{
+    // The view moves off the origin so tiles don't line up with whole units
+    const float viewMins[ 2 ] = { RandomInRange( rng, -SCREEN_SIZE_X, SCREEN_SIZE_X ),
+                                  RandomInRange( rng, -SCREEN_SIZE_Y, SCREEN_SIZE_Y ) };
+    const float viewMaxs[ 2 ] = { viewMins[ 0 ] + SCREEN_SIZE_X, viewMins[ 1 ] + SCREEN_SIZE_Y };
+
+    std::vector<TileLight> lights( lightCount );
+    for( TileLight& light : lights )
+    {
+        light.position[ 0 ] = RandomInRange( rng, viewMins[ 0 ] - SPATIAL_GRID_MARGIN, viewMaxs[ 0 ] + SPATIAL_GRID_MARGIN );
+        light.position[ 1 ] = RandomInRange( rng, viewMins[ 1 ] - SPATIAL_GRID_MARGIN, viewMaxs[ 1 ] + SPATIAL_GRID_MARGIN );
+        light.position[ 2 ] = RandomInRange( rng, -EXPLOSION_LIGHT_HEIGHT, EXPLOSION_LIGHT_HEIGHT );
+        light.radius = RandomInRange( rng, 1.f, PLAYER_SHIP_EXPLOSION_LIGHT_RADIUS );
+        light.color[ 0 ] = RandomInRange( rng, 0.f, 1.f );
+        light.color[ 1 ] = RandomInRange( rng, 0.f, 1.f );
+        light.color[ 2 ] = RandomInRange( rng, 0.f, 1.f );
+        light.intensity = RandomInRange( rng, 1.f, PLAYER_SHIP_EXPLOSION_LIGHT_INTENSITY );
+    }
+
+    for( int passIndex = 0; passIndex < BIN_PASSES; ++passIndex )
+    {
+        serialBinner.Bin( lights.data(), lightCount, viewMins, viewMaxs );
+        inOutSerialSeconds += serialBinner.GetLastBinSeconds();
+        parallelBinner.Bin( lights.data(), lightCount, viewMins, viewMaxs );
+        inOutParallelSeconds += parallelBinner.GetLastBinSeconds();
+    }
+
+    SceneResult result;
+    result.isSameBinning = IsSameBinning( serialBinner, parallelBinner );
+
+    TileLightingConstants constants;
+    constants.cameraPosition[ 0 ] = (viewMins[ 0 ] + viewMaxs[ 0 ]) * .5f;
+    constants.cameraPosition[ 1 ] = (viewMins[ 1 ] + viewMaxs[ 1 ]) * .5f;
+    constants.cameraPosition[ 2 ] = -SCREEN_SIZE_X;
+    constants.ambient[ 0 ] = constants.ambient[ 1 ] = constants.ambient[ 2 ] = 1.f;
+    constants.ambient[ 3 ] = .1f;
+    const float textureColor[ 4 ] = { .75f, .75f, .75f, 1.f };
+    const float tint[ 4 ] = { 1.f, 1.f, 1.f, 1.f };
+
+    const std::vector<TileLightRange>& ranges = parallelBinner.GetTileRanges();
+    const std::vector<unsigned int>& lightIndices = parallelBinner.GetLightIndices();
+    for( int tileIndex = 0; tileIndex < static_cast<int>(ranges.size()); ++tileIndex )
+    {
+        float tileMinX = parallelBinner.GetGridMinX() + static_cast<float>(tileIndex % parallelBinner.GetTileCountX()) * TILE_LIGHT_TILE_SIZE;
+        float tileMinY = parallelBinner.GetGridMinY() + static_cast<float>(tileIndex / parallelBinner.GetTileCountX()) * TILE_LIGHT_TILE_SIZE;
+        for( int sampleIndex = 0; sampleIndex < SAMPLES_PER_TILE; ++sampleIndex )
+        {
+            const float position[ 3 ] = { tileMinX + RandomInRange( rng, 0.f, TILE_LIGHT_TILE_SIZE ),
+                                          tileMinY + RandomInRange( rng, 0.f, TILE_LIGHT_TILE_SIZE ),
+                                          0.f };
+            const float normal[ 3 ] = { RandomInRange( rng, -.5f, .5f ), RandomInRange( rng, -.5f, .5f ), -1.f };
+
+            // Whichever tile the shader would pick, edges included
+            const TileLightRange& range = ranges[ parallelBinner.GetTileIndexAt( position[ 0 ], position[ 1 ] ) ];
+            const unsigned int* tileIndices = range.count > 0 ? &lightIndices[ range.offset ] : nullptr;
+
+            float everyLightColor[ 3 ] = {};
+            float tileLightColor[ 3 ] = {};
+            EvaluateTileLighting( constants, position, normal, textureColor, tint, lights.data(), nullptr, lightCount, everyLightColor );
+            EvaluateTileLighting( constants, position, normal, textureColor, tint, lights.data(), tileIndices, static_cast<int>(range.count), tileLightColor );
+
+            bool isMatch = true;
+            for( int channel = 0; channel < 3; ++channel )
+            {
+                float error = fabsf( everyLightColor[ channel ] - tileLightColor[ channel ] );
+                result.worstError = error > result.worstError ? error : result.worstError;
+                isMatch = isMatch && everyLightColor[ channel ] == tileLightColor[ channel ];
+            }
+            result.mismatchCount += isMatch ? 0 : 1;
+            result.sampleCount++;
+        }
+    }
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+int main( int argumentCount, char** arguments )
+{
+    int lightCount = argumentCount > 1 ? atoi( arguments[ 1 ] ) : DEFAULT_LIGHT_COUNT;
+    int sceneCount = argumentCount > 2 ? atoi( arguments[ 2 ] ) : DEFAULT_SCENE_COUNT;
+    lightCount = lightCount > 0 ? lightCount : DEFAULT_LIGHT_COUNT;
+    sceneCount = sceneCount > 0 ? sceneCount : DEFAULT_SCENE_COUNT;
+
+    TileLightBinner serialBinner;
+    TileLightBinner parallelBinner;
+    serialBinner.Startup( 0 );
+    parallelBinner.Startup( TILE_LIGHT_MAX_WORKERS );     // Even on fewer cores, so the bands really split
+
+    std::mt19937 rng( 0 );
+    double serialSeconds = 0.0;
+    double parallelSeconds = 0.0;
+    int failedSceneCount = 0;
+    for( int sceneIndex = 0; sceneIndex < sceneCount; ++sceneIndex )
+    {
+        SceneResult result = CheckScene( rng, lightCount, serialBinner, parallelBinner, serialSeconds, parallelSeconds );
+        if( !result.isSameBinning || result.mismatchCount > 0 )
+        {
+            fprintf( stderr, "Scene %i: lists %s, %i of %i samples differ from lighting by every light, worst by %g\n",
+                     sceneIndex,
+                     result.isSameBinning ? "match" : "DIFFER",
+                     result.mismatchCount,
+                     result.sampleCount,
+                     static_cast<double>(result.worstError) );
+            failedSceneCount++;
+        }
+    }
+
+    double binCount = static_cast<double>(sceneCount) * BIN_PASSES;
+    printf( "%i scenes of %i lights, %i tiles each, most in a tile %i\n",
+            sceneCount,
+            lightCount,
+            static_cast<int>(parallelBinner.GetTileRanges().size()),
+            parallelBinner.GetMostLightsInTile() );
+    printf( "bin %.3fms on 1 thread, %.3fms on %i\n",
+            serialSeconds * 1000.0 / binCount,
+            parallelSeconds * 1000.0 / binCount,
+            parallelBinner.GetWorkerCount() + 1 );
+
+    parallelBinner.Shutdown();
+    serialBinner.Shutdown();
+
+    if( failedSceneCount > 0 )
+    {
+        fprintf( stderr, "%i of %i scenes failed\n", failedSceneCount, sceneCount );
+        return 1;
+    }
+    printf( "binned lighting matches lighting by every light\n" );
+    return 0;
+}
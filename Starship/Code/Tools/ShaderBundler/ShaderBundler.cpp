@@ -0,0 +1,268 @@
+//-----------------------------------------------------------------------------
+// Offline shader build: compiles every program under a shader root to D3D11
+//  bytecode with vkd3d-shader's compiler and packs the blobs into one
+//  ShaderBundle. Runs on Linux; build and run from Starship/Code with
+//
+//      g++ -std=c++17 -O2 -I. Tools/ShaderBundler/ShaderBundler.cpp Game/ShaderBundle.cpp -o ShaderBundler
+//      ./ShaderBundler ../Run/Data/Shaders/
+//
+//  A program is any .hlsl file no other file includes. Its includes are
+//  pasted in here rather than by the compiler, so the hash a blob is stored
+//  under is the same one the game computes from the files it ships with.
+//  Entries whose hash and compiler still match the existing bundle are
+//  carried over as they are; only changed sources are compiled again.
+//
+//  Options:
+//      --compiler <path>   defaults to vkd3d-compiler on the PATH
+//      --out <file>        defaults to Shaders.bundle in the shader root
+#include "Game/ShaderBundle.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+//-----------------------------------------------------------------------------
+static std::string ReadCommandFirstLine( const std::string& command )
+{
+    std::string firstLine;
+    FILE* pipe = popen( command.c_str(), "r" );
+    if( pipe == nullptr )
+    {
+        return firstLine;
+    }
+
+    char line[ 256 ] = {};
+    if( fgets( line, sizeof( line ), pipe ) != nullptr )
+    {
+        firstLine = line;
+        while( !firstLine.empty() && (firstLine.back() == '\n' || firstLine.back() == '\r') )
+        {
+            firstLine.pop_back();
+        }
+    }
+    pclose( pipe );
+    return firstLine;
+}
+
+//-----------------------------------------------------------------------------
+static bool ReadBinaryFile( const fs::path& filePath, std::string& outBytes )
+{
+    FILE* file = fopen( filePath.string().c_str(), "rb" );
+    if( file == nullptr )
+    {
+        return false;
+    }
+
+    outBytes.clear();
+    char buffer[ 4096 ];
+    size_t bytesRead = 0;
+    while( (bytesRead = fread( buffer, 1, sizeof( buffer ), file )) > 0 )
+    {
+        outBytes.append( buffer, bytesRead );
+    }
+    fclose( file );
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Only quoted includes count, the same as FlattenShaderSource
+static void FindIncludedPaths( const fs::path& sourcePath, std::vector<fs::path>& outIncluded )
+{
+    std::string source;
+    if( !ReadBinaryFile( sourcePath, source ) )
+    {
+        return;
+    }
+
+    size_t includeStart = 0;
+    while( (includeStart = source.find( "#include", includeStart )) != std::string::npos )
+    {
+        size_t nameStart = source.find( '"', includeStart );
+        size_t lineEnd = source.find( '\n', includeStart );
+        includeStart += strlen( "#include" );
+        if( nameStart == std::string::npos || nameStart > lineEnd )
+        {
+            continue;
+        }
+
+        size_t nameEnd = source.find( '"', nameStart + 1 );
+        if( nameEnd != std::string::npos && nameEnd < lineEnd )
+        {
+            fs::path includedPath = sourcePath.parent_path() / source.substr( nameStart + 1, nameEnd - nameStart - 1 );
+            outIncluded.push_back( fs::weakly_canonical( includedPath ) );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+static bool CompileStage( const std::string& compiler,
+                          const std::string& flattenedSource,
+                          ShaderStage stage,
+                          std::string& outBlob )
+{
+    fs::path sourcePath = fs::temp_directory_path() / "ShaderBundler_source.hlsl";
+    fs::path blobPath = fs::temp_directory_path() / "ShaderBundler_blob.dxbc";
+    {
+        FILE* file = fopen( sourcePath.string().c_str(), "wb" );
+        if( file == nullptr )
+        {
+            return false;
+        }
+        fwrite( flattenedSource.data(), 1, flattenedSource.size(), file );
+        fclose( file );
+    }
+
+    std::string command = "\"" + compiler + "\" -x hlsl -b dxbc-tpf" +
+                          " -p " + SHADER_STAGE_PROFILES[ stage ] +
+                          " -e " + SHADER_STAGE_ENTRY_POINTS[ stage ] +
+                          " -o \"" + blobPath.string() + "\"" +
+                          " \"" + sourcePath.string() + "\"";
+    fs::remove( blobPath );
+    bool isCompiled = std::system( command.c_str() ) == 0 && ReadBinaryFile( blobPath, outBlob ) && !outBlob.empty();
+
+    fs::remove( sourcePath );
+    fs::remove( blobPath );
+    return isCompiled;
+}
+
+//-----------------------------------------------------------------------------
+int main( int argumentCount, char** arguments )
+{
+    std::string shaderRoot;
+    std::string compiler = "vkd3d-compiler";
+    std::string outPath;
+    for( int argumentIndex = 1; argumentIndex < argumentCount; ++argumentIndex )
+    {
+        if( strcmp( arguments[ argumentIndex ], "--compiler" ) == 0 && argumentIndex + 1 < argumentCount )
+        {
+            compiler = arguments[ ++argumentIndex ];
+        }
+        else if( strcmp( arguments[ argumentIndex ], "--out" ) == 0 && argumentIndex + 1 < argumentCount )
+        {
+            outPath = arguments[ ++argumentIndex ];
+        }
+        else
+        {
+            shaderRoot = arguments[ argumentIndex ];
+        }
+    }
+
+    if( shaderRoot.empty() || !fs::is_directory( shaderRoot ) )
+    {
+        fprintf( stderr, "usage: ShaderBundler <shader root> [--compiler <path>] [--out <file>]\n" );
+        return 1;
+    }
+    if( shaderRoot.back() != '/' )
+    {
+        shaderRoot += '/';
+    }
+    if( outPath.empty() )
+    {
+        outPath = shaderRoot + SHADER_BUNDLE_FILE_NAME;
+    }
+
+    std::string compilerVersion = ReadCommandFirstLine( "\"" + compiler + "\" --version" );
+    if( compilerVersion.empty() )
+    {
+        fprintf( stderr, "ShaderBundler: could not run %s\n", compiler.c_str() );
+        return 1;
+    }
+    compilerVersion.resize( compilerVersion.size() < SHADER_BUNDLE_COMPILER_BYTES - 1 ? compilerVersion.size() : SHADER_BUNDLE_COMPILER_BYTES - 1 );
+
+    // A different compiler invalidates everything
+    ShaderBundle previousBundle;
+    bool hasPrevious = previousBundle.Load( outPath.c_str() ) && compilerVersion == previousBundle.GetCompiler();
+    if( hasPrevious )
+    {
+        previousBundle.ValidateAgainstSources( shaderRoot );
+    }
+
+    std::vector<fs::path> sourcePaths;
+    std::vector<fs::path> includedPaths;
+    for( const fs::directory_entry& directoryEntry : fs::recursive_directory_iterator( shaderRoot ) )
+    {
+        if( directoryEntry.is_regular_file() && directoryEntry.path().extension() == ".hlsl" )
+        {
+            sourcePaths.push_back( fs::weakly_canonical( directoryEntry.path() ) );
+            FindIncludedPaths( directoryEntry.path(), includedPaths );
+        }
+    }
+    std::sort( sourcePaths.begin(), sourcePaths.end() );
+
+    std::vector<ShaderBundleEntry> entries;
+    std::vector<std::string> blobs;
+    int compiledCount = 0;
+    int reusedCount = 0;
+    const fs::path canonicalRoot = fs::weakly_canonical( shaderRoot );
+    for( const fs::path& sourcePath : sourcePaths )
+    {
+        if( std::find( includedPaths.begin(), includedPaths.end(), sourcePath ) != includedPaths.end() )
+        {
+            continue;
+        }
+
+        std::string relativePath = sourcePath.lexically_relative( canonicalRoot ).generic_string();
+        if( relativePath.size() >= SHADER_BUNDLE_PATH_BYTES )
+        {
+            fprintf( stderr, "ShaderBundler: path too long for the bundle index: %s\n", relativePath.c_str() );
+            return 1;
+        }
+
+        // The game flattens from the shader root too, so both hash the same text
+        std::string flattenedSource;
+        if( !FlattenShaderSource( shaderRoot + relativePath, flattenedSource ) )
+        {
+            fprintf( stderr, "ShaderBundler: could not resolve the includes of %s\n", relativePath.c_str() );
+            return 1;
+        }
+        unsigned long long sourceHash = HashShaderSource( flattenedSource );
+
+        for( int stageIndex = 0; stageIndex < static_cast<int>(SHADER_STAGE_COUNT); ++stageIndex )
+        {
+            ShaderStage stage = static_cast<ShaderStage>(stageIndex);
+            ShaderBundleEntry entry;
+            strncpy( entry.sourcePath, relativePath.c_str(), SHADER_BUNDLE_PATH_BYTES - 1 );
+            entry.sourceHash = sourceHash;
+            entry.stage = stage;
+
+            size_t blobBytes = 0;
+            const void* previousBlob = hasPrevious ? previousBundle.FindCurrentBlob( entry.sourcePath, stage, blobBytes ) : nullptr;
+
+            std::string blob;
+            if( previousBlob != nullptr )
+            {
+                blob.assign( static_cast<const char*>(previousBlob), blobBytes );
+                reusedCount++;
+            }
+            else if( CompileStage( compiler, flattenedSource, stage, blob ) )
+            {
+                compiledCount++;
+            }
+            else
+            {
+                fprintf( stderr, "ShaderBundler: %s failed to compile %s as %s\n",
+                         relativePath.c_str(), SHADER_STAGE_ENTRY_POINTS[ stage ], SHADER_STAGE_PROFILES[ stage ] );
+                return 1;
+            }
+
+            entries.push_back( entry );
+            blobs.push_back( blob );
+        }
+    }
+
+    if( !ShaderBundle::Write( outPath.c_str(), compilerVersion.c_str(), entries, blobs ) )
+    {
+        fprintf( stderr, "ShaderBundler: could not write %s\n", outPath.c_str() );
+        return 1;
+    }
+
+    printf( "ShaderBundler: %i blobs, %i compiled, %i reused, %s\n",
+            static_cast<int>(entries.size()), compiledCount, reusedCount, outPath.c_str() );
+    return 0;
+}
@@ -65,6 +65,65 @@ float4 calculate_lighting_at_point( float3 worldPosition, float3 worldNormal, fl
     return float4(finalColor, 1);
 }
 
+float3 safe_normalize( float3 v )
+{
+    return v * rsqrt( max( dot( v, v ), 1e-12 ) );
+}
+
+// Inverse square, windowed to reach exactly zero at the radius so a light
+//  left out of a tile contributes nothing there
+float2 calculate_tile_light_factors_at_point( float3 worldPosition, float3 worldNormal, tile_light_t light )
+{
+    float3 toLight = light.worldPosition - worldPosition;
+    float toLightDistanceSquared = dot( toLight, toLight );
+    float3 toLightDirection = safe_normalize( toLight );
+
+    float window = saturate( 1 - toLightDistanceSquared / (light.radius * light.radius) );
+    float attenuation = light.intensity * window * window / (1 + toLightDistanceSquared);
+
+    float incidentAngle = dot( toLightDirection, worldNormal );
+    float facing = smoothstep( -.25, .1, incidentAngle );
+    float diffuse = max( 0, incidentAngle );
+
+    float3 viewDirection = safe_normalize( CAMERA_POSITION - worldPosition );
+    float3 halfDirection = safe_normalize( toLightDirection + viewDirection );
+    float specular = dot( worldNormal, halfDirection );
+    specular = pow( facing * max( 0, specular ), SPECULAR_POWER );
+
+    return float2(attenuation * diffuse, attenuation * specular);
+}
+
+// calculate_lighting_at_point over only the lights binned to this point's
+//  tile; mirrored by EvaluateTileLighting in the game
+float4 calculate_tiled_lighting_at_point( float3 worldPosition, float3 worldNormal, float4 textureColor, float4 tint )
+{
+    float3 surfaceColor = pow( textureColor.xyz, GAMMA ) * tint.xyz;
+
+    float3 diffuse = pow( AMBIENT.xyz * AMBIENT.w, GAMMA.xxx );
+    float3 specular = float3(0, 0, 0);
+
+    float2 tile = floor( (worldPosition.xy - TILE_GRID_MINS) * TILE_GRID_INVERSE_SIZE );
+    uint2 tileCoords = (uint2) clamp( tile, float2(0, 0), (float2) (TILE_GRID_COUNT - 1) );
+    uint2 range = TILE_LIGHT_RANGES[ tileCoords.y * TILE_GRID_COUNT.x + tileCoords.x ];
+
+    for ( uint listIndex = 0; listIndex < range.y; ++listIndex )
+    {
+        tile_light_t light = TILE_LIGHTS[ TILE_LIGHT_INDICES[ range.x + listIndex ] ];
+        float3 lightColor = pow( light.color, GAMMA.xxx );
+
+        float2 lightFactor = calculate_tile_light_factors_at_point( worldPosition, worldNormal, light );
+
+        diffuse += lightFactor.x * lightColor;
+        specular += lightFactor.y * lightColor;
+    }
+
+    diffuse = saturate( diffuse );
+    specular *= SPECULAR_FACTOR;
+
+    float3 finalColor = diffuse * surfaceColor + specular;
+    return float4(finalColor, 1);
+}
+
 float4 calculate_fog( float3 worldPosition, float4 inputColor)
 {
     float distance = length( worldPosition - CAMERA_POSITION );
@@ -62,6 +62,28 @@ cbuffer fog_constants: register(b4)
     float FAR_FOG_DISTANCE;
 };
 
+// Lights binned per screen tile on the CPU by TileLightBinner, read by
+//  calculate_tiled_lighting_at_point; no MAX_LIGHTS limit on these
+struct tile_light_t
+{
+    float3 worldPosition;
+    float radius;
+
+    float3 color;
+    float intensity;
+};
+
+cbuffer tile_light_constants: register(b5)
+{
+    float2 TILE_GRID_MINS;
+    float2 TILE_GRID_INVERSE_SIZE;
+    uint2 TILE_GRID_COUNT;
+};
+
+StructuredBuffer<tile_light_t> TILE_LIGHTS : register(t8);
+StructuredBuffer<uint2> TILE_LIGHT_RANGES : register(t9);      // offset, count; row by row from the mins
+StructuredBuffer<uint> TILE_LIGHT_INDICES : register(t10);
+
 Texture2D <float4> tDiffuse : register(t0);
 Texture2D <float4> tNormal : register(t1);
 